@@ -0,0 +1,534 @@
+/* blas/batch.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Batched Level 2 and Level 3 operations on many small problems of
+ * the same size. The arguments are checked once for the whole batch
+ * and the problems are computed directly, without going through CBLAS.
+ * Small square problems have kernels specialized for their size;
+ * everything else uses plain loops. */
+
+#include <config.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_cblas.h>
+#include <gsl/gsl_blas_types.h>
+#include <gsl/gsl_blas.h>
+
+/* largest sizes with a specialized kernel; beyond them the copies and
+ * the fully unrolled loops are slower than the generic loops */
+#define BATCH_GEMM_NMAX 24
+#define BATCH_GEMV_NMAX 8
+
+/* number of problems computed together by the interleaved kernels */
+#define BATCH_GROUP 4
+
+#define FUNCTION(x) x ## _2
+#define NB 2
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _3
+#define NB 3
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _4
+#define NB 4
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _5
+#define NB 5
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _6
+#define NB 6
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _7
+#define NB 7
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _8
+#define NB 8
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _9
+#define NB 9
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _10
+#define NB 10
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _11
+#define NB 11
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _12
+#define NB 12
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _13
+#define NB 13
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _14
+#define NB 14
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _15
+#define NB 15
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _16
+#define NB 16
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _17
+#define NB 17
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _18
+#define NB 18
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _19
+#define NB 19
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _20
+#define NB 20
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _21
+#define NB 21
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _22
+#define NB 22
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _23
+#define NB 23
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+#define FUNCTION(x) x ## _24
+#define NB 24
+#include "source_batch.h"
+#undef NB
+#undef FUNCTION
+
+typedef void (*gemm_fixed_fn) (const int TransA, const int TransB,
+                               const double alpha, const double *a,
+                               const size_t lda, const double *b,
+                               const size_t ldb, const double beta,
+                               double *c, const size_t ldc);
+
+typedef void (*gemm_interleaved_fn) (const int TransA, const int TransB,
+                                     const double alpha,
+                                     const double * const a[],
+                                     const size_t lda[],
+                                     const double * const b[],
+                                     const size_t ldb[], const double beta,
+                                     double * const c[], const size_t ldc[]);
+
+typedef void (*gemv_fixed_fn) (const int TransA, const double alpha,
+                               const double *a, const size_t lda,
+                               const double *x, const size_t incx,
+                               const double beta, double *y,
+                               const size_t incy);
+
+static const gemm_fixed_fn gemm_fixed[BATCH_GEMM_NMAX + 1] = {
+  NULL, NULL, dgemm_fixed_2, dgemm_fixed_3, dgemm_fixed_4, dgemm_fixed_5,
+  dgemm_fixed_6, dgemm_fixed_7, dgemm_fixed_8, dgemm_fixed_9, dgemm_fixed_10,
+  dgemm_fixed_11, dgemm_fixed_12, dgemm_fixed_13, dgemm_fixed_14,
+  dgemm_fixed_15, dgemm_fixed_16, dgemm_fixed_17, dgemm_fixed_18,
+  dgemm_fixed_19, dgemm_fixed_20, dgemm_fixed_21, dgemm_fixed_22,
+  dgemm_fixed_23, dgemm_fixed_24
+};
+
+/* interleaved kernels exist for the odd sizes only */
+static const gemm_interleaved_fn gemm_interleaved[BATCH_GEMM_NMAX + 1] = {
+  NULL, NULL, NULL, dgemm_interleaved_3, NULL, dgemm_interleaved_5, NULL,
+  dgemm_interleaved_7, NULL, dgemm_interleaved_9, NULL, dgemm_interleaved_11,
+  NULL, dgemm_interleaved_13, NULL, dgemm_interleaved_15, NULL,
+  dgemm_interleaved_17, NULL, dgemm_interleaved_19, NULL,
+  dgemm_interleaved_21, NULL, dgemm_interleaved_23, NULL
+};
+
+static const gemv_fixed_fn gemv_fixed[BATCH_GEMV_NMAX + 1] = {
+  NULL, NULL, dgemv_fixed_2, dgemv_fixed_3, dgemv_fixed_4, dgemv_fixed_5,
+  dgemv_fixed_6, dgemv_fixed_7, dgemv_fixed_8
+};
+
+/* C := alpha op(A) op(B) + beta C for one M-by-N-by-K problem of any size */
+static void
+dgemm_generic (const int TransA, const int TransB, const size_t M,
+               const size_t N, const size_t K, const double alpha,
+               const double *a, const size_t lda, const double *b,
+               const size_t ldb, const double beta, double *c,
+               const size_t ldc)
+{
+  /* op(A)(i,k) = a[i * ai + k * ak] */
+  const size_t ai = (TransA == CblasNoTrans) ? lda : 1;
+  const size_t ak = (TransA == CblasNoTrans) ? 1 : lda;
+  size_t i, j, k;
+
+  for (i = 0; i < M; i++)
+    {
+      double *ci = c + i * ldc;
+
+      if (beta == 0.0)
+        {
+          for (j = 0; j < N; j++)
+            ci[j] = 0.0;
+        }
+      else if (beta != 1.0)
+        {
+          for (j = 0; j < N; j++)
+            ci[j] *= beta;
+        }
+
+      if (TransB == CblasNoTrans)
+        {
+          for (k = 0; k < K; k++)
+            {
+              const double temp = alpha * a[i * ai + k * ak];
+              const double *bk = b + k * ldb;
+
+              for (j = 0; j < N; j++)
+                ci[j] += temp * bk[j];
+            }
+        }
+      else
+        {
+          for (j = 0; j < N; j++)
+            {
+              const double *bj = b + j * ldb;
+              double temp = 0.0;
+
+              for (k = 0; k < K; k++)
+                temp += a[i * ai + k * ak] * bj[k];
+
+              ci[j] += alpha * temp;
+            }
+        }
+    }
+}
+
+/* compute ng <= BATCH_GROUP problems of the same size */
+static void
+dgemm_group (const int TransA, const int TransB, const size_t M,
+             const size_t N, const size_t K, const double alpha,
+             const double * const a[], const size_t lda[],
+             const double * const b[], const size_t ldb[],
+             const double beta, double * const c[], const size_t ldc[],
+             const size_t ng)
+{
+  size_t g;
+
+  if (M == N && N == K && M <= BATCH_GEMM_NMAX && gemm_fixed[M] != NULL)
+    {
+      if (ng == BATCH_GROUP && gemm_interleaved[M] != NULL)
+        {
+          (gemm_interleaved[M]) (TransA, TransB, alpha, a, lda, b, ldb,
+                                 beta, c, ldc);
+        }
+      else
+        {
+          for (g = 0; g < ng; g++)
+            (gemm_fixed[M]) (TransA, TransB, alpha, a[g], lda[g], b[g],
+                             ldb[g], beta, c[g], ldc[g]);
+        }
+    }
+  else
+    {
+      for (g = 0; g < ng; g++)
+        dgemm_generic (TransA, TransB, M, N, K, alpha, a[g], lda[g], b[g],
+                       ldb[g], beta, c[g], ldc[g]);
+    }
+}
+
+/* y := alpha op(A) x + beta y for one M-by-N problem of any size */
+static void
+dgemv_generic (const int TransA, const size_t M, const size_t N,
+               const double alpha, const double *a, const size_t lda,
+               const double *x, const size_t incx, const double beta,
+               double *y, const size_t incy)
+{
+  const size_t leny = (TransA == CblasNoTrans) ? M : N;
+  const size_t lenx = (TransA == CblasNoTrans) ? N : M;
+  size_t i, j;
+
+  if (TransA == CblasNoTrans)
+    {
+      for (i = 0; i < leny; i++)
+        {
+          const double *ai = a + i * lda;
+          double temp = 0.0;
+
+          for (j = 0; j < lenx; j++)
+            temp += ai[j] * x[j * incx];
+
+          y[i * incy] = (beta == 0.0) ? alpha * temp
+                                      : alpha * temp + beta * y[i * incy];
+        }
+    }
+  else
+    {
+      if (beta == 0.0)
+        {
+          for (i = 0; i < leny; i++)
+            y[i * incy] = 0.0;
+        }
+      else if (beta != 1.0)
+        {
+          for (i = 0; i < leny; i++)
+            y[i * incy] *= beta;
+        }
+
+      for (j = 0; j < lenx; j++)
+        {
+          const double *aj = a + j * lda;
+          const double temp = alpha * x[j * incx];
+
+          for (i = 0; i < leny; i++)
+            y[i * incy] += temp * aj[i];
+        }
+    }
+}
+
+static void
+dgemv_one (const int TransA, const size_t M, const size_t N,
+           const double alpha, const double *a, const size_t lda,
+           const double *x, const size_t incx, const double beta,
+           double *y, const size_t incy)
+{
+  if (M == N && M <= BATCH_GEMV_NMAX && gemv_fixed[M] != NULL)
+    (gemv_fixed[M]) (TransA, alpha, a, lda, x, incx, beta, y, incy);
+  else
+    dgemv_generic (TransA, M, N, alpha, a, lda, x, incx, beta, y, incy);
+}
+
+int
+gsl_blas_dgemm_batch (CBLAS_TRANSPOSE_t TransA, CBLAS_TRANSPOSE_t TransB,
+                      double alpha, const gsl_matrix * const A[],
+                      const gsl_matrix * const B[], double beta,
+                      gsl_matrix * const C[], const size_t batch_size)
+{
+  const double *a[BATCH_GROUP], *b[BATCH_GROUP];
+  double *c[BATCH_GROUP];
+  size_t lda[BATCH_GROUP], ldb[BATCH_GROUP], ldc[BATCH_GROUP];
+  size_t M, N, K, i;
+
+  if (batch_size == 0)
+    return GSL_SUCCESS;
+
+  M = C[0]->size1;
+  N = C[0]->size2;
+  K = (TransA == CblasNoTrans) ? A[0]->size2 : A[0]->size1;
+
+  for (i = 0; i < batch_size; i++)
+    {
+      const size_t MA = (TransA == CblasNoTrans) ? A[i]->size1 : A[i]->size2;
+      const size_t NA = (TransA == CblasNoTrans) ? A[i]->size2 : A[i]->size1;
+      const size_t MB = (TransB == CblasNoTrans) ? B[i]->size1 : B[i]->size2;
+      const size_t NB = (TransB == CblasNoTrans) ? B[i]->size2 : B[i]->size1;
+
+      if (C[i]->size1 != M || C[i]->size2 != N || MA != M || NA != K
+          || MB != K || NB != N)
+        {
+          GSL_ERROR ("invalid length", GSL_EBADLEN);
+        }
+    }
+
+  for (i = 0; i < batch_size; i += BATCH_GROUP)
+    {
+      const size_t ng = GSL_MIN (BATCH_GROUP, batch_size - i);
+      size_t g;
+
+      for (g = 0; g < ng; g++)
+        {
+          a[g] = A[i + g]->data;
+          lda[g] = A[i + g]->tda;
+          b[g] = B[i + g]->data;
+          ldb[g] = B[i + g]->tda;
+          c[g] = C[i + g]->data;
+          ldc[g] = C[i + g]->tda;
+        }
+
+      dgemm_group (TransA, TransB, M, N, K, alpha, a, lda, b, ldb, beta,
+                   c, ldc, ng);
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_blas_dgemm_batch_strided (CBLAS_TRANSPOSE_t TransA,
+                              CBLAS_TRANSPOSE_t TransB, const size_t M,
+                              const size_t N, const size_t K, double alpha,
+                              const double * A, const size_t lda,
+                              const size_t strideA, const double * B,
+                              const size_t ldb, const size_t strideB,
+                              double beta, double * C, const size_t ldc,
+                              const size_t strideC, const size_t batch_size)
+{
+  const double *a[BATCH_GROUP], *b[BATCH_GROUP];
+  double *c[BATCH_GROUP];
+  size_t la[BATCH_GROUP], lb[BATCH_GROUP], lc[BATCH_GROUP];
+  size_t i, g;
+
+  if (lda < ((TransA == CblasNoTrans) ? K : M)
+      || ldb < ((TransB == CblasNoTrans) ? N : K) || ldc < N)
+    {
+      GSL_ERROR ("leading dimension is too small", GSL_EINVAL);
+    }
+
+  if (M == 0 || N == 0 || batch_size == 0)
+    return GSL_SUCCESS;
+
+  for (g = 0; g < BATCH_GROUP; g++)
+    {
+      la[g] = lda;
+      lb[g] = ldb;
+      lc[g] = ldc;
+    }
+
+  for (i = 0; i < batch_size; i += BATCH_GROUP)
+    {
+      const size_t ng = GSL_MIN (BATCH_GROUP, batch_size - i);
+
+      for (g = 0; g < ng; g++)
+        {
+          a[g] = A + (i + g) * strideA;
+          b[g] = B + (i + g) * strideB;
+          c[g] = C + (i + g) * strideC;
+        }
+
+      dgemm_group (TransA, TransB, M, N, K, alpha, a, la, b, lb, beta,
+                   c, lc, ng);
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_blas_dgemv_batch (CBLAS_TRANSPOSE_t TransA, double alpha,
+                      const gsl_matrix * const A[],
+                      const gsl_vector * const X[], double beta,
+                      gsl_vector * const Y[], const size_t batch_size)
+{
+  size_t M, N, i;
+
+  if (batch_size == 0)
+    return GSL_SUCCESS;
+
+  M = A[0]->size1;
+  N = A[0]->size2;
+
+  for (i = 0; i < batch_size; i++)
+    {
+      const size_t lenx = (TransA == CblasNoTrans) ? N : M;
+      const size_t leny = (TransA == CblasNoTrans) ? M : N;
+
+      if (A[i]->size1 != M || A[i]->size2 != N || X[i]->size != lenx
+          || Y[i]->size != leny)
+        {
+          GSL_ERROR ("invalid length", GSL_EBADLEN);
+        }
+    }
+
+  for (i = 0; i < batch_size; i++)
+    {
+      dgemv_one (TransA, M, N, alpha, A[i]->data, A[i]->tda, X[i]->data,
+                 X[i]->stride, beta, Y[i]->data, Y[i]->stride);
+    }
+
+  return GSL_SUCCESS;
+}
+
+int
+gsl_blas_dgemv_batch_strided (CBLAS_TRANSPOSE_t TransA, const size_t M,
+                              const size_t N, double alpha,
+                              const double * A, const size_t lda,
+                              const size_t strideA, const double * X,
+                              const size_t strideX, double beta, double * Y,
+                              const size_t strideY, const size_t batch_size)
+{
+  size_t i;
+
+  if (lda < N)
+    {
+      GSL_ERROR ("leading dimension is too small", GSL_EINVAL);
+    }
+
+  if (M == 0 || N == 0)
+    return GSL_SUCCESS;
+
+  for (i = 0; i < batch_size; i++)
+    {
+      dgemv_one (TransA, M, N, alpha, A + i * strideA, lda, X + i * strideX,
+                 1, beta, Y + i * strideY, 1);
+    }
+
+  return GSL_SUCCESS;
+}
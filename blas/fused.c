@@ -0,0 +1,170 @@
+/* blas/fused.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Fused Level 2 operations. gsl_blas_dger_gemv does the work of two
+ * BLAS calls on the same matrix in a single sweep over its rows, so
+ * that a matrix which does not fit in cache is read from memory only
+ * once. */
+
+#include <config.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_cblas.h>
+#include <gsl/gsl_blas_types.h>
+#include <gsl/gsl_blas.h>
+
+static double
+row_dot (const size_t n, const double *a, const double *x, const size_t incx)
+{
+  double r = 0.0;
+  size_t j;
+
+  if (incx == 1)
+    {
+      for (j = 0; j < n; j++)
+        r += a[j] * x[j];
+    }
+  else
+    {
+      for (j = 0; j < n; j++)
+        r += a[j] * x[j * incx];
+    }
+
+  return r;
+}
+
+/* y := alpha a + y */
+static void
+row_axpy (const size_t n, const double alpha, const double *a,
+          double *y, const size_t incy)
+{
+  size_t j;
+
+  if (incy == 1)
+    {
+      for (j = 0; j < n; j++)
+        y[j] += alpha * a[j];
+    }
+  else
+    {
+      for (j = 0; j < n; j++)
+        y[j * incy] += alpha * a[j];
+    }
+}
+
+/* a := alpha x + a */
+static void
+row_update (const size_t n, const double alpha, const double *x,
+            const size_t incx, double *a)
+{
+  size_t j;
+
+  if (incx == 1)
+    {
+      for (j = 0; j < n; j++)
+        a[j] += alpha * x[j];
+    }
+  else
+    {
+      for (j = 0; j < n; j++)
+        a[j] += alpha * x[j * incx];
+    }
+}
+
+static void
+vector_scale (const double beta, gsl_vector * Y)
+{
+  double *y = Y->data;
+  const size_t incy = Y->stride;
+  size_t i;
+
+  if (beta == 0.0)
+    {
+      for (i = 0; i < Y->size; i++)
+        y[i * incy] = 0.0;
+    }
+  else if (beta != 1.0)
+    {
+      for (i = 0; i < Y->size; i++)
+        y[i * incy] *= beta;
+    }
+}
+
+int
+gsl_blas_dger_gemv (CBLAS_TRANSPOSE_t TransA, double alpha,
+                    const gsl_vector * U, const gsl_vector * V,
+                    gsl_matrix * A, const gsl_vector * X,
+                    double beta, gsl_vector * Y)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+
+  if (U->size != M || V->size != N)
+    {
+      GSL_ERROR ("invalid length", GSL_EBADLEN);
+    }
+  else if ((TransA == CblasNoTrans && (X->size != N || Y->size != M))
+           || (TransA == CblasTrans && (X->size != M || Y->size != N)))
+    {
+      GSL_ERROR ("invalid length", GSL_EBADLEN);
+    }
+  else if (TransA != CblasNoTrans && TransA != CblasTrans)
+    {
+      GSL_ERROR ("unrecognized operation", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t incu = U->stride;
+      const size_t incv = V->stride;
+      const size_t incx = X->stride;
+      const size_t incy = Y->stride;
+      size_t i;
+
+      if (TransA == CblasTrans)
+        vector_scale (beta, Y);
+
+      for (i = 0; i < M; i++)
+        {
+          double *Ai = A->data + i * A->tda;
+          const double ui = alpha * U->data[i * incu];
+
+          /* A(i,:) += alpha U(i) V^T, then use the updated row while it
+           * is still in cache */
+          if (ui != 0.0)
+            row_update (N, ui, V->data, incv, Ai);
+
+          if (TransA == CblasNoTrans)
+            {
+              const double r = row_dot (N, Ai, X->data, incx);
+              double *yi = Y->data + i * incy;
+
+              if (beta == 0.0)
+                *yi = r;
+              else
+                *yi = r + beta * (*yi);
+            }
+          else
+            {
+              row_axpy (N, X->data[i * incx], Ai, Y->data, incy);
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
@@ -597,6 +597,68 @@ int  gsl_blas_zher2k (CBLAS_UPLO_t Uplo,
                       gsl_matrix_complex * C);
 
 
+/* ========================================================================
+ * Fused operations, one pass over the matrix
+ * ========================================================================
+ */
+
+int  gsl_blas_dger_gemv (CBLAS_TRANSPOSE_t TransA,
+                         double alpha,
+                         const gsl_vector * U,
+                         const gsl_vector * V,
+                         gsl_matrix * A,
+                         const gsl_vector * X,
+                         double beta,
+                         gsl_vector * Y);
+
+
+/* ========================================================================
+ * Batched operations on many small problems of the same size
+ * ========================================================================
+ */
+
+int  gsl_blas_dgemv_batch (CBLAS_TRANSPOSE_t TransA,
+                           double alpha,
+                           const gsl_matrix * const A[],
+                           const gsl_vector * const X[],
+                           double beta,
+                           gsl_vector * const Y[],
+                           const size_t batch_size);
+
+int  gsl_blas_dgemv_batch_strided (CBLAS_TRANSPOSE_t TransA,
+                                   const size_t M, const size_t N,
+                                   double alpha,
+                                   const double * A, const size_t lda,
+                                   const size_t strideA,
+                                   const double * X, const size_t strideX,
+                                   double beta,
+                                   double * Y, const size_t strideY,
+                                   const size_t batch_size);
+
+int  gsl_blas_dgemm_batch (CBLAS_TRANSPOSE_t TransA,
+                           CBLAS_TRANSPOSE_t TransB,
+                           double alpha,
+                           const gsl_matrix * const A[],
+                           const gsl_matrix * const B[],
+                           double beta,
+                           gsl_matrix * const C[],
+                           const size_t batch_size);
+
+int  gsl_blas_dgemm_batch_strided (CBLAS_TRANSPOSE_t TransA,
+                                   CBLAS_TRANSPOSE_t TransB,
+                                   const size_t M, const size_t N,
+                                   const size_t K,
+                                   double alpha,
+                                   const double * A, const size_t lda,
+                                   const size_t strideA,
+                                   const double * B, const size_t ldb,
+                                   const size_t strideB,
+                                   double beta,
+                                   double * C, const size_t ldc,
+                                   const size_t strideC,
+                                   const size_t batch_size);
+
+
 __END_DECLS
 
 #endif /* __GSL_BLAS_H__ */
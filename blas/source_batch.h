@@ -0,0 +1,202 @@
+/* blas/source_batch.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Kernels for batches of NB-by-NB problems. NB is a compile-time
+ * constant, so the compiler unrolls the loops completely and keeps the
+ * operands in registers. This file is included once for each size with
+ * NB defined and FUNCTION(x) mapping x to a size-specific name. */
+
+/* C := alpha op(A) op(B) + beta C for a single problem */
+static void
+FUNCTION (dgemm_fixed) (const int TransA, const int TransB, const double alpha,
+                        const double *a, const size_t lda,
+                        const double *b, const size_t ldb,
+                        const double beta, double *c, const size_t ldc)
+{
+  double A[NB * NB], B[NB * NB], s[NB];
+  size_t i, j, k;
+
+  if (TransA == CblasNoTrans)
+    {
+      for (i = 0; i < NB; i++)
+        for (k = 0; k < NB; k++)
+          A[i * NB + k] = a[i * lda + k];
+    }
+  else
+    {
+      for (i = 0; i < NB; i++)
+        for (k = 0; k < NB; k++)
+          A[i * NB + k] = a[k * lda + i];
+    }
+
+  if (TransB == CblasNoTrans)
+    {
+      for (k = 0; k < NB; k++)
+        for (j = 0; j < NB; j++)
+          B[k * NB + j] = b[k * ldb + j];
+    }
+  else
+    {
+      for (k = 0; k < NB; k++)
+        for (j = 0; j < NB; j++)
+          B[k * NB + j] = b[j * ldb + k];
+    }
+
+  for (i = 0; i < NB; i++)
+    {
+      for (j = 0; j < NB; j++)
+        s[j] = 0.0;
+
+      for (k = 0; k < NB; k++)
+        {
+          const double aik = A[i * NB + k];
+
+          for (j = 0; j < NB; j++)
+            s[j] += aik * B[k * NB + j];
+        }
+
+      if (beta == 0.0)
+        {
+          for (j = 0; j < NB; j++)
+            c[i * ldc + j] = alpha * s[j];
+        }
+      else
+        {
+          for (j = 0; j < NB; j++)
+            c[i * ldc + j] = alpha * s[j] + beta * c[i * ldc + j];
+        }
+    }
+}
+
+#if NB % 2 == 1
+
+/* the same for BATCH_GROUP problems at once; the operands are copied
+ * into interleaved storage so that the innermost loop runs across the
+ * problems and vectorizes even when NB is not a multiple of the SIMD
+ * width. Even sizes already vectorize within a single problem, so the
+ * kernel is only built for odd NB */
+static void
+FUNCTION (dgemm_interleaved) (const int TransA, const int TransB,
+                              const double alpha,
+                              const double * const a[], const size_t lda[],
+                              const double * const b[], const size_t ldb[],
+                              const double beta,
+                              double * const c[], const size_t ldc[])
+{
+  double A[NB * NB][BATCH_GROUP], B[NB * NB][BATCH_GROUP];
+  double s[NB][BATCH_GROUP];
+  size_t g, i, j, k;
+
+  for (g = 0; g < BATCH_GROUP; g++)
+    {
+      /* element (i,j) of op(X) is x[i * xr + j * xc] */
+      const size_t ar = (TransA == CblasNoTrans) ? lda[g] : 1;
+      const size_t ac = (TransA == CblasNoTrans) ? 1 : lda[g];
+      const size_t br = (TransB == CblasNoTrans) ? ldb[g] : 1;
+      const size_t bc = (TransB == CblasNoTrans) ? 1 : ldb[g];
+
+      for (i = 0; i < NB; i++)
+        for (k = 0; k < NB; k++)
+          A[i * NB + k][g] = a[g][i * ar + k * ac];
+
+      for (k = 0; k < NB; k++)
+        for (j = 0; j < NB; j++)
+          B[k * NB + j][g] = b[g][k * br + j * bc];
+    }
+
+  for (i = 0; i < NB; i++)
+    {
+      for (j = 0; j < NB; j++)
+        for (g = 0; g < BATCH_GROUP; g++)
+          s[j][g] = 0.0;
+
+      for (k = 0; k < NB; k++)
+        for (j = 0; j < NB; j++)
+          for (g = 0; g < BATCH_GROUP; g++)
+            s[j][g] += A[i * NB + k][g] * B[k * NB + j][g];
+
+      for (g = 0; g < BATCH_GROUP; g++)
+        {
+          double *ci = c[g] + i * ldc[g];
+
+          if (beta == 0.0)
+            {
+              for (j = 0; j < NB; j++)
+                ci[j] = alpha * s[j][g];
+            }
+          else
+            {
+              for (j = 0; j < NB; j++)
+                ci[j] = alpha * s[j][g] + beta * ci[j];
+            }
+        }
+    }
+}
+
+#endif /* NB % 2 == 1 */
+
+#if NB <= BATCH_GEMV_NMAX
+
+/* y := alpha op(A) x + beta y for a single problem */
+static void
+FUNCTION (dgemv_fixed) (const int TransA, const double alpha,
+                        const double *a, const size_t lda,
+                        const double *x, const size_t incx,
+                        const double beta, double *y, const size_t incy)
+{
+  double A[NB * NB], X[NB], s[NB];
+  size_t i, j;
+
+  if (TransA == CblasNoTrans)
+    {
+      for (i = 0; i < NB; i++)
+        for (j = 0; j < NB; j++)
+          A[i * NB + j] = a[i * lda + j];
+    }
+  else
+    {
+      for (i = 0; i < NB; i++)
+        for (j = 0; j < NB; j++)
+          A[i * NB + j] = a[j * lda + i];
+    }
+
+  for (j = 0; j < NB; j++)
+    X[j] = x[j * incx];
+
+  for (i = 0; i < NB; i++)
+    {
+      s[i] = 0.0;
+
+      for (j = 0; j < NB; j++)
+        s[i] += A[i * NB + j] * X[j];
+    }
+
+  if (beta == 0.0)
+    {
+      for (i = 0; i < NB; i++)
+        y[i * incy] = alpha * s[i];
+    }
+  else
+    {
+      for (i = 0; i < NB; i++)
+        y[i * incy] = alpha * s[i] + beta * y[i * incy];
+    }
+}
+
+#endif /* NB <= BATCH_GEMV_NMAX */
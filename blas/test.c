@@ -0,0 +1,448 @@
+/* blas/test.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Tests of the routines which are implemented in this directory rather
+ * than passed through to CBLAS. Each one is compared with the result of
+ * the plain gsl_blas calls it replaces. */
+
+#include <config.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_ieee_utils.h>
+
+/* the entries are O(1), so the results are compared with an absolute
+ * tolerance; the kernels sum in a different order from CBLAS */
+#define TEST_TOL (64.0 * GSL_DBL_EPSILON)
+
+static const CBLAS_TRANSPOSE_t trans[2] = { CblasNoTrans, CblasTrans };
+
+static double
+urand (void)
+{
+  static unsigned long int x = 1;
+  x = (1103515245 * x + 12345) & 0x7fffffffUL;
+  return x / 2147483648.0 - 0.5;
+}
+
+static double *
+random_array (const size_t n)
+{
+  double *p = malloc (n * sizeof (double));
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    p[i] = urand ();
+
+  return p;
+}
+
+/* compare n elements of two arrays */
+static void
+test_array (const double *x, const double *y, const size_t n,
+            const char *desc, const size_t M, const size_t N,
+            const size_t K, const CBLAS_TRANSPOSE_t TransA,
+            const CBLAS_TRANSPOSE_t TransB, const size_t nbatch)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      gsl_test_abs (x[i], y[i], TEST_TOL,
+                    "%s (%u,%u,%u) TransA=%d TransB=%d batch=%u [%u]",
+                    desc, (unsigned) M, (unsigned) N, (unsigned) K,
+                    TransA == CblasTrans, TransB == CblasTrans,
+                    (unsigned) nbatch, (unsigned) i);
+    }
+}
+
+/* gsl_blas_dgemm_batch on matrices with padded rows, against a loop of
+ * gsl_blas_dgemm */
+static void
+test_dgemm_batch (const CBLAS_TRANSPOSE_t TransA,
+                  const CBLAS_TRANSPOSE_t TransB, const size_t M,
+                  const size_t N, const size_t K, const double beta,
+                  const size_t nbatch)
+{
+  const double alpha = 0.7;
+  const size_t MA = (TransA == CblasNoTrans) ? M : K;
+  const size_t NA = (TransA == CblasNoTrans) ? K : M;
+  const size_t MB = (TransB == CblasNoTrans) ? K : N;
+  const size_t NB = (TransB == CblasNoTrans) ? N : K;
+  const size_t tda = NA + 2, tdb = NB + 1, tdc = N + 3;
+  const size_t sa = MA * tda, sb = MB * tdb, sc = M * tdc;
+  double *a = random_array (nbatch * sa);
+  double *b = random_array (nbatch * sb);
+  double *c = random_array (nbatch * sc);
+  double *c0 = malloc (nbatch * sc * sizeof (double));
+  gsl_matrix_view *av = malloc (nbatch * sizeof (gsl_matrix_view));
+  gsl_matrix_view *bv = malloc (nbatch * sizeof (gsl_matrix_view));
+  gsl_matrix_view *cv = malloc (nbatch * sizeof (gsl_matrix_view));
+  const gsl_matrix **A = malloc (nbatch * sizeof (gsl_matrix *));
+  const gsl_matrix **B = malloc (nbatch * sizeof (gsl_matrix *));
+  gsl_matrix **C = malloc (nbatch * sizeof (gsl_matrix *));
+  size_t i, j;
+  int status;
+
+  memcpy (c0, c, nbatch * sc * sizeof (double));
+
+  for (i = 0; i < nbatch; i++)
+    {
+      av[i] = gsl_matrix_view_array_with_tda (a + i * sa, MA, NA, tda);
+      bv[i] = gsl_matrix_view_array_with_tda (b + i * sb, MB, NB, tdb);
+      cv[i] = gsl_matrix_view_array_with_tda (c + i * sc, M, N, tdc);
+      A[i] = &av[i].matrix;
+      B[i] = &bv[i].matrix;
+      C[i] = &cv[i].matrix;
+    }
+
+  status = gsl_blas_dgemm_batch (TransA, TransB, alpha,
+                                 (const gsl_matrix * const *) A,
+                                 (const gsl_matrix * const *) B, beta,
+                                 (gsl_matrix * const *) C, nbatch);
+  gsl_test (status, "dgemm_batch (%u,%u,%u) status", (unsigned) M,
+            (unsigned) N, (unsigned) K);
+
+  for (i = 0; i < nbatch; i++)
+    {
+      gsl_matrix_view c0v =
+        gsl_matrix_view_array_with_tda (c0 + i * sc, M, N, tdc);
+
+      gsl_blas_dgemm (TransA, TransB, alpha, A[i], B[i], beta, &c0v.matrix);
+
+      for (j = 0; j < M; j++)
+        test_array (c + i * sc + j * tdc, c0 + i * sc + j * tdc, N,
+                    "dgemm_batch", M, N, K, TransA, TransB, nbatch);
+    }
+
+  free (a);
+  free (b);
+  free (c);
+  free (c0);
+  free (av);
+  free (bv);
+  free (cv);
+  free (A);
+  free (B);
+  free (C);
+}
+
+/* gsl_blas_dgemm_batch_strided with gaps between the problems and
+ * leading dimensions larger than the rows, against a loop of
+ * gsl_blas_dgemm */
+static void
+test_dgemm_batch_strided (const CBLAS_TRANSPOSE_t TransA,
+                          const CBLAS_TRANSPOSE_t TransB, const size_t M,
+                          const size_t N, const size_t K, const double beta,
+                          const size_t nbatch)
+{
+  const double alpha = -1.3;
+  const size_t MA = (TransA == CblasNoTrans) ? M : K;
+  const size_t NA = (TransA == CblasNoTrans) ? K : M;
+  const size_t MB = (TransB == CblasNoTrans) ? K : N;
+  const size_t NB = (TransB == CblasNoTrans) ? N : K;
+  const size_t lda = NA + 1, ldb = NB + 3, ldc = N + 2;
+  const size_t sa = MA * lda + 5, sb = MB * ldb + 1, sc = M * ldc + 7;
+  double *a = random_array (nbatch * sa);
+  double *b = random_array (nbatch * sb);
+  double *c = random_array (nbatch * sc);
+  double *c0 = malloc (nbatch * sc * sizeof (double));
+  size_t i, j;
+  int status;
+
+  memcpy (c0, c, nbatch * sc * sizeof (double));
+
+  status = gsl_blas_dgemm_batch_strided (TransA, TransB, M, N, K, alpha,
+                                         a, lda, sa, b, ldb, sb, beta,
+                                         c, ldc, sc, nbatch);
+  gsl_test (status, "dgemm_batch_strided (%u,%u,%u) status", (unsigned) M,
+            (unsigned) N, (unsigned) K);
+
+  for (i = 0; i < nbatch; i++)
+    {
+      gsl_matrix_const_view av =
+        gsl_matrix_const_view_array_with_tda (a + i * sa, MA, NA, lda);
+      gsl_matrix_const_view bv =
+        gsl_matrix_const_view_array_with_tda (b + i * sb, MB, NB, ldb);
+      gsl_matrix_view cv =
+        gsl_matrix_view_array_with_tda (c0 + i * sc, M, N, ldc);
+
+      gsl_blas_dgemm (TransA, TransB, alpha, &av.matrix, &bv.matrix, beta,
+                      &cv.matrix);
+
+      for (j = 0; j < M; j++)
+        test_array (c + i * sc + j * ldc, c0 + i * sc + j * ldc, N,
+                    "dgemm_batch_strided", M, N, K, TransA, TransB, nbatch);
+
+      /* the gap after each problem must be left alone */
+      test_array (c + i * sc + M * ldc, c0 + i * sc + M * ldc, sc - M * ldc,
+                  "dgemm_batch_strided gap", M, N, K, TransA, TransB,
+                  nbatch);
+    }
+
+  free (a);
+  free (b);
+  free (c);
+  free (c0);
+}
+
+/* gsl_blas_dgemv_batch on padded matrices and vectors with non-unit
+ * stride, against a loop of gsl_blas_dgemv */
+static void
+test_dgemv_batch (const CBLAS_TRANSPOSE_t TransA, const size_t M,
+                  const size_t N, const double beta, const size_t nbatch)
+{
+  const double alpha = 1.1;
+  const size_t lenx = (TransA == CblasNoTrans) ? N : M;
+  const size_t leny = (TransA == CblasNoTrans) ? M : N;
+  const size_t tda = N + 1, incx = 2, incy = 3;
+  const size_t sa = M * tda, sx = lenx * incx, sy = leny * incy;
+  double *a = random_array (nbatch * sa);
+  double *x = random_array (nbatch * sx);
+  double *y = random_array (nbatch * sy);
+  double *y0 = malloc (nbatch * sy * sizeof (double));
+  gsl_matrix_view *av = malloc (nbatch * sizeof (gsl_matrix_view));
+  gsl_vector_view *xv = malloc (nbatch * sizeof (gsl_vector_view));
+  gsl_vector_view *yv = malloc (nbatch * sizeof (gsl_vector_view));
+  const gsl_matrix **A = malloc (nbatch * sizeof (gsl_matrix *));
+  const gsl_vector **X = malloc (nbatch * sizeof (gsl_vector *));
+  gsl_vector **Y = malloc (nbatch * sizeof (gsl_vector *));
+  size_t i;
+  int status;
+
+  memcpy (y0, y, nbatch * sy * sizeof (double));
+
+  for (i = 0; i < nbatch; i++)
+    {
+      av[i] = gsl_matrix_view_array_with_tda (a + i * sa, M, N, tda);
+      xv[i] = gsl_vector_view_array_with_stride (x + i * sx, incx, lenx);
+      yv[i] = gsl_vector_view_array_with_stride (y + i * sy, incy, leny);
+      A[i] = &av[i].matrix;
+      X[i] = &xv[i].vector;
+      Y[i] = &yv[i].vector;
+    }
+
+  status = gsl_blas_dgemv_batch (TransA, alpha,
+                                 (const gsl_matrix * const *) A,
+                                 (const gsl_vector * const *) X, beta,
+                                 (gsl_vector * const *) Y, nbatch);
+  gsl_test (status, "dgemv_batch (%u,%u) status", (unsigned) M,
+            (unsigned) N);
+
+  for (i = 0; i < nbatch; i++)
+    {
+      gsl_vector_view y0v =
+        gsl_vector_view_array_with_stride (y0 + i * sy, incy, leny);
+
+      gsl_blas_dgemv (TransA, alpha, A[i], X[i], beta, &y0v.vector);
+
+      /* this also checks the elements between the strides */
+      test_array (y + i * sy, y0 + i * sy, sy, "dgemv_batch", M, N, 0,
+                  TransA, CblasNoTrans, nbatch);
+    }
+
+  free (a);
+  free (x);
+  free (y);
+  free (y0);
+  free (av);
+  free (xv);
+  free (yv);
+  free (A);
+  free (X);
+  free (Y);
+}
+
+/* gsl_blas_dgemv_batch_strided with gaps between the problems, against
+ * a loop of gsl_blas_dgemv */
+static void
+test_dgemv_batch_strided (const CBLAS_TRANSPOSE_t TransA, const size_t M,
+                          const size_t N, const double beta,
+                          const size_t nbatch)
+{
+  const double alpha = -0.6;
+  const size_t lenx = (TransA == CblasNoTrans) ? N : M;
+  const size_t leny = (TransA == CblasNoTrans) ? M : N;
+  const size_t lda = N + 2;
+  const size_t sa = M * lda + 3, sx = lenx + 1, sy = leny + 2;
+  double *a = random_array (nbatch * sa);
+  double *x = random_array (nbatch * sx);
+  double *y = random_array (nbatch * sy);
+  double *y0 = malloc (nbatch * sy * sizeof (double));
+  size_t i;
+  int status;
+
+  memcpy (y0, y, nbatch * sy * sizeof (double));
+
+  status = gsl_blas_dgemv_batch_strided (TransA, M, N, alpha, a, lda, sa,
+                                         x, sx, beta, y, sy, nbatch);
+  gsl_test (status, "dgemv_batch_strided (%u,%u) status", (unsigned) M,
+            (unsigned) N);
+
+  for (i = 0; i < nbatch; i++)
+    {
+      gsl_matrix_const_view av =
+        gsl_matrix_const_view_array_with_tda (a + i * sa, M, N, lda);
+      gsl_vector_const_view xv = gsl_vector_const_view_array (x + i * sx, lenx);
+      gsl_vector_view yv = gsl_vector_view_array (y0 + i * sy, leny);
+
+      gsl_blas_dgemv (TransA, alpha, &av.matrix, &xv.vector, beta,
+                      &yv.vector);
+
+      test_array (y + i * sy, y0 + i * sy, sy, "dgemv_batch_strided",
+                  M, N, 0, TransA, CblasNoTrans, nbatch);
+    }
+
+  free (a);
+  free (x);
+  free (y);
+  free (y0);
+}
+
+/* gsl_blas_dger_gemv against gsl_blas_dger followed by gsl_blas_dgemv */
+static void
+test_dger_gemv (const CBLAS_TRANSPOSE_t TransA, const size_t M,
+                const size_t N, const double alpha, const double beta)
+{
+  const size_t lenx = (TransA == CblasNoTrans) ? N : M;
+  const size_t leny = (TransA == CblasNoTrans) ? M : N;
+  const size_t tda = N + 2, incu = 2, incv = 1, incx = 3, incy = 2;
+  double *a = random_array (M * tda);
+  double *u = random_array (M * incu);
+  double *v = random_array (N * incv);
+  double *x = random_array (lenx * incx);
+  double *y = random_array (leny * incy);
+  double *a0 = malloc (M * tda * sizeof (double));
+  double *y0 = malloc (leny * incy * sizeof (double));
+  gsl_matrix_view A = gsl_matrix_view_array_with_tda (a, M, N, tda);
+  gsl_matrix_view A0 = gsl_matrix_view_array_with_tda (a0, M, N, tda);
+  gsl_vector_view U = gsl_vector_view_array_with_stride (u, incu, M);
+  gsl_vector_view V = gsl_vector_view_array_with_stride (v, incv, N);
+  gsl_vector_view X = gsl_vector_view_array_with_stride (x, incx, lenx);
+  gsl_vector_view Y = gsl_vector_view_array_with_stride (y, incy, leny);
+  gsl_vector_view Y0 = gsl_vector_view_array_with_stride (y0, incy, leny);
+  int status;
+
+  memcpy (a0, a, M * tda * sizeof (double));
+  memcpy (y0, y, leny * incy * sizeof (double));
+
+  status = gsl_blas_dger_gemv (TransA, alpha, &U.vector, &V.vector,
+                               &A.matrix, &X.vector, beta, &Y.vector);
+  gsl_test (status, "dger_gemv (%u,%u) status", (unsigned) M, (unsigned) N);
+
+  gsl_blas_dger (alpha, &U.vector, &V.vector, &A0.matrix);
+  gsl_blas_dgemv (TransA, 1.0, &A0.matrix, &X.vector, beta, &Y0.vector);
+
+  test_array (a, a0, M * tda, "dger_gemv A", M, N, 0, TransA, CblasNoTrans,
+              1);
+  test_array (y, y0, leny * incy, "dger_gemv y", M, N, 0, TransA,
+              CblasNoTrans, 1);
+
+  free (a);
+  free (u);
+  free (v);
+  free (x);
+  free (y);
+  free (a0);
+  free (y0);
+}
+
+static void
+test_batch (void)
+{
+  /* square sizes cover the specialized kernels (2 to 24 for dgemm,
+   * interleaved for the odd ones, and 2 to 8 for dgemv) and the
+   * generic loops on either side */
+  static const size_t dims[][3] = {
+    { 1, 1, 1 }, { 2, 2, 2 }, { 3, 3, 3 }, { 4, 4, 4 }, { 5, 5, 5 },
+    { 6, 6, 6 }, { 7, 7, 7 }, { 8, 8, 8 }, { 9, 9, 9 }, { 16, 16, 16 },
+    { 23, 23, 23 }, { 24, 24, 24 }, { 25, 25, 25 },
+    { 3, 5, 4 }, { 7, 2, 6 }, { 10, 6, 13 }
+  };
+  static const size_t nbatch[] = { 1, 4, 13 };
+  static const double beta[] = { 0.0, 1.0, -0.4 };
+  size_t d, n, b, ta, tb;
+
+  for (d = 0; d < sizeof (dims) / sizeof (dims[0]); d++)
+    {
+      const size_t M = dims[d][0], N = dims[d][1], K = dims[d][2];
+
+      for (n = 0; n < sizeof (nbatch) / sizeof (nbatch[0]); n++)
+        {
+          for (b = 0; b < sizeof (beta) / sizeof (beta[0]); b++)
+            {
+              for (ta = 0; ta < 2; ta++)
+                {
+                  test_dgemv_batch (trans[ta], M, N, beta[b], nbatch[n]);
+                  test_dgemv_batch_strided (trans[ta], M, N, beta[b],
+                                            nbatch[n]);
+
+                  for (tb = 0; tb < 2; tb++)
+                    {
+                      test_dgemm_batch (trans[ta], trans[tb], M, N, K,
+                                        beta[b], nbatch[n]);
+                      test_dgemm_batch_strided (trans[ta], trans[tb], M, N,
+                                                K, beta[b], nbatch[n]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void
+test_fused (void)
+{
+  static const size_t dims[][2] = {
+    { 1, 1 }, { 5, 3 }, { 3, 7 }, { 40, 33 }
+  };
+  static const double beta[] = { 0.0, 1.0, -0.4 };
+  size_t d, b, ta;
+
+  for (d = 0; d < sizeof (dims) / sizeof (dims[0]); d++)
+    {
+      const size_t M = dims[d][0], N = dims[d][1];
+
+      for (b = 0; b < sizeof (beta) / sizeof (beta[0]); b++)
+        {
+          for (ta = 0; ta < 2; ta++)
+            {
+              test_dger_gemv (trans[ta], M, N, 0.0, beta[b]);
+              test_dger_gemv (trans[ta], M, N, 1.7, beta[b]);
+            }
+        }
+    }
+}
+
+int
+main (void)
+{
+  gsl_ieee_env_setup ();
+
+  test_batch ();
+  test_fused ();
+
+  exit (gsl_test_summary ());
+}
@@ -0,0 +1,53 @@
+/* cblas/blocked_l3.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Internal interface to the recursive Level 3 routines, which reduce
+ * the work to GEMM calls on sub-matrices. The arguments side, uplo and
+ * trans are those of a row-major problem, as computed at the top of
+ * the corresponding source_*_r.h file.
+ */
+
+#ifndef __BLOCKED_L3_H__
+#define __BLOCKED_L3_H__
+
+/* triangles of order at most this are handled by the unblocked loops */
+#define TR_BLOCKED_NB 64
+
+void gslcblas_dtrsm_blocked (const int side, const int uplo, const int trans,
+                             const int diag, const int n1, const int n2,
+                             const double alpha, const double *A, const int lda,
+                             double *B, const int ldb);
+
+void gslcblas_dtrmm_blocked (const int side, const int uplo, const int trans,
+                             const int diag, const int n1, const int n2,
+                             const double alpha, const double *A, const int lda,
+                             double *B, const int ldb);
+
+void gslcblas_strsm_blocked (const int side, const int uplo, const int trans,
+                             const int diag, const int n1, const int n2,
+                             const float alpha, const float *A, const int lda,
+                             float *B, const int ldb);
+
+void gslcblas_strmm_blocked (const int side, const int uplo, const int trans,
+                             const int diag, const int n1, const int n2,
+                             const float alpha, const float *A, const int lda,
+                             float *B, const int ldb);
+
+#endif /* __BLOCKED_L3_H__ */
@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_blocked.h"
 
 void
 cblas_cgemm (const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA,
@@ -11,6 +12,8 @@ cblas_cgemm (const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA,
              const int ldc)
 {
 #define BASE float
+#define GEMM_BLOCKED gslcblas_cgemm_blocked
 #include "source_gemm_c.h"
+#undef GEMM_BLOCKED
 #undef BASE
 }
@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_blocked.h"
 
 void
 cblas_cherk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -10,6 +11,8 @@ cblas_cherk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
              const float beta, void *C, const int ldc)
 {
 #define BASE float
+#define HERK_BLOCKED gslcblas_cherk_blocked
 #include "source_herk.h"
+#undef HERK_BLOCKED
 #undef BASE
 }
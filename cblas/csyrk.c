@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_blocked.h"
 
 void
 cblas_csyrk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -10,6 +11,8 @@ cblas_csyrk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
              const void *beta, void *C, const int ldc)
 {
 #define BASE float
+#define SYRK_BLOCKED gslcblas_csyrk_blocked
 #include "source_syrk_c.h"
+#undef SYRK_BLOCKED
 #undef BASE
 }
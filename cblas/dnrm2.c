@@ -1,11 +1,14 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
+#include "nrm2.h"
 
 double
 cblas_dnrm2 (const int N, const double *X, const int incX)
 {
 #define BASE double
+#define NRM2(x) NRM2_DBL_ ## x
 #include "source_nrm2_r.h"
+#undef NRM2
 #undef BASE
 }
@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "thread.h"
 
 void
 cblas_dsymm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
@@ -11,6 +12,8 @@ cblas_dsymm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
              const int ldc)
 {
 #define BASE double
+#define SYMM_THREADED gslcblas_dsymm_threaded
 #include "source_symm_r.h"
+#undef SYMM_THREADED
 #undef BASE
 }
@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_blocked.h"
 
 void
 cblas_dsyr2k (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -11,6 +12,8 @@ cblas_dsyr2k (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
               const int ldc)
 {
 #define BASE double
+#define SYR2K_BLOCKED gslcblas_dsyr2k_blocked
 #include "source_syr2k_r.h"
+#undef SYR2K_BLOCKED
 #undef BASE
 }
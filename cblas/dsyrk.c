@@ -2,6 +2,8 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_blocked.h"
+#include "thread.h"
 
 void
 cblas_dsyrk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -10,6 +12,10 @@ cblas_dsyrk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
              const double beta, double *C, const int ldc)
 {
 #define BASE double
+#define SYRK_THREADED gslcblas_dsyrk_threaded
+#define SYRK_BLOCKED gslcblas_dsyrk_blocked
 #include "source_syrk_r.h"
+#undef SYRK_BLOCKED
+#undef SYRK_THREADED
 #undef BASE
 }
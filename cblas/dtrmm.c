@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "blocked_l3.h"
 
 void
 cblas_dtrmm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
@@ -11,6 +12,8 @@ cblas_dtrmm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
              const int ldb)
 {
 #define BASE double
+#define TRMM_BLOCKED gslcblas_dtrmm_blocked
 #include "source_trmm_r.h"
+#undef TRMM_BLOCKED
 #undef BASE
 }
@@ -1,11 +1,14 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
+#include "nrm2.h"
 
 double
 cblas_dznrm2 (const int N, const void *X, const int incX)
 {
 #define BASE double
+#define NRM2(x) NRM2_DBL_ ## x
 #include "source_nrm2_c.h"
+#undef NRM2
 #undef BASE
 }
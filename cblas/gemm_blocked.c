@@ -0,0 +1,100 @@
+/* cblas/gemm_blocked.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_cblas.h>
+#include "cblas.h"
+#include "gemm_blocked.h"
+
+/*
+ * The register block is 4x8 in single and 4x4 in double precision, so
+ * that the accumulators fill half of the sixteen SSE2 registers and the
+ * compiler is free to keep them there. KC*NR elements of the packed
+ * op(G) sliver fit in the L1 cache, MC*KC of alpha*op(F) in L2.
+ */
+
+#define BASE double
+#define FUNCTION(x) gslcblas_d ## x
+#define MR 4
+#define NR 4
+#define MC 128
+#define KC 256
+#define NC 2048
+#include "source_gemm_blocked_r.h"
+#undef BASE
+#undef FUNCTION
+#undef MR
+#undef NR
+#undef MC
+#undef KC
+#undef NC
+
+#define BASE float
+#define FUNCTION(x) gslcblas_s ## x
+#define MR 4
+#define NR 8
+#define MC 128
+#define KC 384
+#define NC 4096
+#include "source_gemm_blocked_r.h"
+#undef BASE
+#undef FUNCTION
+#undef MR
+#undef NR
+#undef MC
+#undef KC
+#undef NC
+
+/*
+ * The complex micro-kernel keeps separate real and imaginary
+ * accumulators, so its register block is half as high as the real one.
+ */
+
+#define BASE double
+#define FUNCTION(x) gslcblas_z ## x
+#define MR 2
+#define NR 4
+#define MC 64
+#define KC 256
+#define NC 1024
+#include "source_gemm_blocked_c.h"
+#undef BASE
+#undef FUNCTION
+#undef MR
+#undef NR
+#undef MC
+#undef KC
+#undef NC
+
+#define BASE float
+#define FUNCTION(x) gslcblas_c ## x
+#define MR 2
+#define NR 8
+#define MC 64
+#define KC 256
+#define NC 2048
+#include "source_gemm_blocked_c.h"
+#undef BASE
+#undef FUNCTION
+#undef MR
+#undef NR
+#undef MC
+#undef KC
+#undef NC
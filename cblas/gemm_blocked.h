@@ -0,0 +1,131 @@
+/* cblas/gemm_blocked.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Internal interface to the cache-blocked, packed-panel matrix multiply
+ * engine. All routines work on row-major storage and accumulate
+ *
+ *   C := alpha*op(F)*op(G) + C
+ *
+ * where op(F) is n1-by-K and op(G) is K-by-n2; any scaling by beta must
+ * have been applied by the caller. Column-major problems are handled by
+ * the callers by swapping the roles of the operands, as in
+ * source_gemm_r.h.
+ *
+ * The syrk, syr2k, herk and her2k variants update only the triangle
+ * uplo of the square result, as the corresponding Level 3 routines on
+ * row-major storage. Complex matrices are passed as arrays of
+ * interleaved (real,imag) pairs.
+ *
+ * The routines return 0 on success and -1 if the packing buffers could
+ * not be allocated, in which case C is unchanged and the caller should
+ * fall back to the unblocked loops.
+ */
+
+#ifndef __GEMM_BLOCKED_H__
+#define __GEMM_BLOCKED_H__
+
+/* problems with fewer than this many multiply-adds are computed by the
+ * simple loops, where the cost of packing would not be recovered */
+#define GEMM_BLOCKED_MIN_FLOPS 32768.0
+
+#define GEMM_BLOCKED_USE(n1,n2,K) \
+  ((double) (n1) * (double) (n2) * (double) (K) >= GEMM_BLOCKED_MIN_FLOPS)
+
+int gslcblas_dgemm_blocked (const int TransF, const int TransG,
+                            const int n1, const int n2, const int K,
+                            const double alpha, const double *F, const int ldf,
+                            const double *G, const int ldg,
+                            double *C, const int ldc);
+
+int gslcblas_sgemm_blocked (const int TransF, const int TransG,
+                            const int n1, const int n2, const int K,
+                            const float alpha, const float *F, const int ldf,
+                            const float *G, const int ldg,
+                            float *C, const int ldc);
+
+int gslcblas_zgemm_blocked (const int TransF, const int TransG,
+                            const int n1, const int n2, const int K,
+                            const void *alpha, const void *F, const int ldf,
+                            const void *G, const int ldg,
+                            void *C, const int ldc);
+
+int gslcblas_cgemm_blocked (const int TransF, const int TransG,
+                            const int n1, const int n2, const int K,
+                            const void *alpha, const void *F, const int ldf,
+                            const void *G, const int ldg,
+                            void *C, const int ldc);
+
+int gslcblas_dsyrk_blocked (const int uplo, const int Trans, const int N,
+                            const int K, const double alpha, const double *A,
+                            const int lda, double *C, const int ldc);
+
+int gslcblas_ssyrk_blocked (const int uplo, const int Trans, const int N,
+                            const int K, const float alpha, const float *A,
+                            const int lda, float *C, const int ldc);
+
+int gslcblas_dsyr2k_blocked (const int uplo, const int Trans, const int N,
+                             const int K, const double alpha, const double *A,
+                             const int lda, const double *B, const int ldb,
+                             double *C, const int ldc);
+
+int gslcblas_ssyr2k_blocked (const int uplo, const int Trans, const int N,
+                             const int K, const float alpha, const float *A,
+                             const int lda, const float *B, const int ldb,
+                             float *C, const int ldc);
+
+int gslcblas_zsyrk_blocked (const int uplo, const int Trans, const int N,
+                            const int K, const void *alpha, const void *A,
+                            const int lda, void *C, const int ldc);
+
+int gslcblas_csyrk_blocked (const int uplo, const int Trans, const int N,
+                            const int K, const void *alpha, const void *A,
+                            const int lda, void *C, const int ldc);
+
+int gslcblas_zsyr2k_blocked (const int uplo, const int Trans, const int N,
+                             const int K, const void *alpha, const void *A,
+                             const int lda, const void *B, const int ldb,
+                             void *C, const int ldc);
+
+int gslcblas_csyr2k_blocked (const int uplo, const int Trans, const int N,
+                             const int K, const void *alpha, const void *A,
+                             const int lda, const void *B, const int ldb,
+                             void *C, const int ldc);
+
+int gslcblas_zherk_blocked (const int uplo, const int Trans, const int N,
+                            const int K, const double alpha, const void *A,
+                            const int lda, void *C, const int ldc);
+
+int gslcblas_cherk_blocked (const int uplo, const int Trans, const int N,
+                            const int K, const float alpha, const void *A,
+                            const int lda, void *C, const int ldc);
+
+int gslcblas_zher2k_blocked (const int uplo, const int Trans, const int N,
+                             const int K, const double alpha_real,
+                             const double alpha_imag, const void *A,
+                             const int lda, const void *B, const int ldb,
+                             void *C, const int ldc);
+
+int gslcblas_cher2k_blocked (const int uplo, const int Trans, const int N,
+                             const int K, const float alpha_real,
+                             const float alpha_imag, const void *A,
+                             const int lda, const void *B, const int ldb,
+                             void *C, const int ldc);
+
+#endif /* __GEMM_BLOCKED_H__ */
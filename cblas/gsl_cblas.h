@@ -601,6 +601,11 @@ void cblas_zher2k(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
 
 void cblas_xerbla(int p, const char *rout, const char *form, ...);
 
+/* Threading of the Level 3 routines; these are defined in the GSL
+ * CBLAS library only, and are not available with other CBLAS libraries */
+void gsl_blas_set_num_threads (const size_t n);
+size_t gsl_blas_get_num_threads (void);
+
 __END_DECLS
 
 #endif /* __GSL_CBLAS_H__ */
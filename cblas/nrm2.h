@@ -0,0 +1,50 @@
+/* cblas/nrm2.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Constants for Blue's algorithm for the Euclidean norm (J. L. Blue,
+ * ACM TOMS 4, 15-23, 1978; E. Anderson, ACM TOMS 44, 5, 2017).
+ *
+ * Squares of values in [TSML,TBIG] neither underflow nor overflow, and
+ * a sum of up to 1/eps of them does not overflow. Values above TBIG are
+ * accumulated scaled by SBIG and values below TSML scaled by SSML. All
+ * constants are powers of 2, so the scalings are exact.
+ */
+
+#ifndef __CBLAS_NRM2_H__
+#define __CBLAS_NRM2_H__
+
+/* number of elements summed before checking whether any needed scaling */
+#define NRM2_BLOCK 256
+
+/* vectors shorter than this use the scaled sum of the reference BLAS,
+ * which is as fast there and gives the same rounding as before */
+#define NRM2_SMALL 32
+
+#define NRM2_DBL_TSML 1.4916681462400413e-154   /* 2^-511 */
+#define NRM2_DBL_TBIG 1.9979190722022350e+146   /* 2^486 */
+#define NRM2_DBL_SSML 4.4989137945431964e+161   /* 2^537 */
+#define NRM2_DBL_SBIG 1.1113793747425387e-162   /* 2^-538 */
+
+#define NRM2_FLT_TSML 1.08420217e-19f           /* 2^-63 */
+#define NRM2_FLT_TBIG 4.50359963e+15f           /* 2^52 */
+#define NRM2_FLT_SSML 3.77789319e+22f           /* 2^75 */
+#define NRM2_FLT_SBIG 1.32348898e-23f           /* 2^-76 */
+
+#endif /* __CBLAS_NRM2_H__ */
@@ -1,11 +1,14 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
+#include "nrm2.h"
 
 float
 cblas_scnrm2 (const int N, const void *X, const int incX)
 {
 #define BASE float
+#define NRM2(x) NRM2_FLT_ ## x
 #include "source_nrm2_c.h"
+#undef NRM2
 #undef BASE
 }
@@ -2,6 +2,8 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "thread.h"
+#include "gemm_blocked.h"
 
 void
 cblas_sgemm (const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA,
@@ -11,6 +13,10 @@ cblas_sgemm (const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA,
              const int ldc)
 {
 #define BASE float
+#define GEMM_THREADED gslcblas_sgemm_threaded
+#define GEMM_BLOCKED gslcblas_sgemm_blocked
 #include "source_gemm_r.h"
+#undef GEMM_THREADED
+#undef GEMM_BLOCKED
 #undef BASE
 }
@@ -1,11 +1,14 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
+#include "nrm2.h"
 
 float
 cblas_snrm2 (const int N, const float *X, const int incX)
 {
 #define BASE float
+#define NRM2(x) NRM2_FLT_ ## x
 #include "source_nrm2_r.h"
+#undef NRM2
 #undef BASE
 }
@@ -0,0 +1,415 @@
+/* cblas/source_gemm_blocked_c.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Complex version of the packed-panel engine in source_gemm_blocked_r.h.
+ * Matrices are row-major arrays of interleaved (real,imag) pairs. The
+ * packed slivers hold the MR (or NR) real parts of each column (row)
+ * followed by the imaginary parts, so that the micro-kernel works on
+ * separate real and imaginary accumulators. Transposition and
+ * conjugation of the operands are resolved while packing.
+ *
+ * This file is included with the same macros as
+ * source_gemm_blocked_r.h.
+ */
+
+/* pack the mc-by-kc block of alpha*op(F) */
+static void
+FUNCTION (gemm_pack_F) (const int TransF, const int mc, const int kc,
+                        const BASE alpha_real, const BASE alpha_imag,
+                        const BASE *F, const int ldf, BASE *Fp)
+{
+  const BASE conj = (TransF == CblasConjTrans) ? -1.0 : 1.0;
+  int ir, i, p;
+
+  for (ir = 0; ir < mc; ir += MR)
+    {
+      const int mr = GSL_MIN (MR, mc - ir);
+
+      /* element (ir+i,p) of op(F) is at Fr + 2 * (i * fi + p * fk) */
+      const int fi = (TransF == CblasNoTrans) ? ldf : 1;
+      const int fk = (TransF == CblasNoTrans) ? 1 : ldf;
+      const BASE *Fr = (TransF == CblasNoTrans) ? F + 2 * ir * ldf : F + 2 * ir;
+
+      for (p = 0; p < kc; p++)
+        {
+          BASE *fp = Fp + 2 * MR * p;
+
+          for (i = 0; i < mr; i++)
+            {
+              const BASE *f = Fr + 2 * (i * fi + p * fk);
+              const BASE f_real = f[0];
+              const BASE f_imag = conj * f[1];
+
+              fp[i] = alpha_real * f_real - alpha_imag * f_imag;
+              fp[MR + i] = alpha_real * f_imag + alpha_imag * f_real;
+            }
+
+          for (i = mr; i < MR; i++)
+            {
+              fp[i] = 0.0;
+              fp[MR + i] = 0.0;
+            }
+        }
+
+      Fp += 2 * MR * kc;
+    }
+}
+
+/* pack the kc-by-nc block of op(G) */
+static void
+FUNCTION (gemm_pack_G) (const int TransG, const int kc, const int nc,
+                        const BASE *G, const int ldg, BASE *Gp)
+{
+  const BASE conj = (TransG == CblasConjTrans) ? -1.0 : 1.0;
+  int jr, j, p;
+
+  for (jr = 0; jr < nc; jr += NR)
+    {
+      const int nr = GSL_MIN (NR, nc - jr);
+
+      /* element (p,jr+j) of op(G) is at Gr + 2 * (p * gk + j * gj) */
+      const int gk = (TransG == CblasNoTrans) ? ldg : 1;
+      const int gj = (TransG == CblasNoTrans) ? 1 : ldg;
+      const BASE *Gr = (TransG == CblasNoTrans) ? G + 2 * jr : G + 2 * jr * ldg;
+
+      for (p = 0; p < kc; p++)
+        {
+          BASE *gp = Gp + 2 * NR * p;
+
+          for (j = 0; j < nr; j++)
+            {
+              const BASE *g = Gr + 2 * (p * gk + j * gj);
+
+              gp[j] = g[0];
+              gp[NR + j] = conj * g[1];
+            }
+
+          for (j = nr; j < NR; j++)
+            {
+              gp[j] = 0.0;
+              gp[NR + j] = 0.0;
+            }
+        }
+
+      Gp += 2 * NR * kc;
+    }
+}
+
+/* C(0:mr,0:nr) += Fp * Gp for one pair of slivers */
+static void
+FUNCTION (gemm_kernel) (const int kc, const BASE *Fp, const BASE *Gp,
+                        BASE *C, const int ldc, const int mr, const int nr)
+{
+  BASE ab_real[MR * NR], ab_imag[MR * NR];
+  int i, j, p;
+
+  for (i = 0; i < MR * NR; i++)
+    {
+      ab_real[i] = 0.0;
+      ab_imag[i] = 0.0;
+    }
+
+  for (p = 0; p < kc; p++)
+    {
+      for (i = 0; i < MR; i++)
+        {
+          const BASE f_real = Fp[i];
+          const BASE f_imag = Fp[MR + i];
+
+          for (j = 0; j < NR; j++)
+            {
+              ab_real[i * NR + j] += f_real * Gp[j] - f_imag * Gp[NR + j];
+              ab_imag[i * NR + j] += f_real * Gp[NR + j] + f_imag * Gp[j];
+            }
+        }
+
+      Fp += 2 * MR;
+      Gp += 2 * NR;
+    }
+
+  for (i = 0; i < mr; i++)
+    {
+      for (j = 0; j < nr; j++)
+        {
+          C[2 * (i * ldc + j)] += ab_real[i * NR + j];
+          C[2 * (i * ldc + j) + 1] += ab_imag[i * NR + j];
+        }
+    }
+}
+
+/* C(0:mc,0:nc) += Fp * Gp for packed blocks, restricted to a triangle
+ * as in source_gemm_blocked_r.h */
+static void
+FUNCTION (gemm_macro_kernel) (const int uplo, const int offs,
+                              const int mc, const int nc, const int kc,
+                              const BASE *Fp, const BASE *Gp,
+                              BASE *C, const int ldc)
+{
+  int ir, jr, i, j;
+
+  for (jr = 0; jr < nc; jr += NR)
+    {
+      const int nr = GSL_MIN (NR, nc - jr);
+
+      for (ir = 0; ir < mc; ir += MR)
+        {
+          const int mr = GSL_MIN (MR, mc - ir);
+          const int d0 = offs + ir - jr;
+          BASE ab[2 * MR * NR];
+
+          if (uplo == CblasUpper)
+            {
+              if (d0 - (nr - 1) > 0)
+                continue;
+            }
+          else if (uplo == CblasLower)
+            {
+              if (d0 + (mr - 1) < 0)
+                continue;
+            }
+
+          if (uplo == 0 || (uplo == CblasUpper && d0 + (mr - 1) <= 0)
+              || (uplo == CblasLower && d0 - (nr - 1) >= 0))
+            {
+              FUNCTION (gemm_kernel) (kc, Fp + 2 * ir * kc, Gp + 2 * jr * kc,
+                                      C + 2 * (ir * ldc + jr), ldc, mr, nr);
+              continue;
+            }
+
+          for (i = 0; i < 2 * MR * NR; i++)
+            ab[i] = 0.0;
+
+          FUNCTION (gemm_kernel) (kc, Fp + 2 * ir * kc, Gp + 2 * jr * kc,
+                                  ab, NR, mr, nr);
+
+          for (i = 0; i < mr; i++)
+            {
+              for (j = 0; j < nr; j++)
+                {
+                  const int d = d0 + i - j;
+
+                  if ((uplo == CblasUpper) ? (d <= 0) : (d >= 0))
+                    {
+                      BASE *c = C + 2 * ((ir + i) * ldc + jr + j);
+                      c[0] += ab[2 * (i * NR + j)];
+                      c[1] += ab[2 * (i * NR + j) + 1];
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void
+FUNCTION (gemm_blocked_run) (const int uplo, const int TransF,
+                             const int TransG, const int n1, const int n2,
+                             const int K, const BASE alpha_real,
+                             const BASE alpha_imag,
+                             const BASE *F, const int ldf,
+                             const BASE *G, const int ldg,
+                             BASE *C, const int ldc, BASE *Fp, BASE *Gp)
+{
+  int ic, pc, jc;
+
+  for (jc = 0; jc < n2; jc += NC)
+    {
+      const int nc = GSL_MIN (NC, n2 - jc);
+      const int i0 = (uplo == CblasLower) ? jc / MC * MC : 0;
+      const int i1 = (uplo == CblasUpper) ? GSL_MIN (n1, jc + nc) : n1;
+
+      for (pc = 0; pc < K; pc += KC)
+        {
+          const int kc = GSL_MIN (KC, K - pc);
+          const BASE *Gpc = (TransG == CblasNoTrans) ?
+                            G + 2 * (pc * ldg + jc) : G + 2 * (jc * ldg + pc);
+
+          FUNCTION (gemm_pack_G) (TransG, kc, nc, Gpc, ldg, Gp);
+
+          for (ic = i0; ic < i1; ic += MC)
+            {
+              const int mc = GSL_MIN (MC, i1 - ic);
+              const BASE *Fic = (TransF == CblasNoTrans) ?
+                                F + 2 * (ic * ldf + pc) :
+                                F + 2 * (pc * ldf + ic);
+
+              FUNCTION (gemm_pack_F) (TransF, mc, kc, alpha_real, alpha_imag,
+                                      Fic, ldf, Fp);
+              FUNCTION (gemm_macro_kernel) (uplo, ic - jc, mc, nc, kc, Fp, Gp,
+                                            C + 2 * (ic * ldc + jc), ldc);
+            }
+        }
+    }
+}
+
+static int
+FUNCTION (gemm_blocked_alloc) (const int n1, const int n2, const int K,
+                               BASE **Fp, BASE **Gp)
+{
+  const int mcmax = GSL_MIN (MC, n1 + MR - 1) / MR * MR;
+  const int kcmax = GSL_MIN (KC, K);
+  const int ncmax = GSL_MIN (NC, n2 + NR - 1) / NR * NR;
+
+  *Fp = malloc (2 * sizeof (BASE) * mcmax * kcmax);
+  *Gp = malloc (2 * sizeof (BASE) * kcmax * ncmax);
+
+  if (*Fp == 0 || *Gp == 0)
+    {
+      free (*Fp);
+      free (*Gp);
+      return -1;
+    }
+
+  return 0;
+}
+
+/* C := alpha op(F) op(G) + C, where op(F) is n1-by-K, op(G) is
+ * K-by-n2 and op is one of NoTrans, Trans or ConjTrans */
+int
+FUNCTION (gemm_blocked) (const int TransF, const int TransG,
+                         const int n1, const int n2, const int K,
+                         const void *alpha, const void *F, const int ldf,
+                         const void *G, const int ldg,
+                         void *C, const int ldc)
+{
+  BASE *Fp, *Gp;
+
+  if (FUNCTION (gemm_blocked_alloc) (n1, n2, K, &Fp, &Gp))
+    return -1;
+
+  FUNCTION (gemm_blocked_run) (0, TransF, TransG, n1, n2, K,
+                               CONST_REAL0 (alpha), CONST_IMAG0 (alpha),
+                               F, ldf, G, ldg, C, ldc, Fp, Gp);
+
+  free (Fp);
+  free (Gp);
+
+  return 0;
+}
+
+/* set the imaginary parts of the diagonal of C to zero */
+static void
+FUNCTION (zero_diag_imag) (const int N, BASE *C, const int ldc)
+{
+  int i;
+
+  for (i = 0; i < N; i++)
+    C[2 * (i * ldc + i) + 1] = 0.0;
+}
+
+/* C := alpha op(A) op(A)^T + C on the triangle uplo */
+int
+FUNCTION (syrk_blocked) (const int uplo, const int Trans, const int N,
+                         const int K, const void *alpha, const void *A,
+                         const int lda, void *C, const int ldc)
+{
+  const int TransT = (Trans == CblasNoTrans) ? CblasTrans : CblasNoTrans;
+  BASE *Fp, *Gp;
+
+  if (FUNCTION (gemm_blocked_alloc) (N, N, K, &Fp, &Gp))
+    return -1;
+
+  FUNCTION (gemm_blocked_run) (uplo, Trans, TransT, N, N, K,
+                               CONST_REAL0 (alpha), CONST_IMAG0 (alpha),
+                               A, lda, A, lda, C, ldc, Fp, Gp);
+
+  free (Fp);
+  free (Gp);
+
+  return 0;
+}
+
+/* C := alpha op(A) op(B)^T + alpha op(B) op(A)^T + C on the triangle
+ * uplo */
+int
+FUNCTION (syr2k_blocked) (const int uplo, const int Trans, const int N,
+                          const int K, const void *alpha, const void *A,
+                          const int lda, const void *B, const int ldb,
+                          void *C, const int ldc)
+{
+  const int TransT = (Trans == CblasNoTrans) ? CblasTrans : CblasNoTrans;
+  BASE *Fp, *Gp;
+
+  if (FUNCTION (gemm_blocked_alloc) (N, N, K, &Fp, &Gp))
+    return -1;
+
+  FUNCTION (gemm_blocked_run) (uplo, Trans, TransT, N, N, K,
+                               CONST_REAL0 (alpha), CONST_IMAG0 (alpha),
+                               A, lda, B, ldb, C, ldc, Fp, Gp);
+  FUNCTION (gemm_blocked_run) (uplo, Trans, TransT, N, N, K,
+                               CONST_REAL0 (alpha), CONST_IMAG0 (alpha),
+                               B, ldb, A, lda, C, ldc, Fp, Gp);
+
+  free (Fp);
+  free (Gp);
+
+  return 0;
+}
+
+/* C := alpha op(A) op(A)^H + C on the triangle uplo, with Trans equal
+ * to CblasNoTrans or CblasConjTrans and alpha real */
+int
+FUNCTION (herk_blocked) (const int uplo, const int Trans, const int N,
+                         const int K, const BASE alpha, const void *A,
+                         const int lda, void *C, const int ldc)
+{
+  const int TransH = (Trans == CblasNoTrans) ? CblasConjTrans : CblasNoTrans;
+  BASE *Fp, *Gp;
+
+  if (FUNCTION (gemm_blocked_alloc) (N, N, K, &Fp, &Gp))
+    return -1;
+
+  FUNCTION (gemm_blocked_run) (uplo, Trans, TransH, N, N, K, alpha, 0.0,
+                               A, lda, A, lda, C, ldc, Fp, Gp);
+  FUNCTION (zero_diag_imag) (N, C, ldc);
+
+  free (Fp);
+  free (Gp);
+
+  return 0;
+}
+
+/* C := alpha op(A) op(B)^H + conj(alpha) op(B) op(A)^H + C on the
+ * triangle uplo, with Trans equal to CblasNoTrans or CblasConjTrans */
+int
+FUNCTION (her2k_blocked) (const int uplo, const int Trans, const int N,
+                          const int K, const BASE alpha_real,
+                          const BASE alpha_imag, const void *A,
+                          const int lda, const void *B, const int ldb,
+                          void *C, const int ldc)
+{
+  const int TransH = (Trans == CblasNoTrans) ? CblasConjTrans : CblasNoTrans;
+  BASE *Fp, *Gp;
+
+  if (FUNCTION (gemm_blocked_alloc) (N, N, K, &Fp, &Gp))
+    return -1;
+
+  FUNCTION (gemm_blocked_run) (uplo, Trans, TransH, N, N, K,
+                               alpha_real, alpha_imag,
+                               A, lda, B, ldb, C, ldc, Fp, Gp);
+  FUNCTION (gemm_blocked_run) (uplo, Trans, TransH, N, N, K,
+                               alpha_real, -alpha_imag,
+                               B, ldb, A, lda, C, ldc, Fp, Gp);
+  FUNCTION (zero_diag_imag) (N, C, ldc);
+
+  free (Fp);
+  free (Gp);
+
+  return 0;
+}
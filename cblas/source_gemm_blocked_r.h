@@ -0,0 +1,372 @@
+/* cblas/source_gemm_blocked_r.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Packed-panel matrix multiply (Goto & van de Geijn, "Anatomy of
+ * High-Performance Matrix Multiplication", ACM TOMS 34, 2008).
+ *
+ * The K dimension is split into panels of depth KC and the columns of
+ * C into panels of width NC. Each KC-by-NC panel of op(G) is packed
+ * into NR-wide column slivers which stay in the L3 cache, and each
+ * MC-by-KC block of alpha*op(F) into MR-high row slivers which stay in
+ * the L2 cache. The micro-kernel then computes an MR-by-NR block of C
+ * held entirely in registers, streaming one sliver of each packed
+ * operand through the L1 cache. Transposition is resolved while
+ * packing, so a single micro-kernel serves all four cases.
+ *
+ * For the symmetric rank-k updates only one triangle of the square
+ * result is wanted. Blocks of C which lie entirely outside it are
+ * skipped, and blocks which straddle the diagonal are computed into a
+ * temporary and only their triangle is added to C, so about half of
+ * the flops of the full product are done.
+ *
+ * This file is included with the following macros defined:
+ *
+ *   BASE        element type
+ *   MR, NR      register block size
+ *   MC, KC, NC  cache block sizes (MC a multiple of MR, NC of NR)
+ *   FUNCTION(x) maps a name to its type-specific version
+ */
+
+/* pack the mc-by-kc block of alpha*op(F) whose first element is
+ * pointed to by F into row slivers of height MR, padding the last
+ * sliver with zeros */
+static void
+FUNCTION (gemm_pack_F) (const int TransF, const int mc, const int kc,
+                        const BASE alpha, const BASE *F, const int ldf,
+                        BASE *Fp)
+{
+  int ir, i, p;
+
+  for (ir = 0; ir < mc; ir += MR)
+    {
+      const int mr = GSL_MIN (MR, mc - ir);
+
+      if (TransF == CblasNoTrans)
+        {
+          for (i = 0; i < mr; i++)
+            {
+              const BASE *f = F + (ir + i) * ldf;
+              for (p = 0; p < kc; p++)
+                Fp[p * MR + i] = alpha * f[p];
+            }
+        }
+      else
+        {
+          for (p = 0; p < kc; p++)
+            {
+              const BASE *f = F + p * ldf + ir;
+              for (i = 0; i < mr; i++)
+                Fp[p * MR + i] = alpha * f[i];
+            }
+        }
+
+      for (i = mr; i < MR; i++)
+        {
+          for (p = 0; p < kc; p++)
+            Fp[p * MR + i] = 0.0;
+        }
+
+      Fp += MR * kc;
+    }
+}
+
+/* pack the kc-by-nc block of op(G) whose first element is pointed to
+ * by G into column slivers of width NR,
+ * padding the last sliver with zeros */
+static void
+FUNCTION (gemm_pack_G) (const int TransG, const int kc, const int nc,
+                        const BASE *G, const int ldg, BASE *Gp)
+{
+  int jr, j, p;
+
+  for (jr = 0; jr < nc; jr += NR)
+    {
+      const int nr = GSL_MIN (NR, nc - jr);
+
+      if (TransG == CblasNoTrans)
+        {
+          for (p = 0; p < kc; p++)
+            {
+              const BASE *g = G + p * ldg + jr;
+              for (j = 0; j < nr; j++)
+                Gp[p * NR + j] = g[j];
+            }
+        }
+      else
+        {
+          for (j = 0; j < nr; j++)
+            {
+              const BASE *g = G + (jr + j) * ldg;
+              for (p = 0; p < kc; p++)
+                Gp[p * NR + j] = g[p];
+            }
+        }
+
+      for (j = nr; j < NR; j++)
+        {
+          for (p = 0; p < kc; p++)
+            Gp[p * NR + j] = 0.0;
+        }
+
+      Gp += NR * kc;
+    }
+}
+
+/* C(0:mr,0:nr) += Fp * Gp for one MR-by-kc and one kc-by-NR sliver;
+ * the loop bounds of the inner loops are compile-time constants so the
+ * accumulator block is kept in (vector) registers */
+static void
+FUNCTION (gemm_kernel) (const int kc, const BASE *Fp, const BASE *Gp,
+                        BASE *C, const int ldc, const int mr, const int nr)
+{
+  BASE ab[MR * NR];
+  int i, j, p;
+
+  for (i = 0; i < MR * NR; i++)
+    ab[i] = 0.0;
+
+  for (p = 0; p < kc; p++)
+    {
+      for (i = 0; i < MR; i++)
+        {
+          const BASE fi = Fp[i];
+          for (j = 0; j < NR; j++)
+            ab[i * NR + j] += fi * Gp[j];
+        }
+
+      Fp += MR;
+      Gp += NR;
+    }
+
+  if (mr == MR && nr == NR)
+    {
+      for (i = 0; i < MR; i++)
+        {
+          for (j = 0; j < NR; j++)
+            C[i * ldc + j] += ab[i * NR + j];
+        }
+    }
+  else
+    {
+      for (i = 0; i < mr; i++)
+        {
+          for (j = 0; j < nr; j++)
+            C[i * ldc + j] += ab[i * NR + j];
+        }
+    }
+}
+
+/* C(0:mc,0:nc) += Fp * Gp for packed blocks. If uplo is CblasUpper or
+ * CblasLower only the elements of C on and above, or on and below, the
+ * diagonal of the full result are updated, where element (0,0) of the
+ * block lies on diagonal offs = row - column of the full result */
+static void
+FUNCTION (gemm_macro_kernel) (const int uplo, const int offs,
+                              const int mc, const int nc, const int kc,
+                              const BASE *Fp, const BASE *Gp,
+                              BASE *C, const int ldc)
+{
+  int ir, jr, i, j;
+
+  for (jr = 0; jr < nc; jr += NR)
+    {
+      const int nr = GSL_MIN (NR, nc - jr);
+
+      for (ir = 0; ir < mc; ir += MR)
+        {
+          const int mr = GSL_MIN (MR, mc - ir);
+
+          /* row - column of the top left corner */
+          const int d0 = offs + ir - jr;
+          BASE ab[MR * NR];
+
+          if (uplo == CblasUpper)
+            {
+              if (d0 - (nr - 1) > 0)
+                continue;               /* entirely below the diagonal */
+            }
+          else if (uplo == CblasLower)
+            {
+              if (d0 + (mr - 1) < 0)
+                continue;               /* entirely above the diagonal */
+            }
+
+          if (uplo == 0 || (uplo == CblasUpper && d0 + (mr - 1) <= 0)
+              || (uplo == CblasLower && d0 - (nr - 1) >= 0))
+            {
+              FUNCTION (gemm_kernel) (kc, Fp + ir * kc, Gp + jr * kc,
+                                      C + ir * ldc + jr, ldc, mr, nr);
+              continue;
+            }
+
+          /* the block straddles the diagonal */
+          for (i = 0; i < MR * NR; i++)
+            ab[i] = 0.0;
+
+          FUNCTION (gemm_kernel) (kc, Fp + ir * kc, Gp + jr * kc, ab, NR,
+                                  mr, nr);
+
+          for (i = 0; i < mr; i++)
+            {
+              for (j = 0; j < nr; j++)
+                {
+                  const int d = d0 + i - j;
+
+                  if ((uplo == CblasUpper) ? (d <= 0) : (d >= 0))
+                    C[(ir + i) * ldc + jr + j] += ab[i * NR + j];
+                }
+            }
+        }
+    }
+}
+
+/* C += alpha op(F) op(G), using the packing buffers Fp and Gp, which
+ * must hold MC*KC and KC*NC elements. With uplo equal to CblasUpper or
+ * CblasLower only that triangle of the square matrix C is updated. */
+static void
+FUNCTION (gemm_blocked_run) (const int uplo, const int TransF,
+                             const int TransG, const int n1, const int n2,
+                             const int K, const BASE alpha,
+                             const BASE *F, const int ldf,
+                             const BASE *G, const int ldg,
+                             BASE *C, const int ldc, BASE *Fp, BASE *Gp)
+{
+  int ic, pc, jc;
+
+  for (jc = 0; jc < n2; jc += NC)
+    {
+      const int nc = GSL_MIN (NC, n2 - jc);
+
+      /* rows of C which have elements of the triangle in this panel */
+      const int i0 = (uplo == CblasLower) ? jc / MC * MC : 0;
+      const int i1 = (uplo == CblasUpper) ? GSL_MIN (n1, jc + nc) : n1;
+
+      for (pc = 0; pc < K; pc += KC)
+        {
+          const int kc = GSL_MIN (KC, K - pc);
+          const BASE *Gpc = (TransG == CblasNoTrans) ?
+                            G + pc * ldg + jc : G + jc * ldg + pc;
+
+          FUNCTION (gemm_pack_G) (TransG, kc, nc, Gpc, ldg, Gp);
+
+          for (ic = i0; ic < i1; ic += MC)
+            {
+              const int mc = GSL_MIN (MC, i1 - ic);
+              const BASE *Fic = (TransF == CblasNoTrans) ?
+                                F + ic * ldf + pc : F + pc * ldf + ic;
+
+              FUNCTION (gemm_pack_F) (TransF, mc, kc, alpha, Fic, ldf, Fp);
+              FUNCTION (gemm_macro_kernel) (uplo, ic - jc, mc, nc, kc, Fp, Gp,
+                                            C + ic * ldc + jc, ldc);
+            }
+        }
+    }
+}
+
+/* allocate packing buffers for an n1-by-n2-by-K product; returns -1 if
+ * they are not available */
+static int
+FUNCTION (gemm_blocked_alloc) (const int n1, const int n2, const int K,
+                               BASE **Fp, BASE **Gp)
+{
+  const int mcmax = GSL_MIN (MC, n1 + MR - 1) / MR * MR;
+  const int kcmax = GSL_MIN (KC, K);
+  const int ncmax = GSL_MIN (NC, n2 + NR - 1) / NR * NR;
+
+  *Fp = malloc (sizeof (BASE) * mcmax * kcmax);
+  *Gp = malloc (sizeof (BASE) * kcmax * ncmax);
+
+  if (*Fp == 0 || *Gp == 0)
+    {
+      free (*Fp);
+      free (*Gp);
+      return -1;
+    }
+
+  return 0;
+}
+
+int
+FUNCTION (gemm_blocked) (const int TransF, const int TransG,
+                         const int n1, const int n2, const int K,
+                         const BASE alpha, const BASE *F, const int ldf,
+                         const BASE *G, const int ldg,
+                         BASE *C, const int ldc)
+{
+  BASE *Fp, *Gp;
+
+  if (FUNCTION (gemm_blocked_alloc) (n1, n2, K, &Fp, &Gp))
+    return -1;
+
+  FUNCTION (gemm_blocked_run) (0, TransF, TransG, n1, n2, K, alpha,
+                               F, ldf, G, ldg, C, ldc, Fp, Gp);
+
+  free (Fp);
+  free (Gp);
+
+  return 0;
+}
+
+/* C := alpha op(A) op(A)^T + C on the triangle uplo, where op(A) is
+ * N-by-K */
+int
+FUNCTION (syrk_blocked) (const int uplo, const int Trans, const int N,
+                         const int K, const BASE alpha, const BASE *A,
+                         const int lda, BASE *C, const int ldc)
+{
+  const int TransT = (Trans == CblasNoTrans) ? CblasTrans : CblasNoTrans;
+  BASE *Fp, *Gp;
+
+  if (FUNCTION (gemm_blocked_alloc) (N, N, K, &Fp, &Gp))
+    return -1;
+
+  FUNCTION (gemm_blocked_run) (uplo, Trans, TransT, N, N, K, alpha,
+                               A, lda, A, lda, C, ldc, Fp, Gp);
+
+  free (Fp);
+  free (Gp);
+
+  return 0;
+}
+
+/* C := alpha op(A) op(B)^T + alpha op(B) op(A)^T + C on the triangle
+ * uplo, where op(A) and op(B) are N-by-K */
+int
+FUNCTION (syr2k_blocked) (const int uplo, const int Trans, const int N,
+                          const int K, const BASE alpha, const BASE *A,
+                          const int lda, const BASE *B, const int ldb,
+                          BASE *C, const int ldc)
+{
+  const int TransT = (Trans == CblasNoTrans) ? CblasTrans : CblasNoTrans;
+  BASE *Fp, *Gp;
+
+  if (FUNCTION (gemm_blocked_alloc) (N, N, K, &Fp, &Gp))
+    return -1;
+
+  FUNCTION (gemm_blocked_run) (uplo, Trans, TransT, N, N, K, alpha,
+                               A, lda, B, ldb, C, ldc, Fp, Gp);
+  FUNCTION (gemm_blocked_run) (uplo, Trans, TransT, N, N, K, alpha,
+                               B, ldb, A, lda, C, ldc, Fp, Gp);
+
+  free (Fp);
+  free (Gp);
+
+  return 0;
+}
@@ -83,6 +83,14 @@
     if (alpha_real == 0.0 && alpha_imag == 0.0)
       return;
 
+    /* large products go through the packed-panel engine, which
+     * resolves the conjugation while packing */
+    if (GEMM_BLOCKED_USE(n1, n2, K)
+        && GEMM_BLOCKED((conjF < 0) ? CblasConjTrans : TransF,
+                        (conjG < 0) ? CblasConjTrans : TransG,
+                        n1, n2, K, alpha, F, ldf, G, ldg, C, ldc) == 0)
+      return;
+
     if (TransF == CblasNoTrans && TransG == CblasNoTrans) {
 
       /* form  C := alpha*A*B + C */
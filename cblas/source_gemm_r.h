@@ -29,6 +29,10 @@
   if (alpha == 0.0 && beta == 1.0)
     return;
 
+  if (GEMM_THREADED(Order, TransA, TransB, M, N, K, alpha, A, lda, B, ldb,
+                    beta, C, ldc) == 0)
+    return;
+
   if (Order == CblasRowMajor) {
     n1 = M;
     n2 = N;
@@ -67,6 +71,13 @@
   if (alpha == 0.0)
     return;
 
+  /* large products go through the packed-panel engine, which returns
+   * nonzero only if it could not allocate its buffers */
+  if (GEMM_BLOCKED_USE(n1, n2, K)
+      && GEMM_BLOCKED(TransF, TransG, n1, n2, K, alpha, F, ldf, G, ldg,
+                      C, ldc) == 0)
+    return;
+
   if (TransF == CblasNoTrans && TransG == CblasNoTrans) {
 
     /* form  C := alpha*A*B + C */
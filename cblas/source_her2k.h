@@ -86,6 +86,11 @@
     if (alpha_real == 0.0 && alpha_imag == 0.0)
       return;
 
+    if (GEMM_BLOCKED_USE(N, N, K)
+        && HER2K_BLOCKED(uplo, trans, N, K, alpha_real, alpha_imag, A, lda,
+                         B, ldb, C, ldc) == 0)
+      return;
+
     if (uplo == CblasUpper && trans == CblasNoTrans) {
 
       for (i = 0; i < N; i++) {
@@ -81,6 +81,10 @@
   if (alpha == 0.0)
     return;
 
+  if (GEMM_BLOCKED_USE(N, N, K)
+      && HERK_BLOCKED(uplo, trans, N, K, alpha, A, lda, C, ldc) == 0)
+    return;
+
   if (uplo == CblasUpper && trans == CblasNoTrans) {
 
     for (i = 0; i < N; i++) {
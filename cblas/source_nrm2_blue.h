@@ -0,0 +1,49 @@
+/* cblas/source_nrm2_blue.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* combine the accumulators abig, amed and asml of Blue's algorithm
+ * into the norm; a NaN in amed is propagated */
+
+  if (abig > 0.0) {
+    if (amed > 0.0 || amed != amed) {
+      abig += (amed * sbig) * sbig;
+    }
+
+    return sqrt(abig) / sbig;
+  } else if (asml > 0.0) {
+    if (amed > 0.0 || amed != amed) {
+      const BASE ymed = sqrt(amed);
+      const BASE ysml = sqrt(asml) / ssml;
+      BASE ymin, ymax;
+
+      if (ysml > ymed) {
+        ymin = ymed;
+        ymax = ysml;
+      } else {
+        ymin = ysml;
+        ymax = ymed;
+      }
+
+      return ymax * sqrt(1.0 + (ymin / ymax) * (ymin / ymax));
+    }
+
+    return sqrt(asml) / ssml;
+  }
+
+  return sqrt(amed);
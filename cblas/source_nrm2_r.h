@@ -18,33 +18,103 @@
  */
 
 {
-  BASE scale = 0.0;
-  BASE ssq = 1.0;
-  INDEX i;
-  INDEX ix = 0;
+  /* Blue's algorithm, see nrm2.h. Each block is first summed without
+   * scaling, which is exact enough unless its largest element is
+   * outside [TSML,TBIG]; only then is the block summed again into the
+   * three scaled accumulators. */
+  const BASE tsml = NRM2 (TSML);
+  const BASE tbig = NRM2 (TBIG);
+  const BASE ssml = NRM2 (SSML);
+  const BASE sbig = NRM2 (SBIG);
+  BASE abig = 0.0;
+  BASE amed = 0.0;
+  BASE asml = 0.0;
+  int notbig = 1;
+  INDEX i, j;
 
   if (N <= 0 || incX <= 0) {
     return 0;
   } else if (N == 1) {
     return fabs(X[0]);
+  } else if (N < NRM2_SMALL) {
+    BASE scale = 0.0;
+    BASE ssq = 1.0;
+    INDEX ix = 0;
+
+    for (i = 0; i < N; i++) {
+      const BASE x = X[ix];
+
+      if (x != 0.0) {
+        const BASE ax = fabs(x);
+
+        if (scale < ax) {
+          ssq = 1.0 + ssq * (scale / ax) * (scale / ax);
+          scale = ax;
+        } else {
+          ssq += (ax / scale) * (ax / scale);
+        }
+      }
+
+      ix += incX;
+    }
+
+    return scale * sqrt(ssq);
   }
 
-  for (i = 0; i < N; i++) {
-    const BASE x = X[ix];
+  for (i = 0; i < N; i += NRM2_BLOCK) {
+    const INDEX nb = GSL_MIN(NRM2_BLOCK, N - i);
+    const BASE *x = X + i * incX;
+    BASE s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+    BASE m0 = 0.0, m1 = 0.0, m2 = 0.0, m3 = 0.0;
 
-    if (x != 0.0) {
-      const BASE ax = fabs(x);
+    /* four independent sums, so the loop is not limited by the latency
+       of a single chain of additions */
+    for (j = 0; j + 4 <= nb; j += 4) {
+      const BASE x0 = x[j * incX];
+      const BASE x1 = x[(j + 1) * incX];
+      const BASE x2 = x[(j + 2) * incX];
+      const BASE x3 = x[(j + 3) * incX];
+      const BASE a0 = fabs(x0), a1 = fabs(x1), a2 = fabs(x2), a3 = fabs(x3);
+
+      s0 += x0 * x0;
+      s1 += x1 * x1;
+      s2 += x2 * x2;
+      s3 += x3 * x3;
+      m0 = (a0 > m0) ? a0 : m0;
+      m1 = (a1 > m1) ? a1 : m1;
+      m2 = (a2 > m2) ? a2 : m2;
+      m3 = (a3 > m3) ? a3 : m3;
+    }
 
-      if (scale < ax) {
-        ssq = 1.0 + ssq * (scale / ax) * (scale / ax);
-        scale = ax;
+    for (; j < nb; j++) {
+      const BASE x0 = x[j * incX];
+      const BASE a0 = fabs(x0);
+
+      s0 += x0 * x0;
+      m0 = (a0 > m0) ? a0 : m0;
+    }
+
+    m0 = GSL_MAX(GSL_MAX(m0, m1), GSL_MAX(m2, m3));
+
+    if (m0 <= tbig && (m0 >= tsml || m0 == 0.0)) {
+      amed += (s0 + s1) + (s2 + s3);
+      continue;
+    }
+
+    for (j = 0; j < nb; j++) {
+      const BASE ax = fabs(x[j * incX]);
+
+      if (ax > tbig) {
+        abig += (ax * sbig) * (ax * sbig);
+        notbig = 0;
+      } else if (ax < tsml) {
+        if (notbig)
+          asml += (ax * ssml) * (ax * ssml);
       } else {
-        ssq += (ax / scale) * (ax / scale);
+        amed += ax * ax;
       }
     }
-
-    ix += incX;
   }
 
-  return scale * sqrt(ssq);
+#include "source_nrm2_blue.h"
 }
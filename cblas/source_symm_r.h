@@ -27,6 +27,10 @@
   if (alpha == 0.0 && beta == 1.0)
     return;
 
+  if (SYMM_THREADED(Order, Side, Uplo, M, N, alpha, A, lda, B, ldb, beta,
+                    C, ldc) == 0)
+    return;
+
   if (Order == CblasRowMajor) {
     n1 = M;
     n2 = N;
@@ -85,6 +85,11 @@
     if (alpha_real == 0.0 && alpha_imag == 0.0)
       return;
 
+    if (GEMM_BLOCKED_USE(N, N, K)
+        && SYR2K_BLOCKED(uplo, (trans == CblasNoTrans) ? CblasNoTrans : CblasTrans,
+                         N, K, alpha, A, lda, B, ldb, C, ldc) == 0)
+      return;
+
     if (uplo == CblasUpper && trans == CblasNoTrans) {
 
       for (i = 0; i < N; i++) {
@@ -73,6 +73,10 @@
   if (alpha == 0.0)
     return;
 
+  if (GEMM_BLOCKED_USE(N, N, K)
+      && SYR2K_BLOCKED(uplo, trans, N, K, alpha, A, lda, B, ldb, C, ldc) == 0)
+    return;
+
   if (uplo == CblasUpper && trans == CblasNoTrans) {
 
     for (i = 0; i < N; i++) {
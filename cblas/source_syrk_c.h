@@ -85,6 +85,10 @@
     if (alpha_real == 0.0 && alpha_imag == 0.0)
       return;
 
+    if (GEMM_BLOCKED_USE(N, N, K)
+        && SYRK_BLOCKED(uplo, trans, N, K, alpha, A, lda, C, ldc) == 0)
+      return;
+
     if (uplo == CblasUpper && trans == CblasNoTrans) {
 
       for (i = 0; i < N; i++) {
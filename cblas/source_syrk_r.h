@@ -26,6 +26,10 @@
   if (alpha == 0.0 && beta == 1.0)
     return;
 
+  if (SYRK_THREADED(Order, Uplo, Trans, N, K, alpha, A, lda, beta, C,
+                    ldc) == 0)
+    return;
+
   if (Order == CblasRowMajor) {
     uplo = Uplo;
     trans = (Trans == CblasConjTrans) ? CblasTrans : Trans;
@@ -73,6 +77,10 @@
   if (alpha == 0.0)
     return;
 
+  if (GEMM_BLOCKED_USE(N, N, K)
+      && SYRK_BLOCKED(uplo, trans, N, K, alpha, A, lda, C, ldc) == 0)
+    return;
+
   if (uplo == CblasUpper && trans == CblasNoTrans) {
 
     for (i = 0; i < N; i++) {
@@ -0,0 +1,318 @@
+/* cblas/source_thread_l3_r.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Parallel drivers for the real Level 3 routines. Each driver splits
+ * the output matrix into independent tiles and has every thread call
+ * the ordinary routine on its tiles. Those nested calls find the pool
+ * busy and run serially.
+ *
+ * This file is included with the following macros defined:
+ *
+ *   BASE        element type
+ *   FUNCTION(x) maps a name to its type-specific version, e.g.
+ *               FUNCTION(gemm) = cblas_dgemm
+ *   INTERNAL(x) the same for the library-internal drivers, e.g.
+ *               INTERNAL(gemm_threaded) = gslcblas_dgemm_threaded
+ */
+
+/* offset of element (i,j) of a matrix with leading dimension ld */
+#define IDX(ld,i,j) ((Order == CblasRowMajor) ? (i) * (ld) + (j) : (j) * (ld) + (i))
+
+typedef struct
+{
+  enum CBLAS_ORDER Order;
+  enum CBLAS_SIDE Side;
+  enum CBLAS_UPLO Uplo;
+  enum CBLAS_TRANSPOSE TransA;
+  enum CBLAS_TRANSPOSE TransB;
+  enum CBLAS_DIAG Diag;
+  int M, N, K;
+  BASE alpha, beta;
+  const BASE *A;
+  int lda;
+  const BASE *B;
+  int ldb;
+  BASE *C;
+  int ldc;
+} FUNCTION (thread_args);
+
+/* C(i0:i1,j0:j1) for a p1-by-p2 grid of tiles of C */
+static void
+FUNCTION (gemm_task) (void *arg, const int tid, const int nthreads)
+{
+  const FUNCTION (thread_args) *p = arg;
+  const enum CBLAS_ORDER Order = p->Order;
+  int p1, p2, i0, i1, j0, j1;
+
+  gslcblas_thread_grid (nthreads, p->M, p->N, &p1, &p2);
+  gslcblas_thread_range (p->M, p1, tid / p2, &i0, &i1);
+  gslcblas_thread_range (p->N, p2, tid % p2, &j0, &j1);
+
+  if (i1 > i0 && j1 > j0)
+    {
+      const BASE *A = (p->TransA == CblasNoTrans) ?
+                      p->A + IDX (p->lda, i0, 0) : p->A + IDX (p->lda, 0, i0);
+      const BASE *B = (p->TransB == CblasNoTrans) ?
+                      p->B + IDX (p->ldb, 0, j0) : p->B + IDX (p->ldb, j0, 0);
+
+      FUNCTION (gemm) (Order, p->TransA, p->TransB, i1 - i0, j1 - j0, p->K,
+                       p->alpha, A, p->lda, B, p->ldb, p->beta,
+                       p->C + IDX (p->ldc, i0, j0), p->ldc);
+    }
+}
+
+int
+INTERNAL (gemm_threaded) (const enum CBLAS_ORDER Order,
+                          const enum CBLAS_TRANSPOSE TransA,
+                          const enum CBLAS_TRANSPOSE TransB,
+                          const int M, const int N, const int K,
+                          const BASE alpha, const BASE *A, const int lda,
+                          const BASE *B, const int ldb, const BASE beta,
+                          BASE *C, const int ldc)
+{
+  const int nthreads = gslcblas_thread_num ((double) M * N * K);
+  FUNCTION (thread_args) args;
+
+  if (nthreads < 2)
+    return -1;
+
+  args.Order = Order;
+  args.TransA = TransA;
+  args.TransB = TransB;
+  args.M = M;
+  args.N = N;
+  args.K = K;
+  args.alpha = alpha;
+  args.A = A;
+  args.lda = lda;
+  args.B = B;
+  args.ldb = ldb;
+  args.beta = beta;
+  args.C = C;
+  args.ldc = ldc;
+
+  return gslcblas_thread_run (nthreads, FUNCTION (gemm_task), &args);
+}
+
+/* the columns (Side = Left) or rows (Side = Right) of C are independent */
+static void
+FUNCTION (symm_task) (void *arg, const int tid, const int nthreads)
+{
+  const FUNCTION (thread_args) *p = arg;
+  const enum CBLAS_ORDER Order = p->Order;
+  int lo, hi;
+
+  if (p->Side == CblasLeft)
+    {
+      gslcblas_thread_range (p->N, nthreads, tid, &lo, &hi);
+
+      if (hi > lo)
+        FUNCTION (symm) (Order, p->Side, p->Uplo, p->M, hi - lo, p->alpha,
+                         p->A, p->lda, p->B + IDX (p->ldb, 0, lo), p->ldb,
+                         p->beta, p->C + IDX (p->ldc, 0, lo), p->ldc);
+    }
+  else
+    {
+      gslcblas_thread_range (p->M, nthreads, tid, &lo, &hi);
+
+      if (hi > lo)
+        FUNCTION (symm) (Order, p->Side, p->Uplo, hi - lo, p->N, p->alpha,
+                         p->A, p->lda, p->B + IDX (p->ldb, lo, 0), p->ldb,
+                         p->beta, p->C + IDX (p->ldc, lo, 0), p->ldc);
+    }
+}
+
+int
+INTERNAL (symm_threaded) (const enum CBLAS_ORDER Order,
+                          const enum CBLAS_SIDE Side,
+                          const enum CBLAS_UPLO Uplo, const int M, const int N,
+                          const BASE alpha, const BASE *A, const int lda,
+                          const BASE *B, const int ldb, const BASE beta,
+                          BASE *C, const int ldc)
+{
+  const int nA = (Side == CblasLeft) ? M : N;
+  const int nthreads = gslcblas_thread_num ((double) M * N * nA);
+  FUNCTION (thread_args) args;
+
+  if (nthreads < 2)
+    return -1;
+
+  args.Order = Order;
+  args.Side = Side;
+  args.Uplo = Uplo;
+  args.M = M;
+  args.N = N;
+  args.alpha = alpha;
+  args.A = A;
+  args.lda = lda;
+  args.B = B;
+  args.ldb = ldb;
+  args.beta = beta;
+  args.C = C;
+  args.ldc = ldc;
+
+  return gslcblas_thread_run (nthreads, FUNCTION (symm_task), &args);
+}
+
+/* each thread takes a block of rows i0:i1 of the triangle of C, made of
+ * a diagonal block computed by syrk and a rectangle computed by gemm;
+ * the boundaries are chosen so that all blocks have equal area */
+static void
+FUNCTION (syrk_task) (void *arg, const int tid, const int nthreads)
+{
+  const FUNCTION (thread_args) *p = arg;
+  const enum CBLAS_ORDER Order = p->Order;
+  const int N = p->N;
+  const int trans = (p->TransA == CblasNoTrans) ? CblasNoTrans : CblasTrans;
+  const double t0 = (double) tid / nthreads;
+  const double t1 = (double) (tid + 1) / nthreads;
+  int i0, i1;
+  int j0, j1;
+
+  if (p->Uplo == CblasLower)
+    {
+      i0 = (int) (N * sqrt (t0));
+      i1 = (tid == nthreads - 1) ? N : (int) (N * sqrt (t1));
+      j0 = 0;
+      j1 = i0;
+    }
+  else
+    {
+      i0 = (int) (N * (1.0 - sqrt (1.0 - t0)));
+      i1 = (tid == nthreads - 1) ? N : (int) (N * (1.0 - sqrt (1.0 - t1)));
+      j0 = i1;
+      j1 = N;
+    }
+
+  if (i1 <= i0)
+    return;
+
+  /* diagonal block */
+  FUNCTION (syrk) (Order, p->Uplo, p->TransA, i1 - i0, p->K, p->alpha,
+                   (trans == CblasNoTrans) ? p->A + IDX (p->lda, i0, 0)
+                                           : p->A + IDX (p->lda, 0, i0),
+                   p->lda, p->beta, p->C + IDX (p->ldc, i0, i0), p->ldc);
+
+  /* off-diagonal rectangle C(i0:i1,j0:j1) = alpha op(A)_i op(A)_j^T */
+  if (j1 > j0)
+    {
+      if (trans == CblasNoTrans)
+        FUNCTION (gemm) (Order, CblasNoTrans, CblasTrans, i1 - i0, j1 - j0,
+                         p->K, p->alpha, p->A + IDX (p->lda, i0, 0), p->lda,
+                         p->A + IDX (p->lda, j0, 0), p->lda, p->beta,
+                         p->C + IDX (p->ldc, i0, j0), p->ldc);
+      else
+        FUNCTION (gemm) (Order, CblasTrans, CblasNoTrans, i1 - i0, j1 - j0,
+                         p->K, p->alpha, p->A + IDX (p->lda, 0, i0), p->lda,
+                         p->A + IDX (p->lda, 0, j0), p->lda, p->beta,
+                         p->C + IDX (p->ldc, i0, j0), p->ldc);
+    }
+}
+
+int
+INTERNAL (syrk_threaded) (const enum CBLAS_ORDER Order,
+                          const enum CBLAS_UPLO Uplo,
+                          const enum CBLAS_TRANSPOSE Trans, const int N,
+                          const int K, const BASE alpha, const BASE *A,
+                          const int lda, const BASE beta, BASE *C,
+                          const int ldc)
+{
+  const int nthreads = gslcblas_thread_num (0.5 * N * N * K);
+  FUNCTION (thread_args) args;
+
+  if (nthreads < 2)
+    return -1;
+
+  args.Order = Order;
+  args.Uplo = Uplo;
+  args.TransA = Trans;
+  args.N = N;
+  args.K = K;
+  args.alpha = alpha;
+  args.A = A;
+  args.lda = lda;
+  args.beta = beta;
+  args.C = C;
+  args.ldc = ldc;
+
+  return gslcblas_thread_run (nthreads, FUNCTION (syrk_task), &args);
+}
+
+/* the columns (Side = Left) or rows (Side = Right) of B are independent */
+static void
+FUNCTION (trsm_task) (void *arg, const int tid, const int nthreads)
+{
+  const FUNCTION (thread_args) *p = arg;
+  const enum CBLAS_ORDER Order = p->Order;
+  int lo, hi;
+
+  if (p->Side == CblasLeft)
+    {
+      gslcblas_thread_range (p->N, nthreads, tid, &lo, &hi);
+
+      if (hi > lo)
+        FUNCTION (trsm) (Order, p->Side, p->Uplo, p->TransA, p->Diag, p->M,
+                         hi - lo, p->alpha, p->A, p->lda,
+                         p->C + IDX (p->ldc, 0, lo), p->ldc);
+    }
+  else
+    {
+      gslcblas_thread_range (p->M, nthreads, tid, &lo, &hi);
+
+      if (hi > lo)
+        FUNCTION (trsm) (Order, p->Side, p->Uplo, p->TransA, p->Diag, hi - lo,
+                         p->N, p->alpha, p->A, p->lda,
+                         p->C + IDX (p->ldc, lo, 0), p->ldc);
+    }
+}
+
+int
+INTERNAL (trsm_threaded) (const enum CBLAS_ORDER Order,
+                          const enum CBLAS_SIDE Side,
+                          const enum CBLAS_UPLO Uplo,
+                          const enum CBLAS_TRANSPOSE TransA,
+                          const enum CBLAS_DIAG Diag, const int M, const int N,
+                          const BASE alpha, const BASE *A, const int lda,
+                          BASE *B, const int ldb)
+{
+  const int nA = (Side == CblasLeft) ? M : N;
+  const int nthreads = gslcblas_thread_num (0.5 * M * N * nA);
+  FUNCTION (thread_args) args;
+
+  if (nthreads < 2)
+    return -1;
+
+  args.Order = Order;
+  args.Side = Side;
+  args.Uplo = Uplo;
+  args.TransA = TransA;
+  args.Diag = Diag;
+  args.M = M;
+  args.N = N;
+  args.alpha = alpha;
+  args.A = A;
+  args.lda = lda;
+  args.C = B;
+  args.ldc = ldb;
+
+  return gslcblas_thread_run (nthreads, FUNCTION (trsm_task), &args);
+}
+
+#undef IDX
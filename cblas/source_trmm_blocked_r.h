@@ -0,0 +1,99 @@
+/* cblas/source_trmm_blocked_r.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Recursive triangular matrix multiply,
+ *
+ *   B := alpha * op(A) * B    (side = Left)
+ *   B := alpha * B * op(A)    (side = Right)
+ *
+ * on row-major storage, using the same splitting of op(A) as
+ * source_trsm_blocked_r.h. The half of B which is read by the GEMM
+ * update is always overwritten last.
+ */
+
+#define OPA(i,j) ((trans == CblasNoTrans) ? A + (i) * lda + (j) : A + (j) * lda + (i))
+
+void
+INTERNAL (trmm_blocked) (const int side, const int uplo, const int trans,
+                         const int diag, const int n1, const int n2,
+                         const BASE alpha, const BASE *A, const int lda,
+                         BASE *B, const int ldb)
+{
+  /* op(A) is upper triangular */
+  const int upper = (uplo == CblasUpper) == (trans == CblasNoTrans);
+  const int n = (side == CblasLeft) ? n1 : n2;
+  const int m1 = ((n / 2 + 7) / 8) * 8;
+  const int m2 = n - m1;
+
+  if (side == CblasLeft)
+    {
+      BASE *B1 = B;
+      BASE *B2 = B + m1 * ldb;
+
+      if (upper)
+        {
+          /* B1 := alpha (A11 B1 + A12 B2), then B2 := alpha A22 B2 */
+          FUNCTION (trmm) (CblasRowMajor, CblasLeft, uplo, trans, diag,
+                           m1, n2, alpha, A, lda, B1, ldb);
+          FUNCTION (gemm) (CblasRowMajor, trans, CblasNoTrans, m1, n2, m2,
+                           alpha, OPA (0, m1), lda, B2, ldb, 1.0, B1, ldb);
+          FUNCTION (trmm) (CblasRowMajor, CblasLeft, uplo, trans, diag,
+                           m2, n2, alpha, OPA (m1, m1), lda, B2, ldb);
+        }
+      else
+        {
+          /* B2 := alpha (A21 B1 + A22 B2), then B1 := alpha A11 B1 */
+          FUNCTION (trmm) (CblasRowMajor, CblasLeft, uplo, trans, diag,
+                           m2, n2, alpha, OPA (m1, m1), lda, B2, ldb);
+          FUNCTION (gemm) (CblasRowMajor, trans, CblasNoTrans, m2, n2, m1,
+                           alpha, OPA (m1, 0), lda, B1, ldb, 1.0, B2, ldb);
+          FUNCTION (trmm) (CblasRowMajor, CblasLeft, uplo, trans, diag,
+                           m1, n2, alpha, A, lda, B1, ldb);
+        }
+    }
+  else
+    {
+      BASE *B1 = B;
+      BASE *B2 = B + m1;
+
+      if (upper)
+        {
+          /* B2 := alpha (B1 A12 + B2 A22), then B1 := alpha B1 A11 */
+          FUNCTION (trmm) (CblasRowMajor, CblasRight, uplo, trans, diag,
+                           n1, m2, alpha, OPA (m1, m1), lda, B2, ldb);
+          FUNCTION (gemm) (CblasRowMajor, CblasNoTrans, trans, n1, m2, m1,
+                           alpha, B1, ldb, OPA (0, m1), lda, 1.0, B2, ldb);
+          FUNCTION (trmm) (CblasRowMajor, CblasRight, uplo, trans, diag,
+                           n1, m1, alpha, A, lda, B1, ldb);
+        }
+      else
+        {
+          /* B1 := alpha (B1 A11 + B2 A21), then B2 := alpha B2 A22 */
+          FUNCTION (trmm) (CblasRowMajor, CblasRight, uplo, trans, diag,
+                           n1, m1, alpha, A, lda, B1, ldb);
+          FUNCTION (gemm) (CblasRowMajor, CblasNoTrans, trans, n1, m1, m2,
+                           alpha, B2, ldb, OPA (m1, 0), lda, 1.0, B1, ldb);
+          FUNCTION (trmm) (CblasRowMajor, CblasRight, uplo, trans, diag,
+                           n1, m2, alpha, OPA (m1, m1), lda, B2, ldb);
+        }
+    }
+}
+
+#undef OPA
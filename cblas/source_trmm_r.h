@@ -40,6 +40,12 @@
     trans = (TransA == CblasConjTrans) ? CblasTrans : TransA;
   }
 
+  /* large triangles are split recursively into GEMM updates */
+  if (((side == CblasLeft) ? n1 : n2) > TR_BLOCKED_NB) {
+    TRMM_BLOCKED(side, uplo, trans, Diag, n1, n2, alpha, A, lda, B, ldb);
+    return;
+  }
+
   if (side == CblasLeft && uplo == CblasUpper && trans == CblasNoTrans) {
 
     /* form  B := alpha * TriU(A)*B */
@@ -0,0 +1,108 @@
+/* cblas/source_trsm_blocked_r.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Recursive triangular solve with multiple right hand sides,
+ *
+ *   B := alpha * inv(op(A)) * B    (side = Left)
+ *   B := alpha * B * inv(op(A))    (side = Right)
+ *
+ * on row-major storage. op(A) is split as
+ *
+ *   op(A) = [ A11 A12 ]
+ *           [ A21 A22 ]
+ *
+ * where one of A12 or A21 is zero, and the problem is reduced to two
+ * half-size solves and a GEMM update with the off-diagonal block. The
+ * halves are solved by calling FUNCTION(trsm) again, which recurses
+ * until the triangle is small enough for the unblocked loops, so
+ * almost all of the flops are done by GEMM.
+ */
+
+/* pointer to block (i,j) of op(A), and the transpose flag to pass to
+ * gemm for it */
+#define OPA(i,j) ((trans == CblasNoTrans) ? A + (i) * lda + (j) : A + (j) * lda + (i))
+
+void
+INTERNAL (trsm_blocked) (const int side, const int uplo, const int trans,
+                         const int diag, const int n1, const int n2,
+                         const BASE alpha, const BASE *A, const int lda,
+                         BASE *B, const int ldb)
+{
+  /* op(A) is upper triangular */
+  const int upper = (uplo == CblasUpper) == (trans == CblasNoTrans);
+  const int n = (side == CblasLeft) ? n1 : n2;
+  const int m1 = ((n / 2 + 7) / 8) * 8;
+  const int m2 = n - m1;
+
+  if (side == CblasLeft)
+    {
+      BASE *B1 = B;
+      BASE *B2 = B + m1 * ldb;
+
+      if (upper)
+        {
+          /* solve A22 X2 = alpha B2, then A11 X1 = alpha B1 - A12 X2 */
+          FUNCTION (trsm) (CblasRowMajor, CblasLeft, uplo, trans, diag,
+                           m2, n2, alpha, OPA (m1, m1), lda, B2, ldb);
+          FUNCTION (gemm) (CblasRowMajor, trans, CblasNoTrans, m1, n2, m2,
+                           -1.0, OPA (0, m1), lda, B2, ldb, alpha, B1, ldb);
+          FUNCTION (trsm) (CblasRowMajor, CblasLeft, uplo, trans, diag,
+                           m1, n2, 1.0, A, lda, B1, ldb);
+        }
+      else
+        {
+          /* solve A11 X1 = alpha B1, then A22 X2 = alpha B2 - A21 X1 */
+          FUNCTION (trsm) (CblasRowMajor, CblasLeft, uplo, trans, diag,
+                           m1, n2, alpha, A, lda, B1, ldb);
+          FUNCTION (gemm) (CblasRowMajor, trans, CblasNoTrans, m2, n2, m1,
+                           -1.0, OPA (m1, 0), lda, B1, ldb, alpha, B2, ldb);
+          FUNCTION (trsm) (CblasRowMajor, CblasLeft, uplo, trans, diag,
+                           m2, n2, 1.0, OPA (m1, m1), lda, B2, ldb);
+        }
+    }
+  else
+    {
+      BASE *B1 = B;
+      BASE *B2 = B + m1;
+
+      if (upper)
+        {
+          /* solve X1 A11 = alpha B1, then X2 A22 = alpha B2 - X1 A12 */
+          FUNCTION (trsm) (CblasRowMajor, CblasRight, uplo, trans, diag,
+                           n1, m1, alpha, A, lda, B1, ldb);
+          FUNCTION (gemm) (CblasRowMajor, CblasNoTrans, trans, n1, m2, m1,
+                           -1.0, B1, ldb, OPA (0, m1), lda, alpha, B2, ldb);
+          FUNCTION (trsm) (CblasRowMajor, CblasRight, uplo, trans, diag,
+                           n1, m2, 1.0, OPA (m1, m1), lda, B2, ldb);
+        }
+      else
+        {
+          /* solve X2 A22 = alpha B2, then X1 A11 = alpha B1 - X2 A21 */
+          FUNCTION (trsm) (CblasRowMajor, CblasRight, uplo, trans, diag,
+                           n1, m2, alpha, OPA (m1, m1), lda, B2, ldb);
+          FUNCTION (gemm) (CblasRowMajor, CblasNoTrans, trans, n1, m1, m2,
+                           -1.0, B2, ldb, OPA (m1, 0), lda, alpha, B1, ldb);
+          FUNCTION (trsm) (CblasRowMajor, CblasRight, uplo, trans, diag,
+                           n1, m1, 1.0, A, lda, B1, ldb);
+        }
+    }
+}
+
+#undef OPA
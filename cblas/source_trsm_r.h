@@ -26,6 +26,10 @@
 
   CHECK_ARGS12(TRSM,Order,Side,Uplo,TransA,Diag,M,N,alpha,A,lda,B,ldb);
 
+  if (TRSM_THREADED(Order, Side, Uplo, TransA, Diag, M, N, alpha, A, lda,
+                    B, ldb) == 0)
+    return;
+
   if (Order == CblasRowMajor) {
     n1 = M;
     n2 = N;
@@ -40,6 +44,12 @@
     trans = (TransA == CblasConjTrans) ? CblasTrans : TransA;
   }
 
+  /* large triangles are split recursively into GEMM updates */
+  if (((side == CblasLeft) ? n1 : n2) > TR_BLOCKED_NB) {
+    TRSM_BLOCKED(side, uplo, trans, Diag, n1, n2, alpha, A, lda, B, ldb);
+    return;
+  }
+
   if (side == CblasLeft && uplo == CblasUpper && trans == CblasNoTrans) {
 
     /* form  B := alpha * inv(TriU(A)) *B */
@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "thread.h"
 
 void
 cblas_ssymm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
@@ -10,6 +11,8 @@ cblas_ssymm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
              const int ldb, const float beta, float *C, const int ldc)
 {
 #define BASE float
+#define SYMM_THREADED gslcblas_ssymm_threaded
 #include "source_symm_r.h"
+#undef SYMM_THREADED
 #undef BASE
 }
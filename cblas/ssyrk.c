@@ -2,6 +2,8 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_blocked.h"
+#include "thread.h"
 
 void
 cblas_ssyrk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -10,6 +12,10 @@ cblas_ssyrk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
              const float beta, float *C, const int ldc)
 {
 #define BASE float
+#define SYRK_THREADED gslcblas_ssyrk_threaded
+#define SYRK_BLOCKED gslcblas_ssyrk_blocked
 #include "source_syrk_r.h"
+#undef SYRK_BLOCKED
+#undef SYRK_THREADED
 #undef BASE
 }
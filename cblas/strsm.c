@@ -2,6 +2,8 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "blocked_l3.h"
+#include "thread.h"
 
 void
 cblas_strsm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
@@ -11,6 +13,10 @@ cblas_strsm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
              const int ldb)
 {
 #define BASE float
+#define TRSM_BLOCKED gslcblas_strsm_blocked
+#define TRSM_THREADED gslcblas_strsm_threaded
 #include "source_trsm_r.h"
+#undef TRSM_BLOCKED
+#undef TRSM_THREADED
 #undef BASE
 }
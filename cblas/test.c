@@ -26,6 +26,8 @@
 
 #include "tests.h"
 
+void test_blocked (void);
+
 int 
 main (void)
 {
@@ -33,6 +35,8 @@ main (void)
 
 #include "tests.c"
 
+  test_blocked ();
+
   exit (gsl_test_summary());
 }
 
@@ -0,0 +1,800 @@
+/* cblas/test_blocked.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * The generated tests in test_*.c use matrices of order at most 4,
+ * which never reach the blocked code paths. The tests here compare the
+ * blocked routines against straightforward loops on problems large
+ * enough to cross every cache block boundary.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_cblas.h>
+#include <gsl/gsl_blas.h>
+
+#include "tests.h"
+
+static unsigned long int test_seed = 1;
+
+/* simple LCG, so that the cblas tests need not link against gsl_rng */
+static double
+test_rand (void)
+{
+  test_seed = (test_seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+  return 2.0 * ((double) test_seed / 2147483648.0) - 1.0;
+}
+
+static void
+test_fill (double *A, const size_t n)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    A[i] = test_rand ();
+}
+
+/* offset of element (i,j) of a matrix with leading dimension ld */
+#define IDX(order,ld,i,j) \
+  ((order) == CblasRowMajor ? (i) * (ld) + (j) : (j) * (ld) + (i))
+
+static void
+test_dgemm_blocked (const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE transA,
+                    const enum CBLAS_TRANSPOSE transB,
+                    const int M, const int N, const int K)
+{
+  const double alpha = 0.7, beta = -1.3;
+  const int rowsA = (transA == CblasNoTrans) ? M : K;
+  const int colsA = (transA == CblasNoTrans) ? K : M;
+  const int rowsB = (transB == CblasNoTrans) ? K : N;
+  const int colsB = (transB == CblasNoTrans) ? N : K;
+  const int lda = ((order == CblasRowMajor) ? colsA : rowsA) + 3;
+  const int ldb = ((order == CblasRowMajor) ? colsB : rowsB) + 1;
+  const int ldc = ((order == CblasRowMajor) ? N : M) + 2;
+  const size_t sizeA = (size_t) lda * ((order == CblasRowMajor) ? rowsA : colsA);
+  const size_t sizeB = (size_t) ldb * ((order == CblasRowMajor) ? rowsB : colsB);
+  const size_t sizeC = (size_t) ldc * ((order == CblasRowMajor) ? M : N);
+  double *A = malloc (sizeA * sizeof (double));
+  double *B = malloc (sizeB * sizeof (double));
+  double *C = malloc (sizeC * sizeof (double));
+  double *C_expected = malloc (sizeC * sizeof (double));
+  float *Af = malloc (sizeA * sizeof (float));
+  float *Bf = malloc (sizeB * sizeof (float));
+  float *Cf = malloc (sizeC * sizeof (float));
+  double dmax = 0.0, fmax = 0.0;
+  size_t n;
+  int i, j, k;
+
+  test_fill (A, sizeA);
+  test_fill (B, sizeB);
+  test_fill (C, sizeC);
+
+  for (n = 0; n < sizeA; n++)
+    Af[n] = (float) A[n];
+  for (n = 0; n < sizeB; n++)
+    Bf[n] = (float) B[n];
+  for (n = 0; n < sizeC; n++)
+    {
+      Cf[n] = (float) C[n];
+      C_expected[n] = C[n];
+    }
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double sum = 0.0;
+
+          for (k = 0; k < K; k++)
+            {
+              double aik = (transA == CblasNoTrans) ?
+                           A[IDX (order, lda, i, k)] : A[IDX (order, lda, k, i)];
+              double bkj = (transB == CblasNoTrans) ?
+                           B[IDX (order, ldb, k, j)] : B[IDX (order, ldb, j, k)];
+              sum += aik * bkj;
+            }
+
+          C_expected[IDX (order, ldc, i, j)] =
+            alpha * sum + beta * C_expected[IDX (order, ldc, i, j)];
+        }
+    }
+
+  cblas_dgemm (order, transA, transB, M, N, K, alpha, A, lda, B, ldb,
+               beta, C, ldc);
+  cblas_sgemm (order, transA, transB, M, N, K, (float) alpha, Af, lda, Bf, ldb,
+               (float) beta, Cf, ldc);
+
+  for (n = 0; n < sizeC; n++)
+    {
+      dmax = GSL_MAX (dmax, fabs (C[n] - C_expected[n]));
+      fmax = GSL_MAX (fmax, fabs (Cf[n] - C_expected[n]));
+    }
+
+  gsl_test (dmax > 1.0e-12 * K, "dgemm blocked order=%d transA=%d transB=%d M=%d N=%d K=%d, error %g",
+            order, transA, transB, M, N, K, dmax);
+  gsl_test (fmax > 1.0e-5 * K, "sgemm blocked order=%d transA=%d transB=%d M=%d N=%d K=%d, error %g",
+            order, transA, transB, M, N, K, fmax);
+
+  free (A);
+  free (B);
+  free (C);
+  free (C_expected);
+  free (Af);
+  free (Bf);
+  free (Cf);
+}
+
+/* element (i,j) of op(A) for a triangular matrix A */
+static double
+test_tri_elem (const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+               const enum CBLAS_TRANSPOSE trans, const enum CBLAS_DIAG diag,
+               const double *A, const int lda, int i, int j)
+{
+  if (trans != CblasNoTrans)
+    {
+      int t = i;
+      i = j;
+      j = t;
+    }
+
+  if (i == j)
+    return (diag == CblasUnit) ? 1.0 : A[IDX (order, lda, i, i)];
+  else if ((uplo == CblasUpper && i < j) || (uplo == CblasLower && i > j))
+    return A[IDX (order, lda, i, j)];
+  else
+    return 0.0;
+}
+
+/* X := alpha op(A) B or alpha B op(A), computed with plain loops */
+static void
+test_trmm_ref (const enum CBLAS_ORDER order, const enum CBLAS_SIDE side,
+               const enum CBLAS_UPLO uplo, const enum CBLAS_TRANSPOSE trans,
+               const enum CBLAS_DIAG diag, const int M, const int N,
+               const double alpha, const double *A, const int lda,
+               const double *B, double *X, const int ldb)
+{
+  const int K = (side == CblasLeft) ? M : N;
+  int i, j, k;
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double sum = 0.0;
+
+          for (k = 0; k < K; k++)
+            {
+              if (side == CblasLeft)
+                sum += test_tri_elem (order, uplo, trans, diag, A, lda, i, k)
+                       * B[IDX (order, ldb, k, j)];
+              else
+                sum += B[IDX (order, ldb, i, k)]
+                       * test_tri_elem (order, uplo, trans, diag, A, lda, k, j);
+            }
+
+          X[IDX (order, ldb, i, j)] = alpha * sum;
+        }
+    }
+}
+
+static double
+test_maxdiff (const double *x, const double *y, const size_t n)
+{
+  double d = 0.0;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    d = GSL_MAX (d, fabs (x[i] - y[i]));
+
+  return d;
+}
+
+/* compare the multithreaded Level 3 routines against serial runs */
+static void
+test_threads (const enum CBLAS_ORDER order, const size_t nthreads)
+{
+  const int M = 203, N = 187, K = 161;
+  const int ld = 211;
+  const size_t size = (size_t) ld * ld;
+  const enum CBLAS_UPLO uplos[] = { CblasUpper, CblasLower };
+  const enum CBLAS_SIDE sides[] = { CblasLeft, CblasRight };
+  const enum CBLAS_TRANSPOSE trans[] = { CblasNoTrans, CblasTrans };
+  double *A = malloc (size * sizeof (double));
+  double *B = malloc (size * sizeof (double));
+  double *C0 = malloc (size * sizeof (double));
+  double *C1 = malloc (size * sizeof (double));
+  double *C = malloc (size * sizeof (double));
+  size_t i, u, s, t;
+
+  test_fill (A, size);
+  test_fill (B, size);
+  test_fill (C, size);
+
+  /* make the triangular factors well conditioned */
+  for (i = 0; i < (size_t) ld; i++)
+    A[i * ld + i] += 10.0;
+
+  for (t = 0; t < 2; t++)
+    {
+      for (i = 0; i < size; i++)
+        C0[i] = C1[i] = C[i];
+
+      gsl_blas_set_num_threads (1);
+      cblas_dgemm (order, trans[t], CblasNoTrans, M, N, K, 0.5, A, ld, B, ld, 2.0, C0, ld);
+      gsl_blas_set_num_threads (nthreads);
+      cblas_dgemm (order, trans[t], CblasNoTrans, M, N, K, 0.5, A, ld, B, ld, 2.0, C1, ld);
+
+      gsl_test (test_maxdiff (C0, C1, size) > 1.0e-12,
+                "dgemm threads=%zu order=%d transA=%d", nthreads, order, trans[t]);
+    }
+
+  for (u = 0; u < 2; u++)
+    {
+      for (s = 0; s < 2; s++)
+        {
+          for (i = 0; i < size; i++)
+            C0[i] = C1[i] = C[i];
+
+          gsl_blas_set_num_threads (1);
+          cblas_dsymm (order, sides[s], uplos[u], M, N, 0.5, A, ld, B, ld, 2.0, C0, ld);
+          gsl_blas_set_num_threads (nthreads);
+          cblas_dsymm (order, sides[s], uplos[u], M, N, 0.5, A, ld, B, ld, 2.0, C1, ld);
+
+          gsl_test (test_maxdiff (C0, C1, size) > 1.0e-12,
+                    "dsymm threads=%zu order=%d side=%d uplo=%d", nthreads, order, sides[s], uplos[u]);
+
+          for (t = 0; t < 2; t++)
+            {
+              for (i = 0; i < size; i++)
+                C0[i] = C1[i] = B[i];
+
+              gsl_blas_set_num_threads (1);
+              cblas_dtrsm (order, sides[s], uplos[u], trans[t], CblasNonUnit, M, N, 0.5, A, ld, C0, ld);
+              gsl_blas_set_num_threads (nthreads);
+              cblas_dtrsm (order, sides[s], uplos[u], trans[t], CblasNonUnit, M, N, 0.5, A, ld, C1, ld);
+
+              gsl_test (test_maxdiff (C0, C1, size) > 1.0e-12,
+                        "dtrsm threads=%zu order=%d side=%d uplo=%d trans=%d", nthreads, order, sides[s], uplos[u], trans[t]);
+            }
+        }
+
+      for (t = 0; t < 2; t++)
+        {
+          for (i = 0; i < size; i++)
+            C0[i] = C1[i] = C[i];
+
+          gsl_blas_set_num_threads (1);
+          cblas_dsyrk (order, uplos[u], trans[t], M, K, 0.5, A, ld, 2.0, C0, ld);
+          gsl_blas_set_num_threads (nthreads);
+          cblas_dsyrk (order, uplos[u], trans[t], M, K, 0.5, A, ld, 2.0, C1, ld);
+
+          gsl_test (test_maxdiff (C0, C1, size) > 1.0e-12,
+                    "dsyrk threads=%zu order=%d uplo=%d trans=%d", nthreads, order, uplos[u], trans[t]);
+        }
+    }
+
+  gsl_blas_set_num_threads (1);
+
+  free (A);
+  free (B);
+  free (C);
+  free (C0);
+  free (C1);
+}
+
+static void
+test_trsm_trmm_blocked (const enum CBLAS_ORDER order, const int M, const int N)
+{
+  const enum CBLAS_UPLO uplos[] = { CblasUpper, CblasLower };
+  const enum CBLAS_SIDE sides[] = { CblasLeft, CblasRight };
+  const enum CBLAS_TRANSPOSE trans[] = { CblasNoTrans, CblasTrans };
+  const enum CBLAS_DIAG diags[] = { CblasNonUnit, CblasUnit };
+  const double alpha = 1.7;
+  const int nA = GSL_MAX (M, N);
+  const int lda = nA + 5;
+  const int ldb = ((order == CblasRowMajor) ? N : M) + 3;
+  const size_t sizeA = (size_t) lda * nA;
+  const size_t sizeB = (size_t) ldb * ((order == CblasRowMajor) ? M : N);
+  double *A = malloc (sizeA * sizeof (double));
+  double *B = malloc (sizeB * sizeof (double));
+  double *X = malloc (sizeB * sizeof (double));
+  double *Y = malloc (sizeB * sizeof (double));
+  size_t i, s, u, t, d;
+
+  test_fill (A, sizeA);
+  test_fill (B, sizeB);
+
+  /* scale off-diagonal elements so that op(A) is well conditioned */
+  for (i = 0; i < sizeA; i++)
+    A[i] *= 2.0 / nA;
+
+  for (i = 0; i < (size_t) nA; i++)
+    A[i * lda + i] = 1.0 + 0.5 * A[i * lda + i];
+
+  for (s = 0; s < 2; s++)
+    for (u = 0; u < 2; u++)
+      for (t = 0; t < 2; t++)
+        for (d = 0; d < 2; d++)
+          {
+            double dmax;
+
+            /* trmm against the reference product */
+            for (i = 0; i < sizeB; i++)
+              X[i] = Y[i] = B[i];
+
+            cblas_dtrmm (order, sides[s], uplos[u], trans[t], diags[d],
+                         M, N, alpha, A, lda, X, ldb);
+            test_trmm_ref (order, sides[s], uplos[u], trans[t], diags[d],
+                           M, N, alpha, A, lda, B, Y, ldb);
+
+            dmax = test_maxdiff (X, Y, sizeB);
+            gsl_test (dmax > 1.0e-12 * nA, "dtrmm blocked order=%d side=%d uplo=%d trans=%d diag=%d M=%d N=%d, error %g",
+                      order, sides[s], uplos[u], trans[t], diags[d], M, N, dmax);
+
+            /* trsm, checked by multiplying the solution back */
+            for (i = 0; i < sizeB; i++)
+              X[i] = B[i];
+
+            cblas_dtrsm (order, sides[s], uplos[u], trans[t], diags[d],
+                         M, N, alpha, A, lda, X, ldb);
+            test_trmm_ref (order, sides[s], uplos[u], trans[t], diags[d],
+                           M, N, 1.0 / alpha, A, lda, X, Y, ldb);
+
+            dmax = test_maxdiff (B, Y, sizeB);
+            gsl_test (dmax > 1.0e-12 * nA, "dtrsm blocked order=%d side=%d uplo=%d trans=%d diag=%d M=%d N=%d, error %g",
+                      order, sides[s], uplos[u], trans[t], diags[d], M, N, dmax);
+          }
+
+  free (A);
+  free (B);
+  free (X);
+  free (Y);
+}
+
+/* element (i,k) of op(X) for a real or complex (interleaved) matrix;
+ * for complex matrices the real and imaginary parts are returned */
+static double
+test_op (const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+         const double *X, const int ldx, const int i, const int k)
+{
+  return (trans == CblasNoTrans) ? X[IDX (order, ldx, i, k)]
+                                 : X[IDX (order, ldx, k, i)];
+}
+
+static void
+test_zop (const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE trans,
+          const double *X, const int ldx, const int i, const int k,
+          double *re, double *im)
+{
+  const int idx = (trans == CblasNoTrans) ? IDX (order, ldx, i, k)
+                                          : IDX (order, ldx, k, i);
+  *re = X[2 * idx];
+  *im = (trans == CblasConjTrans) ? -X[2 * idx + 1] : X[2 * idx + 1];
+}
+
+/* compare the blocked complex multiply with plain loops, for every
+ * combination of transposition and conjugation */
+static void
+test_zgemm_blocked (const enum CBLAS_ORDER order,
+                    const enum CBLAS_TRANSPOSE transA,
+                    const enum CBLAS_TRANSPOSE transB,
+                    const int M, const int N, const int K)
+{
+  const double alpha[2] = { 0.7, -0.4 }, beta[2] = { -1.3, 0.2 };
+  const float alphaf[2] = { 0.7f, -0.4f }, betaf[2] = { -1.3f, 0.2f };
+  const int rowsA = (transA == CblasNoTrans) ? M : K;
+  const int colsA = (transA == CblasNoTrans) ? K : M;
+  const int rowsB = (transB == CblasNoTrans) ? K : N;
+  const int colsB = (transB == CblasNoTrans) ? N : K;
+  const int lda = ((order == CblasRowMajor) ? colsA : rowsA) + 3;
+  const int ldb = ((order == CblasRowMajor) ? colsB : rowsB) + 1;
+  const int ldc = ((order == CblasRowMajor) ? N : M) + 2;
+  const size_t sizeA = 2 * (size_t) lda * ((order == CblasRowMajor) ? rowsA : colsA);
+  const size_t sizeB = 2 * (size_t) ldb * ((order == CblasRowMajor) ? rowsB : colsB);
+  const size_t sizeC = 2 * (size_t) ldc * ((order == CblasRowMajor) ? M : N);
+  double *A = malloc (sizeA * sizeof (double));
+  double *B = malloc (sizeB * sizeof (double));
+  double *C = malloc (sizeC * sizeof (double));
+  double *C_expected = malloc (sizeC * sizeof (double));
+  float *Af = malloc (sizeA * sizeof (float));
+  float *Bf = malloc (sizeB * sizeof (float));
+  float *Cf = malloc (sizeC * sizeof (float));
+  double zmax = 0.0, cmax = 0.0;
+  size_t n;
+  int i, j, k;
+
+  test_fill (A, sizeA);
+  test_fill (B, sizeB);
+  test_fill (C, sizeC);
+
+  for (n = 0; n < sizeA; n++)
+    Af[n] = (float) A[n];
+  for (n = 0; n < sizeB; n++)
+    Bf[n] = (float) B[n];
+  for (n = 0; n < sizeC; n++)
+    {
+      Cf[n] = (float) C[n];
+      C_expected[n] = C[n];
+    }
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double *c = C_expected + 2 * IDX (order, ldc, i, j);
+          double sr = 0.0, si = 0.0, cr, ci;
+
+          for (k = 0; k < K; k++)
+            {
+              double ar, ai, br, bi;
+
+              test_zop (order, transA, A, lda, i, k, &ar, &ai);
+              test_zop (order, transB, B, ldb, k, j, &br, &bi);
+              sr += ar * br - ai * bi;
+              si += ar * bi + ai * br;
+            }
+
+          cr = c[0];
+          ci = c[1];
+          c[0] = alpha[0] * sr - alpha[1] * si + beta[0] * cr - beta[1] * ci;
+          c[1] = alpha[0] * si + alpha[1] * sr + beta[0] * ci + beta[1] * cr;
+        }
+    }
+
+  cblas_zgemm (order, transA, transB, M, N, K, alpha, A, lda, B, ldb,
+               beta, C, ldc);
+  cblas_cgemm (order, transA, transB, M, N, K, alphaf, Af, lda, Bf, ldb,
+               betaf, Cf, ldc);
+
+  for (n = 0; n < sizeC; n++)
+    {
+      zmax = GSL_MAX (zmax, fabs (C[n] - C_expected[n]));
+      cmax = GSL_MAX (cmax, fabs (Cf[n] - C_expected[n]));
+    }
+
+  gsl_test (zmax > 1.0e-12 * K, "zgemm blocked order=%d transA=%d transB=%d M=%d N=%d K=%d, error %g",
+            order, transA, transB, M, N, K, zmax);
+  gsl_test (cmax > 1.0e-5 * K, "cgemm blocked order=%d transA=%d transB=%d M=%d N=%d K=%d, error %g",
+            order, transA, transB, M, N, K, cmax);
+
+  free (A);
+  free (B);
+  free (C);
+  free (C_expected);
+  free (Af);
+  free (Bf);
+  free (Cf);
+}
+
+/* maximum difference over the triangle uplo of C and C_expected, and
+ * check that the other triangle was not touched */
+static double
+test_tri_diff (const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+               const int N, const int ncomp, const double *C,
+               const double *C_expected, const double *C_orig,
+               const int ldc, int *touched)
+{
+  double dmax = 0.0;
+  int i, j, c;
+
+  *touched = 0;
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          const int idx = ncomp * IDX (order, ldc, i, j);
+          const int in = (uplo == CblasUpper) ? (i <= j) : (i >= j);
+
+          for (c = 0; c < ncomp; c++)
+            {
+              if (in)
+                dmax = GSL_MAX (dmax, fabs (C[idx + c] - C_expected[idx + c]));
+              else if (C[idx + c] != C_orig[idx + c])
+                *touched = 1;
+            }
+        }
+    }
+
+  return dmax;
+}
+
+/* compare the blocked rank-k updates, which are used for these sizes,
+ * with plain loops */
+static void
+test_syrk_blocked (const enum CBLAS_ORDER order, const enum CBLAS_UPLO uplo,
+                   const enum CBLAS_TRANSPOSE trans, const int N, const int K)
+{
+  const int rows = (trans == CblasNoTrans) ? N : K;
+  const int cols = (trans == CblasNoTrans) ? K : N;
+  const int lda = ((order == CblasRowMajor) ? cols : rows) + 3;
+  const int ldc = N + 2;
+  const size_t asize = (size_t) lda * GSL_MAX (rows, cols);
+  const size_t csize = (size_t) ldc * N;
+  const double alpha = 0.7, beta = -1.3;
+  const double zalpha[2] = { 0.7, -0.4 }, zbeta[2] = { -1.3, 0.2 };
+  const enum CBLAS_TRANSPOSE ztrans =
+    (trans == CblasNoTrans) ? CblasNoTrans : CblasConjTrans;
+  double *A = malloc (2 * asize * sizeof (double));
+  double *B = malloc (2 * asize * sizeof (double));
+  double *C = malloc (2 * csize * sizeof (double));
+  double *C0 = malloc (2 * csize * sizeof (double));
+  double *C_expected = malloc (2 * csize * sizeof (double));
+  int i, j, k, touched;
+  double dmax;
+
+  test_fill (A, 2 * asize);
+  test_fill (B, 2 * asize);
+  test_fill (C0, 2 * csize);
+
+  /* real syrk and syr2k */
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          const int idx = IDX (order, ldc, i, j);
+          double s1 = 0.0, s2 = 0.0;
+
+          for (k = 0; k < K; k++)
+            {
+              const double aik = test_op (order, trans, A, lda, i, k);
+              const double ajk = test_op (order, trans, A, lda, j, k);
+              const double bik = test_op (order, trans, B, lda, i, k);
+              const double bjk = test_op (order, trans, B, lda, j, k);
+
+              s1 += aik * ajk;
+              s2 += aik * bjk + bik * ajk;
+            }
+
+          C_expected[idx] = alpha * s1 + beta * C0[idx];
+          C_expected[csize + idx] = alpha * s2 + beta * C0[idx];
+        }
+    }
+
+  memcpy (C, C0, csize * sizeof (double));
+  cblas_dsyrk (order, uplo, trans, N, K, alpha, A, lda, beta, C, ldc);
+  dmax = test_tri_diff (order, uplo, N, 1, C, C_expected, C0, ldc, &touched);
+  gsl_test (dmax > 1.0e-12 * K || touched, "dsyrk blocked order=%d uplo=%d trans=%d N=%d K=%d, error %g",
+            order, uplo, trans, N, K, dmax);
+
+  memcpy (C, C0, csize * sizeof (double));
+  cblas_dsyr2k (order, uplo, trans, N, K, alpha, A, lda, B, lda, beta, C, ldc);
+  dmax = test_tri_diff (order, uplo, N, 1, C, C_expected + csize, C0, ldc, &touched);
+  gsl_test (dmax > 1.0e-12 * K || touched, "dsyr2k blocked order=%d uplo=%d trans=%d N=%d K=%d, error %g",
+            order, uplo, trans, N, K, dmax);
+
+  /* complex herk and her2k */
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          const int idx = 2 * IDX (order, ldc, i, j);
+          double h1r = 0.0, h1i = 0.0, h2r = 0.0, h2i = 0.0;
+
+          for (k = 0; k < K; k++)
+            {
+              double ar, ai, br, bi, cr, ci, dr, di, tr, ti;
+
+              test_zop (order, ztrans, A, lda, i, k, &ar, &ai);
+              test_zop (order, ztrans, A, lda, j, k, &br, &bi);
+              test_zop (order, ztrans, B, lda, i, k, &cr, &ci);
+              test_zop (order, ztrans, B, lda, j, k, &dr, &di);
+
+              /* op(A)ik conj(op(A)jk) */
+              h1r += ar * br + ai * bi;
+              h1i += ai * br - ar * bi;
+
+              /* alpha op(A)ik conj(op(B)jk) + conj(alpha) op(B)ik conj(op(A)jk) */
+              tr = ar * dr + ai * di;
+              ti = ai * dr - ar * di;
+              h2r += zalpha[0] * tr - zalpha[1] * ti;
+              h2i += zalpha[0] * ti + zalpha[1] * tr;
+              tr = cr * br + ci * bi;
+              ti = ci * br - cr * bi;
+              h2r += zalpha[0] * tr + zalpha[1] * ti;
+              h2i += zalpha[0] * ti - zalpha[1] * tr;
+            }
+
+          C_expected[idx] = alpha * h1r + beta * C0[idx];
+          C_expected[idx + 1] = (i == j) ? 0.0 : alpha * h1i + beta * C0[idx + 1];
+          C[idx] = h2r + beta * C0[idx];
+          C[idx + 1] = (i == j) ? 0.0 : h2i + beta * C0[idx + 1];
+        }
+    }
+
+  {
+    double *H2 = malloc (2 * csize * sizeof (double));
+
+    memcpy (H2, C, 2 * csize * sizeof (double));
+
+    memcpy (C, C0, 2 * csize * sizeof (double));
+    cblas_zherk (order, uplo, ztrans, N, K, alpha, A, lda, beta, C, ldc);
+    dmax = test_tri_diff (order, uplo, N, 2, C, C_expected, C0, ldc, &touched);
+    gsl_test (dmax > 1.0e-12 * K || touched, "zherk blocked order=%d uplo=%d trans=%d N=%d K=%d, error %g",
+              order, uplo, ztrans, N, K, dmax);
+
+    memcpy (C, C0, 2 * csize * sizeof (double));
+    cblas_zher2k (order, uplo, ztrans, N, K, zalpha, A, lda, B, lda, beta, C, ldc);
+    dmax = test_tri_diff (order, uplo, N, 2, C, H2, C0, ldc, &touched);
+    gsl_test (dmax > 1.0e-12 * K || touched, "zher2k blocked order=%d uplo=%d trans=%d N=%d K=%d, error %g",
+              order, uplo, ztrans, N, K, dmax);
+
+    free (H2);
+  }
+
+  /* complex syrk and syr2k */
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          const int idx = 2 * IDX (order, ldc, i, j);
+          double s1r = 0.0, s1i = 0.0, s2r = 0.0, s2i = 0.0;
+
+          for (k = 0; k < K; k++)
+            {
+              double ar, ai, br, bi, cr, ci, dr, di;
+
+              test_zop (order, trans, A, lda, i, k, &ar, &ai);
+              test_zop (order, trans, A, lda, j, k, &br, &bi);
+              test_zop (order, trans, B, lda, i, k, &cr, &ci);
+              test_zop (order, trans, B, lda, j, k, &dr, &di);
+
+              s1r += ar * br - ai * bi;
+              s1i += ar * bi + ai * br;
+              s2r += (ar * dr - ai * di) + (cr * br - ci * bi);
+              s2i += (ar * di + ai * dr) + (cr * bi + ci * br);
+            }
+
+          C_expected[idx] = zalpha[0] * s1r - zalpha[1] * s1i
+                            + zbeta[0] * C0[idx] - zbeta[1] * C0[idx + 1];
+          C_expected[idx + 1] = zalpha[0] * s1i + zalpha[1] * s1r
+                                + zbeta[0] * C0[idx + 1] + zbeta[1] * C0[idx];
+          C[idx] = zalpha[0] * s2r - zalpha[1] * s2i
+                   + zbeta[0] * C0[idx] - zbeta[1] * C0[idx + 1];
+          C[idx + 1] = zalpha[0] * s2i + zalpha[1] * s2r
+                       + zbeta[0] * C0[idx + 1] + zbeta[1] * C0[idx];
+        }
+    }
+
+  {
+    double *S2 = malloc (2 * csize * sizeof (double));
+
+    memcpy (S2, C, 2 * csize * sizeof (double));
+
+    memcpy (C, C0, 2 * csize * sizeof (double));
+    cblas_zsyrk (order, uplo, trans, N, K, zalpha, A, lda, zbeta, C, ldc);
+    dmax = test_tri_diff (order, uplo, N, 2, C, C_expected, C0, ldc, &touched);
+    gsl_test (dmax > 1.0e-12 * K || touched, "zsyrk blocked order=%d uplo=%d trans=%d N=%d K=%d, error %g",
+              order, uplo, trans, N, K, dmax);
+
+    memcpy (C, C0, 2 * csize * sizeof (double));
+    cblas_zsyr2k (order, uplo, trans, N, K, zalpha, A, lda, B, lda, zbeta, C, ldc);
+    dmax = test_tri_diff (order, uplo, N, 2, C, S2, C0, ldc, &touched);
+    gsl_test (dmax > 1.0e-12 * K || touched, "zsyr2k blocked order=%d uplo=%d trans=%d N=%d K=%d, error %g",
+              order, uplo, trans, N, K, dmax);
+
+    free (S2);
+  }
+
+  free (A);
+  free (B);
+  free (C);
+  free (C0);
+  free (C_expected);
+}
+
+/* norms of vectors of alternating 3s and 4s, scaled so that a naive
+ * sum of squares overflows or underflows, across several blocks */
+static void
+test_nrm2_scaled (const int N, const int incX, const double scale)
+{
+  const double expected = 5.0 * scale * sqrt (0.5 * N);
+  double *x = malloc (N * incX * sizeof (double));
+  float *xf = malloc (N * incX * sizeof (float));
+  int i;
+
+  for (i = 0; i < N * incX; i++)
+    {
+      x[i] = ((i / incX) % 2 == 0) ? 3.0 * scale : 4.0 * scale;
+      xf[i] = (float) x[i];
+    }
+
+  gsl_test_rel (cblas_dnrm2 (N, x, incX), expected, 1.0e-14,
+                "dnrm2 scaled N=%d incX=%d scale=%g", N, incX, scale);
+  /* with unit stride the vector is also N/2 complex numbers 3+4i */
+  if (incX == 1)
+    gsl_test_rel (cblas_dznrm2 (N / 2, x, 1), expected, 1.0e-14,
+                  "dznrm2 scaled N=%d scale=%g", N / 2, scale);
+
+  if (scale > 1.0e-36 && scale < 1.0e36)
+    {
+      gsl_test_rel (cblas_snrm2 (N, xf, incX), expected, 1.0e-5,
+                    "snrm2 scaled N=%d incX=%d scale=%g", N, incX, scale);
+
+      if (incX == 1)
+        gsl_test_rel (cblas_scnrm2 (N / 2, xf, 1), expected, 1.0e-5,
+                      "scnrm2 scaled N=%d scale=%g", N / 2, scale);
+    }
+
+  /* a single large element beyond the first block */
+  if (N > 300 && scale < 1.0e100)
+    {
+      x[300 * incX] = 1.0e300;
+      gsl_test_rel (cblas_dnrm2 (N, x, incX), 1.0e300, 1.0e-14,
+                    "dnrm2 mixed N=%d incX=%d scale=%g", N, incX, scale);
+    }
+
+  free (x);
+  free (xf);
+}
+
+void
+test_blocked (void)
+{
+  const enum CBLAS_ORDER orders[] = { CblasRowMajor, CblasColMajor };
+  const enum CBLAS_TRANSPOSE trans[] = { CblasNoTrans, CblasTrans, CblasConjTrans };
+  size_t o, ta, tb;
+
+  for (o = 0; o < 2; o++)
+    {
+      for (ta = 0; ta < 3; ta++)
+        {
+          for (tb = 0; tb < 3; tb++)
+            {
+              test_dgemm_blocked (orders[o], trans[ta], trans[tb], 37, 29, 41);
+              test_dgemm_blocked (orders[o], trans[ta], trans[tb], 133, 71, 397);
+              test_zgemm_blocked (orders[o], trans[ta], trans[tb], 75, 41, 283);
+            }
+        }
+
+      test_dgemm_blocked (orders[o], CblasNoTrans, CblasNoTrans, 5, 4103, 9);
+      test_dgemm_blocked (orders[o], CblasTrans, CblasNoTrans, 4103, 5, 9);
+
+      test_trsm_trmm_blocked (orders[o], 150, 77);
+      test_trsm_trmm_blocked (orders[o], 21, 203);
+
+      for (ta = 0; ta < 2; ta++)
+        {
+          test_syrk_blocked (orders[o], CblasUpper, trans[ta], 67, 45);
+          test_syrk_blocked (orders[o], CblasLower, trans[ta], 67, 45);
+          test_syrk_blocked (orders[o], CblasUpper, trans[ta], 9, 701);
+          test_syrk_blocked (orders[o], CblasLower, trans[ta], 9, 701);
+        }
+
+      test_threads (orders[o], 3);
+      test_threads (orders[o], 4);
+    }
+
+  {
+    const double scales[] = { 1.0, 1.0e30, 1.0e-30, 1.0e300, 1.0e-300, 1.0e-160 };
+    size_t k;
+
+    for (k = 0; k < 6; k++)
+      {
+        test_nrm2_scaled (6, 1, scales[k]);
+        test_nrm2_scaled (64, 1, scales[k]);
+        test_nrm2_scaled (1000, 1, scales[k]);
+        test_nrm2_scaled (602, 3, scales[k]);
+      }
+  }
+}
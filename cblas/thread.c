@@ -0,0 +1,274 @@
+/* cblas/thread.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * A minimal pool of worker threads for the Level 3 routines. Workers
+ * are started on demand, the first time a region needs them, and then
+ * sleep on a condition variable between regions. The number of threads
+ * defaults to the value of the environment variable GSL_NUM_THREADS,
+ * or 1 if it is unset, and can be changed with
+ * gsl_blas_set_num_threads().
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_cblas.h>
+#include "cblas.h"
+#include "thread.h"
+
+#ifdef HAVE_PTHREAD
+
+#include <pthread.h>
+
+static int thread_num = 1;
+static pthread_once_t thread_once = PTHREAD_ONCE_INIT;
+
+static void
+thread_init (void)
+{
+  const char *p = getenv ("GSL_NUM_THREADS");
+
+  if (p != 0)
+    {
+      const int n = atoi (p);
+      thread_num = GSL_MAX (1, GSL_MIN (n, CBLAS_THREAD_MAX));
+    }
+}
+
+/* held by the calling thread for the duration of a parallel region */
+static pthread_mutex_t pool_region = PTHREAD_MUTEX_INITIALIZER;
+
+/* protects the job description and counters below */
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_start = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+
+static int pool_size = 0;               /* number of workers started */
+static unsigned long pool_generation = 0;
+static int pool_pending = 0;            /* workers still running the job */
+static gslcblas_thread_fn pool_fn = 0;
+static void *pool_arg = 0;
+static int pool_nthreads = 0;
+
+typedef struct
+{
+  int tid;
+  unsigned long generation;     /* last job seen by the worker */
+} pool_worker_t;
+
+static void *
+pool_worker (void *p)
+{
+  const int tid = ((pool_worker_t *) p)->tid;
+  unsigned long generation = ((pool_worker_t *) p)->generation;
+
+  free (p);
+
+  pthread_mutex_lock (&pool_lock);
+
+  for (;;)
+    {
+      while (pool_generation == generation)
+        pthread_cond_wait (&pool_start, &pool_lock);
+
+      generation = pool_generation;
+
+      if (tid < pool_nthreads)
+        {
+          gslcblas_thread_fn fn = pool_fn;
+          void *arg = pool_arg;
+          const int nthreads = pool_nthreads;
+
+          pthread_mutex_unlock (&pool_lock);
+          fn (arg, tid, nthreads);
+          pthread_mutex_lock (&pool_lock);
+
+          if (--pool_pending == 0)
+            pthread_cond_signal (&pool_done);
+        }
+    }
+
+  return 0;
+}
+
+/* start workers until there are nthreads - 1 of them; returns the
+ * number of threads available, including the caller */
+static int
+pool_grow (const int nthreads)
+{
+  while (pool_size < nthreads - 1)
+    {
+      pool_worker_t *w = malloc (sizeof (pool_worker_t));
+      pthread_t thread;
+      pthread_attr_t attr;
+      int status;
+
+      if (w == 0)
+        break;
+
+      /* the worker must wait for the next job, not the previous one;
+       * pool_generation cannot change here since the caller holds
+       * pool_region */
+      w->tid = pool_size + 1;
+      w->generation = pool_generation;
+
+      pthread_attr_init (&attr);
+      pthread_attr_setdetachstate (&attr, PTHREAD_CREATE_DETACHED);
+      status = pthread_create (&thread, &attr, pool_worker, w);
+      pthread_attr_destroy (&attr);
+
+      if (status != 0)
+        {
+          free (w);
+          break;
+        }
+
+      ++pool_size;
+    }
+
+  return GSL_MIN (nthreads, pool_size + 1);
+}
+
+int
+gslcblas_thread_run (const int nthreads, gslcblas_thread_fn fn, void *arg)
+{
+  int n;
+
+  if (nthreads < 2 || pthread_mutex_trylock (&pool_region) != 0)
+    return -1;
+
+  n = pool_grow (nthreads);
+
+  if (n < 2)
+    {
+      pthread_mutex_unlock (&pool_region);
+      return -1;
+    }
+
+  pthread_mutex_lock (&pool_lock);
+  pool_fn = fn;
+  pool_arg = arg;
+  pool_nthreads = n;
+  pool_pending = n - 1;
+  ++pool_generation;
+  pthread_cond_broadcast (&pool_start);
+  pthread_mutex_unlock (&pool_lock);
+
+  fn (arg, 0, n);
+
+  pthread_mutex_lock (&pool_lock);
+  while (pool_pending > 0)
+    pthread_cond_wait (&pool_done, &pool_lock);
+  pthread_mutex_unlock (&pool_lock);
+
+  pthread_mutex_unlock (&pool_region);
+
+  return 0;
+}
+
+void
+gsl_blas_set_num_threads (const size_t n)
+{
+  pthread_once (&thread_once, thread_init);
+  thread_num = (n > 0) ? (int) GSL_MIN (n, CBLAS_THREAD_MAX) : 1;
+}
+
+size_t
+gsl_blas_get_num_threads (void)
+{
+  pthread_once (&thread_once, thread_init);
+  return (size_t) thread_num;
+}
+
+#else /* !HAVE_PTHREAD */
+
+int
+gslcblas_thread_run (const int nthreads, gslcblas_thread_fn fn, void *arg)
+{
+  return -1;
+}
+
+void
+gsl_blas_set_num_threads (const size_t n)
+{
+  /* no thread support: the library always runs serially */
+}
+
+size_t
+gsl_blas_get_num_threads (void)
+{
+  return 1;
+}
+
+#endif /* HAVE_PTHREAD */
+
+int
+gslcblas_thread_num (const double flops)
+{
+  const int nmax = (int) gsl_blas_get_num_threads ();
+  double n;
+
+  if (nmax < 2)
+    return 1;
+
+  n = flops / CBLAS_THREAD_MIN_FLOPS;
+
+  return (n < nmax) ? GSL_MAX ((int) n, 1) : nmax;
+}
+
+void
+gslcblas_thread_range (const int n, const int nparts, const int part,
+                       int *lo, int *hi)
+{
+  /* chunk boundaries are kept at multiples of 8 elements, which lines
+   * them up with the register blocks of the Level 3 kernels */
+  const int chunk = ((n + nparts - 1) / nparts + 7) / 8 * 8;
+
+  *lo = GSL_MIN (n, part * chunk);
+  *hi = GSL_MIN (n, *lo + chunk);
+}
+
+void
+gslcblas_thread_grid (const int nthreads, const int n1, const int n2,
+                      int *p1, int *p2)
+{
+  double best = -1.0;
+  int d;
+
+  *p1 = nthreads;
+  *p2 = 1;
+
+  for (d = 1; d <= nthreads; d++)
+    {
+      if (nthreads % d == 0)
+        {
+          /* |log(tile aspect ratio)| for a d-by-(nthreads/d) grid */
+          const double aspect = fabs (log (((double) n1 / d) /
+                                           ((double) n2 / (nthreads / d))));
+
+          if (best < 0.0 || aspect < best)
+            {
+              best = aspect;
+              *p1 = d;
+              *p2 = nthreads / d;
+            }
+        }
+    }
+}
@@ -0,0 +1,122 @@
+/* cblas/thread.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Internal interface to the thread pool used by the Level 3 routines.
+ *
+ * A parallel region runs fn(arg, tid, nthreads) for tid = 0..nthreads-1,
+ * with tid 0 executing on the calling thread. Only one region can be
+ * active at a time; any Level 3 call made while a region is active
+ * (from inside a task, or from an unrelated user thread) runs serially,
+ * so tasks are free to call back into the library on sub-problems.
+ */
+
+#ifndef __CBLAS_THREAD_H__
+#define __CBLAS_THREAD_H__
+
+/* minimum number of multiply-adds given to each thread; smaller
+ * problems run on fewer threads, or serially */
+#define CBLAS_THREAD_MIN_FLOPS 1048576.0
+
+/* upper limit on the number of threads */
+#define CBLAS_THREAD_MAX 1024
+
+typedef void (*gslcblas_thread_fn) (void *arg, const int tid, const int nthreads);
+
+/* number of threads to use for a problem of the given size */
+int gslcblas_thread_num (const double flops);
+
+/* run fn on nthreads threads; returns 0 on success and -1, without
+ * calling fn, if another region is active or threads are unavailable */
+int gslcblas_thread_run (const int nthreads, gslcblas_thread_fn fn, void *arg);
+
+/* split [0,n) into nparts chunks and return chunk part in [*lo,*hi) */
+void gslcblas_thread_range (const int n, const int nparts, const int part,
+                            int *lo, int *hi);
+
+/* factor nthreads = p1 * p2 so that an n1-by-n2 matrix splits into
+ * tiles which are as square as possible */
+void gslcblas_thread_grid (const int nthreads, const int n1, const int n2,
+                           int *p1, int *p2);
+
+/* parallel drivers for the Level 3 routines; these return 0 if the
+ * operation was carried out and -1 if the caller should compute it
+ * serially */
+
+int gslcblas_dgemm_threaded (const enum CBLAS_ORDER Order,
+                             const enum CBLAS_TRANSPOSE TransA,
+                             const enum CBLAS_TRANSPOSE TransB,
+                             const int M, const int N, const int K,
+                             const double alpha, const double *A, const int lda,
+                             const double *B, const int ldb, const double beta,
+                             double *C, const int ldc);
+
+int gslcblas_dsymm_threaded (const enum CBLAS_ORDER Order,
+                             const enum CBLAS_SIDE Side,
+                             const enum CBLAS_UPLO Uplo, const int M, const int N,
+                             const double alpha, const double *A, const int lda,
+                             const double *B, const int ldb, const double beta,
+                             double *C, const int ldc);
+
+int gslcblas_dsyrk_threaded (const enum CBLAS_ORDER Order,
+                             const enum CBLAS_UPLO Uplo,
+                             const enum CBLAS_TRANSPOSE Trans, const int N,
+                             const int K, const double alpha, const double *A,
+                             const int lda, const double beta, double *C,
+                             const int ldc);
+
+int gslcblas_dtrsm_threaded (const enum CBLAS_ORDER Order,
+                             const enum CBLAS_SIDE Side,
+                             const enum CBLAS_UPLO Uplo,
+                             const enum CBLAS_TRANSPOSE TransA,
+                             const enum CBLAS_DIAG Diag, const int M, const int N,
+                             const double alpha, const double *A, const int lda,
+                             double *B, const int ldb);
+
+int gslcblas_sgemm_threaded (const enum CBLAS_ORDER Order,
+                             const enum CBLAS_TRANSPOSE TransA,
+                             const enum CBLAS_TRANSPOSE TransB,
+                             const int M, const int N, const int K,
+                             const float alpha, const float *A, const int lda,
+                             const float *B, const int ldb, const float beta,
+                             float *C, const int ldc);
+
+int gslcblas_ssymm_threaded (const enum CBLAS_ORDER Order,
+                             const enum CBLAS_SIDE Side,
+                             const enum CBLAS_UPLO Uplo, const int M, const int N,
+                             const float alpha, const float *A, const int lda,
+                             const float *B, const int ldb, const float beta,
+                             float *C, const int ldc);
+
+int gslcblas_ssyrk_threaded (const enum CBLAS_ORDER Order,
+                             const enum CBLAS_UPLO Uplo,
+                             const enum CBLAS_TRANSPOSE Trans, const int N,
+                             const int K, const float alpha, const float *A,
+                             const int lda, const float beta, float *C,
+                             const int ldc);
+
+int gslcblas_strsm_threaded (const enum CBLAS_ORDER Order,
+                             const enum CBLAS_SIDE Side,
+                             const enum CBLAS_UPLO Uplo,
+                             const enum CBLAS_TRANSPOSE TransA,
+                             const enum CBLAS_DIAG Diag, const int M, const int N,
+                             const float alpha, const float *A, const int lda,
+                             float *B, const int ldb);
+
+#endif /* __CBLAS_THREAD_H__ */
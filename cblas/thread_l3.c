@@ -0,0 +1,39 @@
+/* cblas/thread_l3.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_cblas.h>
+#include "cblas.h"
+#include "thread.h"
+
+#define BASE double
+#define FUNCTION(x) cblas_d ## x
+#define INTERNAL(x) gslcblas_d ## x
+#include "source_thread_l3_r.h"
+#undef BASE
+#undef FUNCTION
+#undef INTERNAL
+
+#define BASE float
+#define FUNCTION(x) cblas_s ## x
+#define INTERNAL(x) gslcblas_s ## x
+#include "source_thread_l3_r.h"
+#undef BASE
+#undef FUNCTION
+#undef INTERNAL
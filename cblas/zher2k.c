@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_blocked.h"
 
 void
 cblas_zher2k (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -10,6 +11,8 @@ cblas_zher2k (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
               const int ldb, const double beta, void *C, const int ldc)
 {
 #define BASE double
+#define HER2K_BLOCKED gslcblas_zher2k_blocked
 #include "source_her2k.h"
+#undef HER2K_BLOCKED
 #undef BASE
 }
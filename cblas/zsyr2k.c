@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_blocked.h"
 
 void
 cblas_zsyr2k (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -10,6 +11,8 @@ cblas_zsyr2k (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
               const int ldb, const void *beta, void *C, const int ldc)
 {
 #define BASE double
+#define SYR2K_BLOCKED gslcblas_zsyr2k_blocked
 #include "source_syr2k_c.h"
+#undef SYR2K_BLOCKED
 #undef BASE
 }
@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_blocked.h"
 
 void
 cblas_zsyrk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -10,6 +11,8 @@ cblas_zsyrk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
              const void *beta, void *C, const int ldc)
 {
 #define BASE double
+#define SYRK_BLOCKED gslcblas_zsyrk_blocked
 #include "source_syrk_c.h"
+#undef SYRK_BLOCKED
 #undef BASE
 }
@@ -38,12 +38,47 @@
  *
  * See Golub & Van Loan, "Matrix Computations" (3rd ed),
  * algorithm 7.5.2
+ *
+ * Large matrices are reduced with a small-bulge multishift QR
+ * algorithm with aggressive early deflation (see the end of this
+ * file), which falls back to the double shift algorithm once the
+ * active block becomes small.
  */
 
 /* exceptional shift coefficients - these values are from LAPACK DLAHQR */
 #define GSL_FRANCIS_COEFF1        (0.75)
 #define GSL_FRANCIS_COEFF2        (-0.4375)
 
+/* active blocks of at least this size use the multishift algorithm */
+#define FRANCIS_MS_NMIN           75
+
+/* use exceptional shifts after this many sweeps without deflation */
+#define FRANCIS_MS_KEXSH          6
+
+/*
+ * skip the multishift QR sweep if aggressive early deflation found
+ * more than this percentage of the deflation window to be converged
+ */
+#define FRANCIS_MS_NIBBLE         14
+
+typedef struct
+{
+  size_t nsmax;              /* maximum number of shifts */
+  size_t nwmax;              /* maximum size of deflation window */
+  gsl_matrix *T;             /* Schur form of deflation window */
+  gsl_matrix *V;             /* Schur vectors of deflation window */
+  gsl_matrix *U;             /* accumulated reflections of a sweep */
+  gsl_matrix *WV;            /* workspace, N-by-(3 nsmax + 4) */
+  gsl_matrix *WH;            /* workspace, (3 nsmax + 4)-by-N */
+  gsl_vector *tau;           /* Householder coefficients, nwmax */
+  gsl_vector *work;          /* spike vector, nwmax */
+  gsl_vector_complex *ev;    /* eigenvalues of deflation window, nwmax */
+  gsl_vector_complex *shift; /* shifts, nsmax */
+  gsl_eigen_francis_workspace *fw; /* solver for deflation window */
+} francis_ms_workspace;
+
+static void francis_solve(gsl_matrix * H, gsl_vector_complex * eval,
+                          gsl_eigen_francis_workspace * w);
 static inline void francis_schur_decomp(gsl_matrix * H,
                                         gsl_vector_complex * eval,
                                         gsl_eigen_francis_workspace * w);
@@ -56,6 +91,11 @@ static inline void francis_schur_standardize(gsl_matrix *A,
                                              gsl_eigen_francis_workspace *w);
 static inline size_t francis_get_submatrix(gsl_matrix *A, gsl_matrix *B);
 static void francis_standard_form(gsl_matrix *A, double *cs, double *sn);
+static francis_ms_workspace *francis_ms_alloc(const size_t N);
+static void francis_ms_free(francis_ms_workspace * ws);
+static void francis_multishift(gsl_matrix * H, gsl_vector_complex * eval,
+                               gsl_eigen_francis_workspace * w,
+                               francis_ms_workspace * ws);
 
 /*
 gsl_eigen_francis_alloc()
@@ -164,45 +204,8 @@ gsl_eigen_francis (gsl_matrix * H, gsl_vector_complex * eval,
   else
     {
       const size_t N = H->size1;
-      int j;
-
-      /*
-       * Set internal parameters which depend on matrix size.
-       * The Francis solver can be called with any size matrix
-       * since the workspace does not depend on N.
-       * Furthermore, multishift solvers which call the Francis
-       * solver may need to call it with different sized matrices
-       */
-      w->size = N;
-      w->max_iterations = 30 * N;
-
-      /*
-       * save a pointer to original matrix since francis_schur_decomp
-       * is recursive
-       */
-      w->H = H;
-
-      w->n_iter = 0;
-      w->n_evals = 0;
-
-      /*
-       * zero out the first two subdiagonals (below the main subdiagonal)
-       * needed as scratch space by the QR sweep routine
-       */
-      for (j = 0; j < (int) N - 3; ++j)
-        {
-          gsl_matrix_set(H, (size_t) j + 2, (size_t) j, 0.0);
-          gsl_matrix_set(H, (size_t) j + 3, (size_t) j, 0.0);
-        }
 
-      if (N > 2)
-        gsl_matrix_set(H, N - 1, N - 3, 0.0);
-
-      /*
-       * compute Schur decomposition of H and store eigenvalues
-       * into eval
-       */
-      francis_schur_decomp(H, eval, w);
+      francis_solve(H, eval, w);
 
       if (w->n_evals != N)
         {
@@ -276,6 +279,81 @@ gsl_eigen_francis_Z (gsl_matrix * H, gsl_vector_complex * eval,
  *           INTERNAL ROUTINES              *
  ********************************************/
 
+/*
+francis_solve()
+  Compute the eigenvalues, and optionally the Schur form, of the
+Hessenberg matrix H. The number of eigenvalues found is stored in
+w->n_evals
+
+Inputs: H     - upper hessenberg matrix
+        eval  - where to store eigenvalues
+        w     - workspace
+
+Return: none
+*/
+
+static void
+francis_solve(gsl_matrix * H, gsl_vector_complex * eval,
+              gsl_eigen_francis_workspace * w)
+{
+  const size_t N = H->size1;
+  int j;
+
+  /*
+   * Set internal parameters which depend on matrix size.
+   * The Francis solver can be called with any size matrix
+   * since the workspace does not depend on N.
+   * Furthermore, multishift solvers which call the Francis
+   * solver may need to call it with different sized matrices
+   */
+  w->size = N;
+  w->max_iterations = 30 * N;
+
+  /*
+   * save a pointer to original matrix since francis_schur_decomp
+   * is recursive
+   */
+  w->H = H;
+
+  w->n_iter = 0;
+  w->n_evals = 0;
+
+  /*
+   * zero out the first two subdiagonals (below the main subdiagonal)
+   * needed as scratch space by the QR sweep routine
+   */
+  for (j = 0; j < (int) N - 3; ++j)
+    {
+      gsl_matrix_set(H, (size_t) j + 2, (size_t) j, 0.0);
+      gsl_matrix_set(H, (size_t) j + 3, (size_t) j, 0.0);
+    }
+
+  if (N > 2)
+    gsl_matrix_set(H, N - 1, N - 3, 0.0);
+
+  if (N >= FRANCIS_MS_NMIN)
+    {
+      /*
+       * the multishift workspace depends on N, so it is allocated
+       * here; if that fails use the double shift algorithm
+       */
+      francis_ms_workspace *ws = francis_ms_alloc(N);
+
+      if (ws != NULL)
+        {
+          francis_multishift(H, eval, w, ws);
+          francis_ms_free(ws);
+          return;
+        }
+    }
+
+  /*
+   * compute Schur decomposition of H and store eigenvalues
+   * into eval
+   */
+  francis_schur_decomp(H, eval, w);
+} /* francis_solve() */
+
 /*
 francis_schur_decomp()
   Compute the Schur decomposition of the matrix H
@@ -1046,3 +1124,1182 @@ francis_standard_form(gsl_matrix *A, double *cs, double *sn)
   gsl_matrix_set(A, 1, 0, c);
   gsl_matrix_set(A, 1, 1, d);
 } /* francis_standard_form() */
+
+/********************************************
+ *           MULTISHIFT QR                  *
+ ********************************************/
+
+/*
+ * The small-bulge multishift QR algorithm with aggressive early
+ * deflation. See
+ *
+ * K. Braman, R. Byers and R. Mathias, "The Multishift QR Algorithm.
+ * Part I: Maintaining Well-Focused Shifts and Level 3 Performance",
+ * SIAM J. Matrix Anal. Appl. 23(4), 929-947, 2002
+ *
+ * K. Braman, R. Byers and R. Mathias, "The Multishift QR Algorithm.
+ * Part II: Aggressive Early Deflation", SIAM J. Matrix Anal. Appl.
+ * 23(4), 948-973, 2002
+ *
+ * and LAPACK routines DLAQR0, DLAQR3 and DLAQR5.
+ *
+ * Each iteration first computes the Schur form of a trailing
+ * deflation window of the active block. Eigenvalues of the window
+ * whose component in the spike (the column of H coupling the window to
+ * the rest of the block) is negligible are deflated, and the remaining
+ * eigenvalues are used as shifts for a sweep which chases a chain of
+ * closely packed 3-by-3 bulges down the diagonal. The reflections of
+ * a group of consecutive chasing steps are applied only to a small
+ * window along the diagonal and accumulated, so that the rest of H and
+ * Z can be updated with matrix-matrix products.
+ */
+
+/* number of shifts for an active block of size n (LAPACK IPARMQ) */
+static size_t
+francis_ms_nshifts(const size_t n)
+{
+  size_t ns;
+
+  if (n < 30)
+    ns = 2;
+  else if (n < 60)
+    ns = 4;
+  else if (n < 150)
+    ns = 10;
+  else if (n < 590)
+    ns = GSL_MAX(10, n / (size_t) floor(log((double) n) / M_LN2 + 0.5));
+  else if (n < 3000)
+    ns = 64;
+  else if (n < 6000)
+    ns = 128;
+  else
+    ns = 256;
+
+  return ns - ns % 2;
+}
+
+/* deflation window size for an active block of size n */
+static size_t
+francis_ms_nwindow(const size_t n)
+{
+  const size_t ns = francis_ms_nshifts(n);
+
+  return (n <= 500) ? ns : 3 * ns / 2;
+}
+
+static francis_ms_workspace *
+francis_ms_alloc(const size_t N)
+{
+  francis_ms_workspace *ws;
+  size_t ldu;
+
+  ws = calloc(1, sizeof(francis_ms_workspace));
+  if (ws == NULL)
+    return NULL;
+
+  ws->nsmax = GSL_MIN(francis_ms_nshifts(N), GSL_MAX(2, (N + 6) / 9));
+  ws->nsmax -= ws->nsmax % 2;
+  ws->nwmax = GSL_MIN(francis_ms_nwindow(N), (N - 1) / 3);
+  ws->nwmax = GSL_MAX(ws->nwmax, ws->nsmax);
+
+  /* the window of a group of chasing steps is at most 3 nsmax + 1 */
+  ldu = 3 * ws->nsmax + 4;
+
+  ws->T = gsl_matrix_alloc(ws->nwmax, ws->nwmax);
+  ws->V = gsl_matrix_alloc(ws->nwmax, ws->nwmax);
+  ws->U = gsl_matrix_alloc(ldu, ldu);
+  ws->WV = gsl_matrix_alloc(N, ldu);
+  ws->WH = gsl_matrix_alloc(ldu, N);
+  ws->tau = gsl_vector_alloc(ws->nwmax);
+  ws->work = gsl_vector_alloc(ws->nwmax);
+  ws->ev = gsl_vector_complex_alloc(ws->nwmax);
+  ws->shift = gsl_vector_complex_alloc(ws->nsmax);
+  ws->fw = gsl_eigen_francis_alloc();
+
+  if (ws->T == NULL || ws->V == NULL || ws->U == NULL || ws->WV == NULL ||
+      ws->WH == NULL || ws->tau == NULL || ws->work == NULL ||
+      ws->ev == NULL || ws->shift == NULL || ws->fw == NULL)
+    {
+      francis_ms_free(ws);
+      return NULL;
+    }
+
+  return ws;
+}
+
+static void
+francis_ms_free(francis_ms_workspace * ws)
+{
+  if (ws->T)
+    gsl_matrix_free(ws->T);
+
+  if (ws->V)
+    gsl_matrix_free(ws->V);
+
+  if (ws->U)
+    gsl_matrix_free(ws->U);
+
+  if (ws->WV)
+    gsl_matrix_free(ws->WV);
+
+  if (ws->WH)
+    gsl_matrix_free(ws->WH);
+
+  if (ws->tau)
+    gsl_vector_free(ws->tau);
+
+  if (ws->work)
+    gsl_vector_free(ws->work);
+
+  if (ws->ev)
+    gsl_vector_complex_free(ws->ev);
+
+  if (ws->shift)
+    gsl_vector_complex_free(ws->shift);
+
+  if (ws->fw)
+    gsl_eigen_francis_free(ws->fw);
+
+  free(ws);
+}
+
+/*
+francis_ms_sylvester()
+  Solve the small Sylvester equation
+
+T11 X - X T22 = T12
+
+where D = [ T11 T12 ; 0 T22 ] is stored row-wise with a row stride
+of 4, T11 is n1-by-n1 and T22 is n2-by-n2 (n1, n2 = 1 or 2). The
+equation is written as a linear system of order n1*n2 which is solved
+by Gaussian elimination with complete pivoting; tiny pivots are
+perturbed as in LAPACK DLASY2.
+
+Inputs: d  - matrix D
+        n1 - size of T11
+        n2 - size of T22
+        x  - (output) X, stored row-wise with a row stride of n2
+*/
+
+static void
+francis_ms_sylvester(const double d[16], const size_t n1, const size_t n2,
+                     double x[4])
+{
+  const size_t n = n1 * n2;
+  double a[4][4], b[4];
+  size_t jpiv[4];
+  double amax = 0.0, smin;
+  size_t i, j, k, l;
+
+  for (i = 0; i < n; ++i)
+    {
+      for (j = 0; j < n; ++j)
+        a[i][j] = 0.0;
+
+      jpiv[i] = i;
+    }
+
+  /* row i * n2 + l of the system is the equation for X(i,l) */
+  for (i = 0; i < n1; ++i)
+    {
+      for (l = 0; l < n2; ++l)
+        {
+          const size_t e = i * n2 + l;
+
+          for (k = 0; k < n1; ++k)
+            a[e][k * n2 + l] += d[4 * i + k];
+
+          for (k = 0; k < n2; ++k)
+            a[e][i * n2 + k] -= d[4 * (n1 + k) + n1 + l];
+
+          b[e] = d[4 * i + n1 + l];
+        }
+    }
+
+  for (i = 0; i < n; ++i)
+    for (j = 0; j < n; ++j)
+      amax = GSL_MAX(amax, fabs(a[i][j]));
+
+  smin = GSL_MAX(GSL_DBL_EPSILON * amax, GSL_DBL_MIN);
+
+  for (k = 0; k < n; ++k)
+    {
+      size_t ip = k, jp = k;
+      double piv = 0.0;
+
+      /* find pivot in the trailing submatrix */
+      for (i = k; i < n; ++i)
+        {
+          for (j = k; j < n; ++j)
+            {
+              if (fabs(a[i][j]) > piv)
+                {
+                  piv = fabs(a[i][j]);
+                  ip = i;
+                  jp = j;
+                }
+            }
+        }
+
+      if (ip != k)
+        {
+          for (j = 0; j < n; ++j)
+            {
+              double tmp = a[k][j];
+              a[k][j] = a[ip][j];
+              a[ip][j] = tmp;
+            }
+
+          {
+            double tmp = b[k];
+            b[k] = b[ip];
+            b[ip] = tmp;
+          }
+        }
+
+      if (jp != k)
+        {
+          size_t tmp = jpiv[k];
+
+          for (i = 0; i < n; ++i)
+            {
+              double t = a[i][k];
+              a[i][k] = a[i][jp];
+              a[i][jp] = t;
+            }
+
+          jpiv[k] = jpiv[jp];
+          jpiv[jp] = tmp;
+        }
+
+      if (fabs(a[k][k]) < smin)
+        a[k][k] = smin;
+
+      for (i = k + 1; i < n; ++i)
+        {
+          const double mult = a[i][k] / a[k][k];
+
+          for (j = k + 1; j < n; ++j)
+            a[i][j] -= mult * a[k][j];
+
+          b[i] -= mult * b[k];
+        }
+    }
+
+  /* back substitution */
+  for (k = n; k-- > 0; )
+    {
+      double sum = b[k];
+
+      for (j = k + 1; j < n; ++j)
+        sum -= a[k][j] * b[j];
+
+      b[k] = sum / a[k][k];
+    }
+
+  for (k = 0; k < n; ++k)
+    x[jpiv[k]] = b[k];
+}
+
+/*
+francis_ms_swap()
+  Swap the adjacent diagonal blocks T11 (n1-by-n1) and T22 (n2-by-n2)
+of the matrix T = w->H in real Schur form, where T11 starts at row j,
+with an orthogonal similarity transformation which is accumulated into
+the Schur vectors w->Z
+
+Inputs: w  - francis workspace of a solved window
+        j  - first row of T11
+        n1 - size of T11 (1 or 2)
+        n2 - size of T22 (1 or 2)
+
+Return: 1 on success, 0 if the swap was rejected because it would
+        perturb T too much
+
+Notes: based on LAPACK routine DLAEXC
+*/
+
+static int
+francis_ms_swap(gsl_eigen_francis_workspace * w, const size_t j,
+                const size_t n1, const size_t n2)
+{
+  gsl_matrix *T = w->H;
+  gsl_matrix *V = w->Z;
+  const size_t N = w->size;
+  gsl_vector_view xv, yv;
+
+  if (n1 == 1 && n2 == 1)
+    {
+      /* swap two 1-by-1 blocks with a Givens rotation */
+      const double t11 = gsl_matrix_get(T, j, j);
+      const double t22 = gsl_matrix_get(T, j + 1, j + 1);
+      const double f = gsl_matrix_get(T, j, j + 1);
+      const double r = gsl_hypot(f, t22 - t11);
+      double cs, sn;
+
+      if (r == 0.0)
+        return 1;
+
+      cs = f / r;
+      sn = (t22 - t11) / r;
+
+      if (j + 2 < N)
+        {
+          xv = gsl_matrix_subrow(T, j, j + 2, N - j - 2);
+          yv = gsl_matrix_subrow(T, j + 1, j + 2, N - j - 2);
+          gsl_blas_drot(&xv.vector, &yv.vector, cs, sn);
+        }
+
+      if (j > 0)
+        {
+          xv = gsl_matrix_subcolumn(T, j, 0, j);
+          yv = gsl_matrix_subcolumn(T, j + 1, 0, j);
+          gsl_blas_drot(&xv.vector, &yv.vector, cs, sn);
+        }
+
+      gsl_matrix_set(T, j, j, t22);
+      gsl_matrix_set(T, j + 1, j + 1, t11);
+
+      xv = gsl_matrix_column(V, j);
+      yv = gsl_matrix_column(V, j + 1);
+      gsl_blas_drot(&xv.vector, &yv.vector, cs, sn);
+
+      return 1;
+    }
+  else
+    {
+      const size_t nd = n1 + n2;
+      double d[16], x[4], a[4][2], q[16], dq[16], tmp[4];
+      double dnorm = 0.0, thresh;
+      size_t i, k, l;
+
+      for (i = 0; i < nd; ++i)
+        {
+          for (k = 0; k < nd; ++k)
+            {
+              d[4 * i + k] = gsl_matrix_get(T, j + i, j + k);
+              dnorm = GSL_MAX(dnorm, fabs(d[4 * i + k]));
+            }
+        }
+
+      thresh = GSL_MAX(10.0 * GSL_DBL_EPSILON * dnorm,
+                       GSL_DBL_MIN / GSL_DBL_EPSILON);
+
+      /*
+       * The columns of [ -X ; I ], where T11 X - X T22 = T12, span the
+       * invariant subspace belonging to T22; the first n2 columns of
+       * the orthogonal factor Q of their QR decomposition bring T22 to
+       * the top left of Q^T D Q
+       */
+      francis_ms_sylvester(d, n1, n2, x);
+
+      for (i = 0; i < nd; ++i)
+        {
+          for (l = 0; l < n2; ++l)
+            {
+              if (i < n1)
+                a[i][l] = -x[i * n2 + l];
+              else
+                a[i][l] = (i - n1 == l) ? 1.0 : 0.0;
+            }
+        }
+
+      for (i = 0; i < nd; ++i)
+        for (k = 0; k < nd; ++k)
+          q[4 * i + k] = (i == k) ? 1.0 : 0.0;
+
+      for (l = 0; l < n2; ++l)
+        {
+          gsl_vector_view hv = gsl_vector_view_array(tmp, nd - l);
+          double tau;
+          size_t c, r;
+
+          for (i = l; i < nd; ++i)
+            tmp[i - l] = a[i][l];
+
+          tau = gsl_linalg_householder_transform(&hv.vector);
+          tmp[0] = 1.0;
+
+          /* apply (I - tau v v^T) to the remaining columns of a */
+          for (c = l + 1; c < n2; ++c)
+            {
+              double s = 0.0;
+
+              for (i = l; i < nd; ++i)
+                s += tmp[i - l] * a[i][c];
+
+              for (i = l; i < nd; ++i)
+                a[i][c] -= tau * s * tmp[i - l];
+            }
+
+          /* Q = Q (I - tau v v^T) */
+          for (r = 0; r < nd; ++r)
+            {
+              double s = 0.0;
+
+              for (i = l; i < nd; ++i)
+                s += q[4 * r + i] * tmp[i - l];
+
+              for (i = l; i < nd; ++i)
+                q[4 * r + i] -= tau * s * tmp[i - l];
+            }
+        }
+
+      /* dq = Q^T D Q */
+      for (i = 0; i < nd; ++i)
+        {
+          for (k = 0; k < nd; ++k)
+            {
+              double s = 0.0;
+
+              for (l = 0; l < nd; ++l)
+                s += d[4 * i + l] * q[4 * l + k];
+
+              dq[4 * i + k] = s;
+            }
+        }
+
+      for (k = 0; k < nd; ++k)
+        {
+          for (i = 0; i < nd; ++i)
+            {
+              double s = 0.0;
+
+              for (l = 0; l < nd; ++l)
+                s += q[4 * l + i] * dq[4 * l + k];
+
+              tmp[i] = s;
+            }
+
+          for (i = 0; i < nd; ++i)
+            dq[4 * i + k] = tmp[i];
+        }
+
+      /* reject the swap if the blocks did not decouple */
+      for (i = n2; i < nd; ++i)
+        {
+          for (k = 0; k < n2; ++k)
+            {
+              if (fabs(dq[4 * i + k]) > thresh)
+                return 0;
+
+              dq[4 * i + k] = 0.0;
+            }
+        }
+
+      for (i = 0; i < nd; ++i)
+        for (k = 0; k < nd; ++k)
+          gsl_matrix_set(T, j + i, j + k, dq[4 * i + k]);
+
+      /* apply Q to the rest of T and to V */
+
+      for (k = j + nd; k < N; ++k)
+        {
+          for (i = 0; i < nd; ++i)
+            {
+              double s = 0.0;
+
+              for (l = 0; l < nd; ++l)
+                s += q[4 * l + i] * gsl_matrix_get(T, j + l, k);
+
+              tmp[i] = s;
+            }
+
+          for (i = 0; i < nd; ++i)
+            gsl_matrix_set(T, j + i, k, tmp[i]);
+        }
+
+      for (k = 0; k < j + N; ++k)
+        {
+          /* rows 0..j-1 of T, then all rows of V */
+          gsl_matrix *M = (k < j) ? T : V;
+          const size_t r = (k < j) ? k : k - j;
+
+          for (i = 0; i < nd; ++i)
+            {
+              double s = 0.0;
+
+              for (l = 0; l < nd; ++l)
+                s += gsl_matrix_get(M, r, j + l) * q[4 * l + i];
+
+              tmp[i] = s;
+            }
+
+          for (i = 0; i < nd; ++i)
+            gsl_matrix_set(M, r, j + i, tmp[i]);
+        }
+
+      /* restore the standard form of the 2-by-2 blocks */
+
+      if (n2 == 2)
+        {
+          gsl_matrix_view m = gsl_matrix_submatrix(T, j, j, 2, 2);
+          gsl_complex e1, e2;
+
+          francis_schur_standardize(&m.matrix, &e1, &e2, w);
+        }
+
+      if (n1 == 2)
+        {
+          gsl_matrix_view m = gsl_matrix_submatrix(T, j + n2, j + n2, 2, 2);
+          gsl_complex e1, e2;
+
+          francis_schur_standardize(&m.matrix, &e1, &e2, w);
+        }
+
+      return 1;
+    }
+}
+
+/*
+francis_ms_move_block()
+  Move the diagonal block of size nbf starting at row ifst of the
+matrix w->H in real Schur form up to row ilst by swapping adjacent
+blocks. ilst must be the first row of a block.
+
+Return: size of the block at row ilst, or 0 if a swap was rejected
+        or the block split into two real eigenvalues
+*/
+
+static size_t
+francis_ms_move_block(gsl_eigen_francis_workspace * w, const size_t ifst,
+                      const size_t ilst, const size_t nbf)
+{
+  gsl_matrix *T = w->H;
+  size_t here = ifst;
+
+  while (here > ilst)
+    {
+      size_t nbnext = 1;
+
+      if (here >= ilst + 2 && gsl_matrix_get(T, here - 1, here - 2) != 0.0)
+        nbnext = 2;
+
+      if (!francis_ms_swap(w, here - nbnext, nbnext, nbf))
+        return 0;
+
+      here -= nbnext;
+
+      if (nbf == 2 && gsl_matrix_get(T, here + 1, here) == 0.0)
+        return 0;
+    }
+
+  return nbf;
+}
+
+/*
+francis_ms_aed()
+  Aggressive early deflation on the trailing jw-by-jw window of the
+active block H(ktop:kend-1,ktop:kend-1)
+
+Inputs: H    - hessenberg matrix
+        ktop - first row of active block
+        kend - one past the last row of active block
+        jw   - size of deflation window
+        eval - where to store deflated eigenvalues
+        nsh  - (output) number of undeflated eigenvalues of the window,
+               which are stored in ws->ev in the order in which they
+               appear on the diagonal
+        w    - francis workspace
+        ws   - multishift workspace
+
+Return: number of deflated eigenvalues
+
+Notes: based on LAPACK routine DLAQR3
+*/
+
+static size_t
+francis_ms_aed(gsl_matrix * H, const size_t ktop, const size_t kend,
+               const size_t jw, gsl_vector_complex * eval, size_t * nsh,
+               gsl_eigen_francis_workspace * w, francis_ms_workspace * ws)
+{
+  const size_t N = H->size1;
+  const size_t kwtop = kend - jw;
+  const size_t ltop = w->compute_t ? 0 : ktop;
+  const double smlnum = GSL_DBL_MIN * ((double) jw / GSL_DBL_EPSILON);
+  gsl_matrix_view T = gsl_matrix_submatrix(ws->T, 0, 0, jw, jw);
+  gsl_matrix_view V = gsl_matrix_submatrix(ws->V, 0, 0, jw, jw);
+  gsl_matrix_view Hw = gsl_matrix_submatrix(H, kwtop, kwtop, jw, jw);
+  gsl_vector_complex_view ev = gsl_vector_complex_subvector(ws->ev, 0, jw);
+  double s = (kwtop > ktop) ? gsl_matrix_get(H, kwtop, kwtop - 1) : 0.0;
+  size_t ns, ilst, i, j;
+
+  *nsh = 0;
+
+  /* Schur factorization of the window, T = V^T H_w V */
+
+  for (i = 0; i < jw; ++i)
+    {
+      for (j = 0; j < jw; ++j)
+        {
+          double hij = (i <= j + 1) ? gsl_matrix_get(&Hw.matrix, i, j) : 0.0;
+          gsl_matrix_set(&T.matrix, i, j, hij);
+        }
+    }
+
+  gsl_matrix_set_identity(&V.matrix);
+
+  ws->fw->compute_t = 1;
+  ws->fw->Z = &V.matrix;
+  francis_solve(&T.matrix, &ev.vector, ws->fw);
+
+  if (ws->fw->n_evals != jw)
+    {
+      ws->fw->Z = NULL;
+      return 0;
+    }
+
+  /* remove the scratch elements of the QR sweeps below the subdiagonal */
+  for (j = 0; j + 2 < jw; ++j)
+    for (i = j + 2; i < jw; ++i)
+      gsl_matrix_set(&T.matrix, i, j, 0.0);
+
+  /*
+   * Starting from the bottom, test each diagonal block for
+   * deflation. A block is deflated if the corresponding part of the
+   * spike s V(0,:) is negligible; otherwise it is moved to the top of
+   * the window and the undeflated part grows by one block
+   */
+
+  ns = jw;
+  ilst = 0;
+
+  while (ilst < ns)
+    {
+      const size_t nbf =
+        (ns > 1 && gsl_matrix_get(&T.matrix, ns - 1, ns - 2) != 0.0) ? 2 : 1;
+      double foo = fabs(gsl_matrix_get(&T.matrix, ns - 1, ns - 1));
+      double spike = fabs(s * gsl_matrix_get(&V.matrix, 0, ns - 1));
+
+      if (nbf == 2)
+        {
+          foo += sqrt(fabs(gsl_matrix_get(&T.matrix, ns - 1, ns - 2))) *
+                 sqrt(fabs(gsl_matrix_get(&T.matrix, ns - 2, ns - 1)));
+          spike = GSL_MAX(spike,
+                          fabs(s * gsl_matrix_get(&V.matrix, 0, ns - 2)));
+        }
+
+      if (foo == 0.0)
+        foo = fabs(s);
+
+      if (spike <= GSL_MAX(smlnum, GSL_DBL_EPSILON * foo))
+        {
+          /* deflatable */
+          ns -= nbf;
+        }
+      else
+        {
+          /* undeflatable - move it up out of the way */
+          size_t nb = francis_ms_move_block(ws->fw, ns - nbf, ilst, nbf);
+
+          if (nb == 0)
+            break;
+
+          ilst += nb;
+        }
+    }
+
+  ws->fw->Z = NULL;
+
+  if (ns == 0)
+    s = 0.0;
+
+  /* eigenvalues of the window, in order of the diagonal */
+
+  for (i = 0; i < jw; )
+    {
+      const double tii = gsl_matrix_get(&T.matrix, i, i);
+      gsl_complex z;
+
+      if (i + 1 < jw && gsl_matrix_get(&T.matrix, i + 1, i) != 0.0)
+        {
+          double im = sqrt(fabs(gsl_matrix_get(&T.matrix, i, i + 1))) *
+                      sqrt(fabs(gsl_matrix_get(&T.matrix, i + 1, i)));
+
+          GSL_SET_COMPLEX(&z, tii, im);
+          gsl_vector_complex_set(ws->ev, i, z);
+          GSL_SET_COMPLEX(&z, tii, -im);
+          gsl_vector_complex_set(ws->ev, i + 1, z);
+          i += 2;
+        }
+      else
+        {
+          GSL_SET_COMPLEX(&z, tii, 0.0);
+          gsl_vector_complex_set(ws->ev, i, z);
+          i += 1;
+        }
+    }
+
+  *nsh = ns;
+
+  if (ns == jw)
+    return 0; /* nothing deflated, leave H unchanged */
+
+  for (i = ns; i < jw; ++i)
+    {
+      gsl_vector_complex_set(eval, w->n_evals, gsl_vector_complex_get(ws->ev, i));
+      w->n_evals += 1;
+    }
+
+  if (ns > 1 && s != 0.0)
+    {
+      /*
+       * reflect the spike back into a multiple of e_1 and restore
+       * the Hessenberg form of the undeflated part of the window
+       */
+      gsl_vector_view sv = gsl_vector_subvector(ws->work, 0, ns);
+      gsl_vector_view tv = gsl_vector_subvector(ws->tau, 0, ns);
+      gsl_matrix_view Tn = gsl_matrix_submatrix(&T.matrix, 0, 0, ns, ns);
+      gsl_matrix_view Tr = gsl_matrix_submatrix(&T.matrix, 0, 0, ns, jw);
+      gsl_matrix_view Vn = gsl_matrix_submatrix(&V.matrix, 0, 0, jw, ns);
+      double tau;
+
+      for (i = 0; i < ns; ++i)
+        gsl_vector_set(&sv.vector, i, gsl_matrix_get(&V.matrix, 0, i));
+
+      tau = gsl_linalg_householder_transform(&sv.vector);
+      gsl_linalg_householder_hm(tau, &sv.vector, &Tr.matrix);
+      gsl_linalg_householder_mh(tau, &sv.vector, &Tn.matrix);
+      gsl_linalg_householder_mh(tau, &sv.vector, &Vn.matrix);
+
+      if (ns > 2)
+        {
+          gsl_linalg_hessenberg_submatrix(&T.matrix, &Tn.matrix, 0, &tv.vector);
+          gsl_linalg_hessenberg_unpack_accum(&Tn.matrix, &tv.vector, &Vn.matrix);
+          gsl_linalg_hessenberg_set_zero(&Tn.matrix);
+        }
+    }
+
+  /* copy the window back into H and apply V to the rest of H and Z */
+
+  gsl_matrix_memcpy(&Hw.matrix, &T.matrix);
+
+  if (kwtop > ktop)
+    gsl_matrix_set(H, kwtop, kwtop - 1, s * gsl_matrix_get(&V.matrix, 0, 0));
+
+  if (ltop < kwtop)
+    {
+      gsl_matrix_view Hc = gsl_matrix_submatrix(H, ltop, kwtop, kwtop - ltop, jw);
+      gsl_matrix_view Wc = gsl_matrix_submatrix(ws->WV, 0, 0, kwtop - ltop, jw);
+
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &Hc.matrix, &V.matrix,
+                     0.0, &Wc.matrix);
+      gsl_matrix_memcpy(&Hc.matrix, &Wc.matrix);
+    }
+
+  if (w->compute_t && kend < N)
+    {
+      gsl_matrix_view Hr = gsl_matrix_submatrix(H, kwtop, kend, jw, N - kend);
+      gsl_matrix_view Wr = gsl_matrix_submatrix(ws->WH, 0, 0, jw, N - kend);
+
+      gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, &V.matrix, &Hr.matrix,
+                     0.0, &Wr.matrix);
+      gsl_matrix_memcpy(&Hr.matrix, &Wr.matrix);
+    }
+
+  if (w->Z)
+    {
+      gsl_matrix_view Zc = gsl_matrix_submatrix(w->Z, 0, kwtop, N, jw);
+      gsl_matrix_view Wz = gsl_matrix_submatrix(ws->WV, 0, 0, N, jw);
+
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &Zc.matrix, &V.matrix,
+                     0.0, &Wz.matrix);
+      gsl_matrix_memcpy(&Zc.matrix, &Wz.matrix);
+    }
+
+  return jw - ns;
+}
+
+/*
+francis_ms_shifts()
+  Choose the shifts for the next sweep on the active block
+H(ktop:kend-1,ktop:kend-1). The undeflated eigenvalues of the last
+deflation window closest to the bottom are used, keeping complex
+conjugate pairs together and pairing real shifts. If there are too few
+of them, the eigenvalues of the trailing ns-by-ns submatrix are used
+instead. Exceptional shifts are used every FRANCIS_MS_KEXSH sweeps
+without deflation.
+
+Inputs: H    - hessenberg matrix
+        ktop - first row of active block
+        kend - one past the last row of active block
+        ns   - desired number of shifts (even)
+        nsh  - number of undeflated eigenvalues in ws->ev
+        ndfl - number of sweeps since the last deflation
+        ws   - multishift workspace
+
+Return: number of shifts stored in ws->shift (even)
+*/
+
+static size_t
+francis_ms_shifts(const gsl_matrix * H, const size_t ktop, const size_t kend,
+                  const size_t ns, size_t nsh, const size_t ndfl,
+                  francis_ms_workspace * ws)
+{
+  size_t n = 0;
+  size_t i;
+
+  if (ndfl % FRANCIS_MS_KEXSH != 0)
+    {
+      gsl_complex zr;
+      int have_real = 0;
+
+      GSL_SET_COMPLEX(&zr, 0.0, 0.0);
+
+      if (nsh < ns / 2)
+        {
+          gsl_matrix_view Ts = gsl_matrix_submatrix(ws->T, 0, 0, ns, ns);
+          gsl_vector_complex_view ev = gsl_vector_complex_subvector(ws->ev, 0, ns);
+          const size_t k0 = kend - ns;
+          size_t j;
+
+          for (i = 0; i < ns; ++i)
+            {
+              for (j = 0; j < ns; ++j)
+                {
+                  double hij = (i <= j + 1) ? gsl_matrix_get(H, k0 + i, k0 + j) : 0.0;
+                  gsl_matrix_set(&Ts.matrix, i, j, hij);
+                }
+            }
+
+          ws->fw->compute_t = 0;
+          francis_solve(&Ts.matrix, &ev.vector, ws->fw);
+          nsh = (ws->fw->n_evals == ns) ? ns : 0;
+        }
+
+      i = (nsh > ns) ? nsh - ns : 0;
+
+      /* do not split a complex conjugate pair */
+      if (i > 0 && GSL_IMAG(gsl_vector_complex_get(ws->ev, i)) < 0.0)
+        ++i;
+
+      for (; i < nsh; ++i)
+        {
+          gsl_complex z = gsl_vector_complex_get(ws->ev, i);
+
+          if (GSL_IMAG(z) != 0.0)
+            {
+              if (i + 1 < nsh)
+                {
+                  gsl_vector_complex_set(ws->shift, n, z);
+                  gsl_vector_complex_set(ws->shift, n + 1,
+                                         gsl_vector_complex_get(ws->ev, i + 1));
+                  n += 2;
+                }
+
+              ++i;
+            }
+          else if (have_real)
+            {
+              gsl_vector_complex_set(ws->shift, n, zr);
+              gsl_vector_complex_set(ws->shift, n + 1, z);
+              n += 2;
+              have_real = 0;
+            }
+          else
+            {
+              zr = z;
+              have_real = 1;
+            }
+        }
+
+      if (n == 0 && have_real)
+        {
+          /* use a single real shift twice */
+          gsl_vector_complex_set(ws->shift, 0, zr);
+          gsl_vector_complex_set(ws->shift, 1, zr);
+          n = 2;
+        }
+    }
+
+  if (n == 0)
+    {
+      /* exceptional shifts, see LAPACK DLAQR0 */
+      for (i = kend - 1; i >= ktop + 2 && n + 2 <= ns; i -= 2)
+        {
+          const double ss = fabs(gsl_matrix_get(H, i, i - 1)) +
+                            fabs(gsl_matrix_get(H, i - 1, i - 2));
+          const double aa = gsl_matrix_get(H, i, i) + GSL_FRANCIS_COEFF1 * ss;
+          const double im = sqrt(-GSL_FRANCIS_COEFF2) * ss;
+          gsl_complex z;
+
+          GSL_SET_COMPLEX(&z, aa, im);
+          gsl_vector_complex_set(ws->shift, n, z);
+          GSL_SET_COMPLEX(&z, aa, -im);
+          gsl_vector_complex_set(ws->shift, n + 1, z);
+          n += 2;
+        }
+    }
+
+  return n;
+}
+
+/*
+francis_ms_first_column()
+  Compute a multiple of the first column of
+
+(H - s1 I) (H - s2 I)
+
+for the active block starting at row k, where s1 and s2 are either
+both real or a complex conjugate pair (LAPACK DLAQR1)
+*/
+
+static void
+francis_ms_first_column(const gsl_matrix * H, const size_t k,
+                        const gsl_complex s1, const gsl_complex s2,
+                        double v[3])
+{
+  const double h11 = gsl_matrix_get(H, k, k);
+  const double h21 = gsl_matrix_get(H, k + 1, k);
+  const double h12 = gsl_matrix_get(H, k, k + 1);
+  const double h22 = gsl_matrix_get(H, k + 1, k + 1);
+  const double h32 = gsl_matrix_get(H, k + 2, k + 1);
+  const double sr1 = GSL_REAL(s1), si1 = GSL_IMAG(s1);
+  const double sr2 = GSL_REAL(s2), si2 = GSL_IMAG(s2);
+  const double s = fabs(h11 - sr2) + fabs(si2) + fabs(h21);
+
+  if (s == 0.0)
+    {
+      v[0] = v[1] = v[2] = 0.0;
+    }
+  else
+    {
+      const double h21s = h21 / s;
+
+      v[0] = h21s * h12 + (h11 - sr1) * ((h11 - sr2) / s) - si1 * (si2 / s);
+      v[1] = h21s * (h11 + h22 - sr1 - sr2);
+      v[2] = h21s * h32;
+    }
+}
+
+/*
+francis_ms_sweep()
+  Perform a multishift QR sweep on the active block
+H(ktop:kend-1,ktop:kend-1) with the ns shifts in ws->shift, which are
+used in pairs to introduce ns/2 bulges. The bulges are chased down the
+diagonal as a chain with a spacing of 3 rows; this is equivalent to
+ns/2 consecutive double shift sweeps.
+
+The chain is moved by 3 ns/2 rows at a time. The reflections of such
+a group of steps only touch the rows and columns [j0, j1) of the
+current window, so they are applied inside the window and
+accumulated into U; the rest of H and Z are then updated with
+matrix-matrix products.
+
+Notes: based on LAPACK routine DLAQR5
+*/
+
+static void
+francis_ms_sweep(gsl_matrix * H, const size_t ktop, const size_t kend,
+                 const size_t ns, gsl_eigen_francis_workspace * w,
+                 francis_ms_workspace * ws)
+{
+  const size_t N = H->size1;
+  const size_t nb = ns / 2;                      /* number of bulges */
+  const size_t nstep = 3 * nb;                   /* steps per group */
+  const size_t ltop = w->compute_t ? 0 : ktop;   /* first row to update */
+  const size_t lend = w->compute_t ? N : kend;   /* last column to update */
+  const size_t pend = kend - 1 + 3 * (nb - 1);   /* positions of bulge 0 */
+  size_t pc0;
+
+  /*
+   * The reflection of bulge m at position p acts on rows and columns
+   * p, p+1, p+2 (p, p+1 at the bottom of the block); bulge 0 is at
+   * position pc and bulge m at pc - 3m
+   */
+
+  for (pc0 = ktop; pc0 < pend; pc0 += nstep)
+    {
+      const size_t pc1 = GSL_MIN(pc0 + nstep, pend);
+      const size_t pmin = (pc0 >= ktop + 3 * (nb - 1)) ? pc0 - 3 * (nb - 1) : ktop;
+      const size_t pmax = GSL_MIN(pc1 - 1, kend - 2);
+      const size_t j0 = pmin;
+      const size_t j1 = GSL_MIN(pmax + 4, kend);
+      const size_t nw = j1 - j0;
+      gsl_matrix_view U = gsl_matrix_submatrix(ws->U, 0, 0, nw, nw);
+      size_t pc;
+
+      gsl_matrix_set_identity(&U.matrix);
+
+      for (pc = pc0; pc < pc1; ++pc)
+        {
+          size_t m;
+
+          for (m = 0; m < nb && pc >= ktop + 3 * m; ++m)
+            {
+              const size_t p = pc - 3 * m;
+              size_t nr;
+              double v[3], tau;
+              gsl_vector_view vv;
+              gsl_matrix_view A;
+
+              if (p > kend - 2)
+                continue; /* bulge m has left the block */
+
+              nr = GSL_MIN(3, kend - p);
+              vv = gsl_vector_view_array(v, nr);
+
+              if (p == ktop)
+                {
+                  /* introduce a new bulge */
+                  francis_ms_first_column(H, ktop,
+                                          gsl_vector_complex_get(ws->shift, 2 * m),
+                                          gsl_vector_complex_get(ws->shift, 2 * m + 1),
+                                          v);
+                  tau = gsl_linalg_householder_transform(&vv.vector);
+                }
+              else
+                {
+                  size_t i;
+
+                  for (i = 0; i < nr; ++i)
+                    v[i] = gsl_matrix_get(H, p + i, p - 1);
+
+                  tau = gsl_linalg_householder_transform(&vv.vector);
+
+                  gsl_matrix_set(H, p, p - 1, v[0]);
+                  for (i = 1; i < nr; ++i)
+                    gsl_matrix_set(H, p + i, p - 1, 0.0);
+                }
+
+              if (tau == 0.0)
+                continue;
+
+              /* H -> P^T H P inside the window, U -> U P */
+
+              A = gsl_matrix_submatrix(H, p, p, nr, j1 - p);
+              gsl_linalg_householder_hm(tau, &vv.vector, &A.matrix);
+
+              A = gsl_matrix_submatrix(H, j0, p, GSL_MIN(p + 4, kend) - j0, nr);
+              gsl_linalg_householder_mh(tau, &vv.vector, &A.matrix);
+
+              A = gsl_matrix_submatrix(&U.matrix, 0, p - j0, nw, nr);
+              gsl_linalg_householder_mh(tau, &vv.vector, &A.matrix);
+            }
+        }
+
+      /* apply the accumulated reflections to the rest of H and to Z */
+
+      if (j1 < lend)
+        {
+          gsl_matrix_view Hr = gsl_matrix_submatrix(H, j0, j1, nw, lend - j1);
+          gsl_matrix_view Wr = gsl_matrix_submatrix(ws->WH, 0, 0, nw, lend - j1);
+
+          gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, &U.matrix, &Hr.matrix,
+                         0.0, &Wr.matrix);
+          gsl_matrix_memcpy(&Hr.matrix, &Wr.matrix);
+        }
+
+      if (ltop < j0)
+        {
+          gsl_matrix_view Hc = gsl_matrix_submatrix(H, ltop, j0, j0 - ltop, nw);
+          gsl_matrix_view Wc = gsl_matrix_submatrix(ws->WV, 0, 0, j0 - ltop, nw);
+
+          gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &Hc.matrix, &U.matrix,
+                         0.0, &Wc.matrix);
+          gsl_matrix_memcpy(&Hc.matrix, &Wc.matrix);
+        }
+
+      if (w->Z)
+        {
+          gsl_matrix_view Zc = gsl_matrix_submatrix(w->Z, 0, j0, N, nw);
+          gsl_matrix_view Wz = gsl_matrix_submatrix(ws->WV, 0, 0, N, nw);
+
+          gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, &Zc.matrix, &U.matrix,
+                         0.0, &Wz.matrix);
+          gsl_matrix_memcpy(&Zc.matrix, &Wz.matrix);
+        }
+    }
+}
+
+/*
+francis_multishift()
+  Compute the eigenvalues, and optionally the Schur form, of the
+Hessenberg matrix H = w->H with the multishift QR algorithm. Active
+blocks smaller than FRANCIS_MS_NMIN are handed to the double shift
+algorithm.
+
+Inputs: H    - hessenberg matrix
+        eval - where to store eigenvalues
+        w    - francis workspace
+        ws   - multishift workspace
+
+Notes: based on LAPACK routine DLAQR0. On return, w->n_evals is less
+       than N if the iteration did not converge
+*/
+
+static void
+francis_multishift(gsl_matrix * H, gsl_vector_complex * eval,
+                   gsl_eigen_francis_workspace * w,
+                   francis_ms_workspace * ws)
+{
+  const size_t N = H->size1;
+  const size_t itmax = 30 * GSL_MAX(10, N);
+  size_t kend = N;  /* one past the last row of the active block */
+  size_t ndfl = 1;  /* sweeps since the last deflation */
+  size_t nsweep = 0;
+
+  while (kend > 0)
+    {
+      size_t ktop, nh, jw, nd, nsh, ns;
+
+      /* find the top of the active block */
+      for (ktop = kend - 1; ktop > 0; --ktop)
+        {
+          const double sel = gsl_matrix_get(H, ktop, ktop - 1);
+
+          if ((sel == 0.0) ||
+              (fabs(sel) < GSL_DBL_EPSILON *
+                           (fabs(gsl_matrix_get(H, ktop, ktop)) +
+                            fabs(gsl_matrix_get(H, ktop - 1, ktop - 1)))))
+            {
+              gsl_matrix_set(H, ktop, ktop - 1, 0.0);
+              break;
+            }
+        }
+
+      nh = kend - ktop;
+
+      if (nh < FRANCIS_MS_NMIN)
+        {
+          /* small block - use the double shift algorithm */
+          gsl_matrix_view m = gsl_matrix_submatrix(H, ktop, ktop, nh, nh);
+          const size_t n_evals = w->n_evals;
+
+          w->n_iter = 0;
+          francis_schur_decomp(&m.matrix, eval, w);
+
+          if (w->n_evals != n_evals + nh)
+            return;
+
+          kend = ktop;
+          ndfl = 1;
+          continue;
+        }
+
+      if (++nsweep > itmax)
+        return;
+
+      /* aggressive early deflation */
+      jw = GSL_MIN(GSL_MIN(ws->nwmax, francis_ms_nwindow(nh)), nh - 1);
+      nd = francis_ms_aed(H, ktop, kend, jw, eval, &nsh, w, ws);
+      kend -= nd;
+
+      if (nd > 0)
+        ndfl = 1;
+      else
+        ++ndfl;
+
+      /*
+       * skip the sweep if many eigenvalues were deflated, unless the
+       * active block is still large
+       */
+      if (nd > 0 &&
+          (100 * nd > FRANCIS_MS_NIBBLE * jw || kend - ktop < FRANCIS_MS_NMIN))
+        continue;
+
+      ns = GSL_MIN(ws->nsmax, francis_ms_nshifts(kend - ktop));
+      ns = francis_ms_shifts(H, ktop, kend, ns, nsh, ndfl, ws);
+      francis_ms_sweep(H, ktop, kend, ns, w, ws);
+    }
+}
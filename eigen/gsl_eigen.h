@@ -57,6 +57,45 @@ gsl_eigen_symmv_workspace * gsl_eigen_symmv_alloc (const size_t n);
 void gsl_eigen_symmv_free (gsl_eigen_symmv_workspace * w);
 int gsl_eigen_symmv (gsl_matrix * A, gsl_vector * eval, gsl_matrix * evec, gsl_eigen_symmv_workspace * w);
 
+typedef struct {
+  size_t size;
+  double * d;
+  double * sd;
+  double * tau;
+  double * gc;
+  double * gs;
+  double * z;
+  double * dlam;
+  size_t * perm;
+  size_t * idx;
+  gsl_matrix * W;
+  gsl_matrix * U;
+} gsl_eigen_symmv_dc_workspace;
+
+gsl_eigen_symmv_dc_workspace * gsl_eigen_symmv_dc_alloc (const size_t n);
+void gsl_eigen_symmv_dc_free (gsl_eigen_symmv_dc_workspace * w);
+int gsl_eigen_symmv_dc (gsl_matrix * A, gsl_vector * eval, gsl_matrix * evec, gsl_eigen_symmv_dc_workspace * w);
+
+typedef struct {
+  size_t size;
+  double * d;
+  double * sd;
+  double * tau;
+  double * work;
+  size_t * piv;
+  gsl_matrix * VT;
+  gsl_matrix * W;
+} gsl_eigen_symmv_select_workspace;
+
+gsl_eigen_symmv_select_workspace * gsl_eigen_symmv_select_alloc (const size_t n);
+void gsl_eigen_symmv_select_free (gsl_eigen_symmv_select_workspace * w);
+int gsl_eigen_symmv_select (gsl_matrix * A, const size_t il, const size_t iu,
+                            gsl_vector * eval, gsl_matrix * evec,
+                            gsl_eigen_symmv_select_workspace * w);
+int gsl_eigen_symmv_select_interval (gsl_matrix * A, const double vl, const double vu,
+                                     gsl_vector * eval, gsl_matrix * evec, size_t * nfound,
+                                     gsl_eigen_symmv_select_workspace * w);
+
 typedef struct {
   size_t size;
   double * d;
@@ -315,6 +354,14 @@ int gsl_schur_solve_equation_z(double ca, const gsl_matrix *A,
                                double *xnorm, double smin);
 
 
+/* Eigensolve a real symmetric matrix by the block one-sided
+ * Jacobi method, using nthreads threads
+ *
+ * The data in the matrix input is destroyed.
+ */
+int gsl_eigen_jacobi_tiled (gsl_matrix * A, gsl_vector * eval,
+                            gsl_matrix * evec, const size_t nthreads);
+
 /* The following functions are obsolete: */
 
 /* Eigensolve by Jacobi Method
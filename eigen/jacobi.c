@@ -23,6 +23,8 @@
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_eigen.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_blas.h>
 
 /* Algorithm 8.4.3 - Cyclic Jacobi.  Golub & Van Loan, Matrix Computations */
 
@@ -203,6 +205,164 @@ gsl_eigen_jacobi (gsl_matrix * a,
   return GSL_SUCCESS;
 }
 
+/*
+gsl_eigen_jacobi_tiled()
+  Compute the eigensystem of a real symmetric matrix with the
+block one-sided Jacobi method, using several threads
+
+Inputs: A        - (input) symmetric matrix, both triangles are used
+                   (output) destroyed
+        eval     - (output) eigenvalues
+        evec     - (output) orthonormal eigenvectors
+        nthreads - number of threads
+
+Return: success/error
+
+Notes:
+1) For symmetric A = Z L Z^T, the SVD A = U S V^T has S = |L| and
+V = Z, with u_j = sign(l_j) v_j. The SVD is computed with
+gsl_linalg_SV_decomp_jacobi_tiled(), so the eigenvalues inherit its
+accuracy, and the sign of each eigenvalue is that of u_j . v_j
+
+2) The right singular vectors of a cluster of (nearly) equal singular
+values may mix eigenvectors of l and -l. For such a cluster, with
+columns V_g and U_g, the small projected matrix
+V_g^T A V_g = V_g^T U_g S_g is diagonalized and V_g is rotated to its
+eigenvectors
+
+3) The eigenvalues are returned unordered; use gsl_eigen_symmv_sort()
+to sort them
+*/
+
+int
+gsl_eigen_jacobi_tiled (gsl_matrix * A, gsl_vector * eval,
+                        gsl_matrix * evec, const size_t nthreads)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR ("eigenproblem requires square matrix", GSL_ENOTSQR);
+    }
+  else if (N != evec->size1 || N != evec->size2)
+    {
+      GSL_ERROR ("eigenvector matrix must match input matrix", GSL_EBADLEN);
+    }
+  else if (N != eval->size)
+    {
+      GSL_ERROR ("eigenvalue vector must match input matrix", GSL_EBADLEN);
+    }
+  else
+    {
+      const double gaptol = GSL_SQRT_DBL_EPSILON;
+      double smax;
+      size_t j, k;
+      int status;
+
+      /* A <- U, evec <- V, eval <- S */
+      status = gsl_linalg_SV_decomp_jacobi_tiled (A, evec, eval, nthreads);
+      if (status)
+        return status;
+
+      smax = gsl_vector_get (eval, 0);
+
+      for (j = 0; j < N; j = k)
+        {
+          const double sj = gsl_vector_get (eval, j);
+
+          /* find the cluster j..k-1 of nearly equal singular values */
+          for (k = j + 1; k < N; ++k)
+            {
+              if (gsl_vector_get (eval, k - 1) - gsl_vector_get (eval, k) > gaptol * smax)
+                break;
+            }
+
+          if (sj == 0.0)
+            {
+              /* eigenvalue zero, any orthonormal basis of the null space */
+              for (; j < k; ++j)
+                gsl_vector_set (eval, j, 0.0);
+            }
+          else if (k == j + 1)
+            {
+              gsl_vector_const_view u = gsl_matrix_const_column (A, j);
+              gsl_vector_const_view v = gsl_matrix_const_column (evec, j);
+              double d;
+
+              gsl_blas_ddot (&u.vector, &v.vector, &d);
+              gsl_vector_set (eval, j, (d < 0.0) ? -sj : sj);
+            }
+          else
+            {
+              const size_t ng = k - j;
+              gsl_matrix_view Ug = gsl_matrix_submatrix (A, 0, j, N, ng);
+              gsl_matrix_view Vg = gsl_matrix_submatrix (evec, 0, j, N, ng);
+              gsl_vector_view eg = gsl_vector_subvector (eval, j, ng);
+              gsl_matrix *C = gsl_matrix_alloc (ng, ng);
+              gsl_matrix *Z = gsl_matrix_alloc (ng, ng);
+              gsl_matrix *T = gsl_matrix_alloc (N, ng);
+              gsl_eigen_symmv_workspace *w = gsl_eigen_symmv_alloc (ng);
+              size_t a, b;
+
+              if (C == NULL || Z == NULL || T == NULL || w == NULL)
+                {
+                  gsl_matrix_free (C);
+                  gsl_matrix_free (Z);
+                  gsl_matrix_free (T);
+                  gsl_eigen_symmv_free (w);
+                  GSL_ERROR ("failed to allocate space for cluster workspace", GSL_ENOMEM);
+                }
+
+              /* U_g <- U_g S_g, C = V_g^T U_g S_g */
+              for (b = 0; b < ng; ++b)
+                {
+                  gsl_vector_view ub = gsl_matrix_column (&Ug.matrix, b);
+                  gsl_blas_dscal (gsl_vector_get (&eg.vector, b), &ub.vector);
+                }
+
+              gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, &Vg.matrix, &Ug.matrix, 0.0, C);
+
+              /* symmetrize, C is symmetric in exact arithmetic */
+              for (a = 0; a < ng; ++a)
+                {
+                  for (b = 0; b < a; ++b)
+                    {
+                      double cab = 0.5 * (gsl_matrix_get (C, a, b) + gsl_matrix_get (C, b, a));
+                      gsl_matrix_set (C, a, b, cab);
+                      gsl_matrix_set (C, b, a, cab);
+                    }
+                }
+
+              status = gsl_eigen_symmv (C, &eg.vector, Z, w);
+
+              /* V_g <- V_g Z */
+              gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Vg.matrix, Z, 0.0, T);
+              gsl_matrix_memcpy (&Vg.matrix, T);
+
+              gsl_matrix_free (C);
+              gsl_matrix_free (Z);
+              gsl_matrix_free (T);
+              gsl_eigen_symmv_free (w);
+
+              if (status)
+                return status;
+            }
+        }
+
+      /* remove the drift of the norms accumulated by the rotations */
+      for (j = 0; j < N; ++j)
+        {
+          gsl_vector_view v = gsl_matrix_column (evec, j);
+          double nrm = gsl_blas_dnrm2 (&v.vector);
+
+          if (nrm > 0.0)
+            gsl_blas_dscal (1.0 / nrm, &v.vector);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
 int
 gsl_eigen_invert_jacobi (const gsl_matrix * a,
                          gsl_matrix * ainv, unsigned int max_rot)
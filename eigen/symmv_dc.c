@@ -0,0 +1,654 @@
+/* eigen/symmv_dc.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_sort_double.h>
+#include <gsl/gsl_eigen.h>
+
+/* Compute eigenvalues/eigenvectors of real symmetric matrix using
+   reduction to tridiagonal form, followed by Cuppen's divide and
+   conquer method on the tridiagonal matrix.
+
+   The tridiagonal matrix T is split in two halves by a rank-one
+   modification,
+
+     T = diag(T1, T2) + rho v v^T
+
+   the halves are solved recursively, and the eigensystem of T is
+   recovered from the eigenvalues of the rank-one update D + rho z z^T
+   of a diagonal matrix. Eigenvalues which can be found trivially are
+   deflated, the remaining ones are the roots of the secular equation
+
+     1 + rho \sum_j z_j^2 / (d_j - lambda) = 0
+
+   and the eigenvectors are updated with a single matrix-matrix product
+   per merge. The vector z is recomputed from the computed eigenvalues
+   (Gu and Eisenstat) so that the eigenvectors are numerically
+   orthogonal.
+
+   See Golub & Van Loan, "Matrix Computations" (3rd ed), Section 8.5.4
+   and LAPACK routines DSTEDC, DLAED0-DLAED4. */
+
+#include "qrstep.c"
+#include "tdback.c"
+
+/* subproblems of this size or smaller are solved with QR iteration */
+#define SYMMV_DC_LEAF 25
+
+static void dc_tridiag (const size_t n, double d[], double sd[],
+                        gsl_matrix * Z, gsl_eigen_symmv_dc_workspace * w);
+static void dc_leaf (const size_t n, double d[], double sd[], gsl_matrix * Z,
+                     double gc[], double gs[]);
+static void dc_merge (const size_t n, const size_t n1, double d[],
+                      const double beta, gsl_matrix * Z,
+                      gsl_eigen_symmv_dc_workspace * w);
+static double secular_root (const size_t k, const size_t i,
+                            const double dlam[], const double z[],
+                            const double rho, double delta[]);
+
+gsl_eigen_symmv_dc_workspace *
+gsl_eigen_symmv_dc_alloc (const size_t n)
+{
+  gsl_eigen_symmv_dc_workspace * w ;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("matrix dimension must be positive integer", GSL_EINVAL);
+    }
+
+  w = calloc (1, sizeof (gsl_eigen_symmv_dc_workspace));
+
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->size = n;
+
+  w->d = malloc (n * sizeof (double));
+  w->sd = malloc (n * sizeof (double));
+  w->tau = malloc (n * sizeof (double));
+  w->gc = malloc (n * sizeof (double));
+  w->gs = malloc (n * sizeof (double));
+  w->z = malloc (n * sizeof (double));
+  w->dlam = malloc (n * sizeof (double));
+  w->perm = malloc (n * sizeof (size_t));
+  w->idx = malloc (n * sizeof (size_t));
+
+  if (w->d == 0 || w->sd == 0 || w->tau == 0 || w->gc == 0 || w->gs == 0 ||
+      w->z == 0 || w->dlam == 0 || w->perm == 0 || w->idx == 0)
+    {
+      gsl_eigen_symmv_dc_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for vectors", GSL_ENOMEM);
+    }
+
+  w->W = gsl_matrix_alloc (n, n);
+  w->U = gsl_matrix_alloc (n, n);
+
+  if (w->W == 0 || w->U == 0)
+    {
+      gsl_eigen_symmv_dc_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for matrices", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_eigen_symmv_dc_free (gsl_eigen_symmv_dc_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->U)
+    gsl_matrix_free (w->U);
+
+  if (w->W)
+    gsl_matrix_free (w->W);
+
+  free (w->idx);
+  free (w->perm);
+  free (w->dlam);
+  free (w->z);
+  free (w->gs);
+  free (w->gc);
+  free (w->tau);
+  free (w->sd);
+  free (w->d);
+  free (w);
+}
+
+int
+gsl_eigen_symmv_dc (gsl_matrix * A, gsl_vector * eval, gsl_matrix * evec,
+                    gsl_eigen_symmv_dc_workspace * w)
+{
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR ("matrix must be square to compute eigenvalues", GSL_ENOTSQR);
+    }
+  else if (eval->size != A->size1)
+    {
+      GSL_ERROR ("eigenvalue vector must match matrix size", GSL_EBADLEN);
+    }
+  else if (evec->size1 != A->size1 || evec->size2 != A->size1)
+    {
+      GSL_ERROR ("eigenvector matrix must match matrix size", GSL_EBADLEN);
+    }
+  else if (A->size1 != w->size)
+    {
+      GSL_ERROR ("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      double *const d = w->d;
+      double *const sd = w->sd;
+      const size_t N = A->size1;
+      size_t i;
+
+      /* handle special case */
+
+      if (N == 1)
+        {
+          double A00 = gsl_matrix_get (A, 0, 0);
+          gsl_vector_set (eval, 0, A00);
+          gsl_matrix_set (evec, 0, 0, 1.0);
+          return GSL_SUCCESS;
+        }
+
+      /* A = Q T Q^T, with Q stored as Householder vectors in A */
+
+      {
+        gsl_vector_view d_vec = gsl_vector_view_array (d, N);
+        gsl_vector_view sd_vec = gsl_vector_view_array (sd, N - 1);
+        gsl_vector_view tau = gsl_vector_view_array (w->tau, N - 1);
+        gsl_linalg_symmtd_decomp (A, &tau.vector);
+        gsl_linalg_symmtd_unpack_T (A, &d_vec.vector, &sd_vec.vector);
+      }
+
+      /* T = Z diag(d) Z^T, with Z stored in evec */
+
+      dc_tridiag (N, d, sd, evec, w);
+
+      /* eigenvectors of A are Q Z */
+
+      symmtd_backtransform (A, w->tau, evec, w->U, w->W);
+
+      for (i = 0; i < N; i++)
+        {
+          gsl_vector_set (eval, i, d[i]);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* eigensystem of the n-by-n tridiagonal matrix with diagonal d and
+   off-diagonal sd; on output d contains the eigenvalues and the
+   columns of Z the eigenvectors */
+
+static void
+dc_tridiag (const size_t n, double d[], double sd[], gsl_matrix * Z,
+            gsl_eigen_symmv_dc_workspace * w)
+{
+  if (n <= SYMMV_DC_LEAF)
+    {
+      gsl_matrix_view Zn = gsl_matrix_submatrix (Z, 0, 0, n, n);
+      dc_leaf (n, d, sd, &Zn.matrix, w->gc, w->gs);
+    }
+  else
+    {
+      const size_t n1 = n / 2;
+      const size_t n2 = n - n1;
+      const double beta = sd[n1 - 1];
+      gsl_matrix_view Z1 = gsl_matrix_submatrix (Z, 0, 0, n1, n1);
+      gsl_matrix_view Z2 = gsl_matrix_submatrix (Z, n1, n1, n2, n2);
+      gsl_matrix_view Z12 = gsl_matrix_submatrix (Z, 0, n1, n1, n2);
+      gsl_matrix_view Z21 = gsl_matrix_submatrix (Z, n1, 0, n2, n1);
+
+      /* T = diag(T1, T2) + |beta| v v^T with v = (e_n1, sign(beta) e_1) */
+
+      d[n1 - 1] -= fabs (beta);
+      d[n1] -= fabs (beta);
+
+      dc_tridiag (n1, d, sd, &Z1.matrix, w);
+      dc_tridiag (n2, d + n1, sd + n1, &Z2.matrix, w);
+
+      gsl_matrix_set_zero (&Z12.matrix);
+      gsl_matrix_set_zero (&Z21.matrix);
+
+      if (beta != 0.0)
+        {
+          gsl_matrix_view Zn = gsl_matrix_submatrix (Z, 0, 0, n, n);
+          dc_merge (n, n1, d, beta, &Zn.matrix, w);
+        }
+    }
+}
+
+/* QR iteration with implicit shifts, as in gsl_eigen_symmv, with the
+   rotations accumulated into Z = I */
+
+static void
+dc_leaf (const size_t n, double d[], double sd[], gsl_matrix * Z,
+         double gc[], double gs[])
+{
+  size_t a, b;
+
+  gsl_matrix_set_identity (Z);
+
+  if (n == 1)
+    return;
+
+  chop_small_elements (n, d, sd);
+
+  b = n - 1;
+
+  while (b > 0)
+    {
+      if (sd[b - 1] == 0.0 || isnan (sd[b - 1]))
+        {
+          b--;
+          continue;
+        }
+
+      a = b - 1;
+
+      while (a > 0)
+        {
+          if (sd[a - 1] == 0.0)
+            {
+              break;
+            }
+          a--;
+        }
+
+      {
+        size_t i;
+        const size_t n_block = b - a + 1;
+
+        qrstep (n_block, d + a, sd + a, gc, gs);
+
+        for (i = 0; i < n_block - 1; i++)
+          {
+            const double c = gc[i], s = gs[i];
+            size_t k;
+
+            for (k = 0; k < n; k++)
+              {
+                double qki = gsl_matrix_get (Z, k, a + i);
+                double qkj = gsl_matrix_get (Z, k, a + i + 1);
+                gsl_matrix_set (Z, k, a + i, qki * c - qkj * s);
+                gsl_matrix_set (Z, k, a + i + 1, qki * s + qkj * c);
+              }
+          }
+
+        chop_small_elements (n, d, sd);
+      }
+    }
+}
+
+/* Given the eigensystems diag(d) = Z^T diag(T1, T2) Z of the two
+   halves, with Z block diagonal, compute the eigensystem of
+   diag(T1, T2) + |beta| v v^T and store it in d and Z */
+
+static void
+dc_merge (const size_t n, const size_t n1, double d[], const double beta,
+          gsl_matrix * Z, gsl_eigen_symmv_dc_workspace * w)
+{
+  double *const z = w->z;
+  double *const dlam = w->dlam;
+  size_t *const perm = w->perm;
+  size_t *const idx = w->idx;
+  double rho = 2.0 * fabs (beta);
+  double dmax = 0.0, zmax = 0.0, tol;
+  size_t i, j, k = 0, nd = 0, prev = 0;
+  int have_prev = 0;
+
+  /* z = Z^T v / sqrt(2), which has unit norm, and rho = 2 |beta| */
+
+  for (j = 0; j < n1; j++)
+    {
+      z[j] = gsl_matrix_get (Z, n1 - 1, j) / M_SQRT2;
+    }
+
+  for (j = n1; j < n; j++)
+    {
+      double zj = gsl_matrix_get (Z, n1, j) / M_SQRT2;
+      z[j] = (beta < 0.0) ? -zj : zj;
+    }
+
+  gsl_sort_index (perm, d, 1, n);
+
+  for (j = 0; j < n; j++)
+    {
+      dmax = GSL_MAX_DBL (dmax, fabs (d[j]));
+      zmax = GSL_MAX_DBL (zmax, fabs (z[j]));
+    }
+
+  tol = 8.0 * GSL_DBL_EPSILON * GSL_MAX_DBL (dmax, zmax);
+
+  /* Deflation. Visit the eigenvalues in increasing order; a component
+     which is negligible in z deflates directly, and two eigenvalues
+     which are close enough are combined by a rotation of their
+     eigenvectors which zeroes one of the components of z. Undeflated
+     columns are listed in idx[0..k-1] and deflated ones in
+     idx[n-1], idx[n-2], ... */
+
+  for (i = 0; i < n; i++)
+    {
+      const size_t p = perm[i];
+
+      if (rho * fabs (z[p]) <= tol)
+        {
+          idx[n - 1 - nd++] = p;
+          continue;
+        }
+
+      if (have_prev)
+        {
+          double s = z[prev];
+          double c = z[p];
+          double tau = hypot (c, s);
+          double t = d[p] - d[prev];
+
+          c /= tau;
+          s = -s / tau;
+
+          if (fabs (t * c * s) <= tol)
+            {
+              gsl_vector_view zp = gsl_matrix_column (Z, prev);
+              gsl_vector_view zq = gsl_matrix_column (Z, p);
+              double dp = d[prev] * c * c + d[p] * s * s;
+
+              d[p] = d[prev] * s * s + d[p] * c * c;
+              d[prev] = dp;
+              z[p] = tau;
+              z[prev] = 0.0;
+
+              gsl_blas_drot (&zp.vector, &zq.vector, c, s);
+
+              idx[n - 1 - nd++] = prev;
+              prev = p;
+              continue;
+            }
+
+          idx[k++] = prev;
+        }
+
+      prev = p;
+      have_prev = 1;
+    }
+
+  if (have_prev)
+    idx[k++] = prev;
+
+  /* the eigenvectors are gathered in W, undeflated first */
+
+  for (j = 0; j < n; j++)
+    {
+      gsl_vector_view src = gsl_matrix_column (Z, idx[j]);
+      gsl_vector_view dst = gsl_matrix_subcolumn (w->W, j, 0, n);
+      gsl_blas_dcopy (&src.vector, &dst.vector);
+      dlam[j] = d[idx[j]];
+    }
+
+  for (j = 0; j < k; j++)
+    {
+      w->gs[j] = z[idx[j]];
+    }
+
+  for (j = 0; j < k; j++)
+    {
+      z[j] = w->gs[j];
+    }
+
+  /* deflated eigenvalues and eigenvectors move to the end */
+
+  for (j = k; j < n; j++)
+    {
+      gsl_vector_view src = gsl_matrix_subcolumn (w->W, j, 0, n);
+      gsl_vector_view dst = gsl_matrix_column (Z, j);
+      gsl_blas_dcopy (&src.vector, &dst.vector);
+      d[j] = dlam[j];
+    }
+
+  if (k == 0)
+    return;
+
+  {
+    gsl_matrix_view U = gsl_matrix_submatrix (w->U, 0, 0, k, k);
+    gsl_matrix_view Wk = gsl_matrix_submatrix (w->W, 0, 0, n, k);
+    gsl_matrix_view Zk = gsl_matrix_submatrix (Z, 0, 0, n, k);
+    double *const zhat = w->gc;
+
+    /* roots of the secular equation; column i of U holds the
+       differences dlam[j] - lambda_i */
+
+    for (i = 0; i < k; i++)
+      {
+        double *delta = w->gs;
+
+        d[i] = secular_root (k, i, dlam, z, rho, delta);
+
+        for (j = 0; j < k; j++)
+          {
+            gsl_matrix_set (&U.matrix, j, i, delta[j]);
+          }
+      }
+
+    /* recompute z from the eigenvalues (Lowner's theorem) */
+
+    for (j = 0; j < k; j++)
+      {
+        double prod = gsl_matrix_get (&U.matrix, j, j);
+
+        for (i = 0; i < k; i++)
+          {
+            if (i != j)
+              prod *= gsl_matrix_get (&U.matrix, j, i) / (dlam[j] - dlam[i]);
+          }
+
+        zhat[j] = (z[j] < 0.0) ? -sqrt (-prod) : sqrt (-prod);
+      }
+
+    /* eigenvectors of diag(dlam) + rho zhat zhat^T */
+
+    for (i = 0; i < k; i++)
+      {
+        gsl_vector_view ui = gsl_matrix_column (&U.matrix, i);
+        double nrm;
+
+        for (j = 0; j < k; j++)
+          {
+            double *uji = gsl_matrix_ptr (&U.matrix, j, i);
+            *uji = zhat[j] / *uji;
+          }
+
+        nrm = gsl_blas_dnrm2 (&ui.vector);
+        gsl_blas_dscal (1.0 / nrm, &ui.vector);
+      }
+
+    gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Wk.matrix, &U.matrix,
+                    0.0, &Zk.matrix);
+  }
+}
+
+/* Find the i-th root lambda of the secular equation
+
+     f(lambda) = 1/rho + \sum_j z_j^2 / (dlam_j - lambda) = 0
+
+   for dlam increasing and rho > 0. To preserve the small distances to
+   the poles the root is computed as an offset from the nearest pole,
+   and delta[j] = dlam[j] - lambda is returned from the same offsets.
+   Each step approximates f by a rational function matching the value
+   and slope of the sums over the poles on either side of the root
+   (Bunch, Nielsen and Sorensen), and falls back to bisection if the
+   approximation leaves the bracket. */
+
+static double
+secular_root (const size_t k, const size_t i, const double dlam[],
+              const double z[], const double rho, double delta[])
+{
+  const size_t max_iter = 100;
+  size_t j, origin, iter;
+  double lo, hi, tau;
+
+  if (k == 1)
+    {
+      delta[0] = -rho * z[0] * z[0];
+      return dlam[0] + rho * z[0] * z[0];
+    }
+
+  if (i < k - 1)
+    {
+      /* decide which half of (dlam_i, dlam_i+1) contains the root */
+
+      const double mid = 0.5 * (dlam[i + 1] - dlam[i]);
+      double f = 1.0 / rho;
+
+      for (j = 0; j < k; j++)
+        {
+          f += z[j] * z[j] / ((dlam[j] - dlam[i]) - mid);
+        }
+
+      if (f >= 0.0)
+        {
+          origin = i;
+          lo = 0.0;
+          hi = mid;
+        }
+      else
+        {
+          origin = i + 1;
+          lo = -mid;
+          hi = 0.0;
+        }
+    }
+  else
+    {
+      double zz = 0.0;
+
+      for (j = 0; j < k; j++)
+        {
+          zz += z[j] * z[j];
+        }
+
+      origin = k - 1;
+      lo = 0.0;
+      hi = rho * zz;
+    }
+
+  /* delta[j] holds dlam_j - dlam_origin during the iteration */
+
+  for (j = 0; j < k; j++)
+    {
+      delta[j] = dlam[j] - dlam[origin];
+    }
+
+  tau = 0.5 * (lo + hi);
+
+  for (iter = 0; iter < max_iter; iter++)
+    {
+      double psi = 0.0, dpsi = 0.0, phi = 0.0, dphi = 0.0;
+      double f, eta, tau_new;
+      const double di = delta[i] - tau;
+
+      for (j = 0; j <= i; j++)
+        {
+          const double t = z[j] / (delta[j] - tau);
+          psi += z[j] * t;
+          dpsi += t * t;
+        }
+
+      for (j = i + 1; j < k; j++)
+        {
+          const double t = z[j] / (delta[j] - tau);
+          phi += z[j] * t;
+          dphi += t * t;
+        }
+
+      f = 1.0 / rho + psi + phi;
+
+      if (fabs (f) <= GSL_DBL_EPSILON * (1.0 / rho + fabs (psi) + fabs (phi)))
+        break;
+
+      if (f < 0.0)
+        lo = tau;
+      else
+        hi = tau;
+
+      if (hi - lo <= 2.0 * GSL_DBL_EPSILON * GSL_MAX_DBL (fabs (lo), fabs (hi)))
+        break;
+
+      if (i < k - 1)
+        {
+          /* f ~ c + q / (di - eta) + s / (dj - eta), with eta the
+             step from tau; solve c eta^2 - b eta + cc = 0 for the
+             root between the poles */
+          const double dj = delta[i + 1] - tau;
+          const double q = dpsi * di * di;
+          const double s = dphi * dj * dj;
+          const double c = 1.0 / rho + (psi - q / di) + (phi - s / dj);
+          const double b = c * (di + dj) + q + s;
+          const double cc = di * dj * f;
+          const double disc = b * b - 4.0 * c * cc;
+
+          eta = GSL_NAN;
+
+          if (c == 0.0)
+            {
+              eta = cc / b;
+            }
+          else if (disc >= 0.0)
+            {
+              const double r = b + ((b < 0.0) ? -sqrt (disc) : sqrt (disc));
+              const double e1 = 2.0 * cc / r;
+              const double e2 = r / (2.0 * c);
+
+              eta = (e1 > di && e1 < dj) ? e1 : e2;
+            }
+        }
+      else
+        {
+          /* f ~ c + q / (di - eta) */
+          const double q = dpsi * di * di;
+          const double c = 1.0 / rho + (psi - q / di);
+
+          eta = (c > 0.0) ? di + q / c : GSL_NAN;
+        }
+
+      tau_new = tau + eta;
+
+      if (!(tau_new > lo && tau_new < hi))
+        tau_new = 0.5 * (lo + hi);
+
+      tau = tau_new;
+    }
+
+  for (j = 0; j < k; j++)
+    {
+      delta[j] -= tau;
+    }
+
+  return dlam[origin] + tau;
+}
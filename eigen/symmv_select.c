@@ -0,0 +1,611 @@
+/* eigen/symmv_select.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_eigen.h>
+
+/* Compute selected eigenvalues/eigenvectors of a real symmetric
+   matrix using reduction to tridiagonal form, followed by bisection
+   with Sturm sequences for the eigenvalues and inverse iteration for
+   the eigenvectors of the tridiagonal matrix. The eigenvectors are
+   transformed back with the Householder reflectors of the reduction,
+   so that everything after the reduction costs O(n k) or O(n^2 k)
+   for k eigenpairs.
+
+   See Golub & Van Loan, "Matrix Computations" (3rd ed), Sections 8.5.1
+   and 7.6.1, and LAPACK routines DSTEBZ and DSTEIN. */
+
+#include "tdback.c"
+
+/* maximum number of inverse iterations, and extra iterations taken
+   after the convergence criterion is met (as in DSTEIN) */
+#define SELECT_MAX_ITER 5
+#define SELECT_EXTRA_ITER 2
+
+static void tridiag_reduce (gsl_matrix * A,
+                            gsl_eigen_symmv_select_workspace * w);
+static int select_vectors (gsl_matrix * A, const gsl_vector * eval,
+                           gsl_matrix * evec,
+                           gsl_eigen_symmv_select_workspace * w);
+static void tridiag_range (const size_t n, const double d[], const double e[],
+                           double *lo, double *hi, double *pivmin,
+                           double *tnorm);
+static size_t sturm_count (const size_t n, const double d[], const double e[],
+                           const double pivmin, const double x);
+static double bisect_eigenvalue (const size_t n, const double d[],
+                                 const double e[], const double pivmin,
+                                 const double tnorm, const size_t j,
+                                 double lo, double hi);
+static void tridiag_lu (const size_t n, const double d[], const double e[],
+                        const double lambda, const double pivtol,
+                        double dd[], double du[], double du2[], double dl[],
+                        size_t piv[]);
+static void tridiag_lu_solve (const size_t n, const double dd[],
+                              const double du[], const double du2[],
+                              const double dl[], const size_t piv[],
+                              double b[]);
+
+gsl_eigen_symmv_select_workspace *
+gsl_eigen_symmv_select_alloc (const size_t n)
+{
+  gsl_eigen_symmv_select_workspace * w ;
+  const size_t nb = GSL_MIN (SYMMTD_BACK_BLOCK, GSL_MAX (n / 2, 1));
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("matrix dimension must be positive integer", GSL_EINVAL);
+    }
+
+  w = calloc (1, sizeof (gsl_eigen_symmv_select_workspace));
+
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->size = n;
+
+  w->d = malloc (n * sizeof (double));
+  w->sd = malloc (n * sizeof (double));
+  w->tau = malloc (n * sizeof (double));
+  w->work = malloc (6 * n * sizeof (double));
+  w->piv = malloc (n * sizeof (size_t));
+
+  if (w->d == 0 || w->sd == 0 || w->tau == 0 || w->work == 0 || w->piv == 0)
+    {
+      gsl_eigen_symmv_select_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for vectors", GSL_ENOMEM);
+    }
+
+  w->VT = gsl_matrix_alloc (n, 2 * nb);
+  w->W = gsl_matrix_alloc (nb, n);
+
+  if (w->VT == 0 || w->W == 0)
+    {
+      gsl_eigen_symmv_select_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for matrices", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_eigen_symmv_select_free (gsl_eigen_symmv_select_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->W)
+    gsl_matrix_free (w->W);
+
+  if (w->VT)
+    gsl_matrix_free (w->VT);
+
+  free (w->piv);
+  free (w->work);
+  free (w->tau);
+  free (w->sd);
+  free (w->d);
+  free (w);
+}
+
+/* eigenvalues il, il+1, ..., iu in increasing order (counting from 0)
+   and their eigenvectors */
+
+int
+gsl_eigen_symmv_select (gsl_matrix * A, const size_t il, const size_t iu,
+                        gsl_vector * eval, gsl_matrix * evec,
+                        gsl_eigen_symmv_select_workspace * w)
+{
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR ("matrix must be square to compute eigenvalues", GSL_ENOTSQR);
+    }
+  else if (A->size1 != w->size)
+    {
+      GSL_ERROR ("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else if (il > iu || iu >= A->size1)
+    {
+      GSL_ERROR ("index range must satisfy il <= iu < N", GSL_EINVAL);
+    }
+  else if (eval->size != iu - il + 1)
+    {
+      GSL_ERROR ("eigenvalue vector must match index range", GSL_EBADLEN);
+    }
+  else if (evec->size1 != A->size1 || evec->size2 != iu - il + 1)
+    {
+      GSL_ERROR ("eigenvector matrix must be N-by-(iu - il + 1)", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t N = A->size1;
+      double *const d = w->d;
+      double *const sd = w->sd;
+      double lo, hi, pivmin, tnorm;
+      size_t j;
+
+      /* handle special case */
+
+      if (N == 1)
+        {
+          double A00 = gsl_matrix_get (A, 0, 0);
+          gsl_vector_set (eval, 0, A00);
+          gsl_matrix_set (evec, 0, 0, 1.0);
+          return GSL_SUCCESS;
+        }
+
+      tridiag_reduce (A, w);
+      tridiag_range (N, d, sd, &lo, &hi, &pivmin, &tnorm);
+
+      for (j = il; j <= iu; j++)
+        {
+          double lj = bisect_eigenvalue (N, d, sd, pivmin, tnorm, j, lo, hi);
+          gsl_vector_set (eval, j - il, lj);
+        }
+
+      return select_vectors (A, eval, evec, w);
+    }
+}
+
+/* eigenvalues in the interval [vl,vu) in increasing order and their
+   eigenvectors; eval and evec must have room for all of them, and the
+   number found is stored in nfound */
+
+int
+gsl_eigen_symmv_select_interval (gsl_matrix * A, const double vl,
+                                 const double vu, gsl_vector * eval,
+                                 gsl_matrix * evec, size_t * nfound,
+                                 gsl_eigen_symmv_select_workspace * w)
+{
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR ("matrix must be square to compute eigenvalues", GSL_ENOTSQR);
+    }
+  else if (A->size1 != w->size)
+    {
+      GSL_ERROR ("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else if (!(vl < vu))
+    {
+      GSL_ERROR ("interval must satisfy vl < vu", GSL_EINVAL);
+    }
+  else if (evec->size1 != A->size1 || evec->size2 != eval->size)
+    {
+      GSL_ERROR ("eigenvector matrix must be N-by-M with M the length of eval",
+                 GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t N = A->size1;
+      double *const d = w->d;
+      double *const sd = w->sd;
+      double lo, hi, pivmin, tnorm;
+      size_t il, iu, j;
+
+      *nfound = 0;
+
+      if (N == 1)
+        {
+          double A00 = gsl_matrix_get (A, 0, 0);
+
+          if (A00 >= vl && A00 < vu)
+            {
+              gsl_vector_set (eval, 0, A00);
+              gsl_matrix_set (evec, 0, 0, 1.0);
+              *nfound = 1;
+            }
+
+          return GSL_SUCCESS;
+        }
+
+      tridiag_reduce (A, w);
+      tridiag_range (N, d, sd, &lo, &hi, &pivmin, &tnorm);
+
+      /* the eigenvalues in [vl,vu) are il, ..., iu - 1 */
+
+      il = sturm_count (N, d, sd, pivmin, vl);
+      iu = sturm_count (N, d, sd, pivmin, vu);
+
+      if (iu - il > eval->size)
+        {
+          GSL_ERROR ("eigenvalue vector too short for interval", GSL_EBADLEN);
+        }
+
+      *nfound = iu - il;
+
+      if (iu == il)
+        return GSL_SUCCESS;
+
+      {
+        gsl_vector_view ev = gsl_vector_subvector (eval, 0, iu - il);
+        gsl_matrix_view Z = gsl_matrix_submatrix (evec, 0, 0, N, iu - il);
+
+        for (j = il; j < iu; j++)
+          {
+            double lj = bisect_eigenvalue (N, d, sd, pivmin, tnorm, j,
+                                           GSL_MAX (lo, vl), GSL_MIN (hi, vu));
+            gsl_vector_set (&ev.vector, j - il, lj);
+          }
+
+        return select_vectors (A, &ev.vector, &Z.matrix, w);
+      }
+    }
+}
+
+/* A = Q T Q^T, with Q stored as Householder vectors in A and T in
+   w->d, w->sd */
+
+static void
+tridiag_reduce (gsl_matrix * A, gsl_eigen_symmv_select_workspace * w)
+{
+  const size_t N = A->size1;
+  gsl_vector_view d_vec = gsl_vector_view_array (w->d, N);
+  gsl_vector_view sd_vec = gsl_vector_view_array (w->sd, N - 1);
+  gsl_vector_view tau = gsl_vector_view_array (w->tau, N - 1);
+
+  gsl_linalg_symmtd_decomp (A, &tau.vector);
+  gsl_linalg_symmtd_unpack_T (A, &d_vec.vector, &sd_vec.vector);
+}
+
+/* Compute the eigenvectors of T for the eigenvalues in eval by inverse
+   iteration and transform them back to eigenvectors of A. Vectors for
+   eigenvalues closer than 1e-3 |T| are orthogonalized against each
+   other, and eigenvalues which are equal to working precision are
+   separated slightly so that the iterations converge to different
+   vectors (LAPACK DSTEIN). */
+
+static int
+select_vectors (gsl_matrix * A, const gsl_vector * eval, gsl_matrix * Z,
+                gsl_eigen_symmv_select_workspace * w)
+{
+  const size_t n = A->size1;
+  const size_t k = eval->size;
+  const double *d = w->d;
+  const double *e = w->sd;
+  double *const dd = w->work;
+  double *const du = w->work + n;
+  double *const du2 = w->work + 2 * n;
+  double *const dl = w->work + 3 * n;
+  double *const b = w->work + 4 * n;
+  double *const ev = w->work + 5 * n;
+  double lo, hi, pivmin, tnorm, ortol, dtpcrt;
+  unsigned long seed = 1;
+  size_t i, j, jblk = 0;
+  int status = GSL_SUCCESS;
+
+  tridiag_range (n, d, e, &lo, &hi, &pivmin, &tnorm);
+
+  ortol = 1.0e-3 * tnorm;
+  dtpcrt = sqrt (0.1 / n);
+
+  for (j = 0; j < k; j++)
+    {
+      ev[j] = gsl_vector_get (eval, j);
+    }
+
+  for (j = 0; j < k; j++)
+    {
+      double xj = ev[j];
+      size_t its, jmax = 0, nconv = 0;
+      double nrm;
+
+      if (j > 0)
+        {
+          const double pertol = 10.0 * fabs (GSL_DBL_EPSILON * xj);
+
+          if (xj - ev[j - 1] > ortol)
+            jblk = j;
+
+          if (xj - ev[j - 1] < pertol)
+            xj = ev[j - 1] + pertol;
+
+          ev[j] = xj;
+        }
+
+      /* random starting vector with entries in (-1,1) */
+
+      for (i = 0; i < n; i++)
+        {
+          seed = (seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+          b[i] = 2.0 * (seed / 2147483648.0) - 1.0;
+        }
+
+      tridiag_lu (n, d, e, xj, GSL_DBL_EPSILON * tnorm, dd, du, du2, dl,
+                  w->piv);
+
+      for (its = 0; its < SELECT_MAX_ITER; its++)
+        {
+          double b1 = 0.0, scl, bmax = 0.0;
+
+          for (i = 0; i < n; i++)
+            b1 += fabs (b[i]);
+
+          scl = n * tnorm * GSL_MAX (GSL_DBL_EPSILON, fabs (dd[n - 1])) / b1;
+
+          for (i = 0; i < n; i++)
+            b[i] *= scl;
+
+          tridiag_lu_solve (n, dd, du, du2, dl, w->piv, b);
+
+          /* orthogonalize against the vectors of the cluster */
+
+          for (i = jblk; i < j; i++)
+            {
+              double ztr = 0.0;
+              size_t r;
+
+              for (r = 0; r < n; r++)
+                ztr += b[r] * gsl_matrix_get (Z, r, i);
+
+              for (r = 0; r < n; r++)
+                b[r] -= ztr * gsl_matrix_get (Z, r, i);
+            }
+
+          for (i = 0; i < n; i++)
+            {
+              if (fabs (b[i]) > bmax)
+                {
+                  bmax = fabs (b[i]);
+                  jmax = i;
+                }
+            }
+
+          if (bmax >= dtpcrt && ++nconv > SELECT_EXTRA_ITER)
+            break;
+        }
+
+      if (its == SELECT_MAX_ITER)
+        status = GSL_EMAXITER;
+
+      nrm = 0.0;
+
+      for (i = 0; i < n; i++)
+        nrm += b[i] * b[i];
+
+      nrm = sqrt (nrm);
+
+      if (b[jmax] < 0.0)
+        nrm = -nrm;
+
+      for (i = 0; i < n; i++)
+        gsl_matrix_set (Z, i, j, b[i] / nrm);
+    }
+
+  symmtd_backtransform (A, w->tau, Z, w->VT, w->W);
+
+  if (status)
+    {
+      GSL_ERROR ("inverse iteration failed to converge", status);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* Gershgorin interval [lo,hi] containing the eigenvalues of T, its
+   1-norm, and the smallest allowed pivot of the Sturm sequence */
+
+static void
+tridiag_range (const size_t n, const double d[], const double e[],
+               double *lo, double *hi, double *pivmin, double *tnorm)
+{
+  double gl = d[0], gu = d[0], emax = 1.0;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      double r = 0.0;
+
+      if (i > 0)
+        r += fabs (e[i - 1]);
+
+      if (i < n - 1)
+        {
+          r += fabs (e[i]);
+          emax = GSL_MAX (emax, e[i] * e[i]);
+        }
+
+      gl = GSL_MIN (gl, d[i] - r);
+      gu = GSL_MAX (gu, d[i] + r);
+    }
+
+  *tnorm = GSL_MAX (fabs (gl), fabs (gu));
+  *pivmin = GSL_DBL_MIN * emax;
+  *lo = gl - 2.1 * n * GSL_DBL_EPSILON * (*tnorm) - 4.2 * (*pivmin);
+  *hi = gu + 2.1 * n * GSL_DBL_EPSILON * (*tnorm) + 4.2 * (*pivmin);
+}
+
+/* number of eigenvalues of T less than x, from the signs of the pivots
+   of T - x I = L D L^T */
+
+static size_t
+sturm_count (const size_t n, const double d[], const double e[],
+             const double pivmin, const double x)
+{
+  size_t count = 0, i;
+  double q = d[0] - x;
+
+  if (fabs (q) <= pivmin)
+    q = -pivmin;
+
+  if (q < 0.0)
+    count++;
+
+  for (i = 1; i < n; i++)
+    {
+      q = d[i] - x - e[i - 1] * e[i - 1] / q;
+
+      if (fabs (q) <= pivmin)
+        q = -pivmin;
+
+      if (q < 0.0)
+        count++;
+    }
+
+  return count;
+}
+
+/* eigenvalue j of T (counting from 0 in increasing order), given
+   sturm_count(lo) <= j < sturm_count(hi) */
+
+static double
+bisect_eigenvalue (const size_t n, const double d[], const double e[],
+                   const double pivmin, const double tnorm, const size_t j,
+                   double lo, double hi)
+{
+  const double atol = GSL_DBL_EPSILON * tnorm + 2.0 * pivmin;
+
+  while (hi - lo > 2.0 * GSL_DBL_EPSILON * GSL_MAX (fabs (lo), fabs (hi)) + atol)
+    {
+      const double mid = 0.5 * (lo + hi);
+
+      if (mid <= lo || mid >= hi)
+        break;
+
+      if (sturm_count (n, d, e, pivmin, mid) > j)
+        hi = mid;
+      else
+        lo = mid;
+    }
+
+  return 0.5 * (lo + hi);
+}
+
+/* LU factorization with partial pivoting of T - lambda I; U has the
+   diagonals dd, du, du2, the multipliers are in dl, and piv[i] is
+   nonzero if rows i and i+1 were interchanged. Pivots smaller than
+   pivtol are replaced by pivtol, as the matrix is nearly singular by
+   construction. */
+
+static void
+tridiag_lu (const size_t n, const double d[], const double e[],
+            const double lambda, const double pivtol,
+            double dd[], double du[], double du2[], double dl[],
+            size_t piv[])
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      dd[i] = d[i] - lambda;
+      du2[i] = 0.0;
+
+      if (i < n - 1)
+        {
+          du[i] = e[i];
+          dl[i] = e[i];
+        }
+    }
+
+  for (i = 0; i + 1 < n; i++)
+    {
+      if (fabs (dd[i]) >= fabs (dl[i]))
+        {
+          double fact;
+
+          if (fabs (dd[i]) < pivtol)
+            dd[i] = (dd[i] < 0.0) ? -pivtol : pivtol;
+
+          fact = dl[i] / dd[i];
+          dl[i] = fact;
+          dd[i + 1] -= fact * du[i];
+          piv[i] = 0;
+        }
+      else
+        {
+          const double fact = dd[i] / dl[i];
+          const double tmp = du[i];
+
+          dd[i] = dl[i];
+          dl[i] = fact;
+          du[i] = dd[i + 1];
+          dd[i + 1] = tmp - fact * dd[i + 1];
+
+          if (i + 2 < n)
+            {
+              du2[i] = du[i + 1];
+              du[i + 1] = -fact * du[i + 1];
+            }
+
+          piv[i] = 1;
+        }
+    }
+
+  if (fabs (dd[n - 1]) < pivtol)
+    dd[n - 1] = (dd[n - 1] < 0.0) ? -pivtol : pivtol;
+}
+
+/* solve (T - lambda I) x = b with the factorization of tridiag_lu */
+
+static void
+tridiag_lu_solve (const size_t n, const double dd[], const double du[],
+                  const double du2[], const double dl[], const size_t piv[],
+                  double b[])
+{
+  size_t i;
+
+  for (i = 0; i + 1 < n; i++)
+    {
+      if (piv[i] == 0)
+        {
+          b[i + 1] -= dl[i] * b[i];
+        }
+      else
+        {
+          const double tmp = b[i];
+          b[i] = b[i + 1];
+          b[i + 1] = tmp - dl[i] * b[i];
+        }
+    }
+
+  b[n - 1] /= dd[n - 1];
+
+  if (n > 1)
+    b[n - 2] = (b[n - 2] - du[n - 2] * b[n - 1]) / dd[n - 2];
+
+  for (i = n - 2; i-- > 0;)
+    {
+      b[i] = (b[i] - du[i] * b[i + 1] - du2[i] * b[i + 2]) / dd[i];
+    }
+}
@@ -0,0 +1,110 @@
+/* eigen/tdback.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* number of Householder reflectors applied together */
+#define SYMMTD_BACK_BLOCK 32
+
+/* Z := Q Z, where Q = H_0 H_1 ... H_{N-3} is the orthogonal matrix of
+   gsl_linalg_symmtd_decomp, stored as Householder vectors below the
+   subdiagonal of A. The reflectors are applied in blocks as
+   I - V T V^T, with T upper triangular (LAPACK DLARFT/DLARFB), so that
+   the work is done in dgemm.
+
+   The workspace VT must have at least N rows and 2 * min(32, N/2)
+   columns, and W at least min(32, N/2) rows and as many columns as Z. */
+
+static void
+symmtd_backtransform (const gsl_matrix * A, const double tau[], gsl_matrix * Z,
+                      gsl_matrix * VT, gsl_matrix * W)
+{
+  const size_t N = A->size1;
+  const size_t nrefl = N - 2;
+  const size_t nb = GSL_MIN (SYMMTD_BACK_BLOCK, N / 2);
+  const size_t ncol = Z->size2;
+  size_t j0;
+
+  if (N < 3)
+    return;
+
+  /* the last block is applied first */
+
+  j0 = ((nrefl - 1) / nb) * nb;
+
+  while (1)
+    {
+      const size_t kb = GSL_MIN (nb, nrefl - j0);
+      const size_t m = N - j0 - 1;
+      gsl_matrix_view V = gsl_matrix_submatrix (VT, 0, 0, m, kb);
+      gsl_matrix_view T = gsl_matrix_submatrix (VT, 0, nb, kb, kb);
+      gsl_matrix_view Wt = gsl_matrix_submatrix (W, 0, 0, kb, ncol);
+      gsl_matrix_view Zs = gsl_matrix_submatrix (Z, j0 + 1, 0, m, ncol);
+      size_t r, c;
+
+      /* V(:,c) is the reflector j0 + c, acting on rows j0+c+1:N of Z */
+
+      for (r = 0; r < m; r++)
+        {
+          for (c = 0; c < kb; c++)
+            {
+              double vrc;
+
+              if (r < c)
+                vrc = 0.0;
+              else if (r == c)
+                vrc = 1.0;
+              else
+                vrc = gsl_matrix_get (A, j0 + 1 + r, j0 + c);
+
+              gsl_matrix_set (&V.matrix, r, c, vrc);
+            }
+        }
+
+      gsl_matrix_set_zero (&T.matrix);
+
+      for (c = 0; c < kb; c++)
+        {
+          const double tc = tau[j0 + c];
+
+          gsl_matrix_set (&T.matrix, c, c, tc);
+
+          if (c > 0)
+            {
+              /* T(0:c,c) = -tau_c T(0:c,0:c) V(:,0:c)^T v_c */
+              gsl_matrix_view Vp = gsl_matrix_submatrix (&V.matrix, 0, 0, m, c);
+              gsl_vector_view vc = gsl_matrix_column (&V.matrix, c);
+              gsl_matrix_view Tp = gsl_matrix_submatrix (&T.matrix, 0, 0, c, c);
+              gsl_vector_view t = gsl_matrix_subcolumn (&T.matrix, c, 0, c);
+
+              gsl_blas_dgemv (CblasTrans, -tc, &Vp.matrix, &vc.vector, 0.0, &t.vector);
+              gsl_blas_dtrmv (CblasUpper, CblasNoTrans, CblasNonUnit, &Tp.matrix, &t.vector);
+            }
+        }
+
+      /* Z := Z - V T V^T Z */
+
+      gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, &V.matrix, &Zs.matrix, 0.0, &Wt.matrix);
+      gsl_blas_dtrmm (CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, &T.matrix, &Wt.matrix);
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, -1.0, &V.matrix, &Wt.matrix, 1.0, &Zs.matrix);
+
+      if (j0 == 0)
+        break;
+
+      j0 -= nb;
+    }
+}
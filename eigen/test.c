@@ -330,6 +330,135 @@ test_eigen_symm_results (const gsl_matrix * A,
   gsl_vector_free(y);
 }
 
+/* check a subset of the eigensystem of A computed by
+ * gsl_eigen_symmv_select, given all eigenvalues in increasing order */
+void
+test_eigen_symm_select_results (const gsl_matrix * A,
+                                const gsl_vector * eval_all,
+                                const size_t il,
+                                const gsl_vector * eval,
+                                const gsl_matrix * evec,
+                                const char * desc,
+                                const char * desc2)
+{
+  const size_t N = A->size1;
+  const size_t k = eval->size;
+  double emax = 0;
+  size_t i, j, l;
+
+  for (i = 0; i < N; i++)
+    {
+      double ei = gsl_vector_get (eval_all, i);
+      if (fabs(ei) > emax) emax = fabs(ei);
+    }
+
+  for (i = 0; i < k; i++)
+    {
+      double ei = gsl_vector_get (eval, i);
+
+      gsl_test_abs(ei, gsl_vector_get (eval_all, il + i),
+                   emax * 1e8 * GSL_DBL_EPSILON,
+                   "%s, select eigenvalue(%d), %s", desc, i, desc2);
+
+      /* A v = lambda v */
+      for (j = 0; j < N; j++)
+        {
+          double yj = 0.0;
+
+          for (l = 0; l < N; l++)
+            yj += gsl_matrix_get (A, j, l) * gsl_matrix_get (evec, l, i);
+
+          gsl_test_abs(yj, chop_subnormals(ei * gsl_matrix_get (evec, j, i)),
+                       emax * 1e8 * GSL_DBL_EPSILON,
+                       "%s, select eigenvector(%d,%d), %s", desc, i, j, desc2);
+        }
+
+      /* orthonormal; inverse iteration only guarantees this to within
+       * eps |A| / gap for eigenvalues outside a cluster */
+      for (j = 0; j <= i; j++)
+        {
+          double vivj = 0.0;
+
+          for (l = 0; l < N; l++)
+            vivj += gsl_matrix_get (evec, l, i) * gsl_matrix_get (evec, l, j);
+
+          gsl_test_abs (vivj, (i == j) ? 1.0 : 0.0, 100.0 * N * GSL_DBL_EPSILON,
+                        "%s, select orthonormal(%d,%d), %s", desc, i, j, desc2);
+        }
+    }
+}
+
+/* compute the middle half of the spectrum by index and by interval */
+void
+test_eigen_symm_select (const gsl_matrix * m, const gsl_vector * eval_all,
+                        const char * desc)
+{
+  const size_t N = m->size1;
+  const size_t il = N / 4;
+  const size_t iu = (3 * N) / 4 - ((N > 1) ? 1 : 0);
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_vector * eval = gsl_vector_alloc(N);
+  gsl_matrix * evec = gsl_matrix_alloc(N, N);
+  gsl_eigen_symmv_select_workspace * w = gsl_eigen_symmv_select_alloc(N);
+
+  {
+    gsl_vector_view ev = gsl_vector_subvector(eval, 0, iu - il + 1);
+    gsl_matrix_view Z = gsl_matrix_submatrix(evec, 0, 0, N, iu - il + 1);
+
+    gsl_matrix_memcpy(A, m);
+    gsl_eigen_symmv_select(A, il, iu, &ev.vector, &Z.matrix, w);
+    test_eigen_symm_select_results(m, eval_all, il, &ev.vector, &Z.matrix,
+                                   desc, "select/index");
+  }
+
+  {
+    double vl = gsl_vector_get(eval_all, il) - 1.0;
+    double vu = gsl_vector_get(eval_all, iu) + 1.0;
+    size_t i, first = N, nexpect = 0, nfound;
+
+    if (il > 0)
+      vl = 0.5 * (gsl_vector_get(eval_all, il - 1) + gsl_vector_get(eval_all, il));
+
+    if (iu + 1 < N)
+      vu = 0.5 * (gsl_vector_get(eval_all, iu) + gsl_vector_get(eval_all, iu + 1));
+
+    for (i = 0; i < N; i++)
+      {
+        double ei = gsl_vector_get(eval_all, i);
+
+        if (ei >= vl && ei < vu)
+          {
+            if (first == N)
+              first = i;
+            nexpect++;
+          }
+      }
+
+    gsl_matrix_memcpy(A, m);
+
+    if (vl < vu)
+      {
+        gsl_eigen_symmv_select_interval(A, vl, vu, eval, evec, &nfound, w);
+
+        gsl_test(nfound != nexpect, "%s, select/interval count %u (%u expected)",
+                 desc, nfound, nexpect);
+
+        if (nfound == nexpect && nfound > 0)
+          {
+            gsl_vector_view ev = gsl_vector_subvector(eval, 0, nfound);
+            gsl_matrix_view Z = gsl_matrix_submatrix(evec, 0, 0, N, nfound);
+            test_eigen_symm_select_results(m, eval_all, first, &ev.vector,
+                                           &Z.matrix, desc, "select/interval");
+          }
+      }
+  }
+
+  gsl_matrix_free(A);
+  gsl_vector_free(eval);
+  gsl_matrix_free(evec);
+  gsl_eigen_symmv_select_free(w);
+}
+
 void
 test_eigen_symm_matrix(const gsl_matrix * m, size_t count,
                        const char * desc)
@@ -343,6 +472,7 @@ test_eigen_symm_matrix(const gsl_matrix * m, size_t count,
   gsl_matrix * evec = gsl_matrix_alloc(N, N);
   gsl_eigen_symm_workspace * w = gsl_eigen_symm_alloc(N);
   gsl_eigen_symmv_workspace * wv = gsl_eigen_symmv_alloc(N);
+  gsl_eigen_symmv_dc_workspace * wdc = gsl_eigen_symmv_dc_alloc(N);
 
   gsl_matrix_memcpy(A, m);
 
@@ -372,6 +502,27 @@ test_eigen_symm_matrix(const gsl_matrix * m, size_t count,
   gsl_eigen_symmv_sort(evalv, evec, GSL_EIGEN_SORT_ABS_DESC);
   test_eigen_symm_results(m, evalv, evec, count, desc, "abs/desc");
 
+  /* divide and conquer */
+  gsl_matrix_memcpy(A, m);
+  gsl_eigen_symmv_dc(A, evalv, evec, wdc);
+  test_eigen_symm_results(m, evalv, evec, count, desc, "dc/unsorted");
+
+  gsl_vector_memcpy(y, evalv);
+  gsl_sort_vector(y);
+  test_eigenvalues_real(y, x, desc, "dc/unsorted");
+
+  /* block one-sided Jacobi */
+  gsl_matrix_memcpy(A, m);
+  gsl_eigen_jacobi_tiled(A, evalv, evec, 2);
+  test_eigen_symm_results(m, evalv, evec, count, desc, "jacobi_tiled/unsorted");
+
+  gsl_vector_memcpy(y, evalv);
+  gsl_sort_vector(y);
+  test_eigenvalues_real(y, x, desc, "jacobi_tiled/unsorted");
+
+  /* x holds the eigenvalues in increasing order */
+  test_eigen_symm_select(m, x, desc);
+
   gsl_matrix_free(A);
   gsl_vector_free(eval);
   gsl_vector_free(evalv);
@@ -380,6 +531,7 @@ test_eigen_symm_matrix(const gsl_matrix * m, size_t count,
   gsl_matrix_free(evec);
   gsl_eigen_symm_free(w);
   gsl_eigen_symmv_free(wv);
+  gsl_eigen_symmv_dc_free(wdc);
 } /* test_eigen_symm_matrix() */
 
 void
@@ -458,6 +610,19 @@ test_eigen_symm(void)
     test_eigen_symm_matrix(&m.matrix, 0, "symm(27)");
   };
 
+  {
+    /* large enough for the blocked tridiagonal reduction and
+     * several divide and conquer merges */
+    gsl_matrix * A = gsl_matrix_alloc(200, 200);
+
+    r = gsl_rng_alloc(gsl_rng_default);
+    create_random_symm_matrix(A, r, -10, 10);
+    test_eigen_symm_matrix(A, 0, "symm random(200)");
+
+    gsl_matrix_free(A);
+    gsl_rng_free(r);
+  }
+
 } /* test_eigen_symm() */
 
 /******************************************
@@ -619,6 +784,18 @@ test_eigen_herm(void)
     m = gsl_matrix_complex_view_array (dat2, 4, 4);
     test_eigen_herm_matrix(&m.matrix, 1, "herm(4) diag");
   }
+
+  {
+    /* large enough for the blocked tridiagonal reduction */
+    gsl_matrix_complex * A = gsl_matrix_complex_alloc(200, 200);
+
+    r = gsl_rng_alloc(gsl_rng_default);
+    create_random_herm_matrix(A, r, -10, 10);
+    test_eigen_herm_matrix(A, 0, "herm random(200)");
+
+    gsl_matrix_complex_free(A);
+    gsl_rng_free(r);
+  }
 } /* test_eigen_herm() */
 
 /******************************************
@@ -732,6 +909,50 @@ test_eigen_nonsymm_matrix(const gsl_matrix * m, size_t count,
   gsl_vector_complex_free(eval);
 }
 
+/* compare trace(A) and trace(A^2) with the sums of the eigenvalues
+ * and of their squares */
+void
+test_eigen_nonsymm_trace(const gsl_matrix * m, const char * desc)
+{
+  const size_t N = m->size1;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_vector_complex * eval = gsl_vector_complex_alloc(N);
+  gsl_eigen_nonsymm_workspace * w = gsl_eigen_nonsymm_alloc(N);
+  double tr = 0.0, tr2 = 0.0, etr = 0.0, etr2 = 0.0, norm = 0.0;
+  size_t i, j;
+
+  gsl_matrix_memcpy(A, m);
+  gsl_eigen_nonsymm(A, eval, w);
+
+  for (i = 0; i < N; ++i)
+    {
+      gsl_complex z = gsl_vector_complex_get(eval, i);
+
+      tr += gsl_matrix_get(m, i, i);
+      etr += GSL_REAL(z);
+      etr2 += GSL_REAL(z) * GSL_REAL(z) - GSL_IMAG(z) * GSL_IMAG(z);
+
+      for (j = 0; j < N; ++j)
+        {
+          double mij = gsl_matrix_get(m, i, j);
+
+          tr2 += mij * gsl_matrix_get(m, j, i);
+          norm += mij * mij;
+        }
+    }
+
+  norm = sqrt(norm);
+
+  gsl_test_abs(etr, tr, 1.0e2 * N * GSL_DBL_EPSILON * norm,
+               "nonsymm(N=%zu), %s, trace", N, desc);
+  gsl_test_abs(etr2, tr2, 1.0e2 * N * GSL_DBL_EPSILON * norm * norm,
+               "nonsymm(N=%zu), %s, trace(A^2)", N, desc);
+
+  gsl_matrix_free(A);
+  gsl_vector_complex_free(eval);
+  gsl_eigen_nonsymm_free(w);
+}
+
 void
 test_eigen_nonsymm(void)
 {
@@ -759,6 +980,25 @@ test_eigen_nonsymm(void)
       gsl_eigen_nonsymmv_free(w);
     }
 
+  /* larger matrices are reduced with the multishift QR algorithm */
+  for (n = 150; n <= 300; n += 150)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(n, n);
+      gsl_eigen_nonsymmv_workspace * w = gsl_eigen_nonsymmv_alloc(n);
+
+      create_random_nonsymm_matrix(m, r, -10, 10);
+      test_eigen_nonsymm_trace(m, "random");
+
+      gsl_eigen_nonsymmv_params(0, w);
+      test_eigen_nonsymm_matrix(m, 0, "random, unbalanced", w);
+
+      gsl_eigen_nonsymmv_params(1, w);
+      test_eigen_nonsymm_matrix(m, 0, "random, balanced", w);
+
+      gsl_matrix_free(m);
+      gsl_eigen_nonsymmv_free(w);
+    }
+
   gsl_rng_free(r);
 
   {
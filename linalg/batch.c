@@ -0,0 +1,719 @@
+/* linalg/batch.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Batched LU and Cholesky factorizations of many small matrices of
+ * the same size N. The matrices are stored one after another in an
+ * (nbatch*N)-by-N matrix, and right hand sides in a vector of length
+ * nbatch*N.
+ *
+ * The problems are processed in groups of BATCH_GROUP. Each group is
+ * copied into a workspace in interleaved order,
+ *
+ *   W[(i*N + j)*BATCH_GROUP + l] = A_l(i,j)
+ *
+ * so that the innermost loop of every kernel runs over the problems of
+ * the group with unit stride and a fixed trip count, and is vectorized
+ * by the compiler. A partial last group is padded with identity
+ * matrices. Each problem is factored with the same operations as the
+ * unblocked LAPACK routines DGETF2 and DPOTF2.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+
+/* number of problems processed together */
+#define BATCH_GROUP 8
+
+static int batch_check (const gsl_matrix * A, size_t * nbatch);
+static void batch_pack (const gsl_matrix * A, const size_t b0, const size_t ng, double * W);
+static void batch_unpack (const double * W, const size_t b0, const size_t ng, gsl_matrix * A);
+static void batch_pack_vector (const gsl_vector * x, const size_t N, const size_t b0,
+                               const size_t ng, double * X);
+static void batch_unpack_vector (const double * X, const size_t N, const size_t b0,
+                                 const size_t ng, gsl_vector * x);
+static void LU_batch_L2 (const size_t N, double * W, size_t * ipiv);
+static void LU_batch_svx (const size_t N, const double * W, const size_t * ipiv, double * X);
+static void cholesky_batch_L2 (const size_t N, double * W, int * bad);
+static void cholesky_batch_svx (const size_t N, const double * W, double * X);
+
+/*
+gsl_linalg_LU_decomp_batch()
+  LU decomposition with partial pivoting of a stack of square matrices
+
+Inputs: A    - on input, nbatch*N-by-N matrix holding the N-by-N matrices
+               A_b in rows b*N to b*N+N-1; on output, the L and U factors
+               of each matrix, in the format of gsl_linalg_LU_decomp
+        ipiv - (output) row interchanges, length nbatch*N; at step k,
+               row k of A_b was interchanged with row ipiv[b*N+k]
+
+Return: success/error
+
+Notes:
+1) Singular matrices are not detected here, as in gsl_linalg_LU_decomp
+*/
+
+int
+gsl_linalg_LU_decomp_batch (gsl_matrix * A, gsl_vector_uint * ipiv)
+{
+  size_t nbatch;
+  int status = batch_check (A, &nbatch);
+
+  if (status)
+    {
+      return status;
+    }
+  else if (ipiv->size != A->size1)
+    {
+      GSL_ERROR ("ipiv length must match matrix size1", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t N = A->size2;
+      double *W = malloc (N * N * BATCH_GROUP * sizeof (double));
+      size_t *piv = malloc (N * BATCH_GROUP * sizeof (size_t));
+      size_t b0, k, l;
+
+      if (W == NULL || piv == NULL)
+        {
+          free (W);
+          free (piv);
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      for (b0 = 0; b0 < nbatch; b0 += BATCH_GROUP)
+        {
+          const size_t ng = GSL_MIN (BATCH_GROUP, nbatch - b0);
+
+          batch_pack (A, b0, ng, W);
+          LU_batch_L2 (N, W, piv);
+          batch_unpack (W, b0, ng, A);
+
+          for (l = 0; l < ng; ++l)
+            {
+              for (k = 0; k < N; ++k)
+                gsl_vector_uint_set (ipiv, (b0 + l) * N + k, piv[k * BATCH_GROUP + l]);
+            }
+        }
+
+      free (W);
+      free (piv);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_LU_solve_batch()
+  Solve A_b x_b = b_b for each matrix of the stack
+
+Inputs: LU   - LU factors from gsl_linalg_LU_decomp_batch
+        ipiv - row interchanges from gsl_linalg_LU_decomp_batch
+        b    - right hand sides, length nbatch*N
+        x    - (output) solutions, length nbatch*N
+*/
+
+int
+gsl_linalg_LU_solve_batch (const gsl_matrix * LU, const gsl_vector_uint * ipiv,
+                           const gsl_vector * b, gsl_vector * x)
+{
+  if (LU->size1 != b->size)
+    {
+      GSL_ERROR ("matrix size1 must match b size", GSL_EBADLEN);
+    }
+  else if (LU->size1 != x->size)
+    {
+      GSL_ERROR ("matrix size1 must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_vector_memcpy (x, b);
+      return gsl_linalg_LU_svx_batch (LU, ipiv, x);
+    }
+}
+
+/*
+gsl_linalg_LU_svx_batch()
+  Solve A_b x_b = b_b in place for each matrix of the stack
+
+Inputs: LU   - LU factors from gsl_linalg_LU_decomp_batch
+        ipiv - row interchanges from gsl_linalg_LU_decomp_batch
+        x    - on input, right hand sides; on output, solutions
+
+Return: success/error; GSL_EDOM if any of the matrices is singular, in
+which case x is not modified
+*/
+
+int
+gsl_linalg_LU_svx_batch (const gsl_matrix * LU, const gsl_vector_uint * ipiv,
+                         gsl_vector * x)
+{
+  size_t nbatch;
+  int status = batch_check (LU, &nbatch);
+
+  if (status)
+    {
+      return status;
+    }
+  else if (ipiv->size != LU->size1)
+    {
+      GSL_ERROR ("ipiv length must match matrix size1", GSL_EBADLEN);
+    }
+  else if (x->size != LU->size1)
+    {
+      GSL_ERROR ("matrix size1 must match solution/rhs size", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t N = LU->size2;
+      double *W;
+      double *X;
+      size_t *piv;
+      size_t b0, i, k, l;
+
+      for (i = 0; i < LU->size1; ++i)
+        {
+          if (gsl_matrix_get (LU, i, i % N) == 0.0)
+            {
+              GSL_ERROR ("matrix is singular", GSL_EDOM);
+            }
+        }
+
+      W = malloc (N * N * BATCH_GROUP * sizeof (double));
+      X = malloc (N * BATCH_GROUP * sizeof (double));
+      piv = malloc (N * BATCH_GROUP * sizeof (size_t));
+
+      if (W == NULL || X == NULL || piv == NULL)
+        {
+          free (W);
+          free (X);
+          free (piv);
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      for (b0 = 0; b0 < nbatch; b0 += BATCH_GROUP)
+        {
+          const size_t ng = GSL_MIN (BATCH_GROUP, nbatch - b0);
+
+          for (k = 0; k < N; ++k)
+            {
+              for (l = 0; l < BATCH_GROUP; ++l)
+                piv[k * BATCH_GROUP + l] = (l < ng) ? gsl_vector_uint_get (ipiv, (b0 + l) * N + k) : k;
+            }
+
+          batch_pack (LU, b0, ng, W);
+          batch_pack_vector (x, N, b0, ng, X);
+          LU_batch_svx (N, W, piv, X);
+          batch_unpack_vector (X, N, b0, ng, x);
+        }
+
+      free (W);
+      free (X);
+      free (piv);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_cholesky_decomp_batch()
+  Cholesky decomposition of a stack of symmetric positive definite
+matrices
+
+Inputs: A - on input, nbatch*N-by-N matrix holding the N-by-N matrices
+            A_b in rows b*N to b*N+N-1, of which only the lower
+            triangles are referenced; on output, L_b is stored in the
+            lower triangle of each A_b and the original matrix in its
+            upper triangle, as in gsl_linalg_cholesky_decomp1
+
+Return: success/error; GSL_EDOM if any of the matrices is not positive
+definite. The factors of the other matrices are still valid in that case.
+*/
+
+int
+gsl_linalg_cholesky_decomp_batch (gsl_matrix * A)
+{
+  size_t nbatch;
+  int status = batch_check (A, &nbatch);
+
+  if (status)
+    {
+      return status;
+    }
+  else
+    {
+      const size_t N = A->size2;
+      double *W = malloc (N * N * BATCH_GROUP * sizeof (double));
+      int bad[BATCH_GROUP];
+      int posdef = 1;
+      size_t b0, l;
+
+      if (W == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      for (b0 = 0; b0 < nbatch; b0 += BATCH_GROUP)
+        {
+          const size_t ng = GSL_MIN (BATCH_GROUP, nbatch - b0);
+
+          batch_pack (A, b0, ng, W);
+          cholesky_batch_L2 (N, W, bad);
+          batch_unpack (W, b0, ng, A);
+
+          for (l = 0; l < ng; ++l)
+            {
+              if (bad[l])
+                posdef = 0;
+            }
+        }
+
+      free (W);
+
+      if (!posdef)
+        {
+          GSL_ERROR ("matrix is not positive definite", GSL_EDOM);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_cholesky_solve_batch()
+  Solve A_b x_b = b_b for each matrix of the stack
+
+Inputs: LLT - Cholesky factors from gsl_linalg_cholesky_decomp_batch
+        b   - right hand sides, length nbatch*N
+        x   - (output) solutions, length nbatch*N
+*/
+
+int
+gsl_linalg_cholesky_solve_batch (const gsl_matrix * LLT, const gsl_vector * b,
+                                 gsl_vector * x)
+{
+  if (LLT->size1 != b->size)
+    {
+      GSL_ERROR ("matrix size1 must match b size", GSL_EBADLEN);
+    }
+  else if (LLT->size1 != x->size)
+    {
+      GSL_ERROR ("matrix size1 must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_vector_memcpy (x, b);
+      return gsl_linalg_cholesky_svx_batch (LLT, x);
+    }
+}
+
+/*
+gsl_linalg_cholesky_svx_batch()
+  Solve A_b x_b = b_b in place for each matrix of the stack
+
+Inputs: LLT - Cholesky factors from gsl_linalg_cholesky_decomp_batch
+        x   - on input, right hand sides; on output, solutions
+*/
+
+int
+gsl_linalg_cholesky_svx_batch (const gsl_matrix * LLT, gsl_vector * x)
+{
+  size_t nbatch;
+  int status = batch_check (LLT, &nbatch);
+
+  if (status)
+    {
+      return status;
+    }
+  else if (x->size != LLT->size1)
+    {
+      GSL_ERROR ("matrix size1 must match solution/rhs size", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t N = LLT->size2;
+      double *W = malloc (N * N * BATCH_GROUP * sizeof (double));
+      double *X = malloc (N * BATCH_GROUP * sizeof (double));
+      size_t b0;
+
+      if (W == NULL || X == NULL)
+        {
+          free (W);
+          free (X);
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      for (b0 = 0; b0 < nbatch; b0 += BATCH_GROUP)
+        {
+          const size_t ng = GSL_MIN (BATCH_GROUP, nbatch - b0);
+
+          batch_pack (LLT, b0, ng, W);
+          batch_pack_vector (x, N, b0, ng, X);
+          cholesky_batch_svx (N, W, X);
+          batch_unpack_vector (X, N, b0, ng, x);
+        }
+
+      free (W);
+      free (X);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* check that A is a stack of square matrices and count them */
+static int
+batch_check (const gsl_matrix * A, size_t * nbatch)
+{
+  const size_t N = A->size2;
+
+  if (N == 0 || A->size1 % N != 0)
+    {
+      GSL_ERROR ("matrix size1 must be a multiple of size2", GSL_EBADLEN);
+    }
+
+  *nbatch = A->size1 / N;
+
+  return GSL_SUCCESS;
+}
+
+/* copy problems b0,...,b0+ng-1 of the stack into interleaved order,
+ * filling the remaining lanes with the identity matrix */
+static void
+batch_pack (const gsl_matrix * A, const size_t b0, const size_t ng, double * W)
+{
+  const size_t N = A->size2;
+  size_t i, j, l;
+
+  for (l = 0; l < BATCH_GROUP; ++l)
+    {
+      for (i = 0; i < N; ++i)
+        {
+          const double * Ai = (l < ng) ? gsl_matrix_const_ptr (A, (b0 + l) * N + i, 0) : NULL;
+
+          for (j = 0; j < N; ++j)
+            W[(i * N + j) * BATCH_GROUP + l] = (Ai != NULL) ? Ai[j] : (double) (i == j);
+        }
+    }
+}
+
+static void
+batch_unpack (const double * W, const size_t b0, const size_t ng, gsl_matrix * A)
+{
+  const size_t N = A->size2;
+  size_t i, j, l;
+
+  for (l = 0; l < ng; ++l)
+    {
+      for (i = 0; i < N; ++i)
+        {
+          double * Ai = gsl_matrix_ptr (A, (b0 + l) * N + i, 0);
+
+          for (j = 0; j < N; ++j)
+            Ai[j] = W[(i * N + j) * BATCH_GROUP + l];
+        }
+    }
+}
+
+static void
+batch_pack_vector (const gsl_vector * x, const size_t N, const size_t b0,
+                   const size_t ng, double * X)
+{
+  size_t i, l;
+
+  for (l = 0; l < BATCH_GROUP; ++l)
+    {
+      for (i = 0; i < N; ++i)
+        X[i * BATCH_GROUP + l] = (l < ng) ? x->data[((b0 + l) * N + i) * x->stride] : 0.0;
+    }
+}
+
+static void
+batch_unpack_vector (const double * X, const size_t N, const size_t b0,
+                     const size_t ng, gsl_vector * x)
+{
+  size_t i, l;
+
+  for (l = 0; l < ng; ++l)
+    {
+      for (i = 0; i < N; ++i)
+        x->data[((b0 + l) * N + i) * x->stride] = X[i * BATCH_GROUP + l];
+    }
+}
+
+/*
+LU_batch_L2()
+  LU decomposition with partial pivoting of one interleaved group
+
+Inputs: N    - matrix size
+        W    - on input, group of matrices; on output, L and U factors
+        ipiv - (output) row interchanges, ipiv[k*BATCH_GROUP + l] for
+               step k of problem l
+
+Notes:
+1) Based on LAPACK DGETF2, as LU_decomp_L2. The pivot search and row
+interchanges differ between problems and are done one problem at a
+time; the elimination, which is O(N^3), runs across the problems.
+*/
+
+static void
+LU_batch_L2 (const size_t N, double * W, size_t * ipiv)
+{
+  /* the kernels work on local copies of the lane vectors, which the
+   * compiler knows do not overlap W */
+  double m[BATCH_GROUP], u[BATCH_GROUP];
+  size_t i, j, k, l;
+
+  for (k = 0; k < N; ++k)
+    {
+      double * Wk = W + k * N * BATCH_GROUP;
+
+      for (l = 0; l < BATCH_GROUP; ++l)
+        {
+          size_t p = k;
+          double max = fabs (Wk[k * BATCH_GROUP + l]);
+
+          for (i = k + 1; i < N; ++i)
+            {
+              double t = fabs (W[(i * N + k) * BATCH_GROUP + l]);
+
+              if (t > max)
+                {
+                  max = t;
+                  p = i;
+                }
+            }
+
+          ipiv[k * BATCH_GROUP + l] = p;
+
+          if (p != k)
+            {
+              double * Wp = W + p * N * BATCH_GROUP;
+
+              for (j = 0; j < N; ++j)
+                {
+                  double t = Wk[j * BATCH_GROUP + l];
+                  Wk[j * BATCH_GROUP + l] = Wp[j * BATCH_GROUP + l];
+                  Wp[j * BATCH_GROUP + l] = t;
+                }
+            }
+        }
+
+      for (l = 0; l < BATCH_GROUP; ++l)
+        u[l] = 1.0 / Wk[k * BATCH_GROUP + l];
+
+      for (i = k + 1; i < N; ++i)
+        {
+          double * Wi = W + i * N * BATCH_GROUP;
+
+          for (l = 0; l < BATCH_GROUP; ++l)
+            Wi[k * BATCH_GROUP + l] *= u[l];
+        }
+
+      /* A(k+1:N,k+1:N) -= A(k+1:N,k) A(k,k+1:N) */
+      for (j = k + 1; j < N; ++j)
+        {
+          for (l = 0; l < BATCH_GROUP; ++l)
+            u[l] = Wk[j * BATCH_GROUP + l];
+
+          for (i = k + 1; i < N; ++i)
+            {
+              double * Wi = W + i * N * BATCH_GROUP;
+
+              for (l = 0; l < BATCH_GROUP; ++l)
+                m[l] = Wi[k * BATCH_GROUP + l];
+
+              for (l = 0; l < BATCH_GROUP; ++l)
+                Wi[j * BATCH_GROUP + l] -= m[l] * u[l];
+            }
+        }
+    }
+}
+
+/* solve L U x = P b for one interleaved group */
+static void
+LU_batch_svx (const size_t N, const double * W, const size_t * ipiv, double * X)
+{
+  double s[BATCH_GROUP];
+  size_t i, j, k, l;
+
+  for (k = 0; k < N; ++k)
+    {
+      for (l = 0; l < BATCH_GROUP; ++l)
+        {
+          const size_t p = ipiv[k * BATCH_GROUP + l];
+          double t = X[k * BATCH_GROUP + l];
+
+          X[k * BATCH_GROUP + l] = X[p * BATCH_GROUP + l];
+          X[p * BATCH_GROUP + l] = t;
+        }
+    }
+
+  /* L y = P b, L unit lower triangular */
+  for (i = 1; i < N; ++i)
+    {
+      for (l = 0; l < BATCH_GROUP; ++l)
+        s[l] = X[i * BATCH_GROUP + l];
+
+      for (j = 0; j < i; ++j)
+        {
+          for (l = 0; l < BATCH_GROUP; ++l)
+            s[l] -= W[(i * N + j) * BATCH_GROUP + l] * X[j * BATCH_GROUP + l];
+        }
+
+      for (l = 0; l < BATCH_GROUP; ++l)
+        X[i * BATCH_GROUP + l] = s[l];
+    }
+
+  /* U x = y */
+  for (i = N; i-- > 0; )
+    {
+      for (l = 0; l < BATCH_GROUP; ++l)
+        s[l] = X[i * BATCH_GROUP + l];
+
+      for (j = i + 1; j < N; ++j)
+        {
+          for (l = 0; l < BATCH_GROUP; ++l)
+            s[l] -= W[(i * N + j) * BATCH_GROUP + l] * X[j * BATCH_GROUP + l];
+        }
+
+      for (l = 0; l < BATCH_GROUP; ++l)
+        X[i * BATCH_GROUP + l] = s[l] / W[(i * N + i) * BATCH_GROUP + l];
+    }
+}
+
+/*
+cholesky_batch_L2()
+  Cholesky decomposition of one interleaved group
+
+Inputs: N   - matrix size
+        W   - on input, group of matrices, lower triangles referenced;
+              on output, L in the lower triangle and the original
+              matrix in the upper
+        bad - (output) bad[l] is nonzero if problem l is not positive
+              definite
+
+Notes:
+1) A problem which is not positive definite is finished with NaNs,
+without affecting the others
+*/
+
+static void
+cholesky_batch_L2 (const size_t N, double * W, int * bad)
+{
+  double m[BATCH_GROUP], u[BATCH_GROUP];
+  size_t i, j, k, l;
+
+  for (l = 0; l < BATCH_GROUP; ++l)
+    bad[l] = 0;
+
+  /* save the original matrix in the upper triangle */
+  for (i = 0; i < N; ++i)
+    {
+      for (j = i + 1; j < N; ++j)
+        {
+          for (l = 0; l < BATCH_GROUP; ++l)
+            W[(i * N + j) * BATCH_GROUP + l] = W[(j * N + i) * BATCH_GROUP + l];
+        }
+    }
+
+  for (k = 0; k < N; ++k)
+    {
+      double * Wk = W + k * N * BATCH_GROUP;
+
+      for (l = 0; l < BATCH_GROUP; ++l)
+        {
+          double akk = Wk[k * BATCH_GROUP + l];
+
+          bad[l] |= !(akk > 0.0);
+          akk = sqrt (akk);
+          Wk[k * BATCH_GROUP + l] = akk;
+          u[l] = 1.0 / akk;
+        }
+
+      for (i = k + 1; i < N; ++i)
+        {
+          double * Wik = W + (i * N + k) * BATCH_GROUP;
+
+          for (l = 0; l < BATCH_GROUP; ++l)
+            Wik[l] *= u[l];
+        }
+
+      /* update lower triangle of trailing matrix */
+      for (j = k + 1; j < N; ++j)
+        {
+          for (l = 0; l < BATCH_GROUP; ++l)
+            u[l] = W[(j * N + k) * BATCH_GROUP + l];
+
+          for (i = j; i < N; ++i)
+            {
+              double * Wi = W + i * N * BATCH_GROUP;
+
+              for (l = 0; l < BATCH_GROUP; ++l)
+                m[l] = Wi[k * BATCH_GROUP + l];
+
+              for (l = 0; l < BATCH_GROUP; ++l)
+                Wi[j * BATCH_GROUP + l] -= m[l] * u[l];
+            }
+        }
+    }
+}
+
+/* solve L L^T x = b for one interleaved group, using the lower triangle */
+static void
+cholesky_batch_svx (const size_t N, const double * W, double * X)
+{
+  double s[BATCH_GROUP];
+  size_t i, j, l;
+
+  /* L y = b */
+  for (i = 0; i < N; ++i)
+    {
+      for (l = 0; l < BATCH_GROUP; ++l)
+        s[l] = X[i * BATCH_GROUP + l];
+
+      for (j = 0; j < i; ++j)
+        {
+          for (l = 0; l < BATCH_GROUP; ++l)
+            s[l] -= W[(i * N + j) * BATCH_GROUP + l] * X[j * BATCH_GROUP + l];
+        }
+
+      for (l = 0; l < BATCH_GROUP; ++l)
+        X[i * BATCH_GROUP + l] = s[l] / W[(i * N + i) * BATCH_GROUP + l];
+    }
+
+  /* L^T x = y */
+  for (i = N; i-- > 0; )
+    {
+      for (l = 0; l < BATCH_GROUP; ++l)
+        s[l] = X[i * BATCH_GROUP + l];
+
+      for (j = i + 1; j < N; ++j)
+        {
+          for (l = 0; l < BATCH_GROUP; ++l)
+            s[l] -= W[(j * N + i) * BATCH_GROUP + l] * X[j * BATCH_GROUP + l];
+        }
+
+      for (l = 0; l < BATCH_GROUP; ++l)
+        X[i * BATCH_GROUP + l] = s[l] / W[(i * N + i) * BATCH_GROUP + l];
+    }
+}
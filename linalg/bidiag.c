@@ -71,6 +71,20 @@
 
 #include <gsl/gsl_linalg.h>
 
+/* number of columns reduced per panel by the blocked algorithm */
+#define BIDIAG_BLOCK 32
+
+/* the blocked algorithm is used while more than this many columns
+ * remain to be reduced */
+#define BIDIAG_CROSSOVER 128
+
+static int bidiag_decomp_L2 (gsl_matrix * A, const size_t i0,
+                             gsl_vector * tau_U, gsl_vector * tau_V);
+static int bidiag_decomp_L3 (gsl_matrix * A, gsl_vector * tau_U, gsl_vector * tau_V);
+static void bidiag_panel (gsl_matrix * A, const size_t nb, gsl_vector * tau_U,
+                          gsl_vector * tau_V, gsl_matrix * X, gsl_matrix * Y,
+                          gsl_vector * work, double d[], double e[]);
+
 int 
 gsl_linalg_bidiag_decomp (gsl_matrix * A, gsl_vector * tau_U, gsl_vector * tau_V)  
 {
@@ -88,57 +102,315 @@ gsl_linalg_bidiag_decomp (gsl_matrix * A, gsl_vector * tau_U, gsl_vector * tau_V
     }
   else
     {
-      const size_t M = A->size1;
-      const size_t N = A->size2;
-      size_t i;
-  
-      for (i = 0 ; i < N; i++)
+      if (A->size2 > BIDIAG_CROSSOVER)
         {
-          /* Apply Householder transformation to current column */
-          
-          {
-            gsl_vector_view c = gsl_matrix_column (A, i);
-            gsl_vector_view v = gsl_vector_subvector (&c.vector, i, M - i);
-            double tau_i = gsl_linalg_householder_transform (&v.vector);
-            
-            /* Apply the transformation to the remaining columns */
-            
-            if (i + 1 < N)
-              {
-                gsl_matrix_view m = 
-                  gsl_matrix_submatrix (A, i, i + 1, M - i, N - (i + 1));
-                gsl_linalg_householder_hm (tau_i, &v.vector, &m.matrix);
-              }
-
-            gsl_vector_set (tau_U, i, tau_i);            
+          int status = bidiag_decomp_L3 (A, tau_U, tau_V);
+
+          if (status != GSL_ENOMEM)
+            return status;
+
+          /* not enough memory for the panel workspace, fall through to
+           * the unblocked algorithm */
+        }
+
+      return bidiag_decomp_L2 (A, 0, tau_U, tau_V);
+    }
+}
+
+/* reduce columns and rows i0 and beyond, one at a time */
+
+static int
+bidiag_decomp_L2 (gsl_matrix * A, const size_t i0, gsl_vector * tau_U,
+                  gsl_vector * tau_V)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  gsl_vector *work = gsl_vector_alloc (M + N);
+  size_t i;
+
+  if (work == 0)
+    {
+      GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  for (i = i0 ; i < N; i++)
+    {
+      /* Apply Householder transformation to current column */
+
+      gsl_vector_view c = gsl_matrix_column (A, i);
+      gsl_vector_view v = gsl_vector_subvector (&c.vector, i, M - i);
+      double tau_i = gsl_linalg_householder_transform (&v.vector);
+
+      gsl_vector_set (tau_U, i, tau_i);
 
+      if (i + 1 < N)
+        {
+          gsl_matrix_view m =
+            gsl_matrix_submatrix (A, i, i + 1, M - i, N - (i + 1));
+          gsl_vector_view w = gsl_vector_subvector (work, 0, N - (i + 1));
+          gsl_vector_view r = gsl_matrix_row (A, i);
+          gsl_vector_view x = gsl_vector_subvector (&r.vector, i + 1, N - (i + 1));
+          double tau_j;
+
+          /* Apply the column transformation to the remaining
+           * columns: w = m^T v, m = m - tau_i v w^T. Only row i of
+           * m is updated here, the rest of the update is fused with
+           * the row transformation below */
+
+          {
+            double d = gsl_vector_get (&v.vector, 0);
+            gsl_vector_set (&v.vector, 0, 1.0);
+            gsl_blas_dgemv (CblasTrans, 1.0, &m.matrix, &v.vector, 0.0, &w.vector);
+            gsl_vector_set (&v.vector, 0, d);
           }
 
+          gsl_blas_daxpy (-tau_i, &w.vector, &x.vector);
+
           /* Apply Householder transformation to current row */
-          
-          if (i + 1 < N)
+
+          tau_j = gsl_linalg_householder_transform (&x.vector);
+
+          /* Finish the column transformation of the remaining rows
+           * and apply the row transformation to them, b = b - tau_j
+           * y x^T with y = b x, sweeping over b twice instead of
+           * four times */
+
+          if (i + 1 < M)
             {
-              gsl_vector_view r = gsl_matrix_row (A, i);
-              gsl_vector_view v = gsl_vector_subvector (&r.vector, i + 1, N - (i + 1));
-              double tau_i = gsl_linalg_householder_transform (&v.vector);
-              
-              /* Apply the transformation to the remaining rows */
-              
-              if (i + 1 < M)
-                {
-                  gsl_matrix_view m = 
-                    gsl_matrix_submatrix (A, i+1, i+1, M - (i+1), N - (i+1));
-                  gsl_linalg_householder_mh (tau_i, &v.vector, &m.matrix);
-                }
-
-              gsl_vector_set (tau_V, i, tau_i);
+              gsl_matrix_view b =
+                gsl_matrix_submatrix (A, i + 1, i + 1, M - (i + 1), N - (i + 1));
+              gsl_vector_view u = gsl_vector_subvector (&v.vector, 1, M - (i + 1));
+              gsl_vector_view y = gsl_vector_subvector (work, N, M - (i + 1));
+              double d = gsl_vector_get (&x.vector, 0);
+
+              gsl_vector_set (&x.vector, 0, 1.0);
+              gsl_blas_dger_gemv (CblasNoTrans, -tau_i, &u.vector, &w.vector,
+                                  &b.matrix, &x.vector, 0.0, &y.vector);
+
+              if (tau_j != 0.0)
+                gsl_blas_dger (-tau_j, &y.vector, &x.vector, &b.matrix);
+
+              gsl_vector_set (&x.vector, 0, d);
             }
+
+          gsl_vector_set (tau_V, i, tau_j);
         }
     }
-        
+
+  gsl_vector_free (work);
+
   return GSL_SUCCESS;
 }
 
+/* Blocked reduction (LAPACK dgebrd/dlabrd). The columns and rows are
+ * reduced in panels of BIDIAG_BLOCK. Within a panel the reflectors are
+ * applied only to the rows and columns being reduced, and the updates
+ * which the unblocked algorithm would make to the rest of the matrix
+ * are collected in the matrices X and Y. The rest of the matrix is
+ * then updated with
+ *
+ *   A := A - V Y^T - X U^T
+ *
+ * where V and U hold the column and row Householder vectors of the
+ * panel, so that half of the flops are done by dgemm. The last
+ * BIDIAG_CROSSOVER columns are reduced by bidiag_decomp_L2. */
+
+static int
+bidiag_decomp_L3 (gsl_matrix * A, gsl_vector * tau_U, gsl_vector * tau_V)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  gsl_matrix *X = gsl_matrix_alloc (M, BIDIAG_BLOCK);
+  gsl_matrix *Y = gsl_matrix_alloc (N, BIDIAG_BLOCK);
+  gsl_vector *work = gsl_vector_alloc (N);
+  size_t i = 0;
+
+  if (X == 0 || Y == 0 || work == 0)
+    {
+      if (X)
+        gsl_matrix_free (X);
+      if (Y)
+        gsl_matrix_free (Y);
+      if (work)
+        gsl_vector_free (work);
+
+      return GSL_ENOMEM;
+    }
+
+  while (N - i > BIDIAG_CROSSOVER)
+    {
+      const size_t m = M - i;
+      const size_t n = N - i;
+      const size_t nb = GSL_MIN (BIDIAG_BLOCK, n - BIDIAG_CROSSOVER);
+      gsl_matrix_view Ai = gsl_matrix_submatrix (A, i, i, m, n);
+      gsl_vector_view tu = gsl_vector_subvector (tau_U, i, nb);
+      gsl_vector_view tv = gsl_vector_subvector (tau_V, i, nb);
+      gsl_matrix_view Xi = gsl_matrix_submatrix (X, 0, 0, m, nb);
+      gsl_matrix_view Yi = gsl_matrix_submatrix (Y, 0, 0, n, nb);
+      double d[BIDIAG_BLOCK], e[BIDIAG_BLOCK];
+      size_t j;
+
+      /* the panel leaves the unit elements of its Householder vectors
+       * in place on the diagonal and superdiagonal for the update */
+
+      bidiag_panel (&Ai.matrix, nb, &tu.vector, &tv.vector,
+                    &Xi.matrix, &Yi.matrix, work, d, e);
+
+      {
+        gsl_matrix_view V = gsl_matrix_submatrix (&Ai.matrix, nb, 0, m - nb, nb);
+        gsl_matrix_view U = gsl_matrix_submatrix (&Ai.matrix, 0, nb, nb, n - nb);
+        gsl_matrix_view X2 = gsl_matrix_submatrix (&Xi.matrix, nb, 0, m - nb, nb);
+        gsl_matrix_view Y2 = gsl_matrix_submatrix (&Yi.matrix, nb, 0, n - nb, nb);
+        gsl_matrix_view A22 = gsl_matrix_submatrix (&Ai.matrix, nb, nb, m - nb, n - nb);
+
+        gsl_blas_dgemm (CblasNoTrans, CblasTrans, -1.0, &V.matrix, &Y2.matrix,
+                        1.0, &A22.matrix);
+        gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, -1.0, &X2.matrix, &U.matrix,
+                        1.0, &A22.matrix);
+      }
+
+      for (j = 0; j < nb; j++)
+        {
+          gsl_matrix_set (&Ai.matrix, j, j, d[j]);
+          gsl_matrix_set (&Ai.matrix, j, j + 1, e[j]);
+        }
+
+      i += nb;
+    }
+
+  gsl_matrix_free (X);
+  gsl_matrix_free (Y);
+  gsl_vector_free (work);
+
+  return bidiag_decomp_L2 (A, i, tau_U, tau_V);
+}
+
+/* reduce the first nb columns and rows of the m-by-n matrix A, m >= n > nb,
+ * and compute the m-by-nb matrix X and n-by-nb matrix Y such that the
+ * remaining matrix is updated by A(nb:m,nb:n) -= V Y^T + X U^T. On
+ * output the elements A(j,j) and A(j,j+1) are set to 1, and the
+ * elements of the bidiagonal matrix which belong there are stored in
+ * d[j] and e[j]. The vector work, of length at least n, holds a
+ * contiguous copy of the columns of Y for dgemv */
+
+static void
+bidiag_panel (gsl_matrix * A, const size_t nb, gsl_vector * tau_U,
+              gsl_vector * tau_V, gsl_matrix * X, gsl_matrix * Y,
+              gsl_vector * work, double d[], double e[])
+{
+  const size_t m = A->size1;
+  const size_t n = A->size2;
+  size_t i;
+
+  for (i = 0; i < nb; i++)
+    {
+      gsl_vector_view c = gsl_matrix_subcolumn (A, i, i, m - i);
+      gsl_vector_view r = gsl_matrix_subrow (A, i, i + 1, n - i - 1);
+      gsl_vector_view yc = gsl_matrix_subcolumn (Y, i, i + 1, n - i - 1);
+      gsl_vector_view xc = gsl_matrix_subcolumn (X, i, i + 1, m - i - 1);
+      double tau_i, tau_j;
+
+      /* bring column i up to date with the previous reflectors,
+       * A(i:m,i) -= V(i:m,0:i) Y(i,0:i)^T + X(i:m,0:i) U(0:i,i) */
+
+      if (i > 0)
+        {
+          gsl_matrix_view Vi = gsl_matrix_submatrix (A, i, 0, m - i, i);
+          gsl_matrix_view Xi = gsl_matrix_submatrix (X, i, 0, m - i, i);
+          gsl_vector_view yr = gsl_matrix_subrow (Y, i, 0, i);
+          gsl_vector_view uc = gsl_matrix_subcolumn (A, i, 0, i);
+
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Vi.matrix, &yr.vector, 1.0, &c.vector);
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Xi.matrix, &uc.vector, 1.0, &c.vector);
+        }
+
+      /* Householder transformation for A(i:m,i) */
+
+      tau_i = gsl_linalg_householder_transform (&c.vector);
+      gsl_vector_set (tau_U, i, tau_i);
+      d[i] = gsl_matrix_get (A, i, i);
+      gsl_matrix_set (A, i, i, 1.0);
+
+      /* Y(i+1:n,i) = tau_i (A - V Y^T - X U^T)^T v, with A the trailing
+       * part of the matrix which has not yet been updated */
+
+      {
+        gsl_matrix_view m1 = gsl_matrix_submatrix (A, i, i + 1, m - i, n - i - 1);
+        gsl_vector_view yt = gsl_vector_subvector (work, 0, n - i - 1);
+
+        gsl_blas_dgemv (CblasTrans, 1.0, &m1.matrix, &c.vector, 0.0, &yt.vector);
+        gsl_blas_dcopy (&yt.vector, &yc.vector);
+      }
+
+      if (i > 0)
+        {
+          gsl_matrix_view Vi = gsl_matrix_submatrix (A, i, 0, m - i, i);
+          gsl_matrix_view Xi = gsl_matrix_submatrix (X, i, 0, m - i, i);
+          gsl_matrix_view Yi = gsl_matrix_submatrix (Y, i + 1, 0, n - i - 1, i);
+          gsl_matrix_view Ui = gsl_matrix_submatrix (A, 0, i + 1, i, n - i - 1);
+          gsl_vector_view t = gsl_matrix_subcolumn (Y, i, 0, i);
+
+          gsl_blas_dgemv (CblasTrans, 1.0, &Vi.matrix, &c.vector, 0.0, &t.vector);
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Yi.matrix, &t.vector, 1.0, &yc.vector);
+          gsl_blas_dgemv (CblasTrans, 1.0, &Xi.matrix, &c.vector, 0.0, &t.vector);
+          gsl_blas_dgemv (CblasTrans, -1.0, &Ui.matrix, &t.vector, 1.0, &yc.vector);
+        }
+
+      gsl_blas_dscal (tau_i, &yc.vector);
+
+      /* bring row i up to date,
+       * A(i,i+1:n) -= Y(i+1:n,0:i+1) V(i,0:i+1)^T + X(i,0:i) U(0:i,i+1:n) */
+
+      {
+        gsl_matrix_view Yi = gsl_matrix_submatrix (Y, i + 1, 0, n - i - 1, i + 1);
+        gsl_vector_view vr = gsl_matrix_subrow (A, i, 0, i + 1);
+
+        gsl_blas_dgemv (CblasNoTrans, -1.0, &Yi.matrix, &vr.vector, 1.0, &r.vector);
+      }
+
+      if (i > 0)
+        {
+          gsl_matrix_view Ui = gsl_matrix_submatrix (A, 0, i + 1, i, n - i - 1);
+          gsl_vector_view xr = gsl_matrix_subrow (X, i, 0, i);
+
+          gsl_blas_dgemv (CblasTrans, -1.0, &Ui.matrix, &xr.vector, 1.0, &r.vector);
+        }
+
+      /* Householder transformation for A(i,i+1:n) */
+
+      tau_j = gsl_linalg_householder_transform (&r.vector);
+      gsl_vector_set (tau_V, i, tau_j);
+      e[i] = gsl_matrix_get (A, i, i + 1);
+      gsl_matrix_set (A, i, i + 1, 1.0);
+
+      /* X(i+1:m,i) = tau_j (A - V Y^T - X U^T) u, with A the trailing
+       * part of the matrix which has not yet been updated */
+
+      {
+        gsl_matrix_view m1 = gsl_matrix_submatrix (A, i + 1, i + 1, m - i - 1, n - i - 1);
+        gsl_matrix_view Vi = gsl_matrix_submatrix (A, i + 1, 0, m - i - 1, i + 1);
+        gsl_matrix_view Yi = gsl_matrix_submatrix (Y, i + 1, 0, n - i - 1, i + 1);
+        gsl_vector_view t = gsl_matrix_subcolumn (X, i, 0, i + 1);
+
+        gsl_blas_dgemv (CblasNoTrans, 1.0, &m1.matrix, &r.vector, 0.0, &xc.vector);
+        gsl_blas_dgemv (CblasTrans, 1.0, &Yi.matrix, &r.vector, 0.0, &t.vector);
+        gsl_blas_dgemv (CblasNoTrans, -1.0, &Vi.matrix, &t.vector, 1.0, &xc.vector);
+      }
+
+      if (i > 0)
+        {
+          gsl_matrix_view Ui = gsl_matrix_submatrix (A, 0, i + 1, i, n - i - 1);
+          gsl_matrix_view Xi = gsl_matrix_submatrix (X, i + 1, 0, m - i - 1, i);
+          gsl_vector_view t = gsl_matrix_subcolumn (X, i, 0, i);
+
+          gsl_blas_dgemv (CblasNoTrans, 1.0, &Ui.matrix, &r.vector, 0.0, &t.vector);
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Xi.matrix, &t.vector, 1.0, &xc.vector);
+        }
+
+      gsl_blas_dscal (tau_j, &xc.vector);
+    }
+}
+
 /* Form the orthogonal matrices U, V, diagonal d and superdiagonal sd
    from the packed bidiagonal matrix A */
 
@@ -32,6 +32,7 @@
  */
 
 #include <config.h>
+#include <stdlib.h>
 
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_errno.h>
@@ -41,11 +42,31 @@
 #include <gsl/gsl_linalg.h>
 
 #include "recurse.h"
+#include "tiled.h"
+
+/* tasks of the tiled factorization */
+enum
+{
+  CHOLESKY_POTRF,
+  CHOLESKY_TRSM,
+  CHOLESKY_SYRK,
+  CHOLESKY_GEMM
+};
+
+typedef struct
+{
+  gsl_matrix * A;
+  size_t nt;            /* number of tile rows and columns */
+  size_t * count;       /* count[i*nt+j]: updates applied to tile (i,j) */
+  char * final;         /* final[i*nt+j]: tile (i,j) of L is computed */
+} cholesky_tiled_params;
 
 static double cholesky_norm1(const gsl_matrix * LLT, gsl_vector * work);
 static int cholesky_Ainv(CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params);
 static int cholesky_decomp_L2 (gsl_matrix * A);
 static int cholesky_decomp_L3 (gsl_matrix * A);
+static int cholesky_tiled_run(const linalg_tiled_task * task, void * params);
+static void cholesky_tiled_done(const linalg_tiled_task * task, void * params, linalg_tiled_sched * sched);
 
 /*
 In GSL 2.2, we decided to modify the behavior of the Cholesky decomposition
@@ -102,6 +123,83 @@ gsl_linalg_cholesky_decomp1 (gsl_matrix * A)
     }
 }
 
+/*
+gsl_linalg_cholesky_decomp_tiled()
+  Perform Cholesky decomposition of a symmetric positive
+definite matrix with a tiled algorithm, using several threads
+
+Inputs: A        - (input) symmetric, positive definite matrix
+                   (output) lower triangle contains Cholesky factor
+        nthreads - number of threads
+
+Return: success/error
+
+Notes:
+1) original matrix is saved in upper triangle on output, as in
+gsl_linalg_cholesky_decomp1
+
+2) the lower triangle is divided into TILE_SIZE-by-TILE_SIZE tiles.
+Step k of the factorization consists of the tasks
+
+  POTRF(k):     L(k,k) = chol(A(k,k))
+  TRSM(i,k):    L(i,k) = A(i,k) L(k,k)^{-T},        i > k
+  SYRK(i,k):    A(i,i) -= L(i,k) L(i,k)^T,           i > k
+  GEMM(i,j,k):  A(i,j) -= L(i,k) L(j,k)^T,           i > j > k
+
+and each task is run as soon as the tiles it reads are final and the
+tile it writes has received all earlier updates, so that tasks of
+different steps overlap
+*/
+
+int
+gsl_linalg_cholesky_decomp_tiled (gsl_matrix * A, const size_t nthreads)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("Cholesky decomposition requires square matrix", GSL_ENOTSQR);
+    }
+  else if (nthreads < 2 || N <= 2 * TILE_SIZE)
+    {
+      return gsl_linalg_cholesky_decomp1(A);
+    }
+  else
+    {
+      const size_t nt = (N + TILE_SIZE - 1) / TILE_SIZE;
+      const size_t ntasks = nt + nt * (nt - 1) + nt * (nt - 1) * (nt - 2) / 6;
+      cholesky_tiled_params params;
+      linalg_tiled_task task0;
+      int status;
+
+      params.A = A;
+      params.nt = nt;
+      params.count = calloc(nt * nt, sizeof(size_t));
+      params.final = calloc(nt * nt, sizeof(char));
+
+      if (params.count == NULL || params.final == NULL)
+        {
+          free(params.count);
+          free(params.final);
+          GSL_ERROR("failed to allocate space for tile states", GSL_ENOMEM);
+        }
+
+      /* save original matrix in upper triangle for later rcond calculation */
+      gsl_matrix_transpose_tricpy('L', 0, A, A);
+
+      task0.type = CHOLESKY_POTRF;
+      task0.i = task0.j = task0.k = 0;
+
+      status = linalg_tiled_execute(nthreads, ntasks, &task0, cholesky_tiled_run,
+                                    cholesky_tiled_done, &params);
+
+      free(params.count);
+      free(params.final);
+
+      return status;
+    }
+}
+
 int
 gsl_linalg_cholesky_solve (const gsl_matrix * LLT,
                            const gsl_vector * b,
@@ -722,3 +820,109 @@ cholesky_decomp_L3 (gsl_matrix * A)
     }
 }
 
+/* tile (i,j) of the matrix in a tiled factorization */
+static gsl_matrix_view
+cholesky_tile(gsl_matrix * A, const size_t i, const size_t j)
+{
+  const size_t N = A->size1;
+  const size_t i0 = i * TILE_SIZE;
+  const size_t j0 = j * TILE_SIZE;
+
+  return gsl_matrix_submatrix(A, i0, j0, GSL_MIN(TILE_SIZE, N - i0),
+                              GSL_MIN(TILE_SIZE, N - j0));
+}
+
+static int
+cholesky_tiled_run(const linalg_tiled_task * task, void * params)
+{
+  cholesky_tiled_params * p = (cholesky_tiled_params *) params;
+  gsl_matrix * A = p->A;
+  gsl_matrix_view Aij = cholesky_tile(A, task->i, task->j);
+  gsl_matrix_view Lkk, Lik, Ljk;
+
+  switch (task->type)
+    {
+      case CHOLESKY_POTRF:
+        return cholesky_decomp_L3(&Aij.matrix);
+
+      case CHOLESKY_TRSM:
+        Lkk = cholesky_tile(A, task->k, task->k);
+        return gsl_blas_dtrsm(CblasRight, CblasLower, CblasTrans, CblasNonUnit, 1.0,
+                              &Lkk.matrix, &Aij.matrix);
+
+      case CHOLESKY_SYRK:
+        Lik = cholesky_tile(A, task->i, task->k);
+        return gsl_blas_dsyrk(CblasLower, CblasNoTrans, -1.0, &Lik.matrix, 1.0, &Aij.matrix);
+
+      default:
+        Lik = cholesky_tile(A, task->i, task->k);
+        Ljk = cholesky_tile(A, task->j, task->k);
+        return gsl_blas_dgemm(CblasNoTrans, CblasTrans, -1.0, &Lik.matrix, &Ljk.matrix,
+                              1.0, &Aij.matrix);
+    }
+}
+
+/* push the task which updates or factors tile (i,j) next, if it is ready */
+static void
+cholesky_tiled_next(cholesky_tiled_params * p, linalg_tiled_sched * sched,
+                    const size_t i, const size_t j)
+{
+  const size_t nt = p->nt;
+  const size_t k = p->count[i * nt + j];
+
+  if (k == j)
+    {
+      /* all updates applied: factor the diagonal tile, or solve with it */
+      if (i == j)
+        linalg_tiled_push(sched, CHOLESKY_POTRF, i, i, i);
+      else if (p->final[j * nt + j])
+        linalg_tiled_push(sched, CHOLESKY_TRSM, i, j, j);
+    }
+  else if (p->final[i * nt + k] && p->final[j * nt + k])
+    {
+      linalg_tiled_push(sched, (i == j) ? CHOLESKY_SYRK : CHOLESKY_GEMM, i, j, k);
+    }
+}
+
+static void
+cholesky_tiled_done(const linalg_tiled_task * task, void * params, linalg_tiled_sched * sched)
+{
+  cholesky_tiled_params * p = (cholesky_tiled_params *) params;
+  const size_t nt = p->nt;
+  const size_t i = task->i;
+  const size_t j = task->j;
+  const size_t k = task->k;
+  size_t m;
+
+  switch (task->type)
+    {
+      case CHOLESKY_POTRF:
+        p->final[k * nt + k] = 1;
+        for (m = k + 1; m < nt; ++m)
+          {
+            if (p->count[m * nt + k] == k)
+              cholesky_tiled_next(p, sched, m, k);
+          }
+        break;
+
+      case CHOLESKY_TRSM:
+        /* L(i,k) is used by the updates of row i and column i at step k */
+        p->final[i * nt + k] = 1;
+        for (m = k + 1; m <= i; ++m)
+          {
+            if (p->count[i * nt + m] == k)
+              cholesky_tiled_next(p, sched, i, m);
+          }
+        for (m = i + 1; m < nt; ++m)
+          {
+            if (p->count[m * nt + i] == k)
+              cholesky_tiled_next(p, sched, m, i);
+          }
+        break;
+
+      default:
+        ++(p->count[i * nt + j]);
+        cholesky_tiled_next(p, sched, i, j);
+        break;
+    }
+}
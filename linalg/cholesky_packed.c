@@ -0,0 +1,198 @@
+/* linalg/cholesky_packed.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_cblas.h>
+
+#include "packed.h"
+
+/*
+gsl_linalg_cholesky_packed_decomp()
+  Cholesky decomposition of a symmetric positive definite matrix
+stored in lower packed format, A = L L^T
+
+Inputs: AP - on input, lower triangle of A in packed format,
+             length N(N+1)/2;
+             on output, lower triangle of L in packed format
+
+Return: success/error
+
+Notes:
+1) The leading i-by-i block of L occupies the first i(i+1)/2 elements
+of AP, so row i of L is computed by solving L(0:i-1,0:i-1) l = A(i,0:i-1)
+with a packed triangular solve (bordered, or dot-product, form of the
+algorithm; LAPACK DPPTRF)
+
+2) Only N(N+1)/2 elements of storage are required, compared with N^2
+for gsl_linalg_cholesky_decomp1()
+*/
+
+int
+gsl_linalg_cholesky_packed_decomp (gsl_vector * AP)
+{
+  size_t N;
+  int status = packed_order (AP, &N);
+
+  if (status)
+    return status;
+  else
+    {
+      double *ap = AP->data;
+      size_t i;
+
+      for (i = 0; i < N; ++i)
+        {
+          double *li = ap + i * (i + 1) / 2; /* row i of L */
+          double aii;
+
+          if (i > 0)
+            {
+              /* solve L(0:i-1,0:i-1) l = A(i,0:i-1) */
+              cblas_dtpsv (CblasRowMajor, CblasLower, CblasNoTrans, CblasNonUnit,
+                           (int) i, ap, li, 1);
+            }
+
+          aii = li[i] - cblas_ddot ((int) i, li, 1, li, 1);
+          if (aii <= 0.0)
+            {
+              GSL_ERROR ("matrix is not positive definite", GSL_EDOM);
+            }
+
+          li[i] = sqrt (aii);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+int
+gsl_linalg_cholesky_packed_solve (const gsl_vector * LLT,
+                                  const gsl_vector * b,
+                                  gsl_vector * x)
+{
+  size_t N;
+  int status = packed_order (LLT, &N);
+
+  if (status)
+    return status;
+  else if (b->size != N)
+    {
+      GSL_ERROR ("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (x->size != N)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      /* copy x <- b */
+      gsl_blas_dcopy (b, x);
+
+      status = gsl_linalg_cholesky_packed_svx (LLT, x);
+
+      return status;
+    }
+}
+
+int
+gsl_linalg_cholesky_packed_svx (const gsl_vector * LLT,
+                                gsl_vector * x)
+{
+  size_t N;
+  int status = packed_order (LLT, &N);
+
+  if (status)
+    return status;
+  else if (x->size != N)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      /* solve for c using forward-substitution, L c = b */
+      cblas_dtpsv (CblasRowMajor, CblasLower, CblasNoTrans, CblasNonUnit,
+                   (int) N, LLT->data, x->data, (int) x->stride);
+
+      /* perform back-substitution, L^T x = c */
+      cblas_dtpsv (CblasRowMajor, CblasLower, CblasTrans, CblasNonUnit,
+                   (int) N, LLT->data, x->data, (int) x->stride);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_cholesky_packed_invert()
+  Compute the inverse of a symmetric positive definite matrix from
+its packed Cholesky factor
+
+Inputs: LLT - on input, Cholesky factor L in lower packed format, from
+              gsl_linalg_cholesky_packed_decomp();
+              on output, lower triangle of A^{-1} in packed format
+
+Return: success/error
+
+Notes:
+1) A^{-1} = L^{-T} L^{-1}. L is first inverted in place; then, since
+row j of L^{-1} is contiguous and follows the leading j-by-j block, the
+product is accumulated one row at a time with symmetric rank-1 updates
+of the leading block (LAPACK DPPTRI)
+*/
+
+int
+gsl_linalg_cholesky_packed_invert (gsl_vector * LLT)
+{
+  size_t N;
+  int status = packed_order (LLT, &N);
+
+  if (status)
+    return status;
+
+  /* invert the lower triangular factor, L <- L^{-1} */
+  status = gsl_linalg_tri_packed_invert (CblasLower, CblasNonUnit, LLT);
+  if (status)
+    return status;
+  else
+    {
+      double *ap = LLT->data;
+      size_t j;
+
+      for (j = 0; j < N; ++j)
+        {
+          double *xj = ap + j * (j + 1) / 2; /* row j of L^{-1} */
+          double xjj = xj[j];
+
+          /* add the contribution of row j to the leading block of A^{-1} */
+          if (j > 0)
+            cblas_dspr (CblasRowMajor, CblasLower, (int) j, 1.0, xj, 1, ap);
+
+          cblas_dscal ((int) j + 1, xjj, xj, 1);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
@@ -185,3 +185,480 @@ gsl_linalg_exponential_ss(
   }
 }
 
+
+
+/* Pade approximants of degree m = 3, 5, 7, 9, 13 and the 1-norm bounds
+ * theta_m below which they give exp(A) to double precision without
+ * scaling, from
+ *
+ * N. J. Higham, The scaling and squaring method for the matrix
+ * exponential revisited, SIAM J. Matrix Anal. Appl. 26, 1179 (2005).
+ */
+
+static const double pade3[] = { 120.0, 60.0, 12.0, 1.0 };
+static const double pade5[] = { 30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0 };
+static const double pade7[] = { 17297280.0, 8648640.0, 1995840.0, 277200.0,
+                                25200.0, 1512.0, 56.0, 1.0 };
+static const double pade9[] = { 17643225600.0, 8821612800.0, 2075673600.0,
+                                302702400.0, 30270240.0, 2162160.0, 110880.0,
+                                3960.0, 90.0, 1.0 };
+static const double pade13[] = { 64764752532480000.0, 32382376266240000.0,
+                                 7771770303897600.0, 1187353796428800.0,
+                                 129060195264000.0, 10559470521600.0,
+                                 670442572800.0, 33522128640.0, 1323241920.0,
+                                 40840800.0, 960960.0, 16380.0, 182.0, 1.0 };
+
+static const double pade_theta[] = { 1.495585217958292e-2,  /* m = 3 */
+                                     2.539398330063230e-1,  /* m = 5 */
+                                     9.504178996162932e-1,  /* m = 7 */
+                                     2.097847961257068e0,   /* m = 9 */
+                                     5.371920351148152e0 }; /* m = 13 */
+
+static double
+expm_norm1(const gsl_matrix * A)
+{
+  const size_t N = A->size2;
+  double value = 0.0;
+  size_t j;
+
+  for (j = 0; j < N; ++j)
+    {
+      gsl_vector_const_view v = gsl_matrix_const_column(A, j);
+      double sum = gsl_blas_dasum(&v.vector);
+      value = GSL_MAX(value, sum);
+    }
+
+  return value;
+}
+
+/* C = alpha I + sum_k c[k] P[k] */
+static void
+expm_lincomb(gsl_matrix * C, const double alpha, const size_t n,
+             const double * c, gsl_matrix * const * P)
+{
+  size_t k;
+
+  gsl_matrix_set_zero(C);
+  gsl_matrix_add_diagonal(C, alpha);
+
+  for (k = 0; k < n; ++k)
+    {
+      size_t i;
+
+      /* C += c[k] P[k], one row at a time */
+      for (i = 0; i < C->size1; ++i)
+        {
+          gsl_vector_const_view p = gsl_matrix_const_row(P[k], i);
+          gsl_vector_view r = gsl_matrix_row(C, i);
+          gsl_blas_daxpy(c[k], &p.vector, &r.vector);
+        }
+    }
+}
+
+/* evaluate the Pade approximant of exp(A) in eA, with scaling and
+ * squaring; As, A2, A4, A6, U, V and p are N-by-N workspace */
+static int
+expm_pade(const gsl_matrix * A, gsl_matrix * eA, gsl_matrix * As,
+          gsl_matrix * A2, gsl_matrix * A4, gsl_matrix * A6,
+          gsl_matrix * U, gsl_matrix * V, gsl_permutation * p)
+{
+  const size_t N = A->size1;
+  const double anorm = expm_norm1(A);
+  const double *b;
+  int m, s = 0;
+  size_t i;
+  int signum, status;
+
+  /* choose the degree of the approximant */
+  if (anorm <= pade_theta[0])
+    {
+      m = 3;
+      b = pade3;
+    }
+  else if (anorm <= pade_theta[1])
+    {
+      m = 5;
+      b = pade5;
+    }
+  else if (anorm <= pade_theta[2])
+    {
+      m = 7;
+      b = pade7;
+    }
+  else if (anorm <= pade_theta[3])
+    {
+      m = 9;
+      b = pade9;
+    }
+  else
+    {
+      m = 13;
+      b = pade13;
+      s = (int) GSL_MAX(0.0, ceil(log(anorm / pade_theta[4]) / M_LN2));
+    }
+
+  gsl_matrix_memcpy(As, A);
+  if (s > 0)
+    gsl_matrix_scale(As, ldexp(1.0, -s));
+
+  gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, As, As, 0.0, A2);
+
+  if (m == 13)
+    {
+      gsl_matrix *P[3];
+      double c[3];
+
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, A2, A2, 0.0, A4);
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, A4, A2, 0.0, A6);
+
+      P[0] = A2;
+      P[1] = A4;
+      P[2] = A6;
+
+      /* U = A [ A6 (b13 A6 + b11 A4 + b9 A2) + b7 A6 + b5 A4 + b3 A2 + b1 I ] */
+      c[0] = b[9]; c[1] = b[11]; c[2] = b[13];
+      expm_lincomb(V, 0.0, 3, c, P);
+      c[0] = b[3]; c[1] = b[5]; c[2] = b[7];
+      expm_lincomb(eA, b[1], 3, c, P);
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, A6, V, 1.0, eA);
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, As, eA, 0.0, U);
+
+      /* V = A6 (b12 A6 + b10 A4 + b8 A2) + b6 A6 + b4 A4 + b2 A2 + b0 I */
+      c[0] = b[8]; c[1] = b[10]; c[2] = b[12];
+      expm_lincomb(eA, 0.0, 3, c, P);
+      c[0] = b[2]; c[1] = b[4]; c[2] = b[6];
+      expm_lincomb(V, b[0], 3, c, P);
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, A6, eA, 1.0, V);
+    }
+  else
+    {
+      /* U = A sum_k b_{2k+1} A^{2k}, V = sum_k b_{2k} A^{2k} with
+       * powers A^2, A^4, A^6, A^8 as needed; As is not needed for
+       * the powers beyond A^2, and A^8 is stored in U */
+      gsl_matrix *P[4];
+      double cu[4], cv[4];
+      const size_t npow = (size_t) (m - 1) / 2;
+      size_t k;
+
+      P[0] = A2;
+      P[1] = A4;
+      P[2] = A6;
+      P[3] = U;
+
+      if (npow > 1)
+        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, A2, A2, 0.0, A4);
+      if (npow > 2)
+        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, A4, A2, 0.0, A6);
+      if (npow > 3)
+        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, A4, A4, 0.0, U);
+
+      for (k = 0; k < npow; ++k)
+        {
+          cu[k] = b[2 * k + 3];
+          cv[k] = b[2 * k + 2];
+        }
+
+      expm_lincomb(V, b[0], npow, cv, P);
+      expm_lincomb(eA, b[1], npow, cu, P);
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, As, eA, 0.0, U);
+    }
+
+  /* A2 = V - U, A4 = V + U */
+  gsl_matrix_memcpy(A2, V);
+  gsl_matrix_sub(A2, U);
+  gsl_matrix_memcpy(A4, V);
+  gsl_matrix_add(A4, U);
+
+  /* solve (V - U) eA = (V + U) */
+  status = gsl_linalg_LU_decomp(A2, p, &signum);
+  if (status)
+    return status;
+
+  for (i = 0; i < N; ++i)
+    {
+      if (gsl_matrix_get(A2, i, i) == 0.0)
+        {
+          GSL_ERROR("Pade denominator V - U is singular", GSL_EDOM);
+        }
+    }
+
+  for (i = 0; i < N; ++i)
+    {
+      gsl_vector_const_view src = gsl_matrix_const_row(A4, gsl_permutation_get(p, i));
+      gsl_vector_view dest = gsl_matrix_row(eA, i);
+      gsl_blas_dcopy(&src.vector, &dest.vector);
+    }
+
+  gsl_blas_dtrsm(CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0, A2, eA);
+  gsl_blas_dtrsm(CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, A2, eA);
+
+  /* undo the scaling, exp(A) = r_13(A / 2^s)^{2^s} */
+  for (i = 0; i < (size_t) s; ++i)
+    {
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, eA, eA, 0.0, U);
+      gsl_matrix_memcpy(eA, U);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_linalg_expm()
+  Compute the matrix exponential exp(A) with the scaling and
+squaring method using Pade approximants
+
+Inputs: A  - square matrix
+        eA - (output) exp(A)
+
+Return: success/error
+
+Notes:
+1) Algorithm 2.3 of Higham (2005): the smallest degree m in
+{3,5,7,9} with ||A||_1 <= theta_m is used without scaling; otherwise
+A is scaled by 2^{-s} so that ||A / 2^s||_1 <= theta_13, r_13 is
+evaluated and squared s times.
+
+2) With U (odd part) and V (even part) of the numerator, the
+approximant is r_m(A) = (V - U)^{-1} (V + U). For m = 13 the powers
+A^2, A^4, A^6 are formed once and reused, so the approximant costs 6
+matrix multiplications and one LU solve with N right hand sides.
+*/
+
+int
+gsl_linalg_expm(const gsl_matrix * A, gsl_matrix * eA)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("cannot exponentiate a non-square matrix", GSL_ENOTSQR);
+    }
+  else if (eA->size1 != N || eA->size2 != N)
+    {
+      GSL_ERROR("exponential of matrix must have same dimension as matrix", GSL_EBADLEN);
+    }
+  else if (N == 0)
+    {
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      gsl_matrix *As = gsl_matrix_alloc(N, N);
+      gsl_matrix *A2 = gsl_matrix_alloc(N, N);
+      gsl_matrix *A4 = gsl_matrix_alloc(N, N);
+      gsl_matrix *A6 = gsl_matrix_alloc(N, N);
+      gsl_matrix *U = gsl_matrix_alloc(N, N);
+      gsl_matrix *V = gsl_matrix_alloc(N, N);
+      gsl_permutation *p = gsl_permutation_alloc(N);
+      int status;
+
+      if (As == NULL || A2 == NULL || A4 == NULL || A6 == NULL ||
+          U == NULL || V == NULL || p == NULL)
+        status = GSL_ENOMEM;
+      else
+        status = expm_pade(A, eA, As, A2, A4, A6, U, V, p);
+
+      if (As)
+        gsl_matrix_free(As);
+      if (A2)
+        gsl_matrix_free(A2);
+      if (A4)
+        gsl_matrix_free(A4);
+      if (A6)
+        gsl_matrix_free(A6);
+      if (U)
+        gsl_matrix_free(U);
+      if (V)
+        gsl_matrix_free(V);
+      if (p)
+        gsl_permutation_free(p);
+
+      if (status == GSL_ENOMEM)
+        {
+          GSL_ERROR("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      return status;
+    }
+}
+
+/* degrees m and bounds theta_m of the truncated Taylor series T_m for
+ * the action of the matrix exponential in double precision, from
+ *
+ * A. H. Al-Mohy and N. J. Higham, Computing the action of the matrix
+ * exponential, with an application to exponential integrators, SIAM
+ * J. Sci. Comput. 33, 488 (2011), table 3.1.
+ */
+
+static const int taylor_m[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+                                11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+                                21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+                                35, 40, 45, 50, 55 };
+
+static const double taylor_theta[] = { 2.29e-16, 2.58e-8, 1.39e-5, 3.40e-4, 2.40e-3,
+                                       9.07e-3, 2.38e-2, 5.00e-2, 8.96e-2, 1.44e-1,
+                                       2.14e-1, 3.00e-1, 4.00e-1, 5.14e-1, 6.41e-1,
+                                       7.81e-1, 9.31e-1, 1.09, 1.26, 1.44,
+                                       1.62, 1.82, 2.01, 2.22, 2.43,
+                                       2.64, 2.86, 3.08, 3.31, 3.54,
+                                       4.7, 6.0, 7.2, 8.5, 9.9 };
+
+static double
+expm_vector_normi(const gsl_vector * v)
+{
+  if (v->size == 0)
+    return 0.0;
+  else
+    {
+      CBLAS_INDEX_t idx = gsl_blas_idamax(v);
+      return fabs(v->data[idx * v->stride]);
+    }
+}
+
+/*
+gsl_linalg_expm_multiply()
+  Compute w = exp(t A) v without forming exp(t A)
+
+Inputs: A - square matrix, N-by-N
+        t - scalar multiplier
+        v - vector, length N
+        w - (output) exp(t A) v, length N; w may be the same vector
+            as v
+
+Return: success/error
+
+Notes:
+1) Algorithm 3.2 of Al-Mohy and Higham (2011): with the shift
+mu = trace(A)/N and B = A - mu I, exp(t A) v = e^{t mu} (exp(t B / s))^s v,
+where each factor is applied with a truncated Taylor series of degree m,
+terminated early when the terms become negligible. (m, s) are chosen
+to minimize the number m s of matrix-vector products subject to
+|t| ||B||_1 / s <= theta_m.
+
+2) The parameters are chosen from ||B||_1 alone rather than from
+estimates of ||B^p||_1^{1/p}; this is always accurate but may use more
+products than necessary for highly nonnormal matrices.
+
+3) Only matrix-vector products with A are required, costing O(N^2)
+per product compared with O(N^3) for gsl_linalg_expm()
+*/
+
+int
+gsl_linalg_expm_multiply(const gsl_matrix * A, const double t,
+                         const gsl_vector * v, gsl_vector * w)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (v->size != N)
+    {
+      GSL_ERROR("vector v must have length N", GSL_EBADLEN);
+    }
+  else if (w->size != N)
+    {
+      GSL_ERROR("vector w must have length N", GSL_EBADLEN);
+    }
+  else if (N == 0)
+    {
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      const double tol = GSL_DBL_EPSILON / 2.0; /* unit roundoff 2^{-53} */
+      const size_t ntab = sizeof(taylor_m) / sizeof(taylor_m[0]);
+      gsl_vector *b, *z;
+      double mu = 0.0, bnorm = 0.0, eta;
+      size_t i, j, k;
+      size_t m = 0, s = 1;
+
+      b = gsl_vector_alloc(N);
+      if (b == NULL)
+        {
+          GSL_ERROR("failed to allocate space for b", GSL_ENOMEM);
+        }
+
+      z = gsl_vector_alloc(N);
+      if (z == NULL)
+        {
+          gsl_vector_free(b);
+          GSL_ERROR("failed to allocate space for z", GSL_ENOMEM);
+        }
+
+      /* shift mu = trace(A) / N */
+      for (i = 0; i < N; ++i)
+        mu += gsl_matrix_get(A, i, i);
+
+      mu /= (double) N;
+
+      /* ||A - mu I||_1 */
+      for (j = 0; j < N; ++j)
+        {
+          gsl_vector_const_view c = gsl_matrix_const_column(A, j);
+          double ajj = gsl_matrix_get(A, j, j);
+          double sum = gsl_blas_dasum(&c.vector) - fabs(ajj) + fabs(ajj - mu);
+          bnorm = GSL_MAX(bnorm, sum);
+        }
+
+      bnorm *= fabs(t);
+
+      /* choose (m, s) to minimize the cost m s */
+      if (bnorm > 0.0)
+        {
+          double best = GSL_POSINF;
+
+          for (k = 0; k < ntab; ++k)
+            {
+              double sk = GSL_MAX(1.0, ceil(bnorm / taylor_theta[k]));
+              double cost = (double) taylor_m[k] * sk;
+
+              if (cost < best)
+                {
+                  best = cost;
+                  m = (size_t) taylor_m[k];
+                  s = (size_t) sk;
+                }
+            }
+        }
+
+      eta = exp(t * mu / (double) s);
+
+      /* w = f = v, b = v */
+      gsl_blas_dcopy(v, b);
+      gsl_blas_dcopy(b, w);
+
+      for (i = 0; i < s; ++i)
+        {
+          double c1 = expm_vector_normi(b);
+
+          for (j = 0; j < m; ++j)
+            {
+              const double coeff = t / (double) (s * (j + 1));
+              double c2;
+
+              /* b <- coeff (A - mu I) b */
+              gsl_blas_dgemv(CblasNoTrans, coeff, A, b, 0.0, z);
+              gsl_blas_daxpy(-coeff * mu, b, z);
+              gsl_blas_dswap(b, z);
+
+              c2 = expm_vector_normi(b);
+              gsl_blas_daxpy(1.0, b, w);
+
+              if (c1 + c2 <= tol * expm_vector_normi(w))
+                break;
+
+              c1 = c2;
+            }
+
+          gsl_blas_dscal(eta, w);
+          gsl_blas_dcopy(w, b);
+        }
+
+      gsl_vector_free(b);
+      gsl_vector_free(z);
+
+      return GSL_SUCCESS;
+    }
+}
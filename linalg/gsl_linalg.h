@@ -87,6 +87,19 @@ int gsl_linalg_exponential_ss(
   gsl_mode_t mode
   );
 
+/* Calculate the matrix exponential by the scaling and squaring
+ * method with Pade approximants, Higham, SIAM J. Matrix Anal.
+ * Appl. 26, 1179 (2005), and the action exp(tA) v of the matrix
+ * exponential on a vector, Al-Mohy + Higham, SIAM J. Sci.
+ * Comput. 33, 488 (2011).
+ *
+ * exceptions: GSL_ENOTSQR, GSL_EBADLEN
+ */
+int gsl_linalg_expm (const gsl_matrix * A, gsl_matrix * eA);
+
+int gsl_linalg_expm_multiply (const gsl_matrix * A, const double t,
+                              const gsl_vector * v, gsl_vector * w);
+
 
 /* Householder Transformations */
 
@@ -159,6 +172,20 @@ int gsl_linalg_SV_decomp_jacobi (gsl_matrix * A,
                                  gsl_matrix * Q,
                                  gsl_vector * S);
 
+int gsl_linalg_SV_decomp_jacobi_tiled (gsl_matrix * A, gsl_matrix * V,
+                                       gsl_vector * S, const size_t nthreads);
+
+int gsl_linalg_SV_decomp_dc (gsl_matrix * A,
+                             gsl_matrix * V,
+                             gsl_vector * S);
+
+/* gsl_rng, declared here without including gsl_rng.h */
+struct gsl_rng_struct;
+
+int gsl_linalg_rSVD (const gsl_matrix * A, const size_t p, const size_t q,
+                     struct gsl_rng_struct * r, gsl_matrix * U,
+                     gsl_vector * S, gsl_matrix * V);
+
 int
 gsl_linalg_SV_solve (const gsl_matrix * U,
                      const gsl_matrix * Q,
@@ -174,6 +201,9 @@ int gsl_linalg_SV_leverage(const gsl_matrix *U, gsl_vector *h);
 
 int gsl_linalg_LU_decomp (gsl_matrix * A, gsl_permutation * p, int *signum);
 
+int gsl_linalg_LU_decomp_tiled (gsl_matrix * A, gsl_permutation * p, int *signum,
+                                const size_t nthreads);
+
 int gsl_linalg_LU_solve (const gsl_matrix * LU,
                          const gsl_permutation * p,
                          const gsl_vector * b,
@@ -190,6 +220,11 @@ int gsl_linalg_LU_refine (const gsl_matrix * A,
                           gsl_vector * x,
                           gsl_vector * work);
 
+int gsl_linalg_LU_solve_mixed (const gsl_matrix * A,
+                               const gsl_vector * b,
+                               gsl_vector * x,
+                               int * iter);
+
 int gsl_linalg_LU_invert (const gsl_matrix * LU,
                           const gsl_permutation * p,
                           gsl_matrix * inverse);
@@ -199,6 +234,19 @@ double gsl_linalg_LU_det (gsl_matrix * LU, int signum);
 double gsl_linalg_LU_lndet (gsl_matrix * LU);
 int gsl_linalg_LU_sgndet (gsl_matrix * lu, int signum);
 
+/* Batched LU Decomposition of a stack of small matrices */
+
+int gsl_linalg_LU_decomp_batch (gsl_matrix * A, gsl_vector_uint * ipiv);
+
+int gsl_linalg_LU_solve_batch (const gsl_matrix * LU,
+                               const gsl_vector_uint * ipiv,
+                               const gsl_vector * b,
+                               gsl_vector * x);
+
+int gsl_linalg_LU_svx_batch (const gsl_matrix * LU,
+                             const gsl_vector_uint * ipiv,
+                             gsl_vector * x);
+
 /* Complex LU Decomposition */
 
 int gsl_linalg_complex_LU_decomp (gsl_matrix_complex * A, 
@@ -280,6 +328,27 @@ int gsl_linalg_R_solve (const gsl_matrix * R, const gsl_vector * b, gsl_vector *
 
 int gsl_linalg_R_svx (const gsl_matrix * R, gsl_vector * x);
 
+int gsl_linalg_R_append_row (gsl_matrix * R, gsl_vector * x);
+
+int gsl_linalg_R_delete_row (gsl_matrix * R, gsl_vector * x, gsl_vector * work);
+
+/* complex QR decomposition */
+
+int gsl_linalg_complex_QR_decomp_r (gsl_matrix_complex * A, gsl_matrix_complex * T);
+
+int gsl_linalg_complex_QR_solve_r (const gsl_matrix_complex * QR, const gsl_matrix_complex * T,
+                                   const gsl_vector_complex * b, gsl_vector_complex * x);
+
+int gsl_linalg_complex_QR_lssolve_r (const gsl_matrix_complex * QR, const gsl_matrix_complex * T,
+                                     const gsl_vector_complex * b, gsl_vector_complex * x,
+                                     gsl_vector_complex * work);
+
+int gsl_linalg_complex_QR_QHvec_r (const gsl_matrix_complex * QR, const gsl_matrix_complex * T,
+                                   gsl_vector_complex * b, gsl_vector_complex * work);
+
+int gsl_linalg_complex_QR_unpack_r (const gsl_matrix_complex * QR, const gsl_matrix_complex * T,
+                                    gsl_matrix_complex * Q, gsl_matrix_complex * R);
+
 /* Q R P^T decomposition */
 
 int gsl_linalg_QRPT_decomp (gsl_matrix * A,
@@ -455,6 +524,7 @@ int gsl_linalg_PTLQ_update (gsl_matrix * Q, gsl_matrix * L,
 
 int gsl_linalg_cholesky_decomp (gsl_matrix * A);
 int gsl_linalg_cholesky_decomp1 (gsl_matrix * A);
+int gsl_linalg_cholesky_decomp_tiled (gsl_matrix * A, const size_t nthreads);
 
 int gsl_linalg_cholesky_solve (const gsl_matrix * cholesky,
                                const gsl_vector * b,
@@ -470,6 +540,16 @@ int gsl_linalg_cholesky_svx_mat (const gsl_matrix * cholesky,
 
 int gsl_linalg_cholesky_invert(gsl_matrix * cholesky);
 
+/* Batched Cholesky decomposition of a stack of small matrices */
+
+int gsl_linalg_cholesky_decomp_batch (gsl_matrix * A);
+
+int gsl_linalg_cholesky_solve_batch (const gsl_matrix * LLT,
+                                     const gsl_vector * b,
+                                     gsl_vector * x);
+
+int gsl_linalg_cholesky_svx_batch (const gsl_matrix * LLT, gsl_vector * x);
+
 /* Cholesky decomposition with unit-diagonal triangular parts.
  *   A = L D L^T, where diag(L) = (1,1,...,1).
  *   Upon exit, A contains L and L^T as for Cholesky, and
@@ -577,6 +657,17 @@ int gsl_linalg_cholesky_band_unpack (const gsl_matrix * LLT, gsl_matrix * L);
 
 int gsl_linalg_cholesky_band_rcond (const gsl_matrix * LLT, double * rcond, gsl_vector * work);
 
+/* Packed Cholesky decomposition */
+
+int gsl_linalg_cholesky_packed_decomp (gsl_vector * AP);
+
+int gsl_linalg_cholesky_packed_solve (const gsl_vector * LLT, const gsl_vector * b,
+                                      gsl_vector * x);
+
+int gsl_linalg_cholesky_packed_svx (const gsl_vector * LLT, gsl_vector * x);
+
+int gsl_linalg_cholesky_packed_invert (gsl_vector * LLT);
+
 /* L D L^T decomposition */
 
 int gsl_linalg_ldlt_decomp (gsl_matrix * A);
@@ -599,6 +690,29 @@ int gsl_linalg_ldlt_band_unpack (const gsl_matrix * LDLT, gsl_matrix * L, gsl_ve
 
 int gsl_linalg_ldlt_band_rcond (const gsl_matrix * LDLT, double * rcond, gsl_vector * work);
 
+/* Packed L D L^T decomposition */
+
+int gsl_linalg_ldlt_packed_decomp (gsl_vector * AP);
+
+int gsl_linalg_ldlt_packed_solve (const gsl_vector * LDLT, const gsl_vector * b, gsl_vector * x);
+
+int gsl_linalg_ldlt_packed_svx (const gsl_vector * LDLT, gsl_vector * x);
+
+/* Banded LU decomposition */
+
+int gsl_linalg_LU_band_decomp (const size_t M, const size_t lb, const size_t ub,
+                               gsl_matrix * AB, gsl_vector_uint * piv);
+
+int gsl_linalg_LU_band_solve (const size_t lb, const size_t ub, const gsl_matrix * LUB,
+                              const gsl_vector_uint * piv, const gsl_vector * b, gsl_vector * x);
+
+int gsl_linalg_LU_band_svx (const size_t lb, const size_t ub, const gsl_matrix * LUB,
+                            const gsl_vector_uint * piv, gsl_vector * x);
+
+int gsl_linalg_LU_band_unpack (const size_t M, const size_t lb, const size_t ub,
+                               const gsl_matrix * LUB, const gsl_vector_uint * piv,
+                               gsl_matrix * L, gsl_matrix * U);
+
 /* Symmetric to symmetric tridiagonal decomposition */
 
 int gsl_linalg_symmtd_decomp (gsl_matrix * A, 
@@ -702,6 +816,36 @@ int gsl_linalg_solve_cyc_tridiag (const gsl_vector * diag,
                                   const gsl_vector * b,
                                   gsl_vector * x);
 
+/* Linear solve for a batch of tridiagonal systems of the same size N.
+
+ * Each input matrix holds one system per column: column b of diag is
+ * the diagonal of system b, and so on, so that element i of every
+ * system is stored in row i. The off-diagonals of the non-cyclic
+ * systems are (N-1)-by-nbatch, and those of the cyclic systems are
+ * N-by-nbatch, with the corner elements in row N-1.
+ */
+int gsl_linalg_solve_symm_tridiag_batch (const gsl_matrix * diag,
+                                         const gsl_matrix * offdiag,
+                                         const gsl_matrix * b,
+                                         gsl_matrix * x);
+
+int gsl_linalg_solve_tridiag_batch (const gsl_matrix * diag,
+                                    const gsl_matrix * abovediag,
+                                    const gsl_matrix * belowdiag,
+                                    const gsl_matrix * b,
+                                    gsl_matrix * x);
+
+int gsl_linalg_solve_symm_cyc_tridiag_batch (const gsl_matrix * diag,
+                                             const gsl_matrix * offdiag,
+                                             const gsl_matrix * b,
+                                             gsl_matrix * x);
+
+int gsl_linalg_solve_cyc_tridiag_batch (const gsl_matrix * diag,
+                                        const gsl_matrix * abovediag,
+                                        const gsl_matrix * belowdiag,
+                                        const gsl_matrix * b,
+                                        gsl_matrix * x);
+
 
 /* Bidiagonal decomposition */
 
@@ -749,6 +893,9 @@ int gsl_linalg_tri_lower_unit_invert(gsl_matrix * T);
 
 int gsl_linalg_tri_invert(CBLAS_UPLO_t Uplo, CBLAS_DIAG_t Diag, gsl_matrix * T);
 int gsl_linalg_complex_tri_invert(CBLAS_UPLO_t Uplo, CBLAS_DIAG_t Diag, gsl_matrix_complex * T);
+int gsl_linalg_tri_packed_invert(CBLAS_UPLO_t Uplo, CBLAS_DIAG_t Diag, gsl_vector * TP);
+int gsl_linalg_tri_packed_svx(CBLAS_UPLO_t Uplo, CBLAS_TRANSPOSE_t TransA, CBLAS_DIAG_t Diag,
+                              const gsl_vector * TP, gsl_vector * x);
 
 int gsl_linalg_tri_LTL(gsl_matrix * L);
 int gsl_linalg_tri_UL(gsl_matrix * LU);
@@ -57,6 +57,22 @@
 
 #include <gsl/gsl_linalg.h>
 
+/* number of columns reduced per panel by the blocked algorithm */
+#define HERMTD_BLOCK 32
+
+/* the blocked algorithms are used while more than this many columns
+ * remain to be reduced */
+#define HERMTD_CROSSOVER 128
+
+static int hermtd_decomp_L2 (gsl_matrix_complex * A, const size_t i0, gsl_vector_complex * tau);
+static int hermtd_decomp_L3 (gsl_matrix_complex * A, gsl_vector_complex * tau);
+static void hermtd_panel (gsl_matrix_complex * A, const size_t nb, gsl_vector_complex * tau,
+                          gsl_matrix_complex * W, gsl_vector_complex * work);
+static int hermtd_unpack_L3 (const gsl_matrix_complex * A, const gsl_vector_complex * tau,
+                             gsl_matrix_complex * U);
+static void hermtd_larft (const gsl_matrix_complex * V, const gsl_vector_complex * tau,
+                          gsl_matrix_complex * T);
+
 int 
 gsl_linalg_hermtd_decomp (gsl_matrix_complex * A, gsl_vector_complex * tau)  
 {
@@ -71,56 +87,243 @@ gsl_linalg_hermtd_decomp (gsl_matrix_complex * A, gsl_vector_complex * tau)
     }
   else
     {
-      const size_t N = A->size1;
-      size_t i;
+      if (A->size1 > HERMTD_CROSSOVER)
+        {
+          int status = hermtd_decomp_L3 (A, tau);
+
+          if (status != GSL_ENOMEM)
+            return status;
+
+          /* not enough memory for the panel workspace, fall through to
+           * the unblocked algorithm */
+        }
+
+      return hermtd_decomp_L2 (A, 0, tau);
+    }
+}  
+
+/* reduce columns i0 and beyond, one column at a time with a hermitian
+ * rank-2 update of the remaining matrix */
+
+static int
+hermtd_decomp_L2 (gsl_matrix_complex * A, const size_t i0, gsl_vector_complex * tau)
+{
+  const size_t N = A->size1;
+  size_t i;
   
-      const gsl_complex zero = gsl_complex_rect (0.0, 0.0);
-      const gsl_complex one = gsl_complex_rect (1.0, 0.0);
-      const gsl_complex neg_one = gsl_complex_rect (-1.0, 0.0);
+  const gsl_complex zero = gsl_complex_rect (0.0, 0.0);
+  const gsl_complex one = gsl_complex_rect (1.0, 0.0);
+  const gsl_complex neg_one = gsl_complex_rect (-1.0, 0.0);
 
-      for (i = 0 ; i < N - 1; i++)
+  for (i = i0 ; i < N - 1; i++)
+    {
+      gsl_vector_complex_view c = gsl_matrix_complex_column (A, i);
+      gsl_vector_complex_view v = gsl_vector_complex_subvector (&c.vector, i + 1, N - (i + 1));
+      gsl_complex tau_i = gsl_linalg_complex_householder_transform (&v.vector);
+      
+      /* Apply the transformation H^T A H to the remaining columns */
+
+      if ((i + 1) < (N - 1) 
+          && !(GSL_REAL(tau_i) == 0.0 && GSL_IMAG(tau_i) == 0.0)) 
         {
-          gsl_vector_complex_view c = gsl_matrix_complex_column (A, i);
-          gsl_vector_complex_view v = gsl_vector_complex_subvector (&c.vector, i + 1, N - (i + 1));
-          gsl_complex tau_i = gsl_linalg_complex_householder_transform (&v.vector);
+          gsl_matrix_complex_view m = 
+            gsl_matrix_complex_submatrix (A, i + 1, i + 1, 
+                                          N - (i+1), N - (i+1));
+          gsl_complex ei = gsl_vector_complex_get(&v.vector, 0);
+          gsl_vector_complex_view x = gsl_vector_complex_subvector (tau, i, N-(i+1));
+          gsl_vector_complex_set (&v.vector, 0, one);
           
-          /* Apply the transformation H^T A H to the remaining columns */
+          /* x = tau * A * v */
+          gsl_blas_zhemv (CblasLower, tau_i, &m.matrix, &v.vector, zero, &x.vector);
 
-          if ((i + 1) < (N - 1) 
-              && !(GSL_REAL(tau_i) == 0.0 && GSL_IMAG(tau_i) == 0.0)) 
-            {
-              gsl_matrix_complex_view m = 
-                gsl_matrix_complex_submatrix (A, i + 1, i + 1, 
-                                              N - (i+1), N - (i+1));
-              gsl_complex ei = gsl_vector_complex_get(&v.vector, 0);
-              gsl_vector_complex_view x = gsl_vector_complex_subvector (tau, i, N-(i+1));
-              gsl_vector_complex_set (&v.vector, 0, one);
-              
-              /* x = tau * A * v */
-              gsl_blas_zhemv (CblasLower, tau_i, &m.matrix, &v.vector, zero, &x.vector);
-
-              /* w = x - (1/2) tau * (x' * v) * v  */
-              {
-                gsl_complex xv, txv, alpha;
-                gsl_blas_zdotc(&x.vector, &v.vector, &xv);
-                txv = gsl_complex_mul(tau_i, xv);
-                alpha = gsl_complex_mul_real(txv, -0.5);
-                gsl_blas_zaxpy(alpha, &v.vector, &x.vector);
-              }
-              
-              /* apply the transformation A = A - v w' - w v' */
-              gsl_blas_zher2(CblasLower, neg_one, &v.vector, &x.vector, &m.matrix);
-
-              gsl_vector_complex_set (&v.vector, 0, ei);
-            }
+          /* w = x - (1/2) tau * (x' * v) * v  */
+          {
+            gsl_complex xv, txv, alpha;
+            gsl_blas_zdotc(&x.vector, &v.vector, &xv);
+            txv = gsl_complex_mul(tau_i, xv);
+            alpha = gsl_complex_mul_real(txv, -0.5);
+            gsl_blas_zaxpy(alpha, &v.vector, &x.vector);
+          }
           
-          gsl_vector_complex_set (tau, i, tau_i);
+          /* apply the transformation A = A - v w' - w v' */
+          gsl_blas_zher2(CblasLower, neg_one, &v.vector, &x.vector, &m.matrix);
+
+          gsl_vector_complex_set (&v.vector, 0, ei);
         }
       
-      return GSL_SUCCESS;
+      gsl_vector_complex_set (tau, i, tau_i);
     }
-}  
+  
+  return GSL_SUCCESS;
+}
+
+/* Blocked reduction (LAPACK zhetrd/zlatrd). The columns are reduced in
+ * panels of HERMTD_BLOCK, collecting the vectors w of the unblocked
+ * rank-2 updates as the columns of a matrix W, and the rest of the
+ * matrix is updated with the single rank-2k update
+ *
+ *   A := A - V W^H - W V^H
+ *
+ * so that half of the flops are done by zher2k. The last
+ * HERMTD_CROSSOVER columns are reduced by hermtd_decomp_L2. */
+
+static int
+hermtd_decomp_L3 (gsl_matrix_complex * A, gsl_vector_complex * tau)
+{
+  const size_t N = A->size1;
+  gsl_matrix_complex *work = gsl_matrix_complex_alloc (N, HERMTD_BLOCK);
+  gsl_vector_complex *vwork = gsl_vector_complex_alloc (2 * N + HERMTD_BLOCK);
+  size_t i = 0;
+
+  if (work == 0 || vwork == 0)
+    {
+      if (work)
+        gsl_matrix_complex_free (work);
+      if (vwork)
+        gsl_vector_complex_free (vwork);
+
+      return GSL_ENOMEM;
+    }
+
+  while (N - i > HERMTD_CROSSOVER)
+    {
+      const size_t n = N - i;
+      const size_t nb = GSL_MIN (HERMTD_BLOCK, n - HERMTD_CROSSOVER);
+      gsl_matrix_complex_view m = gsl_matrix_complex_submatrix (A, i, i, n, n);
+      gsl_vector_complex_view t = gsl_vector_complex_subvector (tau, i, nb);
+      gsl_matrix_complex_view W = gsl_matrix_complex_submatrix (work, 0, 0, n, nb);
+      gsl_complex e[HERMTD_BLOCK];
+      size_t j;
+
+      /* the panel leaves the unit elements of its Householder vectors
+       * in place on the subdiagonal for the rank-2k update */
+
+      hermtd_panel (&m.matrix, nb, &t.vector, &W.matrix, vwork);
+
+      for (j = 0; j < nb; j++)
+        e[j] = gsl_matrix_complex_get (&W.matrix, j, j);
+
+      {
+        gsl_matrix_complex_view V = gsl_matrix_complex_submatrix (&m.matrix, nb, 0, n - nb, nb);
+        gsl_matrix_complex_view W2 = gsl_matrix_complex_submatrix (&W.matrix, nb, 0, n - nb, nb);
+        gsl_matrix_complex_view A22 = gsl_matrix_complex_submatrix (&m.matrix, nb, nb, n - nb, n - nb);
+
+        gsl_blas_zher2k (CblasLower, CblasNoTrans, GSL_COMPLEX_NEGONE, &V.matrix, &W2.matrix,
+                         1.0, &A22.matrix);
+      }
+
+      for (j = 0; j < nb; j++)
+        gsl_matrix_complex_set (&m.matrix, j + 1, j, e[j]);
+
+      i += nb;
+    }
+
+  gsl_matrix_complex_free (work);
+  gsl_vector_complex_free (vwork);
+
+  return hermtd_decomp_L2 (A, i, tau);
+}
+
+/* reduce the first nb columns of the n-by-n matrix A and compute the
+ * n-by-nb matrix W such that the remaining matrix is updated by
+ * A(nb:n,nb:n) -= V W^H + W V^H. On output the subdiagonal elements
+ * A(j+1,j) are set to 1, and the elements of the tridiagonal matrix
+ * which belong there are stored in W(j,j). The vector work, of length
+ * at least 2n + nb, holds contiguous copies of v and w for zhemv and
+ * the conjugated rows of V and W */
+
+static void
+hermtd_panel (gsl_matrix_complex * A, const size_t nb, gsl_vector_complex * tau,
+              gsl_matrix_complex * W, gsl_vector_complex * work)
+{
+  const size_t n = A->size1;
+  size_t i;
+
+  for (i = 0; i < nb; i++)
+    {
+      gsl_vector_complex_view c = gsl_matrix_complex_subcolumn (A, i, i, n - i);
+      gsl_vector_complex_view wc = gsl_matrix_complex_column (W, i);
+      gsl_complex tau_i, wv, alpha, Aii;
+
+      /* bring column i up to date with the previous reflectors,
+       * A(i:n,i) -= V(i:n,0:i) W(i,0:i)^H + W(i:n,0:i) V(i,0:i)^H */
+
+      if (i > 0)
+        {
+          gsl_matrix_complex_view Vi = gsl_matrix_complex_submatrix (A, i, 0, n - i, i);
+          gsl_matrix_complex_view Wi = gsl_matrix_complex_submatrix (W, i, 0, n - i, i);
+          gsl_vector_complex_view vr = gsl_matrix_complex_subrow (A, i, 0, i);
+          gsl_vector_complex_view wr = gsl_matrix_complex_subrow (W, i, 0, i);
+          gsl_vector_complex_view r = gsl_vector_complex_subvector (work, 2 * n, i);
+          gsl_vector_view ri = gsl_vector_complex_imag (&r.vector);
+
+          gsl_blas_zcopy (&wr.vector, &r.vector);
+          gsl_blas_dscal (-1.0, &ri.vector);
+          gsl_blas_zgemv (CblasNoTrans, GSL_COMPLEX_NEGONE, &Vi.matrix, &r.vector,
+                          GSL_COMPLEX_ONE, &c.vector);
+
+          gsl_blas_zcopy (&vr.vector, &r.vector);
+          gsl_blas_dscal (-1.0, &ri.vector);
+          gsl_blas_zgemv (CblasNoTrans, GSL_COMPLEX_NEGONE, &Wi.matrix, &r.vector,
+                          GSL_COMPLEX_ONE, &c.vector);
+        }
 
+      /* the diagonal of a hermitian matrix is real */
+      Aii = gsl_matrix_complex_get (A, i, i);
+      gsl_matrix_complex_set (A, i, i, gsl_complex_rect (GSL_REAL (Aii), 0.0));
+
+      /* Householder transformation for A(i+1:n,i) */
+
+      {
+        gsl_vector_complex_view v = gsl_vector_complex_subvector (&c.vector, 1, n - i - 1);
+        gsl_vector_complex_view w = gsl_vector_complex_subvector (&wc.vector, i + 1, n - i - 1);
+        gsl_vector_complex_view vt = gsl_vector_complex_subvector (work, 0, n - i - 1);
+        gsl_vector_complex_view wt = gsl_vector_complex_subvector (work, n, n - i - 1);
+
+        tau_i = gsl_linalg_complex_householder_transform (&v.vector);
+        gsl_vector_complex_set (tau, i, tau_i);
+
+        gsl_matrix_complex_set (W, i, i, gsl_matrix_complex_get (A, i + 1, i));
+        gsl_matrix_complex_set (A, i + 1, i, GSL_COMPLEX_ONE);
+
+        /* w = tau (A - V W^H - W V^H) v, with A the trailing part of
+         * the matrix which has not yet been updated */
+
+        {
+          gsl_matrix_complex_view m = gsl_matrix_complex_submatrix (A, i + 1, i + 1, n - i - 1, n - i - 1);
+
+          gsl_blas_zcopy (&v.vector, &vt.vector);
+          gsl_blas_zhemv (CblasLower, GSL_COMPLEX_ONE, &m.matrix, &vt.vector,
+                          GSL_COMPLEX_ZERO, &wt.vector);
+          gsl_blas_zcopy (&wt.vector, &w.vector);
+        }
+
+        if (i > 0)
+          {
+            gsl_matrix_complex_view Vi = gsl_matrix_complex_submatrix (A, i + 1, 0, n - i - 1, i);
+            gsl_matrix_complex_view Wi = gsl_matrix_complex_submatrix (W, i + 1, 0, n - i - 1, i);
+            gsl_vector_complex_view t = gsl_vector_complex_subvector (&wc.vector, 0, i);
+
+            gsl_blas_zgemv (CblasConjTrans, GSL_COMPLEX_ONE, &Wi.matrix, &v.vector,
+                            GSL_COMPLEX_ZERO, &t.vector);
+            gsl_blas_zgemv (CblasNoTrans, GSL_COMPLEX_NEGONE, &Vi.matrix, &t.vector,
+                            GSL_COMPLEX_ONE, &w.vector);
+            gsl_blas_zgemv (CblasConjTrans, GSL_COMPLEX_ONE, &Vi.matrix, &v.vector,
+                            GSL_COMPLEX_ZERO, &t.vector);
+            gsl_blas_zgemv (CblasNoTrans, GSL_COMPLEX_NEGONE, &Wi.matrix, &t.vector,
+                            GSL_COMPLEX_ONE, &w.vector);
+          }
+
+        gsl_blas_zscal (tau_i, &w.vector);
+
+        /* w = w - (1/2) tau (w' v) v */
+
+        gsl_blas_zdotc (&w.vector, &v.vector, &wv);
+        alpha = gsl_complex_mul_real (gsl_complex_mul (tau_i, wv), -0.5);
+        gsl_blas_zaxpy (alpha, &v.vector, &w.vector);
+      }
+    }
+}
 
 /*  Form the orthogonal matrix U from the packed QR matrix */
 
@@ -161,7 +364,15 @@ gsl_linalg_hermtd_unpack (const gsl_matrix_complex * A,
 
       gsl_matrix_complex_set_identity (U);
 
-      for (i = N - 1; i-- > 0;)
+      /* for large matrices the reflectors of the panels of the blocked
+       * reduction are applied as block reflectors */
+
+      if (N > HERMTD_CROSSOVER && hermtd_unpack_L3 (A, tau, U) == GSL_SUCCESS)
+        i = 0;
+      else
+        i = N - 1;
+
+      for (; i-- > 0;)
         {
           gsl_complex ti = gsl_vector_complex_get (tau, i);
 
@@ -196,6 +407,133 @@ gsl_linalg_hermtd_unpack (const gsl_matrix_complex * A,
     }
 }
 
+/* Apply the reflectors of the panels of the blocked reduction to U,
+ * which on input contains the identity. The reflectors of the last
+ * HERMTD_CROSSOVER columns are applied one at a time, and each panel
+ * of HERMTD_BLOCK reflectors H_j ... H_(j+nb-1) = I - V T V^H is then
+ * applied in reverse order with Level 3 BLAS (LAPACK zungtr/zungqr) */
+
+static int
+hermtd_unpack_L3 (const gsl_matrix_complex * A, const gsl_vector_complex * tau,
+                  gsl_matrix_complex * U)
+{
+  const size_t N = A->size1;
+  gsl_matrix_complex *T = gsl_matrix_complex_alloc (HERMTD_BLOCK, HERMTD_BLOCK);
+  gsl_matrix_complex *work = gsl_matrix_complex_alloc (HERMTD_BLOCK, N);
+  size_t i = 0, j;
+
+  if (T == 0 || work == 0)
+    {
+      if (T)
+        gsl_matrix_complex_free (T);
+      if (work)
+        gsl_matrix_complex_free (work);
+
+      return GSL_ENOMEM;
+    }
+
+  /* first column not reduced by a panel of hermtd_decomp_L3 */
+  while (N - i > HERMTD_CROSSOVER)
+    i += GSL_MIN (HERMTD_BLOCK, N - i - HERMTD_CROSSOVER);
+
+  for (j = N - 1; j-- > i;)
+    {
+      gsl_complex tj = gsl_vector_complex_get (tau, j);
+      gsl_vector_complex_const_view c = gsl_matrix_complex_const_column (A, j);
+      gsl_vector_complex_const_view h = 
+        gsl_vector_complex_const_subvector (&c.vector, j + 1, N - (j+1));
+      gsl_matrix_complex_view m = 
+        gsl_matrix_complex_submatrix (U, j + 1, j + 1, N-(j+1), N-(j+1));
+
+      gsl_linalg_complex_householder_hm (tj, &h.vector, &m.matrix);
+    }
+
+  for (j = ((i - 1) / HERMTD_BLOCK) * HERMTD_BLOCK; i > 0; i = j, j -= HERMTD_BLOCK)
+    {
+      const size_t nb = i - j;
+      const size_t m = N - j - 1;
+
+      /* the diagonal of V holds the subdiagonal of the tridiagonal
+       * matrix; the unit diagonal is implied by CblasUnit */
+      gsl_matrix_complex_const_view V = gsl_matrix_complex_const_submatrix (A, j + 1, j, m, nb);
+      gsl_matrix_complex_const_view V1 = gsl_matrix_complex_const_submatrix (&V.matrix, 0, 0, nb, nb);
+      gsl_matrix_complex_const_view V2 = gsl_matrix_complex_const_submatrix (&V.matrix, nb, 0, m - nb, nb);
+      gsl_vector_complex_const_view t = gsl_vector_complex_const_subvector (tau, j, nb);
+      gsl_matrix_complex_view Tb = gsl_matrix_complex_submatrix (T, 0, 0, nb, nb);
+      gsl_matrix_complex_view W = gsl_matrix_complex_submatrix (work, 0, 0, nb, m);
+      gsl_matrix_complex_view C1 = gsl_matrix_complex_submatrix (U, j + 1, j + 1, nb, m);
+      gsl_matrix_complex_view C2 = gsl_matrix_complex_submatrix (U, j + 1 + nb, j + 1, m - nb, m);
+
+      hermtd_larft (&V.matrix, &t.vector, &Tb.matrix);
+
+      /* W = T V^H C */
+      gsl_matrix_complex_memcpy (&W.matrix, &C1.matrix);
+      gsl_blas_ztrmm (CblasLeft, CblasLower, CblasConjTrans, CblasUnit, GSL_COMPLEX_ONE,
+                      &V1.matrix, &W.matrix);
+      gsl_blas_zgemm (CblasConjTrans, CblasNoTrans, GSL_COMPLEX_ONE, &V2.matrix, &C2.matrix,
+                      GSL_COMPLEX_ONE, &W.matrix);
+      gsl_blas_ztrmm (CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, GSL_COMPLEX_ONE,
+                      &Tb.matrix, &W.matrix);
+
+      /* C = C - V W */
+      gsl_blas_zgemm (CblasNoTrans, CblasNoTrans, GSL_COMPLEX_NEGONE, &V2.matrix, &W.matrix,
+                      GSL_COMPLEX_ONE, &C2.matrix);
+      gsl_blas_ztrmm (CblasLeft, CblasLower, CblasNoTrans, CblasUnit, GSL_COMPLEX_ONE,
+                      &V1.matrix, &W.matrix);
+      gsl_matrix_complex_sub (&C1.matrix, &W.matrix);
+    }
+
+  gsl_matrix_complex_free (T);
+  gsl_matrix_complex_free (work);
+
+  return GSL_SUCCESS;
+}
+
+/* compute the upper triangular factor T of the block reflector
+ * H_0 H_1 ... H_(k-1) = I - V T V^H, where the m-by-k matrix V is unit
+ * lower trapezoidal and its diagonal is not referenced (LAPACK zlarft) */
+
+static void
+hermtd_larft (const gsl_matrix_complex * V, const gsl_vector_complex * tau,
+              gsl_matrix_complex * T)
+{
+  const size_t m = V->size1;
+  const size_t k = V->size2;
+  size_t i, j;
+
+  for (i = 0; i < k; i++)
+    {
+      const gsl_complex tau_i = gsl_vector_complex_get (tau, i);
+
+      gsl_matrix_complex_set (T, i, i, tau_i);
+
+      if (i > 0)
+        {
+          gsl_vector_complex_view t = gsl_matrix_complex_subcolumn (T, i, 0, i);
+          gsl_matrix_complex_const_view Vi = gsl_matrix_complex_const_submatrix (V, i + 1, 0, m - i - 1, i);
+          gsl_vector_complex_const_view v = gsl_matrix_complex_const_subcolumn (V, i, i + 1, m - i - 1);
+          gsl_matrix_complex_view Ti = gsl_matrix_complex_submatrix (T, 0, 0, i, i);
+
+          /* t = -tau_i V(i:m,0:i)^H v_i, with v_i(i) = 1 */
+          gsl_blas_zgemv (CblasConjTrans, GSL_COMPLEX_ONE, &Vi.matrix, &v.vector,
+                          GSL_COMPLEX_ZERO, &t.vector);
+
+          for (j = 0; j < i; j++)
+            {
+              gsl_complex tj = gsl_matrix_complex_get (T, j, i);
+              gsl_complex vij = gsl_matrix_complex_get (V, i, j);
+
+              gsl_matrix_complex_set (T, j, i, gsl_complex_add (tj, gsl_complex_conjugate (vij)));
+            }
+
+          gsl_blas_zscal (gsl_complex_negative (tau_i), &t.vector);
+
+          /* t = T(0:i,0:i) t */
+          gsl_blas_ztrmv (CblasUpper, CblasNoTrans, CblasNonUnit, &Ti.matrix, &t.vector);
+        }
+    }
+}
+
 int
 gsl_linalg_hermtd_unpack_T (const gsl_matrix_complex * A, 
                             gsl_vector * diag, 
@@ -18,10 +18,26 @@
  */
 
 #include <config.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_blas.h>
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
 
+/* number of columns reduced per panel by the blocked algorithm */
+#define HESSENBERG_BLOCK 32
+
+/* the blocked algorithm is used while more than this many columns
+ * remain to be reduced */
+#define HESSENBERG_CROSSOVER 128
+
+static int hessenberg_decomp_L2 (gsl_matrix * A, const size_t i0, gsl_vector * tau);
+static int hessenberg_decomp_L3 (gsl_matrix * A, gsl_vector * tau);
+static void hessenberg_panel (gsl_matrix * A, const size_t k, const size_t nb,
+                              gsl_vector * tau, gsl_matrix * T, gsl_matrix * Y);
+static int hessenberg_unpack_accum_L3 (gsl_matrix * H, gsl_vector * tau,
+                                       gsl_matrix * V);
+
 /*
 gsl_linalg_hessenberg_decomp()
   Compute the Householder reduction to Hessenberg form of a
@@ -84,51 +100,293 @@ gsl_linalg_hessenberg_decomp(gsl_matrix *A, gsl_vector *tau)
     }
   else
     {
-      size_t i;           /* looping */
-      gsl_vector_view c,  /* matrix column */
-                      hv; /* householder vector */
-      gsl_matrix_view m;
-      double tau_i;       /* beta in algorithm 7.4.2 */
+      if (N > HESSENBERG_CROSSOVER)
+        {
+          int status = hessenberg_decomp_L3 (A, tau);
 
-      for (i = 0; i < N - 2; ++i)
+          if (status != GSL_ENOMEM)
+            return status;
+
+          /* not enough memory for the panel workspace, fall through to
+           * the unblocked algorithm */
+        }
+
+      return hessenberg_decomp_L2 (A, 0, tau);
+    }
+} /* gsl_linalg_hessenberg_decomp() */
+
+/* reduce columns i0 and beyond, one column at a time with Level 2
+ * Householder updates of the whole matrix */
+
+static int
+hessenberg_decomp_L2 (gsl_matrix * A, const size_t i0, gsl_vector * tau)
+{
+  const size_t N = A->size1;
+  size_t i;           /* looping */
+  gsl_vector_view c,  /* matrix column */
+                  hv; /* householder vector */
+  gsl_matrix_view m;
+  double tau_i;       /* beta in algorithm 7.4.2 */
+
+  for (i = i0; i < N - 2; ++i)
+    {
+      /*
+       * make a copy of A(i + 1:n, i) and store it in the section
+       * of 'tau' that we haven't stored coefficients in yet
+       */
+
+      c = gsl_matrix_subcolumn(A, i, i + 1, N - i - 1);
+
+      hv = gsl_vector_subvector(tau, i + 1, N - (i + 1));
+      gsl_blas_dcopy(&c.vector, &hv.vector);
+
+      /* compute householder transformation of A(i+1:n,i) */
+      tau_i = gsl_linalg_householder_transform(&hv.vector);
+
+      /* apply left householder matrix (I - tau_i v v') to A */
+      m = gsl_matrix_submatrix(A, i + 1, i, N - (i + 1), N - i);
+      gsl_linalg_householder_hm(tau_i, &hv.vector, &m.matrix);
+
+      /* apply right householder matrix (I - tau_i v v') to A */
+      m = gsl_matrix_submatrix(A, 0, i + 1, N, N - (i + 1));
+      gsl_linalg_householder_mh(tau_i, &hv.vector, &m.matrix);
+
+      /* save Householder coefficient */
+      gsl_vector_set(tau, i, tau_i);
+
+      /*
+       * store Householder vector below the subdiagonal in column
+       * i of the matrix. hv(1) does not need to be stored since
+       * it is always 1.
+       */
+      c = gsl_vector_subvector(&c.vector, 1, c.vector.size - 1);
+      hv = gsl_vector_subvector(&hv.vector, 1, hv.vector.size - 1);
+      gsl_blas_dcopy(&hv.vector, &c.vector);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* Blocked reduction (LAPACK dgehrd/dlahr2). The columns are reduced in
+ * panels of HESSENBERG_BLOCK. Within a panel the reflectors are applied
+ * only to the columns being reduced, and the panel returns the matrices
+ * T and Y = A V T of the block reflector H = I - V T V^T. The rest of
+ * the matrix is then updated with
+ *
+ *   A := (A - Y V^T) from the right, A := H^T A from the left
+ *
+ * so that most of the flops are done by dgemm. The last
+ * HESSENBERG_CROSSOVER columns are reduced by hessenberg_decomp_L2. */
+
+static int
+hessenberg_decomp_L3 (gsl_matrix * A, gsl_vector * tau)
+{
+  const size_t N = A->size1;
+  gsl_matrix *Y = gsl_matrix_alloc (N, HESSENBERG_BLOCK);
+  gsl_matrix *T = gsl_matrix_alloc (HESSENBERG_BLOCK, HESSENBERG_BLOCK);
+  gsl_matrix *W = gsl_matrix_alloc (HESSENBERG_BLOCK, N);
+  size_t i = 0;
+
+  if (Y == 0 || T == 0 || W == 0)
+    {
+      if (Y)
+        gsl_matrix_free (Y);
+      if (T)
+        gsl_matrix_free (T);
+      if (W)
+        gsl_matrix_free (W);
+
+      return GSL_ENOMEM;
+    }
+
+  while (N - i > HESSENBERG_CROSSOVER)
+    {
+      const size_t nb = GSL_MIN (HESSENBERG_BLOCK, N - i - HESSENBERG_CROSSOVER);
+      const size_t n2 = N - i - nb;        /* columns right of the panel */
+      gsl_matrix_view Yb = gsl_matrix_submatrix (Y, 0, 0, N, nb);
+      gsl_matrix_view Tb = gsl_matrix_submatrix (T, 0, 0, nb, nb);
+      gsl_vector_view t = gsl_vector_subvector (tau, i, nb);
+      double ei;
+      size_t j;
+
+      hessenberg_panel (A, i, nb, &t.vector, &Tb.matrix, &Yb.matrix);
+
+      /* A(0:N,i+nb:N) -= Y V^T, with V the rows i+nb:N of the panel
+       * including the unit element of the last reflector */
+      {
+        gsl_matrix_view V = gsl_matrix_submatrix (A, i + nb, i, n2, nb);
+        gsl_matrix_view A2 = gsl_matrix_submatrix (A, 0, i + nb, N, n2);
+
+        ei = gsl_matrix_get (A, i + nb, i + nb - 1);
+        gsl_matrix_set (A, i + nb, i + nb - 1, 1.0);
+        gsl_blas_dgemm (CblasNoTrans, CblasTrans, -1.0, &Yb.matrix, &V.matrix,
+                        1.0, &A2.matrix);
+        gsl_matrix_set (A, i + nb, i + nb - 1, ei);
+      }
+
+      /* rows 0:i+1 of the panel columns i+1:i+nb, which the panel did
+       * not update */
+      if (nb > 1)
         {
-          /*
-           * make a copy of A(i + 1:n, i) and store it in the section
-           * of 'tau' that we haven't stored coefficients in yet
-           */
+          gsl_matrix_view Y1 = gsl_matrix_submatrix (Y, 0, 0, i + 1, nb - 1);
+          gsl_matrix_view V1 = gsl_matrix_submatrix (A, i + 1, i, nb - 1, nb - 1);
 
-          c = gsl_matrix_subcolumn(A, i, i + 1, N - i - 1);
+          gsl_blas_dtrmm (CblasRight, CblasLower, CblasTrans, CblasUnit, 1.0,
+                          &V1.matrix, &Y1.matrix);
 
-          hv = gsl_vector_subvector(tau, i + 1, N - (i + 1));
-          gsl_vector_memcpy(&hv.vector, &c.vector);
+          for (j = 0; j < nb - 1; ++j)
+            {
+              gsl_vector_view y = gsl_matrix_column (&Y1.matrix, j);
+              gsl_vector_view a = gsl_matrix_subcolumn (A, i + j + 1, 0, i + 1);
 
-          /* compute householder transformation of A(i+1:n,i) */
-          tau_i = gsl_linalg_householder_transform(&hv.vector);
+              gsl_blas_daxpy (-1.0, &y.vector, &a.vector);
+            }
+        }
 
-          /* apply left householder matrix (I - tau_i v v') to A */
-          m = gsl_matrix_submatrix(A, i + 1, i, N - (i + 1), N - i);
-          gsl_linalg_householder_hm(tau_i, &hv.vector, &m.matrix);
+      /* A(i+1:N,i+nb:N) := H^T A(i+1:N,i+nb:N), H = I - V T V^T */
+      {
+        gsl_matrix_view V1 = gsl_matrix_submatrix (A, i + 1, i, nb, nb);
+        gsl_matrix_view V2 = gsl_matrix_submatrix (A, i + 1 + nb, i, n2 - 1, nb);
+        gsl_matrix_view C1 = gsl_matrix_submatrix (A, i + 1, i + nb, nb, n2);
+        gsl_matrix_view C2 = gsl_matrix_submatrix (A, i + 1 + nb, i + nb, n2 - 1, n2);
+        gsl_matrix_view Wb = gsl_matrix_submatrix (W, 0, 0, nb, n2);
+
+        /* W = V^T C */
+        gsl_matrix_memcpy (&Wb.matrix, &C1.matrix);
+        gsl_blas_dtrmm (CblasLeft, CblasLower, CblasTrans, CblasUnit, 1.0,
+                        &V1.matrix, &Wb.matrix);
+        gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, &V2.matrix, &C2.matrix,
+                        1.0, &Wb.matrix);
+
+        /* W = T^T W */
+        gsl_blas_dtrmm (CblasLeft, CblasUpper, CblasTrans, CblasNonUnit, 1.0,
+                        &Tb.matrix, &Wb.matrix);
+
+        /* C = C - V W */
+        gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, -1.0, &V2.matrix, &Wb.matrix,
+                        1.0, &C2.matrix);
+        gsl_blas_dtrmm (CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0,
+                        &V1.matrix, &Wb.matrix);
+        gsl_matrix_sub (&C1.matrix, &Wb.matrix);
+      }
+
+      i += nb;
+    }
 
-          /* apply right householder matrix (I - tau_i v v') to A */
-          m = gsl_matrix_submatrix(A, 0, i + 1, N, N - (i + 1));
-          gsl_linalg_householder_mh(tau_i, &hv.vector, &m.matrix);
+  gsl_matrix_free (Y);
+  gsl_matrix_free (T);
+  gsl_matrix_free (W);
 
-          /* save Householder coefficient */
-          gsl_vector_set(tau, i, tau_i);
+  return hessenberg_decomp_L2 (A, i, tau);
+}
 
-          /*
-           * store Householder vector below the subdiagonal in column
-           * i of the matrix. hv(1) does not need to be stored since
-           * it is always 1.
-           */
-          c = gsl_vector_subvector(&c.vector, 1, c.vector.size - 1);
-          hv = gsl_vector_subvector(&hv.vector, 1, hv.vector.size - 1);
-          gsl_vector_memcpy(&c.vector, &hv.vector);
+/* reduce the nb columns k:k+nb of A, which has already been reduced
+ * in its first k columns, and compute the upper triangular matrix T of
+ * the block reflector H = I - V T V^T and the N-by-nb matrix Y = A V T.
+ * The reflectors are applied to the panel columns only; the rest of A
+ * is not modified. Based on LAPACK DLAHR2 */
+
+static void
+hessenberg_panel (gsl_matrix * A, const size_t k, const size_t nb,
+                  gsl_vector * tau, gsl_matrix * T, gsl_matrix * Y)
+{
+  const size_t N = A->size1;
+  const size_t K = k + 1;     /* first row acted on by the reflectors */
+  gsl_matrix_view Pv = gsl_matrix_submatrix (A, 0, k, N, N - k);
+  gsl_matrix * P = &Pv.matrix;
+  double ei = 0.0;
+  size_t j;
+
+  for (j = 0; j < nb; ++j)
+    {
+      gsl_vector_view v = gsl_matrix_subcolumn (P, j, K + j, N - K - j);
+      gsl_vector_view y = gsl_matrix_subcolumn (Y, j, K, N - K);
+      double tau_j;
+
+      if (j > 0)
+        {
+          gsl_matrix_view V1 = gsl_matrix_submatrix (P, K, 0, j, j);
+          gsl_matrix_view V2 = gsl_matrix_submatrix (P, K + j, 0, N - K - j, j);
+          gsl_matrix_view Yj = gsl_matrix_submatrix (Y, K, 0, N - K, j);
+          gsl_matrix_view Tj = gsl_matrix_submatrix (T, 0, 0, j, j);
+          gsl_vector_view vr = gsl_matrix_subrow (P, K + j - 1, 0, j);
+          gsl_vector_view b = gsl_matrix_subcolumn (P, j, K, N - K);
+          gsl_vector_view b1 = gsl_matrix_subcolumn (P, j, K, j);
+          gsl_vector_view w = gsl_matrix_subcolumn (T, nb - 1, 0, j);
+
+          /* b = A(K:N,j) - Y V(j-1,:)^T */
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Yj.matrix, &vr.vector, 1.0, &b.vector);
+
+          /* apply H^T = I - V T^T V^T to b, with w = T^T V^T b */
+          gsl_blas_dcopy (&b1.vector, &w.vector);
+          gsl_blas_dtrmv (CblasLower, CblasTrans, CblasUnit, &V1.matrix, &w.vector);
+          gsl_blas_dgemv (CblasTrans, 1.0, &V2.matrix, &v.vector, 1.0, &w.vector);
+          gsl_blas_dtrmv (CblasUpper, CblasTrans, CblasNonUnit, &Tj.matrix, &w.vector);
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &V2.matrix, &w.vector, 1.0, &v.vector);
+          gsl_blas_dtrmv (CblasLower, CblasNoTrans, CblasUnit, &V1.matrix, &w.vector);
+          gsl_blas_daxpy (-1.0, &w.vector, &b1.vector);
+
+          gsl_matrix_set (P, K + j - 1, j - 1, ei);
         }
 
-      return GSL_SUCCESS;
+      /* reflector annihilating A(K+j+1:N,j) */
+      tau_j = gsl_linalg_householder_transform (&v.vector);
+      ei = gsl_matrix_get (P, K + j, j);
+      gsl_matrix_set (P, K + j, j, 1.0);
+
+      /* Y(K:N,j) = tau_j (A(K:N,j+1:) v - Y T(0:j,j)), with
+       * T(0:j,j) = V^T v */
+      {
+        gsl_matrix_view Ar = gsl_matrix_submatrix (P, K, j + 1, N - K, N - K - j);
+
+        gsl_blas_dgemv (CblasNoTrans, 1.0, &Ar.matrix, &v.vector, 0.0, &y.vector);
+      }
+
+      if (j > 0)
+        {
+          gsl_matrix_view V2 = gsl_matrix_submatrix (P, K + j, 0, N - K - j, j);
+          gsl_matrix_view Yj = gsl_matrix_submatrix (Y, K, 0, N - K, j);
+          gsl_matrix_view Tj = gsl_matrix_submatrix (T, 0, 0, j, j);
+          gsl_vector_view t = gsl_matrix_subcolumn (T, j, 0, j);
+
+          gsl_blas_dgemv (CblasTrans, 1.0, &V2.matrix, &v.vector, 0.0, &t.vector);
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Yj.matrix, &t.vector, 1.0, &y.vector);
+
+          /* T(0:j,j) = -tau_j T(0:j,0:j) V^T v */
+          gsl_blas_dscal (-tau_j, &t.vector);
+          gsl_blas_dtrmv (CblasUpper, CblasNoTrans, CblasNonUnit, &Tj.matrix, &t.vector);
+        }
+
+      gsl_blas_dscal (tau_j, &y.vector);
+      gsl_matrix_set (T, j, j, tau_j);
+      gsl_vector_set (tau, j, tau_j);
     }
-} /* gsl_linalg_hessenberg_decomp() */
+
+  gsl_matrix_set (P, K + nb - 1, nb - 1, ei);
+
+  /* Y(0:K,:) = A(0:K,1:) V T */
+  {
+    gsl_matrix_view Y0 = gsl_matrix_submatrix (Y, 0, 0, K, nb);
+    gsl_matrix_view A1 = gsl_matrix_submatrix (P, 0, 1, K, nb);
+    gsl_matrix_view V1 = gsl_matrix_submatrix (P, K, 0, nb, nb);
+
+    gsl_matrix_memcpy (&Y0.matrix, &A1.matrix);
+    gsl_blas_dtrmm (CblasRight, CblasLower, CblasNoTrans, CblasUnit, 1.0,
+                    &V1.matrix, &Y0.matrix);
+
+    if (N > K + nb)
+      {
+        gsl_matrix_view A2 = gsl_matrix_submatrix (P, 0, nb + 1, K, N - K - nb);
+        gsl_matrix_view V2 = gsl_matrix_submatrix (P, K + nb, 0, N - K - nb, nb);
+
+        gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &A2.matrix, &V2.matrix,
+                        1.0, &Y0.matrix);
+      }
+
+    gsl_blas_dtrmm (CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0,
+                    T, &Y0.matrix);
+  }
+}
 
 /*
 gsl_linalg_hessenberg_unpack()
@@ -236,6 +494,14 @@ gsl_linalg_hessenberg_unpack_accum(gsl_matrix * H, gsl_vector * tau,
           return GSL_SUCCESS;
         }
 
+      if (N > HESSENBERG_CROSSOVER)
+        {
+          int status = hessenberg_unpack_accum_L3(H, tau, V);
+
+          if (status != GSL_ENOMEM)
+            return status;
+        }
+
       for (j = 0; j < (N - 2); ++j)
         {
           c = gsl_matrix_column(H, j);
@@ -268,6 +534,95 @@ gsl_linalg_hessenberg_unpack_accum(gsl_matrix * H, gsl_vector * tau,
     }
 } /* gsl_linalg_hessenberg_unpack_accum() */
 
+/* V := V U(1) ... U(n-2), with the reflectors applied to V from the
+ * right in blocks of HESSENBERG_BLOCK as V := V (I - Vb T Vb^T)
+ * (LAPACK DLARFT/DLARFB) */
+
+static int
+hessenberg_unpack_accum_L3 (gsl_matrix * H, gsl_vector * tau, gsl_matrix * V)
+{
+  const size_t N = H->size1;
+  const size_t M = V->size1;
+  const size_t nrefl = N - 2;
+  gsl_matrix *Vb = gsl_matrix_alloc (N - 1, HESSENBERG_BLOCK);
+  gsl_matrix *T = gsl_matrix_alloc (HESSENBERG_BLOCK, HESSENBERG_BLOCK);
+  gsl_matrix *W = gsl_matrix_alloc (M, HESSENBERG_BLOCK);
+  size_t j0;
+
+  if (Vb == 0 || T == 0 || W == 0)
+    {
+      if (Vb)
+        gsl_matrix_free (Vb);
+      if (T)
+        gsl_matrix_free (T);
+      if (W)
+        gsl_matrix_free (W);
+
+      return GSL_ENOMEM;
+    }
+
+  for (j0 = 0; j0 < nrefl; j0 += HESSENBERG_BLOCK)
+    {
+      const size_t kb = GSL_MIN (HESSENBERG_BLOCK, nrefl - j0);
+      const size_t m = N - j0 - 1;
+      gsl_matrix_view Vj = gsl_matrix_submatrix (Vb, 0, 0, m, kb);
+      gsl_matrix_view Tj = gsl_matrix_submatrix (T, 0, 0, kb, kb);
+      gsl_matrix_view Wj = gsl_matrix_submatrix (W, 0, 0, M, kb);
+      gsl_matrix_view C = gsl_matrix_submatrix (V, 0, j0 + 1, M, m);
+      size_t r, c;
+
+      /* reflector j0 + c has its unit element in row c of Vj */
+      for (r = 0; r < m; ++r)
+        {
+          for (c = 0; c < kb; ++c)
+            {
+              double vrc;
+
+              if (r < c)
+                vrc = 0.0;
+              else if (r == c)
+                vrc = 1.0;
+              else
+                vrc = gsl_matrix_get (H, j0 + 1 + r, j0 + c);
+
+              gsl_matrix_set (&Vj.matrix, r, c, vrc);
+            }
+        }
+
+      gsl_matrix_set_zero (&Tj.matrix);
+
+      for (c = 0; c < kb; ++c)
+        {
+          const double tc = gsl_vector_get (tau, j0 + c);
+
+          gsl_matrix_set (&Tj.matrix, c, c, tc);
+
+          if (c > 0)
+            {
+              /* T(0:c,c) = -tau_c T(0:c,0:c) Vj(:,0:c)^T v_c */
+              gsl_matrix_view Vp = gsl_matrix_submatrix (&Vj.matrix, 0, 0, m, c);
+              gsl_vector_view vc = gsl_matrix_column (&Vj.matrix, c);
+              gsl_matrix_view Tp = gsl_matrix_submatrix (&Tj.matrix, 0, 0, c, c);
+              gsl_vector_view t = gsl_matrix_subcolumn (&Tj.matrix, c, 0, c);
+
+              gsl_blas_dgemv (CblasTrans, -tc, &Vp.matrix, &vc.vector, 0.0, &t.vector);
+              gsl_blas_dtrmv (CblasUpper, CblasNoTrans, CblasNonUnit, &Tp.matrix, &t.vector);
+            }
+        }
+
+      /* C := C - C Vj T Vj^T */
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &C.matrix, &Vj.matrix, 0.0, &Wj.matrix);
+      gsl_blas_dtrmm (CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, &Tj.matrix, &Wj.matrix);
+      gsl_blas_dgemm (CblasNoTrans, CblasTrans, -1.0, &Wj.matrix, &Vj.matrix, 1.0, &C.matrix);
+    }
+
+  gsl_matrix_free (Vb);
+  gsl_matrix_free (T);
+  gsl_matrix_free (W);
+
+  return GSL_SUCCESS;
+}
+
 /*
 gsl_linalg_hessenberg_set_zero()
   Zero out the lower triangular portion of the Hessenberg matrix H.
@@ -386,7 +741,7 @@ gsl_linalg_hessenberg_submatrix(gsl_matrix *M, gsl_matrix *A, size_t top,
           c = gsl_matrix_subcolumn(A, i, i + 1, N - i - 1);
 
           hv = gsl_vector_subvector(tau, i + 1, N - (i + 1));
-          gsl_vector_memcpy(&hv.vector, &c.vector);
+          gsl_blas_dcopy(&c.vector, &hv.vector);
 
           /* compute householder transformation of A(i+1:n,i) */
           tau_i = gsl_linalg_householder_transform(&hv.vector);
@@ -425,7 +780,7 @@ gsl_linalg_hessenberg_submatrix(gsl_matrix *M, gsl_matrix *A, size_t top,
            */
           c = gsl_vector_subvector(&c.vector, 1, c.vector.size - 1);
           hv = gsl_vector_subvector(&hv.vector, 1, hv.vector.size - 1);
-          gsl_vector_memcpy(&c.vector, &hv.vector);
+          gsl_blas_dcopy(&hv.vector, &c.vector);
         }
 
       return GSL_SUCCESS;
@@ -0,0 +1,161 @@
+/* linalg/ldlt_packed.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_cblas.h>
+
+#include "packed.h"
+
+/*
+gsl_linalg_ldlt_packed_decomp()
+  Perform L D L^T decomposition of a symmetric positive semi-definite
+matrix stored in lower packed format
+
+Inputs: AP - on input, lower triangle of A in packed format,
+             length N(N+1)/2;
+             on output, strict lower triangle contains the unit lower
+             triangular factor L, diagonal contains D
+
+Return: success/error
+
+Notes:
+1) Row i of L and d_i are computed from the leading factors by
+solving L(0:i-1,0:i-1) w = A(i,0:i-1) with a packed unit triangular
+solve, so that w = D L(i,0:i-1)^T. Then L(i,j) = w_j / d_j and
+d_i = A(i,i) - sum_j L(i,j) w_j
+
+2) No rcond estimate is available, since there is no spare element in
+packed storage to save ||A||_1
+*/
+
+int
+gsl_linalg_ldlt_packed_decomp (gsl_vector * AP)
+{
+  size_t N;
+  int status = packed_order (AP, &N);
+
+  if (status)
+    return status;
+  else
+    {
+      double *ap = AP->data;
+      size_t i, j;
+
+      for (i = 0; i < N; ++i)
+        {
+          double *li = ap + i * (i + 1) / 2; /* row i of L */
+          double dval = 0.0;
+
+          if (i > 0)
+            {
+              /* solve L(0:i-1,0:i-1) w = A(i,0:i-1), the diagonal (D) is not referenced */
+              cblas_dtpsv (CblasRowMajor, CblasLower, CblasNoTrans, CblasUnit,
+                           (int) i, ap, li, 1);
+
+              for (j = 0; j < i; ++j)
+                {
+                  double wj = li[j];
+
+                  li[j] = wj / ap[PACKED_LOWER_DIAG (j)];
+                  dval += li[j] * wj;
+                }
+            }
+
+          li[i] -= dval;
+
+          if (li[i] == 0.0)
+            {
+              GSL_ERROR ("matrix is singular", GSL_EDOM);
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+int
+gsl_linalg_ldlt_packed_solve (const gsl_vector * LDLT,
+                              const gsl_vector * b,
+                              gsl_vector * x)
+{
+  size_t N;
+  int status = packed_order (LDLT, &N);
+
+  if (status)
+    return status;
+  else if (b->size != N)
+    {
+      GSL_ERROR ("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (x->size != N)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      /* copy x <- b */
+      gsl_blas_dcopy (b, x);
+
+      status = gsl_linalg_ldlt_packed_svx (LDLT, x);
+
+      return status;
+    }
+}
+
+int
+gsl_linalg_ldlt_packed_svx (const gsl_vector * LDLT,
+                            gsl_vector * x)
+{
+  size_t N;
+  int status = packed_order (LDLT, &N);
+
+  if (status)
+    return status;
+  else if (x->size != N)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      const double *ap = LDLT->data;
+      size_t i;
+
+      /* solve for z using forward-substitution, L z = b */
+      cblas_dtpsv (CblasRowMajor, CblasLower, CblasNoTrans, CblasUnit,
+                   (int) N, ap, x->data, (int) x->stride);
+
+      /* solve for y, D y = z */
+      for (i = 0; i < N; ++i)
+        x->data[i * x->stride] /= ap[PACKED_LOWER_DIAG (i)];
+
+      /* perform back-substitution, L^T x = y */
+      cblas_dtpsv (CblasRowMajor, CblasLower, CblasTrans, CblasUnit,
+                   (int) N, ap, x->data, (int) x->stride);
+
+      return GSL_SUCCESS;
+    }
+}
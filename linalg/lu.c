@@ -29,9 +29,30 @@
 #include <gsl/gsl_linalg.h>
 
 #include "recurse.h"
+#include "tiled.h"
+
+/* tasks of the tiled factorization */
+enum
+{
+  LU_PANEL,
+  LU_SWAP,
+  LU_GEMM
+};
+
+typedef struct
+{
+  gsl_matrix * A;
+  size_t nt;                /* number of tile rows and columns */
+  gsl_vector_uint * ipiv;   /* row interchanges, relative to each panel */
+  size_t * step;            /* step[j]: last step k with SWAP(k,j) done */
+  size_t * nupdate;         /* nupdate[j]: GEMM tasks done in column j at that step */
+  char * panel;             /* panel[k]: PANEL(k) done */
+} LU_tiled_params;
 
 static int LU_decomp_L2 (gsl_matrix * A, gsl_vector_uint * ipiv);
 static int LU_decomp_L3 (gsl_matrix * A, gsl_vector_uint * ipiv);
+static int LU_tiled_run (const linalg_tiled_task * task, void * params);
+static void LU_tiled_done (const linalg_tiled_task * task, void * params, linalg_tiled_sched * sched);
 static int singular (const gsl_matrix * LU);
 static int apply_pivots(gsl_matrix * A, const gsl_vector_uint * ipiv);
 
@@ -115,178 +136,139 @@ gsl_linalg_LU_decomp (gsl_matrix * A, gsl_permutation * p, int *signum)
 }
 
 /*
-LU_decomp_L2
-  LU decomposition with partial pivoting using Level 2 BLAS
-
-Inputs: A    - on input, matrix to be factored; on output, L and U factors
-        ipiv - (output) array containing row swaps
-
-Notes:
-1) Based on LAPACK DGETF2
-*/
-
-static int
-LU_decomp_L2 (gsl_matrix * A, gsl_vector_uint * ipiv)
-{
-  const size_t M = A->size1;
-  const size_t N = A->size2;
-  const size_t minMN = GSL_MIN(M, N);
-
-  if (ipiv->size != minMN)
-    {
-      GSL_ERROR ("ipiv length must equal MIN(M,N)", GSL_EBADLEN);
-    }
-  else
-    {
-      size_t i, j;
-
-      for (j = 0; j < minMN; ++j)
-        {
-          /* find maximum in the j-th column */
-          gsl_vector_view v = gsl_matrix_subcolumn(A, j, j, M - j);
-          size_t j_pivot = j + gsl_blas_idamax(&v.vector);
-          gsl_vector_view v1, v2;
-
-          gsl_vector_uint_set(ipiv, j, j_pivot);
+gsl_linalg_LU_decomp_tiled()
+  LU decomposition with partial pivoting of a square matrix, with
+a tiled algorithm using several threads
 
-          if (j_pivot != j)
-            {
-              /* swap rows j and j_pivot */
-              v1 = gsl_matrix_row(A, j);
-              v2 = gsl_matrix_row(A, j_pivot);
-              gsl_blas_dswap(&v1.vector, &v2.vector);
-            }
-
-          if (j < M - 1)
-            {
-              double Ajj = gsl_matrix_get(A, j, j);
-
-              if (fabs(Ajj) >= GSL_DBL_MIN)
-                {
-                  v1 = gsl_matrix_subcolumn(A, j, j + 1, M - j - 1);
-                  gsl_blas_dscal(1.0 / Ajj, &v1.vector);
-                }
-              else
-                {
-                  for (i = 1; i < M - j; ++i)
-                    {
-                      double * ptr = gsl_matrix_ptr(A, j + i, j);
-                      *ptr /= Ajj;
-                    }
-                }
-            }
+Inputs: A        - on input, matrix to be factored; on output, L and U factors
+        p        - (output) permutation
+        signum   - (output) sign of the permutation
+        nthreads - number of threads
 
-          if (j < minMN - 1)
-            {
-              gsl_matrix_view A22 = gsl_matrix_submatrix(A, j + 1, j + 1, M - j - 1, N - j - 1);
-              v1 = gsl_matrix_subcolumn(A, j, j + 1, M - j - 1);
-              v2 = gsl_matrix_subrow(A, j, j + 1, N - j - 1);
+Return: success/error
 
-              gsl_blas_dger(-1.0, &v1.vector, &v2.vector, &A22.matrix);
-            }
-        }
-
-      return GSL_SUCCESS;
-    }
-}
+Notes:
+1) the output is the same as that of gsl_linalg_LU_decomp, up to
+rounding errors
 
-/*
-LU_decomp_L3
-  LU decomposition with partial pivoting using Level 3 BLAS
+2) the matrix is divided into TILE_SIZE-by-TILE_SIZE tiles. Step k of
+the factorization consists of the tasks
 
-Inputs: A    - on input, matrix to be factored; on output, L and U factors
-        ipiv - (output) array containing row swaps
+  PANEL(k):     factor tile column k below the diagonal, with partial
+                pivoting over all of its rows
+  SWAP(k,j):    apply the row interchanges of PANEL(k) to tile column
+                j > k, and compute U(k,j) = L(k,k)^{-1} A(k,j)
+  GEMM(i,j,k):  A(i,j) -= L(i,k) U(k,j),   i, j > k
 
-Notes:
-1) Based on ReLAPACK DGETRF
+The interchanges of PANEL(k) are applied to the tile columns to the
+left of k once all tasks have completed.
 */
 
-static int
-LU_decomp_L3 (gsl_matrix * A, gsl_vector_uint * ipiv)
+int
+gsl_linalg_LU_decomp_tiled (gsl_matrix * A, gsl_permutation * p, int *signum,
+                            const size_t nthreads)
 {
-  const size_t M = A->size1;
-  const size_t N = A->size2;
+  const size_t N = A->size1;
 
-  if (M < N)
+  if (N != A->size2)
     {
-      GSL_ERROR ("matrix must have M >= N", GSL_EBADLEN);
+      GSL_ERROR ("LU matrix must be square", GSL_ENOTSQR);
     }
-  else if (ipiv->size != GSL_MIN(M, N))
+  else if (p->size != N)
     {
-      GSL_ERROR ("ipiv length must equal MIN(M,N)", GSL_EBADLEN);
+      GSL_ERROR ("permutation length must match matrix size", GSL_EBADLEN);
     }
-  else if (N <= CROSSOVER_LU)
+  else if (nthreads < 2 || N <= 2 * TILE_SIZE)
     {
-      /* use Level 2 algorithm */
-      return LU_decomp_L2(A, ipiv);
+      return gsl_linalg_LU_decomp (A, p, signum);
     }
   else
     {
-      /*
-       * partition matrix:
-       *
-       *       N1  N2
-       * N1  [ A11 A12 ]
-       * M2  [ A21 A22 ]
-       *
-       * and
-       *      N1  N2
-       * M  [ AL  AR  ]
-       */
+      const size_t nt = (N + TILE_SIZE - 1) / TILE_SIZE;
+      const size_t ntasks = nt + nt * (nt - 1) / 2 + (nt - 1) * nt * (2 * nt - 1) / 6;
+      LU_tiled_params params;
+      linalg_tiled_task task0;
+      size_t i, k;
       int status;
-      const size_t N1 = GSL_LINALG_SPLIT(N);
-      const size_t N2 = N - N1;
-      const size_t M2 = M - N1;
-      gsl_matrix_view A11 = gsl_matrix_submatrix(A, 0, 0, N1, N1);
-      gsl_matrix_view A12 = gsl_matrix_submatrix(A, 0, N1, N1, N2);
-      gsl_matrix_view A21 = gsl_matrix_submatrix(A, N1, 0, M2, N1);
-      gsl_matrix_view A22 = gsl_matrix_submatrix(A, N1, N1, M2, N2);
-
-      gsl_matrix_view AL = gsl_matrix_submatrix(A, 0, 0, M, N1);
-      gsl_matrix_view AR = gsl_matrix_submatrix(A, 0, N1, M, N2);
-
-      /*
-       * partition ipiv = [ ipiv1 ] N1
-       *                  [ ipiv2 ] N2
-       */
-      gsl_vector_uint_view ipiv1 = gsl_vector_uint_subvector(ipiv, 0, N1);
-      gsl_vector_uint_view ipiv2 = gsl_vector_uint_subvector(ipiv, N1, N2);
 
-      size_t i;
+      params.A = A;
+      params.nt = nt;
+      params.ipiv = gsl_vector_uint_alloc (N);
+      params.step = calloc (nt, sizeof (size_t));
+      params.nupdate = calloc (nt, sizeof (size_t));
+      params.panel = calloc (nt, sizeof (char));
 
-      /* recursion on (AL, ipiv1) */
-      status = LU_decomp_L3(&AL.matrix, &ipiv1.vector);
-      if (status)
-        return status;
+      if (params.ipiv == NULL || params.step == NULL ||
+          params.nupdate == NULL || params.panel == NULL)
+        {
+          if (params.ipiv)
+            gsl_vector_uint_free (params.ipiv);
+          free (params.step);
+          free (params.nupdate);
+          free (params.panel);
+          GSL_ERROR ("failed to allocate space for tile states", GSL_ENOMEM);
+        }
 
-      /* apply ipiv1 to AR */
-      apply_pivots(&AR.matrix, &ipiv1.vector);
+      task0.type = LU_PANEL;
+      task0.i = task0.j = task0.k = 0;
 
-      /* A12 = A11^{-1} A12 */
-      gsl_blas_dtrsm(CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0, &A11.matrix, &A12.matrix);
+      status = linalg_tiled_execute (nthreads, ntasks, &task0, LU_tiled_run,
+                                     LU_tiled_done, &params);
 
-      /* A22 = A22 - A21 * A12 */
-      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, -1.0, &A21.matrix, &A12.matrix, 1.0, &A22.matrix);
+      if (status == GSL_SUCCESS)
+        {
+          /* apply the interchanges of each panel to the columns on its
+           * left, and make the pivots relative to the whole matrix */
+          for (k = 1; k < nt; ++k)
+            {
+              const size_t k0 = k * TILE_SIZE;
+              const size_t nk = GSL_MIN (TILE_SIZE, N - k0);
+              gsl_vector_uint_view ipivk = gsl_vector_uint_subvector (params.ipiv, k0, nk);
+              gsl_matrix_view AL = gsl_matrix_submatrix (A, k0, 0, N - k0, k0);
 
-      /* recursion on (A22, ipiv2) */
-      status = LU_decomp_L3(&A22.matrix, &ipiv2.vector);
-      if (status)
-        return status;
+              apply_pivots (&AL.matrix, &ipivk.vector);
+
+              for (i = 0; i < nk; ++i)
+                {
+                  unsigned int * ptr = gsl_vector_uint_ptr (&ipivk.vector, i);
+                  *ptr += k0;
+                }
+            }
 
-      /* apply pivots to A21 */
-      apply_pivots(&A21.matrix, &ipiv2.vector);
+          /* convert ipiv array to permutation */
 
-      /* shift pivots */
-      for (i = 0; i < N2; ++i)
-        {
-          unsigned int * ptr = gsl_vector_uint_ptr(&ipiv2.vector, i);
-          *ptr += N1;
+          gsl_permutation_init (p);
+          *signum = 1;
+
+          for (i = 0; i < N; ++i)
+            {
+              unsigned int pivi = gsl_vector_uint_get (params.ipiv, i);
+
+              if (p->data[pivi] != p->data[i])
+                {
+                  size_t tmp = p->data[pivi];
+                  p->data[pivi] = p->data[i];
+                  p->data[i] = tmp;
+                  *signum = -(*signum);
+                }
+            }
         }
 
-      return GSL_SUCCESS;
+      gsl_vector_uint_free (params.ipiv);
+      free (params.step);
+      free (params.nupdate);
+      free (params.panel);
+
+      return status;
     }
 }
 
+#define BASE_DOUBLE
+#include "templates_on.h"
+#include "source_lu.h"
+#include "templates_off.h"
+#undef BASE_DOUBLE
+
 int
 gsl_linalg_LU_solve (const gsl_matrix * LU, const gsl_permutation * p, const gsl_vector * b, gsl_vector * x)
 {
@@ -551,28 +533,86 @@ singular (const gsl_matrix * LU)
 }
 
 static int
-apply_pivots(gsl_matrix * A, const gsl_vector_uint * ipiv)
+LU_tiled_run (const linalg_tiled_task * task, void * params)
 {
-  if (0)
+  LU_tiled_params * p = (LU_tiled_params *) params;
+  gsl_matrix * A = p->A;
+  const size_t N = A->size1;
+  const size_t k0 = task->k * TILE_SIZE;
+  const size_t nk = GSL_MIN (TILE_SIZE, N - k0);
+  gsl_vector_uint_view ipivk = gsl_vector_uint_subvector (p->ipiv, k0, nk);
+
+  if (task->type == LU_PANEL)
     {
+      gsl_matrix_view Ak = gsl_matrix_submatrix (A, k0, k0, N - k0, nk);
+      return LU_decomp_L3 (&Ak.matrix, &ipivk.vector);
     }
   else
     {
-      size_t i;
+      const size_t j0 = task->j * TILE_SIZE;
+      const size_t nj = GSL_MIN (TILE_SIZE, N - j0);
 
-      for (i = 0; i < ipiv->size; ++i)
+      if (task->type == LU_SWAP)
         {
-          size_t pi = gsl_vector_uint_get(ipiv, i);
+          gsl_matrix_view Aj = gsl_matrix_submatrix (A, k0, j0, N - k0, nj);
+          gsl_matrix_view Lkk = gsl_matrix_submatrix (A, k0, k0, nk, nk);
+          gsl_matrix_view Ukj = gsl_matrix_submatrix (A, k0, j0, nk, nj);
 
-          if (i != pi)
-            {
-              /* swap rows i and pi */
-              gsl_vector_view v1 = gsl_matrix_row(A, i);
-              gsl_vector_view v2 = gsl_matrix_row(A, pi);
-              gsl_blas_dswap(&v1.vector, &v2.vector);
-            }
+          apply_pivots (&Aj.matrix, &ipivk.vector);
+          return gsl_blas_dtrsm (CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0,
+                                 &Lkk.matrix, &Ukj.matrix);
+        }
+      else
+        {
+          const size_t i0 = task->i * TILE_SIZE;
+          const size_t ni = GSL_MIN (TILE_SIZE, N - i0);
+          gsl_matrix_view Lik = gsl_matrix_submatrix (A, i0, k0, ni, nk);
+          gsl_matrix_view Ukj = gsl_matrix_submatrix (A, k0, j0, nk, nj);
+          gsl_matrix_view Aij = gsl_matrix_submatrix (A, i0, j0, ni, nj);
+
+          return gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, -1.0, &Lik.matrix,
+                                 &Ukj.matrix, 1.0, &Aij.matrix);
         }
+    }
+}
 
-      return GSL_SUCCESS;
+static void
+LU_tiled_done (const linalg_tiled_task * task, void * params, linalg_tiled_sched * sched)
+{
+  LU_tiled_params * p = (LU_tiled_params *) params;
+  const size_t nt = p->nt;
+  const size_t j = task->j;
+  const size_t k = task->k;
+  size_t m;
+
+  switch (task->type)
+    {
+      case LU_PANEL:
+        p->panel[k] = 1;
+        for (m = k + 1; m < nt; ++m)
+          {
+            /* column m has received the updates of step k - 1 */
+            if (k == 0 || (p->step[m] == k - 1 && p->nupdate[m] == nt - k))
+              linalg_tiled_push (sched, LU_SWAP, k, m, k);
+          }
+        break;
+
+      case LU_SWAP:
+        p->step[j] = k;
+        p->nupdate[j] = 0;
+        for (m = k + 1; m < nt; ++m)
+          linalg_tiled_push (sched, LU_GEMM, m, j, k);
+        break;
+
+      default:
+        /* column j is ready for step k + 1 after all its updates */
+        if (++(p->nupdate[j]) == nt - k - 1)
+          {
+            if (j == k + 1)
+              linalg_tiled_push (sched, LU_PANEL, j, j, j);
+            else if (p->panel[k + 1])
+              linalg_tiled_push (sched, LU_SWAP, k + 1, j, k + 1);
+          }
+        break;
     }
 }
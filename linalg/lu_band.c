@@ -0,0 +1,354 @@
+/* linalg/lu_band.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_cblas.h>
+
+/*
+ * The M-by-N banded matrix A, with lower bandwidth p and upper bandwidth
+ * q, is stored in an N-by-(2p+q+1) matrix AB, with column j of A in row
+ * j of AB:
+ *
+ *   AB(j, p + q + i - j) = A(i,j),  max(0, j - q) <= i <= min(M - 1, j + p)
+ *
+ * so that the main diagonal is in column p + q of AB. This is the
+ * transpose of the LAPACK format used by DGBTRF. The first p columns of
+ * AB need not be set on input; they receive the fill-in of U, which
+ * has upper bandwidth p + q because of the row interchanges.
+ *
+ * Moving along a row of A corresponds to a stride of tda - 1 in AB, so
+ * that the LAPACK algorithms can be applied with BLAS on views.
+ */
+
+/*
+gsl_linalg_LU_band_decomp()
+  LU decomposition with partial pivoting of a general banded matrix
+
+Inputs: M   - number of rows of A
+        lb  - lower bandwidth p
+        ub  - upper bandwidth q
+        AB  - on input, matrix A in banded format, N-by-(2p+q+1);
+              on output, L and U factors
+        piv - (output) row interchanges, length MIN(M,N); at step j,
+              row j was interchanged with row piv[j]
+
+Return: success/error
+
+Notes:
+1) Based on LAPACK DGBTF2
+
+2) U is stored in columns 0 to p+q of AB, with its diagonal in column
+p+q. The multipliers of step j are stored in AB(j, p+q+1:2p+q); the
+row interchanges of later steps are not applied to them, as in LAPACK.
+
+3) Singular matrices are not detected here, as in gsl_linalg_LU_decomp
+*/
+
+int
+gsl_linalg_LU_band_decomp (const size_t M, const size_t lb, const size_t ub,
+                           gsl_matrix * AB, gsl_vector_uint * piv)
+{
+  const size_t N = AB->size1;
+  const size_t minMN = GSL_MIN(M, N);
+
+  if (lb >= M)
+    {
+      GSL_ERROR ("lower bandwidth must be less than M", GSL_EDOM);
+    }
+  else if (ub >= N)
+    {
+      GSL_ERROR ("upper bandwidth must be less than N", GSL_EDOM);
+    }
+  else if (AB->size2 != 2 * lb + ub + 1)
+    {
+      GSL_ERROR ("matrix size inconsistent with bandwidths", GSL_EBADLEN);
+    }
+  else if (piv->size != minMN)
+    {
+      GSL_ERROR ("pivot vector must have length MIN(M,N)", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t kv = ub + lb;      /* column of the main diagonal */
+      const size_t ldr = AB->tda - 1; /* stride along a row of A */
+      size_t ju = 0;                  /* last column touched by the interchanges */
+      size_t i, j;
+
+      /* zero the fill-in elements of the columns which are not cleared
+       * in the main loop */
+      for (j = ub + 1; j < GSL_MIN(kv, N); ++j)
+        {
+          for (i = kv - j; i < lb; ++i)
+            gsl_matrix_set(AB, j, i, 0.0);
+        }
+
+      for (j = 0; j < minMN; ++j)
+        {
+          /* number of subdiagonal elements in column j */
+          const size_t km = GSL_MIN(lb, M - j - 1);
+          gsl_vector_view c = gsl_matrix_subrow(AB, j, kv, km + 1);
+          size_t jp;
+
+          /* zero the fill-in elements of column j + kv */
+          if (j + kv < N)
+            {
+              for (i = 0; i < lb; ++i)
+                gsl_matrix_set(AB, j + kv, i, 0.0);
+            }
+
+          /* find pivot in A(j:j+km,j) */
+          jp = gsl_blas_idamax(&c.vector);
+          gsl_vector_uint_set(piv, j, j + jp);
+
+          if (gsl_matrix_get(AB, j, kv + jp) != 0.0)
+            {
+              ju = GSL_MAX(ju, GSL_MIN(j + ub + jp, N - 1));
+
+              if (jp != 0)
+                {
+                  /* swap rows j and j+jp of A in columns j:ju */
+                  gsl_vector_view r1 = gsl_vector_view_array_with_stride(gsl_matrix_ptr(AB, j, kv), ldr, ju - j + 1);
+                  gsl_vector_view r2 = gsl_vector_view_array_with_stride(gsl_matrix_ptr(AB, j, kv + jp), ldr, ju - j + 1);
+
+                  gsl_blas_dswap(&r1.vector, &r2.vector);
+                }
+
+              if (km > 0)
+                {
+                  gsl_vector_view v = gsl_matrix_subrow(AB, j, kv + 1, km);
+
+                  /* compute multipliers */
+                  gsl_blas_dscal(1.0 / gsl_matrix_get(AB, j, kv), &v.vector);
+
+                  /* update A(j+1:j+km,j+1:ju); the view holds its transpose */
+                  if (ju > j)
+                    {
+                      gsl_vector_view w = gsl_vector_view_array_with_stride(gsl_matrix_ptr(AB, j + 1, kv - 1), ldr, ju - j);
+                      gsl_matrix_view m = gsl_matrix_view_array_with_tda(gsl_matrix_ptr(AB, j + 1, kv), ju - j, km, ldr);
+
+                      gsl_blas_dger(-1.0, &w.vector, &v.vector, &m.matrix);
+                    }
+                }
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+int
+gsl_linalg_LU_band_solve (const size_t lb, const size_t ub, const gsl_matrix * LUB,
+                          const gsl_vector_uint * piv, const gsl_vector * b, gsl_vector * x)
+{
+  if (LUB->size1 != b->size)
+    {
+      GSL_ERROR ("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (LUB->size1 != x->size)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+
+      /* copy x <- b */
+      gsl_vector_memcpy (x, b);
+
+      status = gsl_linalg_LU_band_svx(lb, ub, LUB, piv, x);
+
+      return status;
+    }
+}
+
+/*
+gsl_linalg_LU_band_svx()
+  Solve A x = b in place for a square banded matrix
+
+Inputs: lb  - lower bandwidth p
+        ub  - upper bandwidth q
+        LUB - LU factors from gsl_linalg_LU_band_decomp, N-by-(2p+q+1)
+        piv - row interchanges from gsl_linalg_LU_band_decomp
+        x   - on input, right hand side; on output, solution
+
+Notes:
+1) Based on LAPACK DGBTRS
+*/
+
+int
+gsl_linalg_LU_band_svx (const size_t lb, const size_t ub, const gsl_matrix * LUB,
+                        const gsl_vector_uint * piv, gsl_vector * x)
+{
+  const size_t N = LUB->size1;
+
+  if (LUB->size2 != 2 * lb + ub + 1)
+    {
+      GSL_ERROR ("matrix size inconsistent with bandwidths", GSL_EBADLEN);
+    }
+  else if (piv->size != N)
+    {
+      GSL_ERROR ("pivot vector must have length N", GSL_EBADLEN);
+    }
+  else if (x->size != N)
+    {
+      GSL_ERROR ("matrix size must match solution/rhs size", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t kv = ub + lb;
+      size_t j;
+
+      for (j = 0; j < N; ++j)
+        {
+          if (gsl_matrix_get(LUB, j, kv) == 0.0)
+            {
+              GSL_ERROR ("matrix is singular", GSL_EDOM);
+            }
+        }
+
+      /* solve L y = P b, applying the interchanges as they occur */
+      if (lb > 0)
+        {
+          for (j = 0; j + 1 < N; ++j)
+            {
+              const size_t lm = GSL_MIN(lb, N - j - 1);
+              const size_t l = gsl_vector_uint_get(piv, j);
+              gsl_vector_const_view v = gsl_matrix_const_subrow(LUB, j, kv + 1, lm);
+              gsl_vector_view y = gsl_vector_subvector(x, j + 1, lm);
+              double * xj = x->data + j * x->stride;
+
+              if (l != j)
+                {
+                  double * xl = x->data + l * x->stride;
+                  double tmp = *xl;
+
+                  *xl = *xj;
+                  *xj = tmp;
+                }
+
+              gsl_blas_daxpy(-(*xj), &v.vector, &y.vector);
+            }
+        }
+
+      /* solve U x = y; U is upper triangular with p+q superdiagonals,
+       * stored in LAPACK band format with leading dimension tda */
+      cblas_dtbsv(CblasColMajor, CblasUpper, CblasNoTrans, CblasNonUnit,
+                  (int) N, (int) kv, LUB->data, (int) LUB->tda,
+                  x->data, (int) x->stride);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_LU_band_unpack()
+  Unpack the factors of a banded LU decomposition into dense matrices
+
+Inputs: M   - number of rows of A
+        lb  - lower bandwidth p
+        ub  - upper bandwidth q
+        LUB - LU factors from gsl_linalg_LU_band_decomp, N-by-(2p+q+1)
+        piv - row interchanges from gsl_linalg_LU_band_decomp
+        L   - (output) M-by-MIN(M,N) unit lower triangular matrix
+        U   - (output) MIN(M,N)-by-N upper triangular matrix
+
+Notes:
+1) On output P A = L U, where P applies the interchanges in piv in
+order; the multipliers in LUB are permuted by the interchanges of the
+later steps to form L
+*/
+
+int
+gsl_linalg_LU_band_unpack (const size_t M, const size_t lb, const size_t ub,
+                           const gsl_matrix * LUB, const gsl_vector_uint * piv,
+                           gsl_matrix * L, gsl_matrix * U)
+{
+  const size_t N = LUB->size1;
+  const size_t minMN = GSL_MIN(M, N);
+
+  if (ub >= N)
+    {
+      GSL_ERROR ("upper bandwidth must be less than N", GSL_EDOM);
+    }
+  else if (lb >= M)
+    {
+      GSL_ERROR ("lower bandwidth must be less than M", GSL_EDOM);
+    }
+  else if (LUB->size2 != 2 * lb + ub + 1)
+    {
+      GSL_ERROR ("matrix size inconsistent with bandwidths", GSL_EBADLEN);
+    }
+  else if (piv->size != minMN)
+    {
+      GSL_ERROR ("pivot vector must have length MIN(M,N)", GSL_EBADLEN);
+    }
+  else if (L->size1 != M || L->size2 != minMN)
+    {
+      GSL_ERROR ("L matrix must be M x MIN(M,N)", GSL_EBADLEN);
+    }
+  else if (U->size1 != minMN || U->size2 != N)
+    {
+      GSL_ERROR ("U matrix must be MIN(M,N) x N", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t kv = ub + lb;
+      size_t i, j;
+
+      gsl_matrix_set_zero(L);
+      gsl_matrix_set_zero(U);
+
+      for (j = 0; j < minMN; ++j)
+        {
+          const size_t l = gsl_vector_uint_get(piv, j);
+          const size_t km = GSL_MIN(lb, M - j - 1);
+
+          /* apply interchange of step j to the previous columns of L */
+          if (l != j && j > 0)
+            {
+              gsl_vector_view r1 = gsl_matrix_subrow(L, j, 0, j);
+              gsl_vector_view r2 = gsl_matrix_subrow(L, l, 0, j);
+
+              gsl_blas_dswap(&r1.vector, &r2.vector);
+            }
+
+          gsl_matrix_set(L, j, j, 1.0);
+
+          for (i = 1; i <= km; ++i)
+            gsl_matrix_set(L, j + i, j, gsl_matrix_get(LUB, j, kv + i));
+        }
+
+      for (i = 0; i < minMN; ++i)
+        {
+          const size_t jmax = GSL_MIN(i + kv, N - 1);
+
+          for (j = i; j <= jmax; ++j)
+            gsl_matrix_set(U, i, j, gsl_matrix_get(LUB, j, kv + i - j));
+        }
+
+      return GSL_SUCCESS;
+    }
+}
@@ -0,0 +1,319 @@
+/* linalg/lu_mixed.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <float.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include "recurse.h"
+
+/* Mixed precision solution of A x = b.
+
+   The LU factorization, which costs O(N^3), is computed in single
+   precision, where the Level 3 BLAS run on twice as many elements per
+   vector register and move half as much memory. The solution is then
+   improved by iterative refinement, with the residuals r = b - A x
+   computed in double precision and the corrections A d = r solved with
+   the single precision factors, each step costing O(N^2). For matrices
+   which are not too ill-conditioned (cond(A) well below 1/FLT_EPSILON)
+   the iteration converges to double precision accuracy in a few steps.
+   Otherwise, the matrix is factored again in double precision.
+
+   See Buttari et al, "Mixed precision iterative refinement techniques
+   for the solution of dense linear systems", Int. J. High Perf.
+   Comput. Appl. 21 (2007) 457-466, and LAPACK DSGESV. */
+
+/* maximum number of refinement steps */
+#define LU_MIXED_ITERMAX 30
+
+static int LU_decomp_L2 (gsl_matrix_float * A, gsl_vector_uint * ipiv);
+static int LU_decomp_L3 (gsl_matrix_float * A, gsl_vector_uint * ipiv);
+static int apply_pivots (gsl_matrix_float * A, const gsl_vector_uint * ipiv);
+static int LU_mixed_svx (const gsl_matrix_float * LU, const gsl_vector_uint * ipiv, gsl_vector_float * x);
+static int vector_to_float (const gsl_vector * x, gsl_vector_float * xf);
+static double norminf (const gsl_vector * x);
+
+/*
+gsl_linalg_LU_solve_mixed()
+  Solve the square system A x = b using a single precision LU
+factorization and double precision iterative refinement
+
+Inputs: A    - N-by-N matrix, not modified
+        b    - right hand side vector, length N
+        x    - (output) solution vector, length N
+        iter - (output) number of refinement steps on success;
+               a negative value if the system was solved with a
+               double precision factorization instead:
+                 -1: ||A||_inf, or an element of b or of a
+                     residual, overflows in single precision
+                 -2: the single precision factor U is singular
+                 -3: refinement did not converge in 30 steps
+
+Return: success/error
+
+Notes:
+1) The refinement stops when
+
+  ||b - A x||_inf <= ||x||_inf ||A||_inf eps sqrt(N)
+
+with eps the unit roundoff of double precision, as in LAPACK DSGESV;
+the non-strict inequality also accepts the solution x = 0 of b = 0
+
+2) The workspace of size O(N^2) is allocated internally; the float
+factors take half the memory of a double precision copy of A, which is
+only allocated when falling back
+*/
+
+int
+gsl_linalg_LU_solve_mixed (const gsl_matrix * A, const gsl_vector * b,
+                           gsl_vector * x, int * iter)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR ("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (b->size != N)
+    {
+      GSL_ERROR ("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (x->size != N)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_matrix_float *LU = gsl_matrix_float_alloc (N, N);
+      gsl_vector_float *xf = gsl_vector_float_alloc (N);
+      gsl_vector *r = gsl_vector_alloc (N);
+      gsl_vector_uint *ipiv = gsl_vector_uint_alloc (N);
+      int status = GSL_ENOMEM;
+      int fallback = 0;
+      double anrm = 0.0;
+      size_t i, j;
+
+      if (LU != NULL && xf != NULL && r != NULL && ipiv != NULL)
+        {
+          status = GSL_SUCCESS;
+
+          /* compute ||A||_inf in double precision; if it does not fit in
+           * single precision, some element of A may not either, and the
+           * conversion below would be undefined */
+          for (i = 0; i < N; ++i)
+            {
+              const double *Ai = A->data + i * A->tda;
+              double sum = 0.0;
+
+              for (j = 0; j < N; ++j)
+                sum += fabs (Ai[j]);
+
+              anrm = GSL_MAX (anrm, sum);
+            }
+
+          if (!(anrm <= FLT_MAX))
+            fallback = -1;
+
+          if (!fallback)
+            {
+              /* convert A to single precision and factor it */
+              for (i = 0; i < N; ++i)
+                {
+                  const double *Ai = A->data + i * A->tda;
+                  float *LUi = LU->data + i * LU->tda;
+
+                  for (j = 0; j < N; ++j)
+                    LUi[j] = (float) Ai[j];
+                }
+
+              LU_decomp_L3 (LU, ipiv);
+
+              for (i = 0; i < N; ++i)
+                {
+                  if (LU->data[i * LU->tda + i] == 0.0f)
+                    fallback = -2;
+                }
+            }
+
+          if (!fallback && vector_to_float (b, xf))
+            fallback = -1;
+
+          if (!fallback)
+            {
+              const double cte = anrm * 0.5 * GSL_DBL_EPSILON * sqrt ((double) N);
+              int k = 0;
+
+              LU_mixed_svx (LU, ipiv, xf);
+
+              for (i = 0; i < N; ++i)
+                x->data[i * x->stride] = (double) xf->data[i];
+
+              fallback = -3;
+
+              for (k = 0; k <= LU_MIXED_ITERMAX; ++k)
+                {
+                  double rnrm, xnrm;
+
+                  /* r = b - A x */
+                  gsl_vector_memcpy (r, b);
+                  gsl_blas_dgemv (CblasNoTrans, -1.0, A, x, 1.0, r);
+
+                  rnrm = norminf (r);
+                  xnrm = norminf (x);
+
+                  if (rnrm <= xnrm * cte)
+                    {
+                      *iter = k;
+                      fallback = 0;
+                      break;
+                    }
+                  else if (!gsl_finite (rnrm) || k == LU_MIXED_ITERMAX)
+                    {
+                      break;
+                    }
+
+                  /* solve A d = r in single precision and update x = x + d */
+                  if (vector_to_float (r, xf))
+                    {
+                      fallback = -1;
+                      break;
+                    }
+
+                  LU_mixed_svx (LU, ipiv, xf);
+
+                  for (i = 0; i < N; ++i)
+                    x->data[i * x->stride] += (double) xf->data[i];
+                }
+            }
+
+          if (fallback)
+            {
+              /* refinement failed: solve in double precision */
+              gsl_matrix *LUd = gsl_matrix_alloc (N, N);
+              gsl_permutation *p = gsl_permutation_alloc (N);
+
+              *iter = fallback;
+
+              if (LUd != NULL && p != NULL)
+                {
+                  int signum;
+
+                  gsl_matrix_memcpy (LUd, A);
+                  status = gsl_linalg_LU_decomp (LUd, p, &signum);
+                  if (!status)
+                    status = gsl_linalg_LU_solve (LUd, p, b, x);
+                }
+              else
+                {
+                  status = GSL_ENOMEM;
+                }
+
+              if (LUd)
+                gsl_matrix_free (LUd);
+              if (p)
+                gsl_permutation_free (p);
+            }
+        }
+
+      if (LU)
+        gsl_matrix_float_free (LU);
+      if (xf)
+        gsl_vector_float_free (xf);
+      if (r)
+        gsl_vector_free (r);
+      if (ipiv)
+        gsl_vector_uint_free (ipiv);
+
+      if (status == GSL_ENOMEM)
+        {
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      return status;
+    }
+}
+
+#define BASE_FLOAT
+#include "templates_on.h"
+#include "source_lu.h"
+#include "templates_off.h"
+#undef BASE_FLOAT
+
+/* solve LU x = P b in single precision, with x = b on input */
+static int
+LU_mixed_svx (const gsl_matrix_float * LU, const gsl_vector_uint * ipiv, gsl_vector_float * x)
+{
+  size_t i;
+
+  for (i = 0; i < ipiv->size; ++i)
+    {
+      size_t pi = gsl_vector_uint_get(ipiv, i);
+
+      if (i != pi)
+        {
+          float tmp = x->data[i];
+          x->data[i] = x->data[pi];
+          x->data[pi] = tmp;
+        }
+    }
+
+  gsl_blas_strsv (CblasLower, CblasNoTrans, CblasUnit, LU, x);
+  gsl_blas_strsv (CblasUpper, CblasNoTrans, CblasNonUnit, LU, x);
+
+  return GSL_SUCCESS;
+}
+
+/* convert x to single precision; returns 1, leaving xf partly
+   converted, if an element does not fit */
+static int
+vector_to_float (const gsl_vector * x, gsl_vector_float * xf)
+{
+  const size_t n = x->size;
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    {
+      const double xi = x->data[i * x->stride];
+
+      if (!(fabs (xi) <= FLT_MAX))
+        return 1;
+
+      xf->data[i] = (float) xi;
+    }
+
+  return 0;
+}
+
+static double
+norminf (const gsl_vector * x)
+{
+  const size_t n = x->size;
+  double max = 0.0;
+  size_t i;
+
+  for (i = 0; i < n; ++i)
+    max = GSL_MAX (max, fabs (x->data[i * x->stride]));
+
+  return max;
+}
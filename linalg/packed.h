@@ -0,0 +1,73 @@
+/* linalg/packed.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GSL_LINALG_PACKED_H__
+#define __GSL_LINALG_PACKED_H__
+
+/*
+ * Packed storage of an N-by-N triangular or symmetric matrix keeps
+ * only one triangle, row by row, in a vector of length N(N+1)/2:
+ *
+ * lower: A(i,j) = AP[i(i+1)/2 + j],          0 <= j <= i
+ * upper: A(i,j) = AP[i(2N-i+1)/2 + j - i],   i <= j < N
+ *
+ * This is the CblasRowMajor packed format of the CBLAS routines
+ * cblas_dtpsv, cblas_dtpmv and cblas_dspr.
+ */
+
+/* index of the diagonal element A(i,i) in lower packed storage */
+#define PACKED_LOWER_DIAG(i)      ((i) * ((i) + 3) / 2)
+
+/*
+packed_order()
+  Determine the order N of the triangular matrix stored in the
+packed vector AP
+
+Return: GSL_SUCCESS, or GSL_EBADLEN if the length of AP is not a
+triangular number N(N+1)/2, or GSL_EINVAL if AP does not have unit
+stride
+*/
+
+static inline int
+packed_order (const gsl_vector * AP, size_t * N)
+{
+  const size_t len = AP->size;
+  size_t n = (size_t) ((sqrt (8.0 * (double) len + 1.0) - 1.0) / 2.0);
+
+  /* correct for rounding in the square root */
+  while (n * (n + 1) / 2 > len)
+    --n;
+  while ((n + 1) * (n + 2) / 2 <= len)
+    ++n;
+
+  if (AP->stride != 1)
+    {
+      GSL_ERROR ("packed matrix must have unit stride", GSL_EINVAL);
+    }
+  else if (n * (n + 1) / 2 != len)
+    {
+      GSL_ERROR ("packed matrix length must be N(N+1)/2", GSL_EBADLEN);
+    }
+
+  *N = n;
+
+  return GSL_SUCCESS;
+}
+
+#endif /* __GSL_LINALG_PACKED_H__ */
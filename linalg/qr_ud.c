@@ -0,0 +1,205 @@
+/* linalg/qr_ud.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+
+/*
+ * This module updates the triangular factor R of a QR decomposition
+ * A = Q R when a row is appended to or deleted from A, without
+ * requiring Q. Both operations cost O(N^2) for an N-by-N factor R.
+ *
+ * Since A^T A = R^T R, appending a row x^T to A gives the new factor
+ * of [ R ; x^T ], which is computed with N Givens rotations. Deleting
+ * the row x^T requires R' with R'^T R' = R^T R - x x^T; this is done
+ * with the orthogonal downdating method of LINPACK DCHDD (Saunders),
+ * which is more stable than hyperbolic rotations.
+ *
+ * For a sliding window least squares problem min || b - A c ||,
+ * maintain the factor of the augmented matrix [ A b ], of order
+ * N + 1, and append or delete the rows [ x^T beta ]. The solution c
+ * is then obtained from the leading N-by-N block of R and the first N
+ * elements of its last column with gsl_linalg_R_solve(), and the
+ * absolute value of the last diagonal element of R is the residual
+ * norm || b - A c ||.
+ */
+
+/*
+gsl_linalg_R_append_row()
+  Update the triangular factor R of A when the row x^T is
+appended to A
+
+Inputs: R - on input, N-by-N upper triangular factor of A;
+            on output, upper triangular factor of [ A ; x^T ]
+        x - on input, row to append, length N;
+            on output, destroyed
+
+Return: success/error
+
+Notes: the elements of R below the diagonal are not referenced
+*/
+
+int
+gsl_linalg_R_append_row (gsl_matrix * R, gsl_vector * x)
+{
+  const size_t N = R->size1;
+
+  if (N != R->size2)
+    {
+      GSL_ERROR ("R matrix must be square", GSL_ENOTSQR);
+    }
+  else if (x->size != N)
+    {
+      GSL_ERROR ("x vector must have length N", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t stride = x->stride;
+      double *xd = x->data;
+      size_t i, j;
+
+      /* rotate x into each row of R in turn, zeroing x(i) against R(i,i) */
+      for (i = 0; i < N; ++i)
+        {
+          double c, s;
+
+          gsl_linalg_givens (gsl_matrix_get (R, i, i), xd[i * stride], &c, &s);
+
+          for (j = i; j < N; ++j)
+            {
+              double rij = gsl_matrix_get (R, i, j);
+              double xj = xd[j * stride];
+
+              gsl_matrix_set (R, i, j, c * rij - s * xj);
+              xd[j * stride] = s * rij + c * xj;
+            }
+
+          xd[i * stride] = 0.0; /* exact zero of G^T */
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_R_delete_row()
+  Update the triangular factor R of A when the row x^T is
+deleted from A, so that on output
+
+R'^T R' = R^T R - x x^T
+
+Inputs: R    - on input, N-by-N upper triangular factor of A;
+               on output, upper triangular factor of A with the row x^T
+               removed
+        x    - on input, row to delete, length N;
+               on output, destroyed
+        work - workspace, length N
+
+Return: success/error. GSL_EDOM is returned, and R is left unchanged,
+if R is singular or if R^T R - x x^T is not positive definite, which
+happens when x is not a row of A or when the remaining rows do not
+have full column rank.
+
+Notes:
+1) Algorithm: first solve R^T a = x and set alpha = sqrt(1 - ||a||^2).
+Givens rotations G_{N-1}, ..., G_0 acting on the pairs (alpha, a(i))
+reduce [ a ; alpha ] to e_{N+1}; applying them to [ R ; 0 ] gives
+[ R' ; x^T ] with R' upper triangular. See LINPACK routine DCHDD and
+Golub & Van Loan, "Matrix Computations" (3rd ed), section 12.5.4.
+
+2) the elements of R below the diagonal are not referenced
+*/
+
+int
+gsl_linalg_R_delete_row (gsl_matrix * R, gsl_vector * x, gsl_vector * work)
+{
+  const size_t N = R->size1;
+
+  if (N != R->size2)
+    {
+      GSL_ERROR ("R matrix must be square", GSL_ENOTSQR);
+    }
+  else if (x->size != N)
+    {
+      GSL_ERROR ("x vector must have length N", GSL_EBADLEN);
+    }
+  else if (work->size != N)
+    {
+      GSL_ERROR ("workspace must have length N", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t xstride = x->stride;
+      const size_t wstride = work->stride;
+      double *a = x->data;
+      double *z = work->data;
+      double anorm, alpha;
+      size_t i, j;
+
+      for (i = 0; i < N; ++i)
+        {
+          if (gsl_matrix_get (R, i, i) == 0.0)
+            {
+              GSL_ERROR ("R matrix is singular", GSL_EDOM);
+            }
+        }
+
+      /* solve R^T a = x, a is stored in x */
+      gsl_blas_dtrsv (CblasUpper, CblasTrans, CblasNonUnit, R, x);
+
+      anorm = gsl_blas_dnrm2 (x);
+      if (anorm >= 1.0)
+        {
+          GSL_ERROR ("downdated matrix is not positive definite", GSL_EDOM);
+        }
+
+      alpha = sqrt ((1.0 - anorm) * (1.0 + anorm));
+
+      for (j = 0; j < N; ++j)
+        z[j * wstride] = 0.0;
+
+      for (i = N; i-- > 0; )
+        {
+          double c, s;
+
+          /* zero a(i) against alpha */
+          gsl_linalg_givens (alpha, a[i * xstride], &c, &s);
+          alpha = c * alpha - s * a[i * xstride];
+
+          /* apply the rotation to the pair (z, row i of R) */
+          for (j = i; j < N; ++j)
+            {
+              double zj = z[j * wstride];
+              double rij = gsl_matrix_get (R, i, j);
+
+              z[j * wstride] = c * zj - s * rij;
+              gsl_matrix_set (R, i, j, s * zj + c * rij);
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
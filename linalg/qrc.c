@@ -0,0 +1,464 @@
+/* linalg/qrc.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_complex_math.h>
+
+/*
+ * this module contains routines for the QR factorization of a complex
+ * matrix using the recursive Level 3 BLAS algorithm of Elmroth and
+ * Gustavson. It is the complex analog of rqr.c, with the transposes
+ * of the real algorithm replaced by conjugate transposes.
+ */
+
+static void conjtrans_memcpy(gsl_matrix_complex * dest, const gsl_matrix_complex * src);
+
+/*
+gsl_linalg_complex_QR_decomp_r()
+  QR decomposition using Level 3 BLAS recursive algorithm of:
+
+Elmroth, E. and Gustavson, F.G., 2000. Applying recursion to serial and parallel
+  QR factorization leads to better performance. IBM Journal of Research and Development,
+  44(4), pp.605-624.
+
+Inputs: A - matrix to be factored, M-by-N with M >= N
+        T - N-by-N upper triangular factor of block reflector
+
+Return: success/error
+
+Notes:
+1) on output, diag(T) contains tau vector
+
+2) on output, upper triangle of A contains R, with a real diagonal;
+elements below the diagonal are columns of V, where the block
+reflector H is:
+
+H = I - V T V^H
+
+and A = H R
+*/
+
+int
+gsl_linalg_complex_QR_decomp_r (gsl_matrix_complex * A, gsl_matrix_complex * T)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+
+  if (M < N)
+    {
+      GSL_ERROR ("M must be >= N", GSL_EBADLEN);
+    }
+  else if (T->size1 != T->size2)
+    {
+      GSL_ERROR ("T matrix must be square", GSL_ENOTSQR);
+    }
+  else if (T->size1 != N)
+    {
+      GSL_ERROR ("T matrix does not match dimensions of A", GSL_EBADLEN);
+    }
+  else
+    {
+      if (N == 1)
+        {
+          /* base case, compute householder transform for single column matrix */
+
+          gsl_vector_complex_view v = gsl_matrix_complex_column(A, 0);
+          gsl_complex tau = gsl_linalg_complex_householder_transform(&v.vector);
+
+          gsl_matrix_complex_set(T, 0, 0, tau);
+        }
+      else
+        {
+          /*
+           * partition matrices:
+           *
+           *       N1  N2              N1  N2
+           * N1 [ A11 A12 ] and  N1 [ T11 T12 ]
+           * M2 [ A21 A22 ]      N2 [  0  T22 ]
+           */
+          int status;
+          const size_t N1 = N / 2;
+          const size_t N2 = N - N1;
+          const size_t M2 = M - N1;
+
+          gsl_matrix_complex_view A11 = gsl_matrix_complex_submatrix(A, 0, 0, N1, N1);
+          gsl_matrix_complex_view A12 = gsl_matrix_complex_submatrix(A, 0, N1, N1, N2);
+          gsl_matrix_complex_view A21 = gsl_matrix_complex_submatrix(A, N1, 0, M2, N1);
+          gsl_matrix_complex_view A22 = gsl_matrix_complex_submatrix(A, N1, N1, M2, N2);
+
+          gsl_matrix_complex_view T11 = gsl_matrix_complex_submatrix(T, 0, 0, N1, N1);
+          gsl_matrix_complex_view T12 = gsl_matrix_complex_submatrix(T, 0, N1, N1, N2);
+          gsl_matrix_complex_view T22 = gsl_matrix_complex_submatrix(T, N1, N1, N2, N2);
+
+          gsl_matrix_complex_view m;
+
+          /* recursion on (A(1:m,1:N1), T11) */
+          m = gsl_matrix_complex_submatrix(A, 0, 0, M, N1);
+          status = gsl_linalg_complex_QR_decomp_r(&m.matrix, &T11.matrix);
+          if (status)
+            return status;
+
+          /* apply H_1^H = I - V1 T11^H V1^H to [A12; A22], using T12 as workspace */
+          gsl_matrix_complex_memcpy(&T12.matrix, &A12.matrix);
+
+          gsl_blas_ztrmm(CblasLeft, CblasLower, CblasConjTrans, CblasUnit, GSL_COMPLEX_ONE, &A11.matrix, &T12.matrix);          /* T12 = lower(A11)^H * T12 */
+          gsl_blas_zgemm(CblasConjTrans, CblasNoTrans, GSL_COMPLEX_ONE, &A21.matrix, &A22.matrix, GSL_COMPLEX_ONE, &T12.matrix); /* T12 = T12 + A21^H * A22 */
+          gsl_blas_ztrmm(CblasLeft, CblasUpper, CblasConjTrans, CblasNonUnit, GSL_COMPLEX_ONE, &T11.matrix, &T12.matrix);       /* T12 = T11^H * T12 */
+          gsl_blas_zgemm(CblasNoTrans, CblasNoTrans, GSL_COMPLEX_NEGONE, &A21.matrix, &T12.matrix, GSL_COMPLEX_ONE, &A22.matrix); /* A22 = A22 - A21 * T12 */
+          gsl_blas_ztrmm(CblasLeft, CblasLower, CblasNoTrans, CblasUnit, GSL_COMPLEX_ONE, &A11.matrix, &T12.matrix);            /* T12 = lower(A11) * T12 */
+
+          gsl_matrix_complex_sub(&A12.matrix, &T12.matrix);
+
+          /* recursion on (A22, T22) */
+          status = gsl_linalg_complex_QR_decomp_r(&A22.matrix, &T22.matrix);
+          if (status)
+            return status;
+
+          /* T12 = -T11 * V1^H V2 * T22 */
+          m = gsl_matrix_complex_submatrix(&A21.matrix, 0, 0, N2, N1);
+          conjtrans_memcpy(&T12.matrix, &m.matrix);
+
+          A22 = gsl_matrix_complex_submatrix(A, N1, N1, N2, N2);
+          gsl_blas_ztrmm(CblasRight, CblasLower, CblasNoTrans, CblasUnit, GSL_COMPLEX_ONE, &A22.matrix, &T12.matrix);           /* T12 = T12 * lower(A22) */
+
+          if (M > N)
+            {
+              gsl_matrix_complex_view A31 = gsl_matrix_complex_submatrix(A, N, 0, M - N, N1);
+              gsl_matrix_complex_view A32 = gsl_matrix_complex_submatrix(A, N, N1, M - N, N2);
+
+              gsl_blas_zgemm(CblasConjTrans, CblasNoTrans, GSL_COMPLEX_ONE, &A31.matrix, &A32.matrix, GSL_COMPLEX_ONE, &T12.matrix); /* T12 = T12 + A31^H * A32 */
+            }
+
+          gsl_blas_ztrmm(CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, GSL_COMPLEX_NEGONE, &T11.matrix, &T12.matrix);      /* T12 = -T11 * T12 */
+          gsl_blas_ztrmm(CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit, GSL_COMPLEX_ONE, &T22.matrix, &T12.matrix);        /* T12 = T12 * T22 */
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* Solves the square system A x = b for x using the QR factorisation,
+ *
+ *  R x = Q^H b
+ *
+ * where Q = I - V T V^H
+ */
+
+int
+gsl_linalg_complex_QR_solve_r (const gsl_matrix_complex * QR, const gsl_matrix_complex * T,
+                               const gsl_vector_complex * b, gsl_vector_complex * x)
+{
+  const size_t N = QR->size2;
+
+  if (QR->size1 != N)
+    {
+      GSL_ERROR ("QR matrix must be square", GSL_ENOTSQR);
+    }
+  else if (T->size1 != QR->size1 || T->size2 != QR->size2)
+    {
+      GSL_ERROR ("T matrix must be N-by-N", GSL_EBADLEN);
+    }
+  else if (N != b->size)
+    {
+      GSL_ERROR ("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (N != x->size)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      /* compute Q^H b = [I - V T^H V^H] b */
+
+      /* x := V^H b */
+      gsl_blas_zcopy(b, x);
+      gsl_blas_ztrmv(CblasLower, CblasConjTrans, CblasUnit, QR, x);
+
+      /* x = T^H * x */
+      gsl_blas_ztrmv(CblasUpper, CblasConjTrans, CblasNonUnit, T, x);
+
+      /* x = V * x */
+      gsl_blas_ztrmv(CblasLower, CblasNoTrans, CblasUnit, QR, x);
+
+      /* x = b - V * x */
+      gsl_blas_zdscal(-1.0, x);
+      gsl_blas_zaxpy(GSL_COMPLEX_ONE, b, x);
+
+      /* Solve R x = Q^H b, storing x in-place */
+      gsl_blas_ztrsv (CblasUpper, CblasNoTrans, CblasNonUnit, QR, x);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* Find the least squares solution to the overdetermined system
+ *
+ *   A x = b
+ *
+ * for M >= N using the QR factorization A = Q R.
+ *
+ * Inputs: QR   - [R; V] matrix, M-by-N
+ *         T    - upper triangular block reflector, N-by-N
+ *         b    - right hand side, size M
+ *         x    - (output) solution, size M
+ *                x(1:N) = least squares solution vector
+ *                x(N+1:M) = vector whose norm equals ||b - Ax||
+ *         work - workspace, size N
+ */
+
+int
+gsl_linalg_complex_QR_lssolve_r (const gsl_matrix_complex * QR, const gsl_matrix_complex * T,
+                                 const gsl_vector_complex * b, gsl_vector_complex * x,
+                                 gsl_vector_complex * work)
+{
+  const size_t M = QR->size1;
+  const size_t N = QR->size2;
+
+  if (M < N)
+    {
+      GSL_ERROR ("QR matrix must have M >= N", GSL_EBADLEN);
+    }
+  else if (T->size1 != N || T->size2 != N)
+    {
+      GSL_ERROR ("T matrix must be N-by-N", GSL_EBADLEN);
+    }
+  else if (M != b->size)
+    {
+      GSL_ERROR ("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (M != x->size)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else if (N != work->size)
+    {
+      GSL_ERROR ("matrix size must match work size", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_matrix_complex_const_view R = gsl_matrix_complex_const_submatrix (QR, 0, 0, N, N);
+      gsl_vector_complex_view x1 = gsl_vector_complex_subvector(x, 0, N);
+
+      /* compute x = Q^H b */
+      gsl_blas_zcopy(b, x);
+      gsl_linalg_complex_QR_QHvec_r (QR, T, x, work);
+
+      /* Solve R x = Q^H b */
+      gsl_blas_ztrsv (CblasUpper, CblasNoTrans, CblasNonUnit, &R.matrix, &x1.vector);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_complex_QR_QHvec_r()
+  Apply M-by-M Q^H to the M-by-1 vector b
+
+Inputs: QR   - [R; V] matrix encoded by gsl_linalg_complex_QR_decomp_r
+        T    - block reflector matrix
+        b    - M-by-1 vector replaced by Q^H b on output
+        work - workspace, length N
+
+Notes:
+1) Q^H b = (I - V T^H V^H) b
+         = [ b1 ] - [ V1 w ]
+           [ b2 ]   [ V2 w ]
+
+where w = T^H ( V1^H b1 + V2^H b2 )
+*/
+
+int
+gsl_linalg_complex_QR_QHvec_r(const gsl_matrix_complex * QR, const gsl_matrix_complex * T,
+                              gsl_vector_complex * b, gsl_vector_complex * work)
+{
+  const size_t M = QR->size1;
+  const size_t N = QR->size2;
+
+  if (M < N)
+    {
+      GSL_ERROR ("M must be >= N", GSL_EBADLEN);
+    }
+  else if (T->size1 != N || T->size2 != N)
+    {
+      GSL_ERROR ("T matrix must be N-by-N", GSL_EBADLEN);
+    }
+  else if (b->size != M)
+    {
+      GSL_ERROR ("b vector must have length M", GSL_EBADLEN);
+    }
+  else if (work->size != N)
+    {
+      GSL_ERROR ("workspace must be length N", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_matrix_complex_const_view V1 = gsl_matrix_complex_const_submatrix(QR, 0, 0, N, N);
+      gsl_vector_complex_view b1 = gsl_vector_complex_subvector(b, 0, N);
+      gsl_vector_complex_view b2;
+
+      /* work := V1^H b1 */
+      gsl_blas_zcopy(&b1.vector, work);
+      gsl_blas_ztrmv(CblasLower, CblasConjTrans, CblasUnit, &V1.matrix, work);
+
+      if (M > N)
+        {
+          gsl_matrix_complex_const_view V2 = gsl_matrix_complex_const_submatrix(QR, N, 0, M - N, N);
+
+          /* work = work + V2^H b2 */
+          b2 = gsl_vector_complex_subvector(b, N, M - N);
+          gsl_blas_zgemv(CblasConjTrans, GSL_COMPLEX_ONE, &V2.matrix, &b2.vector, GSL_COMPLEX_ONE, work);
+        }
+
+      /* work = T^H * work */
+      gsl_blas_ztrmv(CblasUpper, CblasConjTrans, CblasNonUnit, T, work);
+
+      if (M > N)
+        {
+          /* b2 = b2 - V2 * work */
+          gsl_matrix_complex_const_view V2 = gsl_matrix_complex_const_submatrix(QR, N, 0, M - N, N);
+          gsl_blas_zgemv(CblasNoTrans, GSL_COMPLEX_NEGONE, &V2.matrix, work, GSL_COMPLEX_ONE, &b2.vector);
+        }
+
+      /* b1 = b1 - V1 * work */
+      gsl_blas_ztrmv(CblasLower, CblasNoTrans, CblasUnit, &V1.matrix, work);
+      gsl_blas_zaxpy(GSL_COMPLEX_NEGONE, work, &b1.vector);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_complex_QR_unpack_r()
+  Unpack matrices Q and R
+
+Inputs: QR - packed QR format, M-by-N
+        T  - block reflector matrix, N-by-N
+        Q  - (output) Q matrix, M-by-M
+        R  - (output) R matrix, N-by-N
+
+Return: success/error
+
+Notes:
+1) Q = I - V T V^H is formed with Level 3 BLAS, using the first N rows
+of Q as workspace for W = T V^H:
+
+Q = [ I  0 ] - [ V1 W ]
+    [ 0  I ]   [ V2 W ]
+*/
+
+int
+gsl_linalg_complex_QR_unpack_r(const gsl_matrix_complex * QR, const gsl_matrix_complex * T,
+                               gsl_matrix_complex * Q, gsl_matrix_complex * R)
+{
+  const size_t M = QR->size1;
+  const size_t N = QR->size2;
+
+  if (M < N)
+    {
+      GSL_ERROR ("M must be >= N", GSL_EBADLEN);
+    }
+  else if (Q->size1 != M || Q->size2 != M)
+    {
+      GSL_ERROR ("Q matrix must be M-by-M", GSL_EBADLEN);
+    }
+  else if (R->size1 != N || R->size2 != N)
+    {
+      GSL_ERROR ("R matrix must be N-by-N", GSL_EBADLEN);
+    }
+  else if (T->size1 != N || T->size2 != N)
+    {
+      GSL_ERROR ("T matrix must be N-by-N", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_matrix_complex_const_view V1 = gsl_matrix_complex_const_submatrix(QR, 0, 0, N, N);
+      gsl_matrix_complex_view W = gsl_matrix_complex_submatrix(Q, 0, 0, N, M);
+      gsl_matrix_complex_view W1 = gsl_matrix_complex_submatrix(Q, 0, 0, N, N);
+      gsl_vector_complex_view diag = gsl_matrix_complex_diagonal(Q);
+      size_t i;
+
+      /* W := V^H = [ V1^H V2^H ], with the unit diagonal of V1 */
+      conjtrans_memcpy(&W1.matrix, &V1.matrix);
+
+      for (i = 0; i < N; ++i)
+        {
+          size_t j;
+
+          gsl_matrix_complex_set(&W1.matrix, i, i, GSL_COMPLEX_ONE);
+
+          for (j = 0; j < i; ++j)
+            gsl_matrix_complex_set(&W1.matrix, i, j, GSL_COMPLEX_ZERO);
+        }
+
+      if (M > N)
+        {
+          gsl_matrix_complex_const_view V2 = gsl_matrix_complex_const_submatrix(QR, N, 0, M - N, N);
+          gsl_matrix_complex_view W2 = gsl_matrix_complex_submatrix(Q, 0, N, N, M - N);
+          gsl_matrix_complex_view Q2 = gsl_matrix_complex_submatrix(Q, N, 0, M - N, M);
+
+          conjtrans_memcpy(&W2.matrix, &V2.matrix);
+
+          /* W := T V^H */
+          gsl_blas_ztrmm(CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, GSL_COMPLEX_ONE, T, &W.matrix);
+
+          /* Q(N:M,:) := - V2 W */
+          gsl_blas_zgemm(CblasNoTrans, CblasNoTrans, GSL_COMPLEX_NEGONE, &V2.matrix, &W.matrix,
+                         GSL_COMPLEX_ZERO, &Q2.matrix);
+        }
+      else
+        {
+          /* W := T V^H */
+          gsl_blas_ztrmm(CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, GSL_COMPLEX_ONE, T, &W.matrix);
+        }
+
+      /* Q(0:N,:) := - V1 W */
+      gsl_blas_ztrmm(CblasLeft, CblasLower, CblasNoTrans, CblasUnit, GSL_COMPLEX_NEGONE, &V1.matrix, &W.matrix);
+
+      /* Q := I + Q */
+      gsl_vector_complex_add_constant(&diag.vector, GSL_COMPLEX_ONE);
+
+      /* copy R */
+      gsl_matrix_complex_set_zero(R);
+      gsl_matrix_complex_tricpy('U', 1, R, &V1.matrix);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* dest := src^H */
+static void
+conjtrans_memcpy(gsl_matrix_complex * dest, const gsl_matrix_complex * src)
+{
+  size_t i, j;
+
+  for (i = 0; i < src->size1; ++i)
+    {
+      for (j = 0; j < src->size2; ++j)
+        {
+          gsl_complex z = gsl_matrix_complex_get(src, i, j);
+          gsl_matrix_complex_set(dest, j, i, gsl_complex_conjugate(z));
+        }
+    }
+}
@@ -64,6 +64,22 @@
  * 
  */
 
+/* number of columns factored per panel by the blocked algorithm */
+#define QRPT_BLOCK 32
+
+/* the blocked algorithm is used while more than this many columns
+ * remain to be factored */
+#define QRPT_CROSSOVER 128
+
+static int qrpt_decomp_L2 (gsl_matrix * A, const size_t i0, gsl_vector * tau,
+                           gsl_permutation * p, int *signum, gsl_vector * norm);
+static int qrpt_decomp_L3 (gsl_matrix * A, gsl_vector * tau,
+                           gsl_permutation * p, int *signum, gsl_vector * norm);
+static size_t qrpt_panel (gsl_matrix * A, const size_t off, const size_t nb,
+                          gsl_vector * tau, gsl_permutation * p, int *signum,
+                          gsl_vector * vn1, gsl_vector * vn2,
+                          gsl_matrix * F, gsl_vector * auxv);
+
 int
 gsl_linalg_QRPT_decomp (gsl_matrix * A, gsl_vector * tau, gsl_permutation * p, int *signum, gsl_vector * norm)
 {
@@ -99,91 +115,375 @@ gsl_linalg_QRPT_decomp (gsl_matrix * A, gsl_vector * tau, gsl_permutation * p, i
           gsl_vector_set (norm, i, x);
         }
 
-      for (i = 0; i < GSL_MIN (M, N); i++)
+      if (GSL_MIN (M, N) > QRPT_CROSSOVER)
         {
-          /* Bring the column of largest norm into the pivot position */
+          int status = qrpt_decomp_L3 (A, tau, p, signum, norm);
+
+          if (status != GSL_ENOMEM)
+            return status;
+
+          /* not enough memory for the panel workspace, fall through to
+           * the unblocked algorithm */
+        }
+
+      return qrpt_decomp_L2 (A, 0, tau, p, signum, norm);
+    }
+}
+
+/* Householder QR with column pivoting on columns i0 and beyond, one
+ * column at a time. On input the first i0 columns must already be
+ * factored, and norm(j) for j >= i0 must hold the norm of column j
+ * below row i0 */
+
+static int
+qrpt_decomp_L2 (gsl_matrix * A, const size_t i0, gsl_vector * tau,
+                gsl_permutation * p, int *signum, gsl_vector * norm)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  size_t i;
+
+  for (i = i0; i < GSL_MIN (M, N); i++)
+    {
+      /* Bring the column of largest norm into the pivot position */
+
+      double max_norm = gsl_vector_get(norm, i);
+      size_t j, kmax = i;
+
+      for (j = i + 1; j < N; j++)
+        {
+          double x = gsl_vector_get (norm, j);
+
+          if (x > max_norm)
+            {
+              max_norm = x;
+              kmax = j;
+            }
+        }
+
+      if (kmax != i)
+        {
+          gsl_matrix_swap_columns (A, i, kmax);
+          gsl_permutation_swap (p, i, kmax);
+          gsl_vector_swap_elements(norm,i,kmax);
+
+          (*signum) = -(*signum);
+        }
+
+      /* Compute the Householder transformation to reduce the j-th
+         column of the matrix to a multiple of the j-th unit vector */
+
+      {
+        gsl_vector_view c_full = gsl_matrix_column (A, i);
+        gsl_vector_view c = gsl_vector_subvector (&c_full.vector, 
+                                                  i, M - i);
+        double tau_i = gsl_linalg_householder_transform (&c.vector);
+
+        gsl_vector_set (tau, i, tau_i);
+
+        /* Apply the transformation to the remaining columns */
+
+        if (i + 1 < N)
+          {
+            gsl_matrix_view m = gsl_matrix_submatrix (A, i, i + 1, M - i, N - (i+1));
+
+            gsl_linalg_householder_hm (tau_i, &c.vector, &m.matrix);
+          }
+      }
 
-          double max_norm = gsl_vector_get(norm, i);
-          size_t j, kmax = i;
+      /* Update the norms of the remaining columns too */
 
+      if (i + 1 < M) 
+        {
           for (j = i + 1; j < N; j++)
             {
               double x = gsl_vector_get (norm, j);
 
-              if (x > max_norm)
+              if (x > 0.0)
                 {
-                  max_norm = x;
-                  kmax = j;
+                  double y = 0;
+                  double temp= gsl_matrix_get (A, i, j) / x;
+              
+                  if (fabs (temp) >= 1)
+                    y = 0.0;
+                  else
+                    y = x * sqrt (1 - temp * temp);
+                  
+                  /* recompute norm to prevent loss of accuracy */
+
+                  if (fabs (y / x) < sqrt (20.0) * GSL_SQRT_DBL_EPSILON)
+                    {
+                      gsl_vector_view c_full = gsl_matrix_column (A, j);
+                      gsl_vector_view c = 
+                        gsl_vector_subvector(&c_full.vector,
+                                             i+1, M - (i+1));
+                      y = gsl_blas_dnrm2 (&c.vector);
+                    }
+              
+                  gsl_vector_set (norm, j, y);
                 }
             }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* Blocked Householder QR with column pivoting (Quintana-Orti, Sun and
+ * Bischof, "A BLAS-3 version of the QR factorization with column
+ * pivoting", SIAM J. Sci. Comput. 19, 1998; LAPACK dgeqp3).
+ *
+ * The columns are factored in panels of QRPT_BLOCK. Within a panel
+ * only the current column and the pivot row are brought up to date,
+ * which is all that is needed to choose the pivots and downdate the
+ * column norms. The reflectors of the panel are accumulated as
+ *
+ *   F = A^T V T
+ *
+ * so that the rest of the trailing matrix is updated at the end of the
+ * panel with the single matrix multiply A := A - V F^T. The remaining
+ * QRPT_CROSSOVER columns are factored by qrpt_decomp_L2. */
+
+static int
+qrpt_decomp_L3 (gsl_matrix * A, gsl_vector * tau, gsl_permutation * p,
+                int *signum, gsl_vector * norm)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  const size_t K = GSL_MIN (M, N);
+  gsl_vector *vn2 = gsl_vector_alloc (N);
+  gsl_vector *auxv = gsl_vector_alloc (QRPT_BLOCK);
+  gsl_matrix *work = gsl_matrix_alloc (N, QRPT_BLOCK);
+  size_t off = 0;
+
+  if (vn2 == 0 || auxv == 0 || work == 0)
+    {
+      if (vn2)
+        gsl_vector_free (vn2);
+      if (auxv)
+        gsl_vector_free (auxv);
+      if (work)
+        gsl_matrix_free (work);
+
+      return GSL_ENOMEM;
+    }
+
+  gsl_vector_memcpy (vn2, norm);
+
+  while (off < K && K - off > QRPT_CROSSOVER)
+    {
+      const size_t nb = GSL_MIN (QRPT_BLOCK, K - off - QRPT_CROSSOVER);
+      gsl_matrix_view F = gsl_matrix_submatrix (work, 0, 0, N - off, nb);
+
+      off += qrpt_panel (A, off, nb, tau, p, signum, norm, vn2,
+                         &F.matrix, auxv);
+    }
+
+  gsl_vector_free (vn2);
+  gsl_vector_free (auxv);
+  gsl_matrix_free (work);
 
-          if (kmax != i)
+  return qrpt_decomp_L2 (A, off, tau, p, signum, norm);
+}
+
+/* factor up to nb columns of A starting at column off, and update the
+ * trailing matrix. vn1 holds the current partial column norms and vn2
+ * the norms when they were last computed exactly; F is
+ * (N - off)-by-nb. Returns the number of columns factored, which is
+ * less than nb if the panel had to stop early for a norm to be
+ * recomputed */
+
+static size_t
+qrpt_panel (gsl_matrix * A, const size_t off, const size_t nb,
+            gsl_vector * tau, gsl_permutation * p, int *signum,
+            gsl_vector * vn1, gsl_vector * vn2,
+            gsl_matrix * F, gsl_vector * auxv)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  const size_t n = N - off;
+  const size_t lastrk = GSL_MIN (M, N);
+  const double tol3z = GSL_SQRT_DBL_EPSILON;
+  int recompute = 0;
+  size_t k = 0, j;
+
+  while (k < nb && !recompute)
+    {
+      const size_t rk = off + k;
+      gsl_vector_view c = gsl_matrix_column (A, off + k);
+      gsl_vector_view v = gsl_vector_subvector (&c.vector, rk, M - rk);
+      gsl_vector_view f = gsl_matrix_column (F, k);
+      double max_norm = gsl_vector_get (vn1, rk);
+      size_t kmax = k;
+      double tau_k, akk;
+
+      /* Bring the column of largest norm into the pivot position */
+
+      for (j = k + 1; j < n; j++)
+        {
+          double x = gsl_vector_get (vn1, off + j);
+
+          if (x > max_norm)
             {
-              gsl_matrix_swap_columns (A, i, kmax);
-              gsl_permutation_swap (p, i, kmax);
-              gsl_vector_swap_elements(norm,i,kmax);
+              max_norm = x;
+              kmax = j;
+            }
+        }
+
+      if (kmax != k)
+        {
+          gsl_matrix_swap_columns (A, off + k, off + kmax);
+          gsl_permutation_swap (p, off + k, off + kmax);
 
-              (*signum) = -(*signum);
+          for (j = 0; j < k; j++)
+            {
+              double tmp = gsl_matrix_get (F, k, j);
+              gsl_matrix_set (F, k, j, gsl_matrix_get (F, kmax, j));
+              gsl_matrix_set (F, kmax, j, tmp);
             }
 
-          /* Compute the Householder transformation to reduce the j-th
-             column of the matrix to a multiple of the j-th unit vector */
+          gsl_vector_set (vn1, off + kmax, gsl_vector_get (vn1, off + k));
+          gsl_vector_set (vn2, off + kmax, gsl_vector_get (vn2, off + k));
 
-          {
-            gsl_vector_view c_full = gsl_matrix_column (A, i);
-            gsl_vector_view c = gsl_vector_subvector (&c_full.vector, 
-                                                      i, M - i);
-            double tau_i = gsl_linalg_householder_transform (&c.vector);
+          (*signum) = -(*signum);
+        }
 
-            gsl_vector_set (tau, i, tau_i);
+      /* Apply the previous reflectors of the panel to column k,
+       * A(rk:M,k) -= A(rk:M,0:k) F(k,0:k)^T */
 
-            /* Apply the transformation to the remaining columns */
+      if (k > 0)
+        {
+          gsl_matrix_view Ak = gsl_matrix_submatrix (A, rk, off, M - rk, k);
+          gsl_vector_view Fk = gsl_matrix_subrow (F, k, 0, k);
 
-            if (i + 1 < N)
-              {
-                gsl_matrix_view m = gsl_matrix_submatrix (A, i, i + 1, M - i, N - (i+1));
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Ak.matrix, &Fk.vector,
+                          1.0, &v.vector);
+        }
 
-                gsl_linalg_householder_hm (tau_i, &c.vector, &m.matrix);
-              }
-          }
+      /* Compute the Householder transformation for column k */
+
+      tau_k = gsl_linalg_householder_transform (&v.vector);
+      gsl_vector_set (tau, rk, tau_k);
+
+      akk = gsl_matrix_get (A, rk, off + k);
+      gsl_matrix_set (A, rk, off + k, 1.0);
+
+      /* F(k+1:n,k) = tau A(rk:M,k+1:n)^T v */
+
+      if (k + 1 < n)
+        {
+          gsl_matrix_view Ar = gsl_matrix_submatrix (A, rk, off + k + 1,
+                                                     M - rk, n - k - 1);
+          gsl_vector_view fk = gsl_vector_subvector (&f.vector, k + 1, n - k - 1);
+
+          gsl_blas_dgemv (CblasTrans, tau_k, &Ar.matrix, &v.vector, 0.0,
+                          &fk.vector);
+        }
+
+      for (j = 0; j <= k; j++)
+        gsl_matrix_set (F, j, k, 0.0);
 
-          /* Update the norms of the remaining columns too */
+      /* F(:,k) -= tau F(:,0:k) A(rk:M,0:k)^T v */
 
-          if (i + 1 < M) 
+      if (k > 0)
+        {
+          gsl_matrix_view Ak = gsl_matrix_submatrix (A, rk, off, M - rk, k);
+          gsl_matrix_view Fk = gsl_matrix_submatrix (F, 0, 0, n, k);
+          gsl_vector_view w = gsl_vector_subvector (auxv, 0, k);
+
+          gsl_blas_dgemv (CblasTrans, -tau_k, &Ak.matrix, &v.vector, 0.0,
+                          &w.vector);
+          gsl_blas_dgemv (CblasNoTrans, 1.0, &Fk.matrix, &w.vector, 1.0,
+                          &f.vector);
+        }
+
+      /* Update the pivot row, A(rk,k+1:n) -= A(rk,0:k+1) F(k+1:n,0:k+1)^T */
+
+      if (k + 1 < n)
+        {
+          gsl_vector_view a = gsl_matrix_subrow (A, rk, off, k + 1);
+          gsl_vector_view r = gsl_matrix_subrow (A, rk, off + k + 1, n - k - 1);
+          gsl_matrix_view Fr = gsl_matrix_submatrix (F, k + 1, 0, n - k - 1, k + 1);
+
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Fr.matrix, &a.vector, 1.0,
+                          &r.vector);
+        }
+
+      /* Downdate the norms of the remaining columns. A norm which has
+       * lost too much accuracy is marked with vn2 = -1 and recomputed
+       * after the trailing update, which ends the panel */
+
+      if (rk + 1 < lastrk)
+        {
+          for (j = off + k + 1; j < N; j++)
             {
-              for (j = i + 1; j < N; j++)
+              double x = gsl_vector_get (vn1, j);
+
+              if (x > 0.0)
                 {
-                  double x = gsl_vector_get (norm, j);
+                  double temp = fabs (gsl_matrix_get (A, rk, j)) / x;
+                  double temp2;
+
+                  temp = GSL_MAX (0.0, (1.0 + temp) * (1.0 - temp));
+                  temp2 = x / gsl_vector_get (vn2, j);
+                  temp2 = temp * temp2 * temp2;
 
-                  if (x > 0.0)
+                  if (temp2 <= tol3z)
                     {
-                      double y = 0;
-                      double temp= gsl_matrix_get (A, i, j) / x;
-                  
-                      if (fabs (temp) >= 1)
-                        y = 0.0;
-                      else
-                        y = x * sqrt (1 - temp * temp);
-                      
-                      /* recompute norm to prevent loss of accuracy */
-
-                      if (fabs (y / x) < sqrt (20.0) * GSL_SQRT_DBL_EPSILON)
-                        {
-                          gsl_vector_view c_full = gsl_matrix_column (A, j);
-                          gsl_vector_view c = 
-                            gsl_vector_subvector(&c_full.vector,
-                                                 i+1, M - (i+1));
-                          y = gsl_blas_dnrm2 (&c.vector);
-                        }
-                  
-                      gsl_vector_set (norm, j, y);
+                      gsl_vector_set (vn2, j, -1.0);
+                      recompute = 1;
+                    }
+                  else
+                    {
+                      gsl_vector_set (vn1, j, x * sqrt (temp));
                     }
                 }
             }
         }
 
-      return GSL_SUCCESS;
+      gsl_matrix_set (A, rk, off + k, akk);
+
+      ++k;
     }
+
+  /* Apply the panel to the rest of the trailing matrix,
+   * A(rk:M,k:n) -= A(rk:M,0:k) F(k:n,0:k)^T */
+
+  {
+    const size_t rk = off + k;
+
+    if (k < GSL_MIN (n, M - off))
+      {
+        gsl_matrix_view V = gsl_matrix_submatrix (A, rk, off, M - rk, k);
+        gsl_matrix_view Fk = gsl_matrix_submatrix (F, k, 0, n - k, k);
+        gsl_matrix_view B = gsl_matrix_submatrix (A, rk, off + k, M - rk, n - k);
+
+        gsl_blas_dgemm (CblasNoTrans, CblasTrans, -1.0, &V.matrix,
+                        &Fk.matrix, 1.0, &B.matrix);
+      }
+
+    if (recompute)
+      {
+        for (j = off + k; j < N; j++)
+          {
+            if (gsl_vector_get (vn2, j) < 0.0)
+              {
+                double x = 0.0;
+
+                if (rk < M)
+                  {
+                    gsl_vector_view c = gsl_matrix_subcolumn (A, j, rk, M - rk);
+                    x = gsl_blas_dnrm2 (&c.vector);
+                  }
+
+                gsl_vector_set (vn1, j, x);
+                gsl_vector_set (vn2, j, x);
+              }
+          }
+      }
+  }
+
+  return k;
 }
 
 int
@@ -0,0 +1,241 @@
+/* linalg/rsvd.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_linalg.h>
+
+/* Randomized truncated singular value decomposition.
+
+   An orthonormal basis Q for the range of A is found by applying A to
+   a random N-by-l test matrix, with l = k + p columns for the k wanted
+   singular triplets and p oversampling columns. Each power iteration
+   multiplies the basis by A A^T, with reorthonormalization in between,
+   which sharpens the decay of the spectrum seen by the basis. Then
+
+     A ~ Q Q^T A = Q B,   B^T = U_B S V_B^T
+
+   so that U = Q V_B and V = U_B. The SVD of the small N-by-l matrix B^T
+   is computed with gsl_linalg_SV_decomp_dc. All products with A are
+   done with dgemm, for a total cost of O(M N l) per pass.
+
+   See Halko, Martinsson and Tropp, "Finding structure with randomness:
+   probabilistic algorithms for constructing approximate matrix
+   decompositions", SIAM Review 53 (2011) 217-288. */
+
+static int rsvd_orth (gsl_matrix * Y, gsl_matrix * Q, gsl_matrix * T, gsl_matrix * W);
+
+/*
+gsl_linalg_rSVD()
+  Compute the k largest singular values and the corresponding singular
+vectors of A with a randomized algorithm
+
+Inputs: A - M-by-N matrix, not modified
+        p - number of oversampling columns
+        q - number of power iterations
+        r - random number generator for the test matrix
+        U - (output) M-by-k matrix of left singular vectors
+        S - (output) k largest singular values, in decreasing order
+        V - (output) N-by-k matrix of right singular vectors
+
+Return: success/error
+
+Notes:
+1) k is the length of S; the size of the random sample k + p is
+reduced to min(M,N) if necessary
+
+2) the workspace of size O((M + N)(k + p)) is allocated internally
+*/
+
+int
+gsl_linalg_rSVD (const gsl_matrix * A, const size_t p, const size_t q,
+                 gsl_rng * r, gsl_matrix * U, gsl_vector * S, gsl_matrix * V)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  const size_t K = S->size;
+
+  if (K == 0)
+    {
+      GSL_ERROR ("number of singular values must be positive", GSL_EBADLEN);
+    }
+  else if (K > GSL_MIN (M, N))
+    {
+      GSL_ERROR ("number of singular values must not exceed min(M,N)", GSL_EBADLEN);
+    }
+  else if (U->size1 != M || U->size2 != K)
+    {
+      GSL_ERROR ("U matrix must be M-by-k", GSL_EBADLEN);
+    }
+  else if (V->size1 != N || V->size2 != K)
+    {
+      GSL_ERROR ("V matrix must be N-by-k", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t L = GSL_MIN (K + p, GSL_MIN (M, N));
+      gsl_matrix *Y = gsl_matrix_alloc (M, L);
+      gsl_matrix *Q = gsl_matrix_alloc (M, L);
+      gsl_matrix *Z = gsl_matrix_alloc (N, L);
+      gsl_matrix *B = gsl_matrix_alloc (N, L);
+      gsl_matrix *T = gsl_matrix_alloc (L, L);
+      gsl_matrix *W = gsl_matrix_alloc (L, L);
+      gsl_vector *SL = gsl_vector_alloc (L);
+      int status = GSL_ENOMEM;
+      size_t i, j;
+
+      if (Y != NULL && Q != NULL && Z != NULL && B != NULL &&
+          T != NULL && W != NULL && SL != NULL)
+        {
+          gsl_matrix_view Wk = gsl_matrix_submatrix (W, 0, 0, L, K);
+          gsl_matrix_const_view Bk = gsl_matrix_const_submatrix (B, 0, 0, N, K);
+          gsl_vector_const_view SLk = gsl_vector_const_subvector (SL, 0, K);
+
+          /* random test matrix with entries uniform on [-1,1) */
+          for (i = 0; i < N; ++i)
+            {
+              for (j = 0; j < L; ++j)
+                gsl_matrix_set (Z, i, j, 2.0 * gsl_rng_uniform (r) - 1.0);
+            }
+
+          /* Q = orth(A Z) */
+          gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, A, Z, 0.0, Y);
+          status = rsvd_orth (Y, Q, T, W);
+
+          /* power iterations: Q = orth(A orth(A^T Q)) */
+          for (i = 0; i < q && !status; ++i)
+            {
+              gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, A, Q, 0.0, Z);
+              status = rsvd_orth (Z, B, T, W);
+              if (status)
+                break;
+
+              gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, A, B, 0.0, Y);
+              status = rsvd_orth (Y, Q, T, W);
+            }
+
+          if (!status)
+            {
+              /* B^T = Q^T A, then B^T = U_B S V_B^T with U_B stored in B */
+              gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, A, Q, 0.0, B);
+              status = gsl_linalg_SV_decomp_dc (B, W, SL);
+            }
+
+          if (!status)
+            {
+              /* U = Q V_B(:,1:k), V = U_B(:,1:k) */
+              gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, Q, &Wk.matrix, 0.0, U);
+              gsl_matrix_memcpy (V, &Bk.matrix);
+              gsl_vector_memcpy (S, &SLk.vector);
+            }
+        }
+
+      if (Y)
+        gsl_matrix_free (Y);
+      if (Q)
+        gsl_matrix_free (Q);
+      if (Z)
+        gsl_matrix_free (Z);
+      if (B)
+        gsl_matrix_free (B);
+      if (T)
+        gsl_matrix_free (T);
+      if (W)
+        gsl_matrix_free (W);
+      if (SL)
+        gsl_vector_free (SL);
+
+      if (status == GSL_ENOMEM)
+        {
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      return status;
+    }
+}
+
+/*
+rsvd_orth()
+  Compute an orthonormal basis for the columns of Y
+
+Inputs: Y - M-by-L matrix, M >= L, destroyed on output
+        Q - (output) M-by-L matrix with orthonormal columns spanning Y
+        T - workspace, L-by-L
+        W - workspace, L-by-L
+
+Notes:
+1) Y is factored with gsl_linalg_QR_decomp_r as Y = H R with
+H = I - V T V^T, and the first L columns of H are formed as
+
+  H [ I ] = [ I - V1 (T V1^T) ]
+    [ 0 ]   [   - V2 (T V1^T) ]
+
+with V1 unit lower triangular
+*/
+
+static int
+rsvd_orth (gsl_matrix * Y, gsl_matrix * Q, gsl_matrix * T, gsl_matrix * W)
+{
+  const size_t M = Y->size1;
+  const size_t L = Y->size2;
+  gsl_matrix_view V1 = gsl_matrix_submatrix (Y, 0, 0, L, L);
+  gsl_matrix_view Q1 = gsl_matrix_submatrix (Q, 0, 0, L, L);
+  size_t i, j;
+  int status;
+
+  status = gsl_linalg_QR_decomp_r (Y, T);
+  if (status)
+    return status;
+
+  /* W = T V1^T */
+  gsl_matrix_set_zero (W);
+  for (i = 0; i < L; ++i)
+    {
+      gsl_matrix_set (W, i, i, 1.0);
+      for (j = i + 1; j < L; ++j)
+        gsl_matrix_set (W, i, j, gsl_matrix_get (Y, j, i));
+    }
+
+  gsl_blas_dtrmm (CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, T, W);
+
+  /* Q2 = -V2 W */
+  if (M > L)
+    {
+      gsl_matrix_view V2 = gsl_matrix_submatrix (Y, L, 0, M - L, L);
+      gsl_matrix_view Q2 = gsl_matrix_submatrix (Q, L, 0, M - L, L);
+
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, -1.0, &V2.matrix, W, 0.0, &Q2.matrix);
+    }
+
+  /* Q1 = I - V1 W */
+  gsl_blas_dtrmm (CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0, &V1.matrix, W);
+
+  for (i = 0; i < L; ++i)
+    {
+      for (j = 0; j < L; ++j)
+        gsl_matrix_set (&Q1.matrix, i, j, (i == j) - gsl_matrix_get (W, i, j));
+    }
+
+  return GSL_SUCCESS;
+}
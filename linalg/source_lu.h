@@ -0,0 +1,231 @@
+/* linalg/source_lu.h
+ *
+ * Copyright (C) 1996, 1997, 1998, 1999, 2000, 2007, 2009 Gerard Jungman, Brian Gough
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Recursive LU decomposition with partial pivoting. This file is
+ * included between templates_on.h and templates_off.h by lu.c with
+ * BASE_DOUBLE and by lu_mixed.c with BASE_FLOAT. */
+
+#if defined(BASE_DOUBLE)
+#define LU_IAMAX gsl_blas_idamax
+#define LU_BLAS(x) gsl_blas_d ## x
+#define LU_MIN GSL_DBL_MIN
+#elif defined(BASE_FLOAT)
+#define LU_IAMAX gsl_blas_isamax
+#define LU_BLAS(x) gsl_blas_s ## x
+#define LU_MIN GSL_FLT_MIN
+#endif
+
+/*
+LU_decomp_L2
+  LU decomposition with partial pivoting using Level 2 BLAS
+
+Inputs: A    - on input, matrix to be factored; on output, L and U factors
+        ipiv - (output) array containing row swaps
+
+Notes:
+1) Based on LAPACK DGETF2
+*/
+
+static int
+LU_decomp_L2 (TYPE (gsl_matrix) * A, gsl_vector_uint * ipiv)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  const size_t minMN = GSL_MIN(M, N);
+
+  if (ipiv->size != minMN)
+    {
+      GSL_ERROR ("ipiv length must equal MIN(M,N)", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t i, j;
+
+      for (j = 0; j < minMN; ++j)
+        {
+          /* find maximum in the j-th column */
+          VIEW (gsl_vector, view) v = FUNCTION (gsl_matrix, subcolumn) (A, j, j, M - j);
+          size_t j_pivot = j + LU_IAMAX(&v.vector);
+          VIEW (gsl_vector, view) v1, v2;
+
+          gsl_vector_uint_set(ipiv, j, j_pivot);
+
+          if (j_pivot != j)
+            {
+              /* swap rows j and j_pivot */
+              v1 = FUNCTION (gsl_matrix, row) (A, j);
+              v2 = FUNCTION (gsl_matrix, row) (A, j_pivot);
+              LU_BLAS (swap) (&v1.vector, &v2.vector);
+            }
+
+          if (j < M - 1)
+            {
+              BASE Ajj = FUNCTION (gsl_matrix, get) (A, j, j);
+
+              if (fabs(Ajj) >= LU_MIN)
+                {
+                  v1 = FUNCTION (gsl_matrix, subcolumn) (A, j, j + 1, M - j - 1);
+                  LU_BLAS (scal) (ONE / Ajj, &v1.vector);
+                }
+              else
+                {
+                  for (i = 1; i < M - j; ++i)
+                    {
+                      BASE * ptr = FUNCTION (gsl_matrix, ptr) (A, j + i, j);
+                      *ptr /= Ajj;
+                    }
+                }
+            }
+
+          if (j < minMN - 1)
+            {
+              VIEW (gsl_matrix, view) A22 = FUNCTION (gsl_matrix, submatrix) (A, j + 1, j + 1, M - j - 1, N - j - 1);
+              v1 = FUNCTION (gsl_matrix, subcolumn) (A, j, j + 1, M - j - 1);
+              v2 = FUNCTION (gsl_matrix, subrow) (A, j, j + 1, N - j - 1);
+
+              LU_BLAS (ger) (-ONE, &v1.vector, &v2.vector, &A22.matrix);
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+LU_decomp_L3
+  LU decomposition with partial pivoting using Level 3 BLAS
+
+Inputs: A    - on input, matrix to be factored; on output, L and U factors
+        ipiv - (output) array containing row swaps
+
+Notes:
+1) Based on ReLAPACK DGETRF
+*/
+
+static int
+LU_decomp_L3 (TYPE (gsl_matrix) * A, gsl_vector_uint * ipiv)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+
+  if (M < N)
+    {
+      GSL_ERROR ("matrix must have M >= N", GSL_EBADLEN);
+    }
+  else if (ipiv->size != GSL_MIN(M, N))
+    {
+      GSL_ERROR ("ipiv length must equal MIN(M,N)", GSL_EBADLEN);
+    }
+  else if (N <= CROSSOVER_LU)
+    {
+      /* use Level 2 algorithm */
+      return LU_decomp_L2(A, ipiv);
+    }
+  else
+    {
+      /*
+       * partition matrix:
+       *
+       *       N1  N2
+       * N1  [ A11 A12 ]
+       * M2  [ A21 A22 ]
+       *
+       * and
+       *      N1  N2
+       * M  [ AL  AR  ]
+       */
+      int status;
+      const size_t N1 = GSL_LINALG_SPLIT(N);
+      const size_t N2 = N - N1;
+      const size_t M2 = M - N1;
+      VIEW (gsl_matrix, view) A11 = FUNCTION (gsl_matrix, submatrix) (A, 0, 0, N1, N1);
+      VIEW (gsl_matrix, view) A12 = FUNCTION (gsl_matrix, submatrix) (A, 0, N1, N1, N2);
+      VIEW (gsl_matrix, view) A21 = FUNCTION (gsl_matrix, submatrix) (A, N1, 0, M2, N1);
+      VIEW (gsl_matrix, view) A22 = FUNCTION (gsl_matrix, submatrix) (A, N1, N1, M2, N2);
+
+      VIEW (gsl_matrix, view) AL = FUNCTION (gsl_matrix, submatrix) (A, 0, 0, M, N1);
+      VIEW (gsl_matrix, view) AR = FUNCTION (gsl_matrix, submatrix) (A, 0, N1, M, N2);
+
+      /*
+       * partition ipiv = [ ipiv1 ] N1
+       *                  [ ipiv2 ] N2
+       */
+      gsl_vector_uint_view ipiv1 = gsl_vector_uint_subvector(ipiv, 0, N1);
+      gsl_vector_uint_view ipiv2 = gsl_vector_uint_subvector(ipiv, N1, N2);
+
+      size_t i;
+
+      /* recursion on (AL, ipiv1) */
+      status = LU_decomp_L3(&AL.matrix, &ipiv1.vector);
+      if (status)
+        return status;
+
+      /* apply ipiv1 to AR */
+      apply_pivots(&AR.matrix, &ipiv1.vector);
+
+      /* A12 = A11^{-1} A12 */
+      LU_BLAS (trsm) (CblasLeft, CblasLower, CblasNoTrans, CblasUnit, ONE, &A11.matrix, &A12.matrix);
+
+      /* A22 = A22 - A21 * A12 */
+      LU_BLAS (gemm) (CblasNoTrans, CblasNoTrans, -ONE, &A21.matrix, &A12.matrix, ONE, &A22.matrix);
+
+      /* recursion on (A22, ipiv2) */
+      status = LU_decomp_L3(&A22.matrix, &ipiv2.vector);
+      if (status)
+        return status;
+
+      /* apply pivots to A21 */
+      apply_pivots(&A21.matrix, &ipiv2.vector);
+
+      /* shift pivots */
+      for (i = 0; i < N2; ++i)
+        {
+          unsigned int * ptr = gsl_vector_uint_ptr(&ipiv2.vector, i);
+          *ptr += N1;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+static int
+apply_pivots(TYPE (gsl_matrix) * A, const gsl_vector_uint * ipiv)
+{
+  size_t i;
+
+  for (i = 0; i < ipiv->size; ++i)
+    {
+      size_t pi = gsl_vector_uint_get(ipiv, i);
+
+      if (i != pi)
+        {
+          /* swap rows i and pi */
+          VIEW (gsl_vector, view) v1 = FUNCTION (gsl_matrix, row) (A, i);
+          VIEW (gsl_vector, view) v2 = FUNCTION (gsl_matrix, row) (A, pi);
+          LU_BLAS (swap) (&v1.vector, &v2.vector);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+#undef LU_IAMAX
+#undef LU_BLAS
+#undef LU_MIN
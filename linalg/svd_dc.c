@@ -0,0 +1,1125 @@
+/* linalg/svd_dc.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_sort_double.h>
+#include <gsl/gsl_linalg.h>
+
+/* Singular value decomposition by divide and conquer.
+
+   The matrix is reduced to upper bidiagonal form B, after a QR
+   decomposition when M is much larger than N. The N-by-N matrix B is
+   split at its middle row k,
+
+     B = [ B1           0    ]   rows 0..k-1, columns 0..k
+         [ d_k e_k^T  e_k e_1^T ]   row k
+         [ 0            B2   ]   rows k+1..N-1, columns k+1..N-1
+
+   the SVDs of the two halves are computed recursively, and with them
+   B is transformed into a diagonal matrix plus the single dense row
+   z. The singular values of this matrix which cannot be found
+   trivially (deflation) are the square roots of the roots of the
+   secular equation
+
+     1 + \sum_j z_j^2 / (d_j^2 - sigma^2) = 0
+
+   and the singular vectors are updated with one matrix-matrix product
+   per merge. As in the eigenvalue case the vector z is recomputed from
+   the singular values (Gu and Eisenstat) so that the singular vectors
+   are numerically orthogonal. Finally the singular vectors of B are
+   transformed with the Householder vectors of the reduction, which are
+   applied in blocks.
+
+   See Gu and Eisenstat, "A divide-and-conquer algorithm for the
+   bidiagonal SVD", SIAM J. Matrix Anal. Appl. 16 (1995) 79-92, and
+   LAPACK routines DGESDD, DBDSDC and DLASD0-DLASD4. */
+
+#include "svdstep.c"
+
+/* subproblems of this size or smaller are solved with QR iteration */
+#define SVD_DC_LEAF 25
+
+/* number of Householder reflectors applied together */
+#define SVD_DC_BLOCK 32
+
+typedef struct
+{
+  size_t size;
+  double *d;          /* diagonal of B, then singular values */
+  double *e;          /* superdiagonal of B */
+  double *tau_U;
+  double *tau_V;
+  double *z;          /* dense row of the merged problem */
+  double *dlam;       /* singular values of the halves, sorted */
+  double *zhat;
+  double *sigma;
+  double *work;
+  double *rot;        /* rotations which make the first half square */
+  size_t *perm;
+  size_t *idx;
+  gsl_matrix *G;      /* singular vectors gathered in sorted order */
+  gsl_matrix *D;      /* differences d_j^2 - sigma_i^2 */
+  gsl_matrix *Q;      /* singular vectors of the merged problem */
+} svd_dc_workspace;
+
+static svd_dc_workspace *svd_dc_alloc (const size_t n);
+static void svd_dc_free (svd_dc_workspace * w);
+static int svd_dc_qr (gsl_matrix * A, gsl_matrix * V, svd_dc_workspace * w);
+static int svd_dc_bidiag (gsl_matrix * A, gsl_matrix * V, svd_dc_workspace * w);
+static int svd_dc_rec (const size_t n, double d[], double e[], gsl_matrix * U,
+                       gsl_matrix * W, double rot[], svd_dc_workspace * w);
+static int svd_dc_leaf (const size_t n, double d[], double e[], gsl_matrix * U,
+                        gsl_matrix * W);
+static void svd_dc_merge (const size_t n, const size_t k, double d[],
+                          const double alpha, const double beta,
+                          gsl_matrix * U, gsl_matrix * W, svd_dc_workspace * w);
+static double svd_dc_secular (const size_t k, const size_t i, const double s[],
+                              const double z[], double delta[]);
+static void svd_dc_apply_householder (const gsl_matrix * A, const double tau[],
+                                      const size_t nrefl, const size_t shift,
+                                      const int rowwise, gsl_matrix * C,
+                                      gsl_matrix * VT, gsl_matrix * Wk);
+
+int
+gsl_linalg_SV_decomp_dc (gsl_matrix * A, gsl_matrix * V, gsl_vector * S)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+
+  if (M < N)
+    {
+      GSL_ERROR ("svd of MxN matrix, M<N, is not implemented", GSL_EUNIMPL);
+    }
+  else if (V->size1 != N)
+    {
+      GSL_ERROR ("square matrix V must match second dimension of matrix A",
+                 GSL_EBADLEN);
+    }
+  else if (V->size1 != V->size2)
+    {
+      GSL_ERROR ("matrix V must be square", GSL_ENOTSQR);
+    }
+  else if (S->size != N)
+    {
+      GSL_ERROR ("length of vector S must match second dimension of matrix A",
+                 GSL_EBADLEN);
+    }
+  else if (N == 1)
+    {
+      /* SVD of a column vector */
+
+      gsl_vector_view column = gsl_matrix_column (A, 0);
+      double norm = gsl_blas_dnrm2 (&column.vector);
+
+      gsl_vector_set (S, 0, norm);
+      gsl_matrix_set (V, 0, 0, 1.0);
+
+      if (norm != 0.0)
+        {
+          gsl_blas_dscal (1.0/norm, &column.vector);
+        }
+
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      svd_dc_workspace *w = svd_dc_alloc (N);
+      int status;
+
+      if (w == 0)
+        {
+          GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      /* for tall matrices it is cheaper to bidiagonalize the triangular
+         factor of a QR decomposition (LAPACK's crossover) */
+
+      if (M >= (11 * N) / 6)
+        status = svd_dc_qr (A, V, w);
+      else
+        status = svd_dc_bidiag (A, V, w);
+
+      if (status == GSL_SUCCESS)
+        {
+          /* sort the singular values into decreasing order */
+
+          double *const d = w->d;
+          size_t *const perm = w->perm;
+          size_t i, j;
+
+          gsl_sort_index (perm, d, 1, N);
+
+          for (j = 0; j < N; j++)
+            {
+              gsl_vector_set (S, j, d[perm[N - 1 - j]]);
+            }
+
+          for (i = 0; i < M; i++)
+            {
+              for (j = 0; j < N; j++)
+                w->work[j] = gsl_matrix_get (A, i, perm[N - 1 - j]);
+
+              for (j = 0; j < N; j++)
+                gsl_matrix_set (A, i, j, w->work[j]);
+            }
+
+          for (i = 0; i < N; i++)
+            {
+              for (j = 0; j < N; j++)
+                w->work[j] = gsl_matrix_get (V, i, perm[N - 1 - j]);
+
+              for (j = 0; j < N; j++)
+                gsl_matrix_set (V, i, j, w->work[j]);
+            }
+        }
+
+      svd_dc_free (w);
+
+      return status;
+    }
+}
+
+static svd_dc_workspace *
+svd_dc_alloc (const size_t n)
+{
+  svd_dc_workspace *w = calloc (1, sizeof (svd_dc_workspace));
+
+  if (w == 0)
+    return 0;
+
+  w->size = n;
+  w->d = malloc (n * sizeof (double));
+  w->e = malloc (n * sizeof (double));
+  w->tau_U = malloc (n * sizeof (double));
+  w->tau_V = malloc (n * sizeof (double));
+  w->z = malloc (n * sizeof (double));
+  w->dlam = malloc (n * sizeof (double));
+  w->zhat = malloc (n * sizeof (double));
+  w->sigma = malloc (n * sizeof (double));
+  w->work = malloc (n * sizeof (double));
+  w->rot = malloc (2 * n * sizeof (double));
+  w->perm = malloc (n * sizeof (size_t));
+  w->idx = malloc (n * sizeof (size_t));
+  w->G = gsl_matrix_alloc (n, n);
+  w->D = gsl_matrix_alloc (n, n);
+  w->Q = gsl_matrix_alloc (n, n);
+
+  if (w->d == 0 || w->e == 0 || w->tau_U == 0 || w->tau_V == 0 ||
+      w->z == 0 || w->dlam == 0 || w->zhat == 0 || w->sigma == 0 ||
+      w->work == 0 || w->rot == 0 || w->perm == 0 || w->idx == 0 ||
+      w->G == 0 || w->D == 0 || w->Q == 0)
+    {
+      svd_dc_free (w);
+      return 0;
+    }
+
+  return w;
+}
+
+static void
+svd_dc_free (svd_dc_workspace * w)
+{
+  if (w->Q)
+    gsl_matrix_free (w->Q);
+
+  if (w->D)
+    gsl_matrix_free (w->D);
+
+  if (w->G)
+    gsl_matrix_free (w->G);
+
+  free (w->idx);
+  free (w->perm);
+  free (w->rot);
+  free (w->work);
+  free (w->sigma);
+  free (w->zhat);
+  free (w->dlam);
+  free (w->z);
+  free (w->tau_V);
+  free (w->tau_U);
+  free (w->e);
+  free (w->d);
+  free (w);
+}
+
+/* SVD of a tall matrix, A = Q R with R = U_R S V^T, so that U = Q U_R.
+   Q = I - Y T Y^T is stored as the block reflector of
+   gsl_linalg_QR_decomp_r */
+
+static int
+svd_dc_qr (gsl_matrix * A, gsl_matrix * V, svd_dc_workspace * w)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  gsl_matrix *T = gsl_matrix_alloc (N, N);
+  gsl_matrix *R = gsl_matrix_calloc (N, N);
+  int status;
+
+  if (T == 0 || R == 0)
+    {
+      if (T)
+        gsl_matrix_free (T);
+      if (R)
+        gsl_matrix_free (R);
+
+      GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  gsl_linalg_QR_decomp_r (A, T);
+
+  {
+    gsl_matrix_view A1 = gsl_matrix_submatrix (A, 0, 0, N, N);
+    gsl_matrix_tricpy ('U', 1, R, &A1.matrix);
+  }
+
+  status = svd_dc_bidiag (R, V, w);
+
+  if (status == GSL_SUCCESS)
+    {
+      /* [U1; U2] = (I - Y T Y^T) [U_R; 0], computed as
+         B = T Y1^T U_R, U2 = -Y2 B and U1 = U_R - Y1 B */
+
+      gsl_matrix_view A1 = gsl_matrix_submatrix (A, 0, 0, N, N);
+      gsl_matrix *B = w->G;
+      gsl_matrix *tmp = w->D;
+      size_t i;
+
+      gsl_matrix_memcpy (B, R);
+      gsl_blas_dtrmm (CblasLeft, CblasLower, CblasTrans, CblasUnit, 1.0,
+                      &A1.matrix, B);
+      gsl_blas_dtrmm (CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0,
+                      T, B);
+
+      /* the rows of Y2 are overwritten by those of U2 one block at a time */
+
+      for (i = N; i < M; i += N)
+        {
+          const size_t nr = GSL_MIN (N, M - i);
+          gsl_matrix_view Y2 = gsl_matrix_submatrix (A, i, 0, nr, N);
+          gsl_matrix_view t = gsl_matrix_submatrix (tmp, 0, 0, nr, N);
+
+          gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, -1.0, &Y2.matrix, B,
+                          0.0, &t.matrix);
+          gsl_matrix_memcpy (&Y2.matrix, &t.matrix);
+        }
+
+      gsl_matrix_memcpy (tmp, B);
+      gsl_blas_dtrmm (CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0,
+                      &A1.matrix, tmp);
+      gsl_matrix_memcpy (&A1.matrix, R);
+      gsl_matrix_sub (&A1.matrix, tmp);
+    }
+
+  gsl_matrix_free (T);
+  gsl_matrix_free (R);
+
+  return status;
+}
+
+/* SVD of an M-by-N matrix A with M >= N through the bidiagonal form
+   A = U_B B V_B^T; on output A contains U and w->d the unsorted
+   singular values */
+
+static int
+svd_dc_bidiag (gsl_matrix * A, gsl_matrix * V, svd_dc_workspace * w)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  double *const d = w->d;
+  double *const e = w->e;
+  gsl_matrix *C = gsl_matrix_calloc (M, N);
+  gsl_matrix *VT = gsl_matrix_alloc (M, 2 * SVD_DC_BLOCK);
+  gsl_matrix *Wk = gsl_matrix_alloc (SVD_DC_BLOCK, N);
+  double scale = 0.0;
+  int status = GSL_SUCCESS;
+  size_t i;
+
+  if (C == 0 || VT == 0 || Wk == 0)
+    {
+      if (C)
+        gsl_matrix_free (C);
+      if (VT)
+        gsl_matrix_free (VT);
+      if (Wk)
+        gsl_matrix_free (Wk);
+
+      GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+    }
+
+  {
+    gsl_vector_view tau_U = gsl_vector_view_array (w->tau_U, N);
+    gsl_vector_view tau_V = gsl_vector_view_array (w->tau_V, N - 1);
+    gsl_linalg_bidiag_decomp (A, &tau_U.vector, &tau_V.vector);
+  }
+
+  e[N - 1] = 0.0;
+
+  for (i = 0; i < N; i++)
+    {
+      d[i] = gsl_matrix_get (A, i, i);
+      scale = GSL_MAX_DBL (scale, fabs (d[i]));
+
+      if (i + 1 < N)
+        {
+          e[i] = gsl_matrix_get (A, i, i + 1);
+          scale = GSL_MAX_DBL (scale, fabs (e[i]));
+        }
+    }
+
+  {
+    gsl_matrix_view U = gsl_matrix_submatrix (C, 0, 0, N, N);
+
+    if (scale == 0.0)
+      {
+        gsl_matrix_set_identity (&U.matrix);
+        gsl_matrix_set_identity (V);
+      }
+    else
+      {
+        /* B is scaled to unit norm, so that the secular equations can
+           be solved without overflow */
+
+        for (i = 0; i < N; i++)
+          {
+            d[i] /= scale;
+            e[i] /= scale;
+          }
+
+        status = svd_dc_rec (N, d, e, &U.matrix, V, w->rot, w);
+
+        for (i = 0; i < N; i++)
+          {
+            d[i] *= scale;
+          }
+      }
+  }
+
+  if (status == GSL_SUCCESS)
+    {
+      svd_dc_apply_householder (A, w->tau_V, N - 1, 1, 1, V, VT, Wk);
+      svd_dc_apply_householder (A, w->tau_U, N, 0, 0, C, VT, Wk);
+      gsl_matrix_memcpy (A, C);
+    }
+
+  gsl_matrix_free (C);
+  gsl_matrix_free (VT);
+  gsl_matrix_free (Wk);
+
+  return status;
+}
+
+/* SVD B = U diag(d) W^T of the n-by-n upper bidiagonal matrix with
+   diagonal d and superdiagonal e; the workspace rot must have room for
+   2n rotations */
+
+static int
+svd_dc_rec (const size_t n, double d[], double e[], gsl_matrix * U,
+            gsl_matrix * W, double rot[], svd_dc_workspace * w)
+{
+  if (n <= SVD_DC_LEAF)
+    {
+      return svd_dc_leaf (n, d, e, U, W);
+    }
+  else
+    {
+      const size_t k = n / 2;
+      const size_t n2 = n - k - 1;
+      const double alpha = d[k];
+      const double beta = e[k];
+      double *const c = rot;
+      double *const s = rot + k;
+      gsl_matrix_view U1 = gsl_matrix_submatrix (U, 0, 0, k, k);
+      gsl_matrix_view W1 = gsl_matrix_submatrix (W, 0, 0, k, k);
+      gsl_matrix_view U2 = gsl_matrix_submatrix (U, k + 1, k + 1, n2, n2);
+      gsl_matrix_view W2 = gsl_matrix_submatrix (W, k + 1, k + 1, n2, n2);
+      int status;
+      size_t j;
+
+      /* B1 is k-by-(k+1). Rotations of column k against columns k-1,
+         ..., 0 chase its last column out, B1 G = [B1' 0] with B1'
+         square upper bidiagonal */
+
+      {
+        double f = e[k - 1];
+
+        for (j = k; j-- > 0;)
+          {
+            const double r = hypot (d[j], f);
+
+            c[j] = (r == 0.0) ? 1.0 : d[j] / r;
+            s[j] = (r == 0.0) ? 0.0 : f / r;
+            d[j] = r;
+
+            if (j > 0)
+              {
+                f = -s[j] * e[j - 1];
+                e[j - 1] *= c[j];
+              }
+          }
+      }
+
+      status = svd_dc_rec (k, d, e, &U1.matrix, &W1.matrix, rot + 2 * k, w);
+
+      if (status)
+        return status;
+
+      status = svd_dc_rec (n2, d + k + 1, e + k + 1, &U2.matrix, &W2.matrix,
+                           rot + 2 * k, w);
+
+      if (status)
+        return status;
+
+      /* U = diag(U1, 1, U2) and W = diag(G diag(W1, 1), W2) */
+
+      {
+        gsl_matrix_view U12 = gsl_matrix_submatrix (U, 0, k, k, n - k);
+        gsl_matrix_view U21 = gsl_matrix_submatrix (U, k, 0, n - k, k + 1);
+        gsl_matrix_view U22 = gsl_matrix_submatrix (U, k, k + 1, 1, n2);
+        gsl_matrix_view W12 = gsl_matrix_submatrix (W, 0, k, k + 1, n - k);
+        gsl_matrix_view W21 = gsl_matrix_submatrix (W, k, 0, n - k, k + 1);
+
+        gsl_matrix_set_zero (&U12.matrix);
+        gsl_matrix_set_zero (&U21.matrix);
+        gsl_matrix_set_zero (&U22.matrix);
+        gsl_matrix_set_zero (&W12.matrix);
+        gsl_matrix_set_zero (&W21.matrix);
+        gsl_matrix_set (U, k, k, 1.0);
+        gsl_matrix_set (W, k, k, 1.0);
+      }
+
+      for (j = 0; j < k; j++)
+        {
+          gsl_vector_view wj = gsl_matrix_subrow (W, j, 0, k + 1);
+          gsl_vector_view wk = gsl_matrix_subrow (W, k, 0, k + 1);
+          gsl_blas_drot (&wj.vector, &wk.vector, c[j], -s[j]);
+        }
+
+      svd_dc_merge (n, k, d, alpha, beta, U, W, w);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* Golub-Kahan QR iteration, as in gsl_linalg_SV_decomp, with the
+   rotations accumulated into U = W = I */
+
+static int
+svd_dc_leaf (const size_t n, double d[], double e[], gsl_matrix * U,
+             gsl_matrix * W)
+{
+  gsl_vector_view dv = gsl_vector_view_array (d, n);
+  size_t a, b, j, iter = 0;
+
+  gsl_matrix_set_identity (U);
+  gsl_matrix_set_identity (W);
+
+  if (n > 1)
+    {
+      gsl_vector_view ev = gsl_vector_view_array (e, n - 1);
+
+      chop_small_elements (&dv.vector, &ev.vector);
+
+      b = n - 1;
+
+      while (b > 0)
+        {
+          if (e[b - 1] == 0.0 || gsl_isnan (e[b - 1]))
+            {
+              b--;
+              continue;
+            }
+
+          a = b - 1;
+
+          while (a > 0)
+            {
+              if (e[a - 1] == 0.0 || gsl_isnan (e[a - 1]))
+                break;
+
+              a--;
+            }
+
+          if (++iter > 100 * n)
+            {
+              GSL_ERROR ("SVD decomposition failed to converge", GSL_EMAXITER);
+            }
+
+          {
+            const size_t n_block = b - a + 1;
+            gsl_vector_view S_block = gsl_vector_subvector (&dv.vector, a, n_block);
+            gsl_vector_view f_block = gsl_vector_subvector (&ev.vector, a, n_block - 1);
+            gsl_matrix_view U_block = gsl_matrix_submatrix (U, 0, a, n, n_block);
+            gsl_matrix_view W_block = gsl_matrix_submatrix (W, 0, a, n, n_block);
+            double norm = 0.0, scale = 1.0;
+
+            for (j = a; j <= b; j++)
+              {
+                norm = GSL_MAX_DBL (norm, fabs (d[j]));
+
+                if (j < b)
+                  norm = GSL_MAX_DBL (norm, fabs (e[j]));
+              }
+
+            /* temporarily scale the block if it is close to underflow */
+
+            if (norm < GSL_SQRT_DBL_MIN)
+              {
+                scale = norm / GSL_SQRT_DBL_MIN;
+                gsl_blas_dscal (1.0 / scale, &S_block.vector);
+                gsl_blas_dscal (1.0 / scale, &f_block.vector);
+              }
+
+            qrstep (&S_block.vector, &f_block.vector, &U_block.matrix, &W_block.matrix);
+            chop_small_elements (&S_block.vector, &f_block.vector);
+
+            if (scale != 1.0)
+              {
+                gsl_blas_dscal (scale, &S_block.vector);
+                gsl_blas_dscal (scale, &f_block.vector);
+              }
+          }
+        }
+    }
+
+  /* make the singular values positive */
+
+  for (j = 0; j < n; j++)
+    {
+      if (d[j] < 0.0)
+        {
+          gsl_vector_view wj = gsl_matrix_column (W, j);
+          gsl_blas_dscal (-1.0, &wj.vector);
+          d[j] = -d[j];
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* Given the SVDs of the two halves of B, stored block diagonally in U
+   and W with a zero singular value for index k, compute the SVD of
+
+     U^T B W = diag(d) + e_k z^T
+
+   and store it in d, U and W */
+
+static void
+svd_dc_merge (const size_t n, const size_t k, double d[], const double alpha,
+              const double beta, gsl_matrix * U, gsl_matrix * W,
+              svd_dc_workspace * w)
+{
+  double *const z = w->z;
+  double *const dlam = w->dlam;
+  double *const zhat = w->zhat;
+  size_t *const perm = w->perm;
+  size_t *const idx = w->idx;
+  const double tol = 8.0 * GSL_DBL_EPSILON;
+  double dmax = GSL_MAX_DBL (fabs (alpha), fabs (beta));
+  size_t i, j, K = 1, nd = 0, prev = 0;
+  int have_prev = 0;
+
+  d[k] = 0.0;
+
+  for (j = 0; j < n; j++)
+    {
+      dmax = GSL_MAX_DBL (dmax, d[j]);
+    }
+
+  if (dmax == 0.0)
+    return;
+
+  /* the merged problem is scaled to unit norm, so that the squares of
+     its singular values do not underflow */
+
+  for (j = 0; j < n; j++)
+    {
+      d[j] /= dmax;
+    }
+
+  for (j = 0; j <= k; j++)
+    {
+      z[j] = (alpha / dmax) * gsl_matrix_get (W, k, j);
+    }
+
+  for (j = k + 1; j < n; j++)
+    {
+      z[j] = (beta / dmax) * gsl_matrix_get (W, k + 1, j);
+    }
+
+  /* sort the singular values, with the zero singular value k first */
+
+  gsl_sort_index (perm, d, 1, n);
+
+  for (i = 0; perm[i] != k; i++)
+    ;
+
+  for (; i > 0; i--)
+    {
+      perm[i] = perm[i - 1];
+    }
+
+  perm[0] = k;
+
+  /* the zero singular value always takes part in the secular equation */
+
+  if (fabs (z[k]) < tol)
+    z[k] = (z[k] < 0.0) ? -tol : tol;
+
+  /* Deflation. A negligible component of z deflates directly, and two
+     singular values which are close enough are combined by a rotation
+     of their left and right singular vectors which zeroes one of the
+     components of z. Undeflated columns are listed in idx[0..K-1] and
+     deflated ones in idx[n-1], idx[n-2], ... */
+
+  idx[0] = k;
+
+  for (i = 1; i < n; i++)
+    {
+      const size_t p = perm[i];
+
+      if (fabs (z[p]) <= tol)
+        {
+          idx[n - 1 - nd++] = p;
+          continue;
+        }
+
+      if (have_prev && d[p] - d[prev] <= tol)
+        {
+          double s = z[prev];
+          double c = z[p];
+          double tau = hypot (c, s);
+          gsl_vector_view up = gsl_matrix_column (U, prev);
+          gsl_vector_view uq = gsl_matrix_column (U, p);
+          gsl_vector_view wp = gsl_matrix_column (W, prev);
+          gsl_vector_view wq = gsl_matrix_column (W, p);
+
+          c /= tau;
+          s = -s / tau;
+          z[p] = tau;
+          z[prev] = 0.0;
+
+          gsl_blas_drot (&up.vector, &uq.vector, c, s);
+          gsl_blas_drot (&wp.vector, &wq.vector, c, s);
+
+          idx[n - 1 - nd++] = prev;
+          prev = p;
+          continue;
+        }
+
+      if (have_prev)
+        idx[K++] = prev;
+
+      prev = p;
+      have_prev = 1;
+    }
+
+  if (have_prev)
+    idx[K++] = prev;
+
+  for (j = 0; j < n; j++)
+    {
+      dlam[j] = d[idx[j]];
+    }
+
+  for (j = 0; j < K; j++)
+    {
+      w->work[j] = z[idx[j]];
+    }
+
+  for (j = 0; j < K; j++)
+    {
+      z[j] = w->work[j];
+    }
+
+  /* keep the smallest nonzero pole away from zero */
+
+  if (K > 1 && dlam[1] < 0.5 * tol)
+    dlam[1] = 0.5 * tol;
+
+  {
+    gsl_matrix_view D = gsl_matrix_submatrix (w->D, 0, 0, K, K);
+    gsl_matrix_view Q = gsl_matrix_submatrix (w->Q, 0, 0, K, K);
+    gsl_matrix_view G = gsl_matrix_submatrix (w->G, 0, 0, n, n);
+    gsl_matrix_view Gk = gsl_matrix_submatrix (w->G, 0, 0, n, K);
+
+    /* roots of the secular equation; column i of D holds the
+       differences dlam[j]^2 - sigma_i^2 */
+
+    for (i = 0; i < K; i++)
+      {
+        double *delta = w->work;
+
+        w->sigma[i] = svd_dc_secular (K, i, dlam, z, delta);
+
+        for (j = 0; j < K; j++)
+          {
+            gsl_matrix_set (&D.matrix, j, i, delta[j]);
+          }
+      }
+
+    /* recompute z from the singular values */
+
+    for (j = 0; j < K; j++)
+      {
+        double prod = gsl_matrix_get (&D.matrix, j, j);
+
+        for (i = 0; i < K; i++)
+          {
+            if (i != j)
+              prod *= gsl_matrix_get (&D.matrix, j, i)
+                / ((dlam[j] - dlam[i]) * (dlam[j] + dlam[i]));
+          }
+
+        zhat[j] = (z[j] < 0.0) ? -sqrt (-prod) : sqrt (-prod);
+      }
+
+    /* left singular vectors, u_0 = -1 and u_j = dlam_j zhat_j / delta_j */
+
+    for (j = 0; j < n; j++)
+      {
+        gsl_vector_view src = gsl_matrix_column (U, idx[j]);
+        gsl_vector_view dst = gsl_matrix_column (&G.matrix, j);
+        gsl_blas_dcopy (&src.vector, &dst.vector);
+      }
+
+    for (j = K; j < n; j++)
+      {
+        gsl_vector_view src = gsl_matrix_column (&G.matrix, j);
+        gsl_vector_view dst = gsl_matrix_column (U, j);
+        gsl_blas_dcopy (&src.vector, &dst.vector);
+      }
+
+    for (i = 0; i < K; i++)
+      {
+        gsl_vector_view qi = gsl_matrix_column (&Q.matrix, i);
+
+        gsl_matrix_set (&Q.matrix, 0, i, -1.0);
+
+        for (j = 1; j < K; j++)
+          {
+            gsl_matrix_set (&Q.matrix, j, i, dlam[j] * zhat[j]
+                            / gsl_matrix_get (&D.matrix, j, i));
+          }
+
+        gsl_blas_dscal (1.0 / gsl_blas_dnrm2 (&qi.vector), &qi.vector);
+      }
+
+    {
+      gsl_matrix_view Uk = gsl_matrix_submatrix (U, 0, 0, n, K);
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Gk.matrix, &Q.matrix,
+                      0.0, &Uk.matrix);
+    }
+
+    /* right singular vectors, v_j = zhat_j / delta_j */
+
+    for (j = 0; j < n; j++)
+      {
+        gsl_vector_view src = gsl_matrix_column (W, idx[j]);
+        gsl_vector_view dst = gsl_matrix_column (&G.matrix, j);
+        gsl_blas_dcopy (&src.vector, &dst.vector);
+      }
+
+    for (j = K; j < n; j++)
+      {
+        gsl_vector_view src = gsl_matrix_column (&G.matrix, j);
+        gsl_vector_view dst = gsl_matrix_column (W, j);
+        gsl_blas_dcopy (&src.vector, &dst.vector);
+      }
+
+    for (i = 0; i < K; i++)
+      {
+        gsl_vector_view qi = gsl_matrix_column (&Q.matrix, i);
+
+        for (j = 0; j < K; j++)
+          {
+            gsl_matrix_set (&Q.matrix, j, i, zhat[j]
+                            / gsl_matrix_get (&D.matrix, j, i));
+          }
+
+        gsl_blas_dscal (1.0 / gsl_blas_dnrm2 (&qi.vector), &qi.vector);
+      }
+
+    {
+      gsl_matrix_view Wk = gsl_matrix_submatrix (W, 0, 0, n, K);
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Gk.matrix, &Q.matrix,
+                      0.0, &Wk.matrix);
+    }
+  }
+
+  for (i = 0; i < K; i++)
+    {
+      d[i] = dmax * w->sigma[i];
+    }
+
+  for (j = K; j < n; j++)
+    {
+      d[j] = dmax * dlam[j];
+    }
+}
+
+/* Find the i-th root sigma of the secular equation
+
+     f(sigma) = 1 + \sum_j z_j^2 / (s_j^2 - sigma^2) = 0
+
+   for 0 = s_0 < s_1 < ... < s_{k-1}. The equation is solved for
+   sigma^2 exactly as in the eigenvalue case, as an offset from the
+   nearest pole s_o^2, with the distances to the poles computed as
+   (s_j - s_o) (s_j + s_o) so that they keep full relative accuracy.
+   On output delta[j] = s_j^2 - sigma^2. */
+
+static double
+svd_dc_secular (const size_t k, const size_t i, const double s[],
+                const double z[], double delta[])
+{
+  const size_t max_iter = 100;
+  size_t j, origin, iter;
+  double lo, hi, tau;
+
+  if (k == 1)
+    {
+      delta[0] = -z[0] * z[0];
+      return hypot (s[0], z[0]);
+    }
+
+  if (i < k - 1)
+    {
+      /* decide which half of (s_i^2, s_i+1^2) contains the root */
+
+      const double mid = 0.5 * (s[i + 1] - s[i]) * (s[i + 1] + s[i]);
+      double f = 1.0;
+
+      for (j = 0; j < k; j++)
+        {
+          f += z[j] * z[j] / ((s[j] - s[i]) * (s[j] + s[i]) - mid);
+        }
+
+      if (f >= 0.0)
+        {
+          origin = i;
+          lo = 0.0;
+          hi = mid;
+        }
+      else
+        {
+          origin = i + 1;
+          lo = -mid;
+          hi = 0.0;
+        }
+    }
+  else
+    {
+      double zz = 0.0;
+
+      for (j = 0; j < k; j++)
+        {
+          zz += z[j] * z[j];
+        }
+
+      origin = k - 1;
+      lo = 0.0;
+      hi = zz;
+    }
+
+  /* delta[j] holds s_j^2 - s_origin^2 during the iteration */
+
+  for (j = 0; j < k; j++)
+    {
+      delta[j] = (s[j] - s[origin]) * (s[j] + s[origin]);
+    }
+
+  tau = 0.5 * (lo + hi);
+
+  for (iter = 0; iter < max_iter; iter++)
+    {
+      double psi = 0.0, dpsi = 0.0, phi = 0.0, dphi = 0.0;
+      double f, eta, tau_new;
+      const double di = delta[i] - tau;
+
+      for (j = 0; j <= i; j++)
+        {
+          const double t = z[j] / (delta[j] - tau);
+          psi += z[j] * t;
+          dpsi += t * t;
+        }
+
+      for (j = i + 1; j < k; j++)
+        {
+          const double t = z[j] / (delta[j] - tau);
+          phi += z[j] * t;
+          dphi += t * t;
+        }
+
+      f = 1.0 + psi + phi;
+
+      if (fabs (f) <= GSL_DBL_EPSILON * (1.0 + fabs (psi) + fabs (phi)))
+        break;
+
+      if (f < 0.0)
+        lo = tau;
+      else
+        hi = tau;
+
+      if (hi - lo <= 2.0 * GSL_DBL_EPSILON * GSL_MAX_DBL (fabs (lo), fabs (hi)))
+        break;
+
+      if (i < k - 1)
+        {
+          /* f ~ c + q / (di - eta) + r / (dj - eta), with eta the
+             step from tau */
+          const double dj = delta[i + 1] - tau;
+          const double q = dpsi * di * di;
+          const double r = dphi * dj * dj;
+          const double c = 1.0 + (psi - q / di) + (phi - r / dj);
+          const double b = c * (di + dj) + q + r;
+          const double cc = di * dj * f;
+          const double disc = b * b - 4.0 * c * cc;
+
+          eta = GSL_NAN;
+
+          if (c == 0.0)
+            {
+              eta = cc / b;
+            }
+          else if (disc >= 0.0)
+            {
+              const double t = b + ((b < 0.0) ? -sqrt (disc) : sqrt (disc));
+              const double e1 = 2.0 * cc / t;
+              const double e2 = t / (2.0 * c);
+
+              eta = (e1 > di && e1 < dj) ? e1 : e2;
+            }
+        }
+      else
+        {
+          /* f ~ c + q / (di - eta) */
+          const double q = dpsi * di * di;
+          const double c = 1.0 + (psi - q / di);
+
+          eta = (c > 0.0) ? di + q / c : GSL_NAN;
+        }
+
+      tau_new = tau + eta;
+
+      if (!(tau_new > lo && tau_new < hi))
+        tau_new = 0.5 * (lo + hi);
+
+      tau = tau_new;
+    }
+
+  for (j = 0; j < k; j++)
+    {
+      delta[j] -= tau;
+    }
+
+  return sqrt ((s[origin] * s[origin]) + tau);
+}
+
+/* C := H_0 H_1 ... H_{nrefl-1} C, where H_j = I - tau_j h_j h_j^T and
+   h_j has a unit element in position j + shift followed by the
+   elements of column j of A below row j + shift or, if rowwise is
+   set, the elements of row j of A to the right of column j + shift.
+   The reflectors are applied in blocks as I - V T V^T (LAPACK
+   DLARFT/DLARFB). VT must have as many rows as C and 2 * SVD_DC_BLOCK
+   columns, Wk SVD_DC_BLOCK rows and as many columns as C. */
+
+static void
+svd_dc_apply_householder (const gsl_matrix * A, const double tau[],
+                          const size_t nrefl, const size_t shift,
+                          const int rowwise, gsl_matrix * C,
+                          gsl_matrix * VT, gsl_matrix * Wk)
+{
+  const size_t nb = SVD_DC_BLOCK;
+  const size_t ncol = C->size2;
+  size_t j0;
+
+  if (nrefl == 0)
+    return;
+
+  /* the last block is applied first */
+
+  j0 = ((nrefl - 1) / nb) * nb;
+
+  while (1)
+    {
+      const size_t kb = GSL_MIN (nb, nrefl - j0);
+      const size_t m = C->size1 - j0 - shift;
+      gsl_matrix_view V = gsl_matrix_submatrix (VT, 0, 0, m, kb);
+      gsl_matrix_view T = gsl_matrix_submatrix (VT, 0, nb, kb, kb);
+      gsl_matrix_view Wt = gsl_matrix_submatrix (Wk, 0, 0, kb, ncol);
+      gsl_matrix_view Cs = gsl_matrix_submatrix (C, j0 + shift, 0, m, ncol);
+      size_t r, c;
+
+      for (r = 0; r < m; r++)
+        {
+          for (c = 0; c < kb; c++)
+            {
+              double vrc;
+
+              if (r < c)
+                vrc = 0.0;
+              else if (r == c)
+                vrc = 1.0;
+              else if (rowwise)
+                vrc = gsl_matrix_get (A, j0 + c, j0 + shift + r);
+              else
+                vrc = gsl_matrix_get (A, j0 + shift + r, j0 + c);
+
+              gsl_matrix_set (&V.matrix, r, c, vrc);
+            }
+        }
+
+      gsl_matrix_set_zero (&T.matrix);
+
+      for (c = 0; c < kb; c++)
+        {
+          const double tc = tau[j0 + c];
+
+          gsl_matrix_set (&T.matrix, c, c, tc);
+
+          if (c > 0)
+            {
+              /* T(0:c,c) = -tau_c T(0:c,0:c) V(:,0:c)^T v_c */
+              gsl_matrix_view Vp = gsl_matrix_submatrix (&V.matrix, 0, 0, m, c);
+              gsl_vector_view vc = gsl_matrix_column (&V.matrix, c);
+              gsl_matrix_view Tp = gsl_matrix_submatrix (&T.matrix, 0, 0, c, c);
+              gsl_vector_view t = gsl_matrix_subcolumn (&T.matrix, c, 0, c);
+
+              gsl_blas_dgemv (CblasTrans, -tc, &Vp.matrix, &vc.vector, 0.0, &t.vector);
+              gsl_blas_dtrmv (CblasUpper, CblasNoTrans, CblasNonUnit, &Tp.matrix, &t.vector);
+            }
+        }
+
+      /* C := C - V T V^T C */
+
+      gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, &V.matrix, &Cs.matrix, 0.0, &Wt.matrix);
+      gsl_blas_dtrmm (CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, &T.matrix, &Wt.matrix);
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, -1.0, &V.matrix, &Wt.matrix, 1.0, &Cs.matrix);
+
+      if (j0 == 0)
+        break;
+
+      j0 -= nb;
+    }
+}
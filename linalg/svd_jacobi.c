@@ -0,0 +1,420 @@
+/* linalg/svd_jacobi.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Block one-sided Jacobi SVD.
+ *
+ * This is the one-sided Jacobi method of gsl_linalg_SV_decomp_jacobi()
+ * (Nash; Demmel and Veselic, LAWN 15) with a different ordering of the
+ * column pairs. The columns are divided into an even number of blocks
+ * of JACOBI_BLOCK columns. Each sweep first orthogonalizes the columns
+ * within every block, then visits all pairs of blocks in the
+ * round-robin (tournament) ordering, in which each step pairs every
+ * block with exactly one other block. The pairs of one step act on
+ * disjoint columns and are processed concurrently.
+ *
+ * The algorithm works on the transpose of A and of V, so that each
+ * column is a contiguous row and the rotations are simple loops over
+ * contiguous arrays which the compiler can vectorize. Every pair of
+ * columns is still visited once per sweep, in an order which does not
+ * depend on the number of threads, so the result is the same for any
+ * number of threads.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_cblas.h>
+
+#include "tiled.h"
+
+/* number of columns in a block */
+#define JACOBI_BLOCK 16
+
+/* task types */
+#define JACOBI_START 0   /* no-op task which starts a sweep */
+#define JACOBI_DIAG  1   /* pairs within block i */
+#define JACOBI_PAIR  2   /* pairs between blocks i < j */
+
+typedef struct
+{
+  double *B;            /* A^T, N-by-M, row j is column j of A */
+  double *W;            /* V^T, N-by-N */
+  double *err;          /* column error estimates, length N */
+  size_t *nrot;         /* rotations performed by the task of block i */
+  size_t M;
+  size_t N;
+  size_t nb;            /* number of blocks, even */
+  double tolerance;
+  size_t step;          /* current step of the sweep, 0 = diagonal blocks */
+  size_t ndone;         /* tasks of the current step completed */
+  size_t count;         /* rotations performed in the sweep */
+} jacobi_params;
+
+static int jacobi_rotate (double * x, double * y, double * vx, double * vy,
+                          double * errx, double * erry, const size_t M,
+                          const size_t N, const double tolerance);
+static void jacobi_push_step (const jacobi_params * params, linalg_tiled_sched * sched);
+static int jacobi_run (const linalg_tiled_task * task, void * params);
+static void jacobi_done (const linalg_tiled_task * task, void * params,
+                         linalg_tiled_sched * sched);
+
+/*
+gsl_linalg_SV_decomp_jacobi_tiled()
+  Compute the SVD of a matrix with the block one-sided Jacobi
+method, using several threads
+
+Inputs: A        - (input) M-by-N matrix, M >= N
+                   (output) M-by-N matrix U
+        V        - (output) N-by-N matrix of right singular vectors
+        S        - (output) singular values, length N, in decreasing order
+        nthreads - number of threads
+
+Return: success/error
+
+Notes:
+1) The rotations and the convergence test are the same as in
+gsl_linalg_SV_decomp_jacobi(), so the singular values have the same
+high relative accuracy, except that the column error estimates are
+propagated as the norms of the rotated error vectors. The bound
+|c| e_x + |s| e_y of gsl_linalg_SV_decomp_jacobi() grows with each
+rotation, and for large matrices marks the columns as noise before
+they are orthogonal
+
+2) Additional storage of M*N + N*N elements is allocated for the
+transposes of A and V
+*/
+
+int
+gsl_linalg_SV_decomp_jacobi_tiled (gsl_matrix * A, gsl_matrix * V,
+                                   gsl_vector * S, const size_t nthreads)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+
+  if (M < N)
+    {
+      GSL_ERROR ("svd of MxN matrix, M<N, is not implemented", GSL_EUNIMPL);
+    }
+  else if (V->size1 != N)
+    {
+      GSL_ERROR ("square matrix V must match second dimension of matrix A",
+                 GSL_EBADLEN);
+    }
+  else if (V->size1 != V->size2)
+    {
+      GSL_ERROR ("matrix V must be square", GSL_ENOTSQR);
+    }
+  else if (S->size != N)
+    {
+      GSL_ERROR ("length of vector S must match second dimension of matrix A",
+                 GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t nb = 2 * ((N + 2 * JACOBI_BLOCK - 1) / (2 * JACOBI_BLOCK));
+      const size_t ntasks = 1 + nb + (nb - 1) * (nb / 2);
+      const int sweepmax = GSL_MAX (5 * (int) N, 12);
+      int sweep = 0;
+      int status = GSL_SUCCESS;
+      gsl_matrix *B = gsl_matrix_alloc (N, M);
+      gsl_matrix *W = gsl_matrix_alloc (N, N);
+      jacobi_params params;
+      linalg_tiled_task task0;
+      double prev_norm = -1.0;
+      size_t j;
+
+      params.err = malloc (N * sizeof (double));
+      params.nrot = malloc (nb * sizeof (size_t));
+
+      if (B == NULL || W == NULL || params.err == NULL || params.nrot == NULL)
+        {
+          gsl_matrix_free (B);
+          gsl_matrix_free (W);
+          free (params.err);
+          free (params.nrot);
+          GSL_ERROR ("failed to allocate space for Jacobi workspace", GSL_ENOMEM);
+        }
+
+      gsl_matrix_transpose_memcpy (B, A);
+      gsl_matrix_set_identity (W);
+
+      params.B = B->data;
+      params.W = W->data;
+      params.M = M;
+      params.N = N;
+      params.nb = nb;
+      params.tolerance = 10 * M * GSL_DBL_EPSILON;
+      params.count = 1;
+
+      /* store the column error estimates, for use during the
+       * orthogonalization */
+      for (j = 0; j < N; ++j)
+        params.err[j] = GSL_DBL_EPSILON * cblas_dnrm2 ((int) M, B->data + j * M, 1);
+
+      task0.type = JACOBI_START;
+      task0.i = task0.j = task0.k = 0;
+
+      while (params.count > 0 && sweep <= sweepmax)
+        {
+          params.step = 0;
+          params.ndone = 0;
+          params.count = 0;
+
+          status = linalg_tiled_execute (nthreads, ntasks, &task0, jacobi_run,
+                                         jacobi_done, &params);
+          if (status)
+            break;
+
+          ++sweep;
+        }
+
+      /* compute the singular values, using the criteria of the sweeps to
+       * detect zero singular values */
+      for (j = 0; j < N && status == GSL_SUCCESS; ++j)
+        {
+          double *bj = B->data + j * M;
+          double norm = cblas_dnrm2 ((int) M, bj, 1);
+
+          if (norm == 0.0 || prev_norm == 0.0
+              || (j > 0 && norm <= params.tolerance * prev_norm))
+            {
+              gsl_vector_set (S, j, 0.0);
+              cblas_dscal ((int) M, 0.0, bj, 1);
+              prev_norm = 0.0;
+            }
+          else
+            {
+              gsl_vector_set (S, j, norm);
+              cblas_dscal ((int) M, 1.0 / norm, bj, 1);
+              prev_norm = norm;
+            }
+        }
+
+      if (status == GSL_SUCCESS)
+        {
+          gsl_matrix_transpose_memcpy (A, B);
+          gsl_matrix_transpose_memcpy (V, W);
+        }
+
+      gsl_matrix_free (B);
+      gsl_matrix_free (W);
+      free (params.err);
+      free (params.nrot);
+
+      if (status)
+        return status;
+
+      if (params.count > 0)
+        {
+          /* reached sweep limit */
+          GSL_ERROR ("Jacobi iterations did not reach desired tolerance",
+                     GSL_ETOL);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+jacobi_rotate()
+  Orthogonalize the columns x and y, x before y, of A with a plane
+rotation, which is also applied to the columns vx and vy of V
+
+Return: 1 if a rotation was applied, 0 if the columns are already
+orthogonal and sorted or dominated by rounding errors
+*/
+
+static int
+jacobi_rotate (double * x, double * y, double * vx, double * vy,
+               double * errx, double * erry, const size_t M,
+               const size_t N, const double tolerance)
+{
+  const double small = M * GSL_DBL_MIN / GSL_DBL_EPSILON;
+  double a2 = 0.0, b2 = 0.0, p = 0.0;
+  double a, b, q, v, cosine, sine;
+  double abserr_a = *errx, abserr_b = *erry;
+  int sorted, orthog, noisya, noisyb;
+  size_t i;
+
+  for (i = 0; i < M; ++i)
+    {
+      p += x[i] * y[i];
+      a2 += x[i] * x[i];
+      b2 += y[i] * y[i];
+    }
+
+  /* the sums of squares are accurate unless they overflow or lose
+   * precision through underflow; use the scaled BLAS norms then */
+  if (a2 <= GSL_DBL_MAX && b2 <= GSL_DBL_MAX
+      && (a2 == 0.0 || a2 > small) && (b2 == 0.0 || b2 > small))
+    {
+      a = sqrt (a2);
+      b = sqrt (b2);
+    }
+  else
+    {
+      a = cblas_dnrm2 ((int) M, x, 1);
+      b = cblas_dnrm2 ((int) M, y, 1);
+      p = cblas_ddot ((int) M, x, 1, y, 1);
+    }
+
+  p *= 2.0;  /* equation 9a:  p = 2 x.y */
+  q = a * a - b * b;
+  v = hypot (p, q);
+
+  /* test for columns orthogonal, or dominant errors */
+  sorted = (GSL_COERCE_DBL (a) >= GSL_COERCE_DBL (b));
+  orthog = (fabs (p) <= tolerance * GSL_COERCE_DBL (a * b));
+  noisya = (a < abserr_a);
+  noisyb = (b < abserr_b);
+
+  if (sorted && (orthog || noisya || noisyb))
+    return 0;
+
+  /* calculate rotation angles */
+  if (v == 0 || !sorted)
+    {
+      cosine = 0.0;
+      sine = 1.0;
+    }
+  else
+    {
+      cosine = sqrt ((v + q) / (2.0 * v));
+      sine = p / (2.0 * v * cosine);
+    }
+
+  for (i = 0; i < M; ++i)
+    {
+      const double xi = x[i];
+      const double yi = y[i];
+
+      x[i] = xi * cosine + yi * sine;
+      y[i] = -xi * sine + yi * cosine;
+    }
+
+  /* the errors of x and y are rotated with the columns, which
+   * preserves the sum of their squares */
+  *errx = hypot (cosine * abserr_a, sine * abserr_b);
+  *erry = hypot (sine * abserr_a, cosine * abserr_b);
+
+  for (i = 0; i < N; ++i)
+    {
+      const double xi = vx[i];
+      const double yi = vy[i];
+
+      vx[i] = xi * cosine + yi * sine;
+      vy[i] = -xi * sine + yi * cosine;
+    }
+
+  return 1;
+}
+
+/* push the tasks of the current step of the sweep */
+static void
+jacobi_push_step (const jacobi_params * params, linalg_tiled_sched * sched)
+{
+  const size_t nb = params->nb;
+  size_t i;
+
+  if (params->step == 0)
+    {
+      for (i = 0; i < nb; ++i)
+        linalg_tiled_push (sched, JACOBI_DIAG, i, i, 0);
+    }
+  else
+    {
+      /* round-robin pairing: block 0 is fixed and blocks 1..nb-1 are
+       * rotated by one position at each step */
+      const size_t r = params->step - 1;
+
+      for (i = 0; i < nb / 2; ++i)
+        {
+          size_t pi = (i == 0) ? 0 : 1 + (i - 1 + r) % (nb - 1);
+          size_t pj = 1 + (nb - 2 - i + r) % (nb - 1);
+
+          linalg_tiled_push (sched, JACOBI_PAIR, GSL_MIN (pi, pj),
+                             GSL_MAX (pi, pj), params->step);
+        }
+    }
+}
+
+static int
+jacobi_run (const linalg_tiled_task * task, void * params)
+{
+  jacobi_params *p = (jacobi_params *) params;
+  const size_t M = p->M;
+  const size_t N = p->N;
+  size_t j, k, jmin, jmax, kmin, kmax;
+  size_t nrot = 0;
+
+  if (task->type == JACOBI_START)
+    return GSL_SUCCESS;
+
+  jmin = GSL_MIN (task->i * JACOBI_BLOCK, N);
+  jmax = GSL_MIN (jmin + JACOBI_BLOCK, N);
+  kmin = GSL_MIN (task->j * JACOBI_BLOCK, N);
+  kmax = GSL_MIN (kmin + JACOBI_BLOCK, N);
+
+  for (j = jmin; j < jmax; ++j)
+    {
+      /* within a diagonal block only the pairs j < k are visited */
+      for (k = (task->type == JACOBI_DIAG) ? j + 1 : kmin; k < kmax; ++k)
+        {
+          nrot += jacobi_rotate (p->B + j * M, p->B + k * M,
+                                 p->W + j * N, p->W + k * N,
+                                 &p->err[j], &p->err[k], M, N, p->tolerance);
+        }
+    }
+
+  p->nrot[task->i] = nrot;
+
+  return GSL_SUCCESS;
+}
+
+static void
+jacobi_done (const linalg_tiled_task * task, void * params,
+             linalg_tiled_sched * sched)
+{
+  jacobi_params *p = (jacobi_params *) params;
+  const size_t nstep = (p->step == 0) ? p->nb : p->nb / 2;
+
+  if (task->type == JACOBI_START)
+    {
+      jacobi_push_step (p, sched);
+      return;
+    }
+
+  p->count += p->nrot[task->i];
+
+  /* start the next step when all tasks of this one are complete */
+  if (++(p->ndone) == nstep && p->step < p->nb - 1)
+    {
+      ++(p->step);
+      p->ndone = 0;
+      jacobi_push_step (p, sched);
+    }
+}
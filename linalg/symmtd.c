@@ -60,6 +60,18 @@
 
 #include <gsl/gsl_linalg.h>
 
+/* number of columns reduced per panel by the blocked algorithm */
+#define SYMMTD_BLOCK 32
+
+/* the blocked algorithm is used while more than this many columns
+ * remain to be reduced */
+#define SYMMTD_CROSSOVER 128
+
+static int symmtd_decomp_L2 (gsl_matrix * A, const size_t i0, gsl_vector * tau);
+static int symmtd_decomp_L3 (gsl_matrix * A, gsl_vector * tau);
+static void symmtd_panel (gsl_matrix * A, const size_t nb, gsl_vector * tau,
+                          gsl_matrix * W, gsl_vector * work);
+
 int 
 gsl_linalg_symmtd_decomp (gsl_matrix * A, gsl_vector * tau)  
 {
@@ -74,48 +86,218 @@ gsl_linalg_symmtd_decomp (gsl_matrix * A, gsl_vector * tau)
     }
   else
     {
-      const size_t N = A->size1;
-      size_t i;
-  
-      for (i = 0 ; i < N - 2; i++)
+      if (A->size1 > SYMMTD_CROSSOVER)
         {
-          gsl_vector_view c = gsl_matrix_column (A, i);
-          gsl_vector_view v = gsl_vector_subvector (&c.vector, i + 1, N - (i + 1));
-          double tau_i = gsl_linalg_householder_transform (&v.vector);
+          int status = symmtd_decomp_L3 (A, tau);
+
+          if (status != GSL_ENOMEM)
+            return status;
+
+          /* not enough memory for the panel workspace, fall through to
+           * the unblocked algorithm */
+        }
+
+      return symmtd_decomp_L2 (A, 0, tau);
+    }
+}  
+
+/* reduce columns i0 and beyond, one column at a time with a symmetric
+ * rank-2 update of the remaining matrix */
+
+static int
+symmtd_decomp_L2 (gsl_matrix * A, const size_t i0, gsl_vector * tau)
+{
+  const size_t N = A->size1;
+  size_t i;
+
+  for (i = i0 ; i + 2 < N; i++)
+    {
+      gsl_vector_view c = gsl_matrix_column (A, i);
+      gsl_vector_view v = gsl_vector_subvector (&c.vector, i + 1, N - (i + 1));
+      double tau_i = gsl_linalg_householder_transform (&v.vector);
+      
+      /* Apply the transformation H^T A H to the remaining columns */
+
+      if (tau_i != 0.0) 
+        {
+          gsl_matrix_view m = gsl_matrix_submatrix (A, i + 1, i + 1, 
+                                                    N - (i+1), N - (i+1));
+          double ei = gsl_vector_get(&v.vector, 0);
+          gsl_vector_view x = gsl_vector_subvector (tau, i, N-(i+1));
+          gsl_vector_set (&v.vector, 0, 1.0);
           
-          /* Apply the transformation H^T A H to the remaining columns */
-
-          if (tau_i != 0.0) 
-            {
-              gsl_matrix_view m = gsl_matrix_submatrix (A, i + 1, i + 1, 
-                                                        N - (i+1), N - (i+1));
-              double ei = gsl_vector_get(&v.vector, 0);
-              gsl_vector_view x = gsl_vector_subvector (tau, i, N-(i+1));
-              gsl_vector_set (&v.vector, 0, 1.0);
-              
-              /* x = tau * A * v */
-              gsl_blas_dsymv (CblasLower, tau_i, &m.matrix, &v.vector, 0.0, &x.vector);
-
-              /* w = x - (1/2) tau * (x' * v) * v  */
-              {
-                double xv, alpha;
-                gsl_blas_ddot(&x.vector, &v.vector, &xv);
-                alpha = - (tau_i / 2.0) * xv;
-                gsl_blas_daxpy(alpha, &v.vector, &x.vector);
-              }
-              
-              /* apply the transformation A = A - v w' - w v' */
-              gsl_blas_dsyr2(CblasLower, -1.0, &v.vector, &x.vector, &m.matrix);
-
-              gsl_vector_set (&v.vector, 0, ei);
-            }
+          /* x = tau * A * v */
+          gsl_blas_dsymv (CblasLower, tau_i, &m.matrix, &v.vector, 0.0, &x.vector);
+
+          /* w = x - (1/2) tau * (x' * v) * v  */
+          {
+            double xv, alpha;
+            gsl_blas_ddot(&x.vector, &v.vector, &xv);
+            alpha = - (tau_i / 2.0) * xv;
+            gsl_blas_daxpy(alpha, &v.vector, &x.vector);
+          }
           
-          gsl_vector_set (tau, i, tau_i);
+          /* apply the transformation A = A - v w' - w v' */
+          gsl_blas_dsyr2(CblasLower, -1.0, &v.vector, &x.vector, &m.matrix);
+
+          gsl_vector_set (&v.vector, 0, ei);
         }
       
-      return GSL_SUCCESS;
+      gsl_vector_set (tau, i, tau_i);
     }
-}  
+  
+  return GSL_SUCCESS;
+}
+
+/* Blocked reduction (LAPACK dsytrd/dlatrd). The columns are reduced in
+ * panels of SYMMTD_BLOCK. Within a panel the reflectors are applied
+ * only to the columns being reduced, and the vectors w which the
+ * unblocked algorithm would use in its rank-2 updates are collected as
+ * the columns of a matrix W. The rest of the matrix is then updated
+ * with the single rank-2k update
+ *
+ *   A := A - V W^T - W V^T
+ *
+ * so that half of the flops are done by dsyr2k. The last
+ * SYMMTD_CROSSOVER columns are reduced by symmtd_decomp_L2. */
+
+static int
+symmtd_decomp_L3 (gsl_matrix * A, gsl_vector * tau)
+{
+  const size_t N = A->size1;
+  gsl_matrix *work = gsl_matrix_alloc (N, SYMMTD_BLOCK);
+  gsl_vector *vwork = gsl_vector_alloc (2 * N);
+  size_t i = 0;
+
+  if (work == 0 || vwork == 0)
+    {
+      if (work)
+        gsl_matrix_free (work);
+      if (vwork)
+        gsl_vector_free (vwork);
+
+      return GSL_ENOMEM;
+    }
+
+  while (N - i > SYMMTD_CROSSOVER)
+    {
+      const size_t n = N - i;
+      const size_t nb = GSL_MIN (SYMMTD_BLOCK, n - SYMMTD_CROSSOVER);
+      gsl_matrix_view m = gsl_matrix_submatrix (A, i, i, n, n);
+      gsl_vector_view t = gsl_vector_subvector (tau, i, nb);
+      gsl_matrix_view W = gsl_matrix_submatrix (work, 0, 0, n, nb);
+      double e[SYMMTD_BLOCK];
+      size_t j;
+
+      /* the panel leaves the unit elements of its Householder vectors
+       * in place on the subdiagonal for the rank-2k update */
+
+      symmtd_panel (&m.matrix, nb, &t.vector, &W.matrix, vwork);
+
+      for (j = 0; j < nb; j++)
+        e[j] = gsl_matrix_get (&W.matrix, j, j);
+
+      {
+        gsl_matrix_view V = gsl_matrix_submatrix (&m.matrix, nb, 0, n - nb, nb);
+        gsl_matrix_view W2 = gsl_matrix_submatrix (&W.matrix, nb, 0, n - nb, nb);
+        gsl_matrix_view A22 = gsl_matrix_submatrix (&m.matrix, nb, nb, n - nb, n - nb);
+
+        gsl_blas_dsyr2k (CblasLower, CblasNoTrans, -1.0, &V.matrix, &W2.matrix,
+                         1.0, &A22.matrix);
+      }
+
+      for (j = 0; j < nb; j++)
+        gsl_matrix_set (&m.matrix, j + 1, j, e[j]);
+
+      i += nb;
+    }
+
+  gsl_matrix_free (work);
+  gsl_vector_free (vwork);
+
+  return symmtd_decomp_L2 (A, i, tau);
+}
+
+/* reduce the first nb columns of the n-by-n matrix A and compute the
+ * n-by-nb matrix W such that the remaining matrix is updated by
+ * A(nb:n,nb:n) -= V W^T + W V^T. On output the subdiagonal elements
+ * A(j+1,j) are set to 1, and the elements of the tridiagonal matrix
+ * which belong there are stored in W(j,j). The vector work, of length
+ * at least 2n, holds contiguous copies of v and w for dsymv */
+
+static void
+symmtd_panel (gsl_matrix * A, const size_t nb, gsl_vector * tau, gsl_matrix * W,
+              gsl_vector * work)
+{
+  const size_t n = A->size1;
+  size_t i;
+
+  for (i = 0; i < nb; i++)
+    {
+      gsl_vector_view c = gsl_matrix_subcolumn (A, i, i, n - i);
+      gsl_vector_view wc = gsl_matrix_column (W, i);
+      double tau_i, xv;
+
+      /* bring column i up to date with the previous reflectors,
+       * A(i:n,i) -= V(i:n,0:i) W(i,0:i)^T + W(i:n,0:i) V(i,0:i)^T */
+
+      if (i > 0)
+        {
+          gsl_matrix_view Vi = gsl_matrix_submatrix (A, i, 0, n - i, i);
+          gsl_matrix_view Wi = gsl_matrix_submatrix (W, i, 0, n - i, i);
+          gsl_vector_view vr = gsl_matrix_subrow (A, i, 0, i);
+          gsl_vector_view wr = gsl_matrix_subrow (W, i, 0, i);
+
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Vi.matrix, &wr.vector, 1.0, &c.vector);
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Wi.matrix, &vr.vector, 1.0, &c.vector);
+        }
+
+      /* Householder transformation for A(i+1:n,i) */
+
+      {
+        gsl_vector_view v = gsl_vector_subvector (&c.vector, 1, n - i - 1);
+        gsl_vector_view w = gsl_vector_subvector (&wc.vector, i + 1, n - i - 1);
+        gsl_vector_view vt = gsl_vector_subvector (work, 0, n - i - 1);
+        gsl_vector_view wt = gsl_vector_subvector (work, n, n - i - 1);
+
+        tau_i = gsl_linalg_householder_transform (&v.vector);
+        gsl_vector_set (tau, i, tau_i);
+
+        gsl_matrix_set (W, i, i, gsl_vector_get (&v.vector, 0));
+        gsl_vector_set (&v.vector, 0, 1.0);
+
+        /* w = tau (A - V W^T - W V^T) v, with A the trailing part of
+         * the matrix which has not yet been updated */
+
+        {
+          gsl_matrix_view m = gsl_matrix_submatrix (A, i + 1, i + 1, n - i - 1, n - i - 1);
+
+          gsl_blas_dcopy (&v.vector, &vt.vector);
+          gsl_blas_dsymv (CblasLower, 1.0, &m.matrix, &vt.vector, 0.0, &wt.vector);
+          gsl_blas_dcopy (&wt.vector, &w.vector);
+        }
+
+        if (i > 0)
+          {
+            gsl_matrix_view Vi = gsl_matrix_submatrix (A, i + 1, 0, n - i - 1, i);
+            gsl_matrix_view Wi = gsl_matrix_submatrix (W, i + 1, 0, n - i - 1, i);
+            gsl_vector_view t = gsl_vector_subvector (&wc.vector, 0, i);
+
+            gsl_blas_dgemv (CblasTrans, 1.0, &Wi.matrix, &v.vector, 0.0, &t.vector);
+            gsl_blas_dgemv (CblasNoTrans, -1.0, &Vi.matrix, &t.vector, 1.0, &w.vector);
+            gsl_blas_dgemv (CblasTrans, 1.0, &Vi.matrix, &v.vector, 0.0, &t.vector);
+            gsl_blas_dgemv (CblasNoTrans, -1.0, &Wi.matrix, &t.vector, 1.0, &w.vector);
+          }
+
+        gsl_blas_dscal (tau_i, &w.vector);
+
+        /* w = w - (1/2) tau (w' v) v */
+
+        gsl_blas_ddot (&w.vector, &v.vector, &xv);
+        gsl_blas_daxpy (-0.5 * tau_i * xv, &v.vector, &w.vector);
+      }
+    }
+}
 
 
 /*  Form the orthogonal matrix Q from the packed QR matrix */
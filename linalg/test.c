@@ -395,6 +395,7 @@ gsl_matrix * moler10;
 #include "test_luc.c"
 #include "test_lq.c"
 #include "test_qr.c"
+#include "test_qrc.c"
 
 int
 test_QR_solve_dim(const gsl_matrix * m, const double * actual, double eps)
@@ -1155,6 +1156,111 @@ int test_QRPT_decomp(void)
 }
 
 
+/* factor a random M-by-N matrix of the given rank, large enough for
+ * the blocked algorithm. Since Q is orthogonal, A P = Q R implies
+ * (A P)^T (A P) = R^T R, which is checked without forming Q, along
+ * with the ordering of the diagonal of R and the rank */
+static int
+test_QRPT_decomp_random(const size_t M, const size_t N, const size_t rank,
+                        const double eps, gsl_rng * r)
+{
+  int s = 0, signum;
+  const size_t K = GSL_MIN(M, N);
+  size_t i, j;
+
+  gsl_matrix * m = gsl_matrix_alloc(M, N);
+  gsl_matrix * QR = gsl_matrix_alloc(M, N);
+  gsl_matrix * AP = gsl_matrix_alloc(M, N);
+  gsl_matrix * R = gsl_matrix_calloc(M, N);
+  gsl_matrix * G1 = gsl_matrix_alloc(N, N);
+  gsl_matrix * G2 = gsl_matrix_alloc(N, N);
+  gsl_matrix * X = gsl_matrix_alloc(M, rank);
+  gsl_matrix * Y = gsl_matrix_alloc(rank, N);
+  gsl_vector * tau = gsl_vector_alloc(K);
+  gsl_vector * norm = gsl_vector_alloc(N);
+  gsl_permutation * perm = gsl_permutation_alloc(N);
+
+  create_random_matrix(X, r);
+  create_random_matrix(Y, r);
+  gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, X, Y, 0.0, m);
+
+  gsl_matrix_memcpy(QR, m);
+  s += gsl_linalg_QRPT_decomp(QR, tau, perm, &signum, norm);
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          gsl_matrix_set(AP, i, j, gsl_matrix_get(m, i, gsl_permutation_get(perm, j)));
+
+          if (j >= i)
+            gsl_matrix_set(R, i, j, gsl_matrix_get(QR, i, j));
+        }
+    }
+
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, R, R, 0.0, G1);
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, AP, AP, 0.0, G2);
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double g1 = gsl_matrix_get(G1, i, j);
+          double g2 = gsl_matrix_get(G2, i, j);
+          double scale = sqrt(gsl_matrix_get(G2, i, i) * gsl_matrix_get(G2, j, j));
+
+          gsl_test_abs(g1, g2, eps * scale,
+                       "QRPT_decomp random (%3zu,%3zu) rank %zu R^T R [%zu,%zu]",
+                       M, N, rank, i, j);
+        }
+    }
+
+  for (i = 1; i < K; i++)
+    {
+      double rii = fabs(gsl_matrix_get(QR, i, i));
+      double rprev = fabs(gsl_matrix_get(QR, i - 1, i - 1));
+
+      s += (rii > rprev * (1.0 + eps));
+    }
+
+  s += (gsl_linalg_QRPT_rank(QR, -1.0) != rank);
+
+  gsl_matrix_free(m);
+  gsl_matrix_free(QR);
+  gsl_matrix_free(AP);
+  gsl_matrix_free(R);
+  gsl_matrix_free(G1);
+  gsl_matrix_free(G2);
+  gsl_matrix_free(X);
+  gsl_matrix_free(Y);
+  gsl_vector_free(tau);
+  gsl_vector_free(norm);
+  gsl_permutation_free(perm);
+
+  return s;
+}
+
+static int
+test_QRPT_decomp_r(gsl_rng * r)
+{
+  int f;
+  int s = 0;
+
+  f = test_QRPT_decomp_random(230, 190, 190, 1.0e5 * GSL_DBL_EPSILON, r);
+  gsl_test(f, "  QRPT_decomp random(230,190)");
+  s += f;
+
+  f = test_QRPT_decomp_random(190, 230, 190, 1.0e5 * GSL_DBL_EPSILON, r);
+  gsl_test(f, "  QRPT_decomp random(190,230)");
+  s += f;
+
+  f = test_QRPT_decomp_random(250, 210, 70, 1.0e5 * GSL_DBL_EPSILON, r);
+  gsl_test(f, "  QRPT_decomp random(250,210) rank 70");
+  s += f;
+
+  return s;
+}
+
 int
 test_QR_update_dim(const gsl_matrix * m, double eps)
 {
@@ -2331,6 +2437,339 @@ int test_SV_decomp_jacobi(void)
   return s;
 }
 
+/* SVD routine under test: A is replaced by U, using nthreads threads
+ * if the routine supports them */
+typedef int (*test_SV_decomp_fn)(gsl_matrix * A, gsl_matrix * V,
+                                   gsl_vector * S, const size_t nthreads);
+
+static int
+test_SV_decomp_dc_func(gsl_matrix * A, gsl_matrix * V, gsl_vector * S,
+                       const size_t nthreads)
+{
+  (void) nthreads;
+  return gsl_linalg_SV_decomp_dc(A, V, S);
+}
+
+static int
+test_SV_decomp_jacobi_tiled_func(gsl_matrix * A, gsl_matrix * V, gsl_vector * S,
+                                 const size_t nthreads)
+{
+  return gsl_linalg_SV_decomp_jacobi_tiled(A, V, S, nthreads);
+}
+
+/* compute the SVD of m with decomp and check A = U S V^T, the ordering
+ * of S and the orthogonality of U and V. With nthreads > 1, S must also
+ * be the same as with one thread. If u_scaled is set, U^T U = I is only
+ * checked up to eps ||A|| / min(s_i,s_j), as the columns of U of the
+ * Jacobi methods are normalized columns of A V */
+static int
+test_SV_decomp_func_dim(const gsl_matrix * m, test_SV_decomp_fn decomp,
+                        const size_t nthreads, const int u_scaled, double eps)
+{
+  int s = 0;
+  double norm = 0.0;
+  size_t i, j, M = m->size1, N = m->size2;
+
+  gsl_matrix * u  = gsl_matrix_alloc(M, N);
+  gsl_matrix * a  = gsl_matrix_alloc(M, N);
+  gsl_matrix * v  = gsl_matrix_alloc(N, N);
+  gsl_matrix * vs = gsl_matrix_alloc(N, N);
+  gsl_matrix * I  = gsl_matrix_alloc(N, N);
+  gsl_vector * S = gsl_vector_alloc(N);
+  gsl_vector * S1 = gsl_vector_alloc(N);
+
+  if (nthreads > 1)
+    {
+      gsl_matrix_memcpy(u, m);
+      s += decomp(u, v, S1, 1);
+    }
+
+  gsl_matrix_memcpy(u, m);
+  s += decomp(u, v, S, nthreads);
+
+  for (i = 0; i < N; i++)
+    {
+      double si = gsl_vector_get(S, i);
+
+      if (si < 0.0 || (i > 0 && si > gsl_vector_get(S, i - 1)))
+        {
+          s++;
+          printf("singular value %zu = %22.18g out of order\n", i, si);
+        }
+
+      if (nthreads > 1 && si != gsl_vector_get(S1, i))
+        {
+          s++;
+          printf("singular value %zu = %22.18g differs from 1 thread %22.18g\n",
+                 i, si, gsl_vector_get(S1, i));
+        }
+
+      norm = GSL_MAX(norm, si);
+    }
+
+  /* compute a = U S V^T */
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        gsl_matrix_set(vs, i, j, gsl_matrix_get(v, i, j) * gsl_vector_get(S, j));
+    }
+
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, u, vs, 0.0, a);
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double aij = gsl_matrix_get(a, i, j);
+          double mij = gsl_matrix_get(m, i, j);
+
+          s += (fabs(aij - mij) > eps * GSL_MAX(norm, 1.0));
+        }
+    }
+
+  /* check U^T U = I; with u_scaled, the orthogonality of the columns
+   * of U degrades with the ratio ||A|| / s_i, and columns of rank
+   * deficient matrices which are pure rounding noise are skipped */
+  gsl_matrix_set_identity(I);
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, u, u, -1.0, I);
+  for (i = 0; i < N; i++)
+    for (j = 0; j < N; j++)
+      {
+        double smin = GSL_MIN(gsl_vector_get(S, i), gsl_vector_get(S, j));
+
+        if (!u_scaled)
+          s += (fabs(gsl_matrix_get(I, i, j)) > eps);
+        else if (smin > GSL_SQRT_DBL_EPSILON * norm)
+          s += (fabs(gsl_matrix_get(I, i, j)) > eps * norm / smin);
+      }
+
+  /* check V^T V = I */
+  gsl_matrix_set_identity(I);
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, v, v, -1.0, I);
+  for (i = 0; i < N; i++)
+    for (j = 0; j < N; j++)
+      s += (fabs(gsl_matrix_get(I, i, j)) > eps);
+
+  gsl_matrix_free(u);
+  gsl_matrix_free(a);
+  gsl_matrix_free(v);
+  gsl_matrix_free(vs);
+  gsl_matrix_free(I);
+  gsl_vector_free(S);
+  gsl_vector_free(S1);
+
+  return s;
+}
+
+/* run test_SV_decomp_func_dim on the fixed test matrices and on random
+ * M-by-N matrices of the given sizes */
+static int
+test_SV_decomp_func(const char * desc, test_SV_decomp_fn decomp,
+                    const size_t nthreads, const int u_scaled,
+                    const size_t sizes[][2], const size_t nsizes,
+                    const double eps_random, gsl_rng * r)
+{
+  int f;
+  int s = 0;
+  size_t k;
+
+  f = test_SV_decomp_func_dim(m11, decomp, nthreads, u_scaled, 2 * GSL_DBL_EPSILON);
+  gsl_test(f, "  %s m(1,1)", desc);
+  s += f;
+
+  f = test_SV_decomp_func_dim(m51, decomp, nthreads, u_scaled, 2 * 64.0 * GSL_DBL_EPSILON);
+  gsl_test(f, "  %s m(5,1)", desc);
+  s += f;
+
+  f = test_SV_decomp_func_dim(m53, decomp, nthreads, u_scaled, 2 * 64.0 * GSL_DBL_EPSILON);
+  gsl_test(f, "  %s m(5,3)", desc);
+  s += f;
+
+  f = test_SV_decomp_func_dim(moler10, decomp, nthreads, u_scaled, 2 * 64.0 * GSL_DBL_EPSILON);
+  gsl_test(f, "  %s moler(10)", desc);
+  s += f;
+
+  f = test_SV_decomp_func_dim(hilb12, decomp, nthreads, u_scaled, 2 * 1024.0 * GSL_DBL_EPSILON);
+  gsl_test(f, "  %s hilbert(12)", desc);
+  s += f;
+
+  f = test_SV_decomp_func_dim(bigsparse, decomp, nthreads, u_scaled, 1024 * GSL_DBL_EPSILON);
+  gsl_test(f, "  %s bigsparse", desc);
+  s += f;
+
+  for (k = 0; k < nsizes; ++k)
+    {
+      const size_t M = sizes[k][0];
+      const size_t N = sizes[k][1];
+      gsl_matrix * m = gsl_matrix_alloc(M, N);
+
+      create_random_matrix(m, r);
+
+      f = test_SV_decomp_func_dim(m, decomp, nthreads, u_scaled, eps_random);
+      gsl_test(f, "  %s random(%zu,%zu)", desc, M, N);
+      s += f;
+
+      gsl_matrix_free(m);
+    }
+
+  return s;
+}
+
+static int
+test_SV_decomp_dc(gsl_rng * r)
+{
+  /* random matrices large enough to exercise the merge step, the
+   * blocked bidiagonalization and the QR preprocessing */
+  const size_t sizes[][2] = { { 30, 30 }, { 77, 60 }, { 201, 150 },
+                              { 300, 140 }, { 500, 200 } };
+
+  return test_SV_decomp_func("SV_decomp_dc", test_SV_decomp_dc_func, 1, 0,
+                             sizes, sizeof(sizes) / sizeof(sizes[0]),
+                             1.0e4 * GSL_DBL_EPSILON, r);
+}
+
+static int
+test_SV_decomp_jacobi_tiled(gsl_rng * r)
+{
+  /* random matrices with several blocks of columns; the fixed
+   * matrices are run with 4 and 3 threads, the random ones with 3 */
+  const size_t sizes[][2] = { { 16, 16 }, { 30, 30 }, { 77, 60 }, { 150, 100 } };
+  int s = 0;
+
+  s += test_SV_decomp_func("SV_decomp_jacobi_tiled(4)", test_SV_decomp_jacobi_tiled_func,
+                           4, 1, sizes, 0, 0.0, r);
+  s += test_SV_decomp_func("SV_decomp_jacobi_tiled(3)", test_SV_decomp_jacobi_tiled_func,
+                           3, 1, sizes, sizeof(sizes) / sizeof(sizes[0]),
+                           1.0e3 * GSL_DBL_EPSILON, r);
+
+  return s;
+}
+
+/* compute a truncated SVD of a random M-by-N matrix of rank k and
+ * check the singular values against the full SVD, the orthogonality
+ * of U and V, and A = U S V^T */
+static int
+test_rSVD_dim(const size_t M, const size_t N, const size_t k,
+              const size_t p, const size_t q, const double eps, gsl_rng * r)
+{
+  int s = 0;
+  size_t i, j;
+
+  gsl_matrix * A = gsl_matrix_alloc(M, N);
+  gsl_matrix * X = gsl_matrix_alloc(M, k);
+  gsl_matrix * Y = gsl_matrix_alloc(k, N);
+  gsl_matrix * U = gsl_matrix_alloc(M, k);
+  gsl_matrix * V = gsl_matrix_alloc(N, k);
+  gsl_matrix * VS = gsl_matrix_alloc(N, k);
+  gsl_matrix * B = gsl_matrix_alloc(M, N);
+  gsl_matrix * I = gsl_matrix_alloc(k, k);
+  gsl_vector * S = gsl_vector_alloc(k);
+  gsl_matrix * At, * Vt;
+  gsl_vector * St;
+  double norm;
+
+  create_random_matrix(X, r);
+  create_random_matrix(Y, r);
+  gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, X, Y, 0.0, A);
+
+  s += gsl_linalg_rSVD(A, p, q, r, U, S, V);
+
+  /* reference singular values from the full SVD of A or A^T */
+  if (M >= N)
+    {
+      At = gsl_matrix_alloc(M, N);
+      gsl_matrix_memcpy(At, A);
+    }
+  else
+    {
+      At = gsl_matrix_alloc(N, M);
+      gsl_matrix_transpose_memcpy(At, A);
+    }
+
+  Vt = gsl_matrix_alloc(At->size2, At->size2);
+  St = gsl_vector_alloc(At->size2);
+  s += gsl_linalg_SV_decomp_dc(At, Vt, St);
+
+  norm = gsl_vector_get(St, 0);
+
+  for (i = 0; i < k; ++i)
+    {
+      double si = gsl_vector_get(S, i);
+      double ti = gsl_vector_get(St, i);
+
+      gsl_test_rel(si, ti, eps, "rSVD (%3zu,%3zu) k=%zu S[%zu]", M, N, k, i);
+    }
+
+  /* check A = U S V^T */
+  for (i = 0; i < N; ++i)
+    {
+      for (j = 0; j < k; ++j)
+        gsl_matrix_set(VS, i, j, gsl_matrix_get(V, i, j) * gsl_vector_get(S, j));
+    }
+
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, U, VS, 0.0, B);
+
+  for (i = 0; i < M; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double bij = gsl_matrix_get(B, i, j);
+          double aij = gsl_matrix_get(A, i, j);
+
+          s += (fabs(bij - aij) > eps * norm);
+        }
+    }
+
+  /* check U^T U = I and V^T V = I */
+  gsl_matrix_set_identity(I);
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, U, U, -1.0, I);
+  for (i = 0; i < k; ++i)
+    for (j = 0; j < k; ++j)
+      s += (fabs(gsl_matrix_get(I, i, j)) > eps);
+
+  gsl_matrix_set_identity(I);
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, V, V, -1.0, I);
+  for (i = 0; i < k; ++i)
+    for (j = 0; j < k; ++j)
+      s += (fabs(gsl_matrix_get(I, i, j)) > eps);
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(X);
+  gsl_matrix_free(Y);
+  gsl_matrix_free(U);
+  gsl_matrix_free(V);
+  gsl_matrix_free(VS);
+  gsl_matrix_free(B);
+  gsl_matrix_free(I);
+  gsl_vector_free(S);
+  gsl_matrix_free(At);
+  gsl_matrix_free(Vt);
+  gsl_vector_free(St);
+
+  return s;
+}
+
+static int
+test_rSVD(gsl_rng * r)
+{
+  int f;
+  int s = 0;
+
+  f = test_rSVD_dim(200, 80, 10, 5, 0, 1.0e6 * GSL_DBL_EPSILON, r);
+  gsl_test(f, "  rSVD random(200,80) k=10");
+  s += f;
+
+  f = test_rSVD_dim(60, 250, 20, 10, 2, 1.0e6 * GSL_DBL_EPSILON, r);
+  gsl_test(f, "  rSVD random(60,250) k=20");
+  s += f;
+
+  f = test_rSVD_dim(50, 40, 40, 10, 1, 1.0e6 * GSL_DBL_EPSILON, r);
+  gsl_test(f, "  rSVD random(50,40) k=40");
+  s += f;
+
+  return s;
+}
+
 
 int
 test_cholesky_solve_dim(const gsl_matrix * m, const double * actual, double eps)
@@ -2984,6 +3423,107 @@ int test_TDN_cyc_solve(void)
   return s;
 }
 
+/* compare the batched tridiagonal solvers with the single system solvers */
+static int
+test_tridiag_batch_eps(const size_t N, const size_t nbatch, const int cyclic,
+                       const int symm, const double eps, gsl_rng * r)
+{
+  int s = 0;
+  const size_t noff = cyclic ? N : N - 1;
+  const char * desc = cyclic ? (symm ? "symm_cyc_tridiag_batch" : "cyc_tridiag_batch")
+                             : (symm ? "symm_tridiag_batch" : "tridiag_batch");
+  gsl_matrix * diag = gsl_matrix_alloc(N, nbatch);
+  gsl_matrix * above = gsl_matrix_alloc(noff, nbatch);
+  gsl_matrix * below = gsl_matrix_alloc(noff, nbatch);
+  gsl_matrix * rhs = gsl_matrix_alloc(N, nbatch);
+  gsl_matrix * x = gsl_matrix_alloc(N, nbatch);
+  gsl_vector * d = gsl_vector_alloc(N);
+  gsl_vector * a = gsl_vector_alloc(noff);
+  gsl_vector * b = gsl_vector_alloc(noff);
+  gsl_vector * rb = gsl_vector_alloc(N);
+  gsl_vector * xb = gsl_vector_alloc(N);
+  size_t i, j;
+
+  create_random_matrix(diag, r);
+  create_random_matrix(above, r);
+  create_random_matrix(below, r);
+  create_random_matrix(rhs, r);
+  gsl_matrix_add_constant(diag, 3.0);
+
+  /* solve in place */
+  gsl_matrix_memcpy(x, rhs);
+
+  if (cyclic && symm)
+    s += gsl_linalg_solve_symm_cyc_tridiag_batch(diag, above, x, x);
+  else if (cyclic)
+    s += gsl_linalg_solve_cyc_tridiag_batch(diag, above, below, x, x);
+  else if (symm)
+    s += gsl_linalg_solve_symm_tridiag_batch(diag, above, x, x);
+  else
+    s += gsl_linalg_solve_tridiag_batch(diag, above, below, x, x);
+
+  for (j = 0; j < nbatch; ++j)
+    {
+      gsl_matrix_get_col(d, diag, j);
+      gsl_matrix_get_col(a, above, j);
+      gsl_matrix_get_col(b, below, j);
+      gsl_matrix_get_col(rb, rhs, j);
+
+      if (cyclic && symm)
+        s += gsl_linalg_solve_symm_cyc_tridiag(d, a, rb, xb);
+      else if (cyclic)
+        s += gsl_linalg_solve_cyc_tridiag(d, a, b, rb, xb);
+      else if (symm)
+        s += gsl_linalg_solve_symm_tridiag(d, a, rb, xb);
+      else
+        s += gsl_linalg_solve_tridiag(d, a, b, rb, xb);
+
+      for (i = 0; i < N; ++i)
+        {
+          double xij = gsl_matrix_get(x, i, j);
+          double yij = gsl_vector_get(xb, i);
+
+          gsl_test_rel(xij, yij, eps, "%s: N=%zu nbatch=%zu x[%zu](%zu)",
+                       desc, N, nbatch, j, i);
+        }
+    }
+
+  gsl_matrix_free(diag);
+  gsl_matrix_free(above);
+  gsl_matrix_free(below);
+  gsl_matrix_free(rhs);
+  gsl_matrix_free(x);
+  gsl_vector_free(d);
+  gsl_vector_free(a);
+  gsl_vector_free(b);
+  gsl_vector_free(rb);
+  gsl_vector_free(xb);
+
+  return s;
+}
+
+static int
+test_tridiag_batch(gsl_rng * r)
+{
+  int s = 0;
+  const size_t sizes[] = { 3, 4, 11, 50 };
+  const size_t nbatch[] = { 1, 16, 37 };
+  size_t i, j;
+
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+      for (j = 0; j < sizeof(nbatch) / sizeof(nbatch[0]); ++j)
+        {
+          s += test_tridiag_batch_eps(sizes[i], nbatch[j], 0, 1, 8.0 * GSL_DBL_EPSILON, r);
+          s += test_tridiag_batch_eps(sizes[i], nbatch[j], 0, 0, 8.0 * GSL_DBL_EPSILON, r);
+          s += test_tridiag_batch_eps(sizes[i], nbatch[j], 1, 1, 8.0 * GSL_DBL_EPSILON, r);
+          s += test_tridiag_batch_eps(sizes[i], nbatch[j], 1, 0, 8.0 * GSL_DBL_EPSILON, r);
+        }
+    }
+
+  return s;
+}
+
 int
 test_bidiag_decomp_dim(const gsl_matrix * m, double eps)
 {
@@ -3159,6 +3699,98 @@ test_tri_invert2(CBLAS_UPLO_t Uplo, CBLAS_DIAG_t Diag, gsl_rng * r, const double
   return s;
 }
 
+int
+test_tri_packed2(CBLAS_UPLO_t Uplo, CBLAS_DIAG_t Diag, gsl_rng * r, const double tol)
+{
+  const size_t N_max = 100;
+  const char *uplo_str = (Uplo == CblasUpper) ? "upper" : "lower";
+  const char *diag_str = (Diag == CblasNonUnit) ? "NonUnit" : "Unit";
+  int s = 0;
+  size_t n, i, j;
+
+  for (n = 1; n <= N_max; ++n)
+    {
+      gsl_matrix *T = gsl_matrix_alloc(n, n);
+      gsl_matrix *B = gsl_matrix_alloc(n, n);
+      gsl_vector *TP = gsl_vector_alloc(n * (n + 1) / 2);
+      gsl_vector *sol = gsl_vector_alloc(n);
+      gsl_vector *x = gsl_vector_alloc(n);
+      int k;
+
+      create_tri_matrix(Uplo, Diag, T, r);
+      tri2packed_matrix(Uplo, T, TP);
+
+      /* solve op(T) x = b for both transpose options */
+      for (k = 0; k < 2; ++k)
+        {
+          CBLAS_TRANSPOSE_t TransA = (k == 0) ? CblasNoTrans : CblasTrans;
+
+          create_random_vector(sol, r);
+          gsl_blas_dcopy(sol, x);
+          gsl_blas_dtrmv(Uplo, TransA, Diag, T, x);
+          s += gsl_linalg_tri_packed_svx(Uplo, TransA, Diag, TP, x);
+
+          for (i = 0; i < n; ++i)
+            {
+              double xi = gsl_vector_get(x, i);
+              double yi = gsl_vector_get(sol, i);
+
+              gsl_test_rel(xi, yi, tol, "tri_packed_svx[%zu] N=%zu %s %s %s",
+                           i, n, uplo_str, diag_str,
+                           (TransA == CblasNoTrans) ? "NoTrans" : "Trans");
+            }
+        }
+
+      /* compute B = T^{-1} */
+      s += gsl_linalg_tri_packed_invert(Uplo, Diag, TP);
+      packed2tri_matrix(Uplo, TP, B);
+
+      if (Diag == CblasUnit)
+        {
+          gsl_vector_view d = gsl_matrix_diagonal(B);
+          gsl_vector_set_all(&d.vector, 1.0);
+        }
+
+      /* compute B = T * T^{-1} */
+      gsl_blas_dtrmm(CblasLeft, Uplo, CblasNoTrans, Diag, 1.0, T, B);
+
+      /* test B = I */
+      for (i = 0; i < n; ++i)
+        {
+          for (j = 0; j < n; ++j)
+            {
+              double Bij = gsl_matrix_get(B, i, j);
+              double expected = (i == j) ? 1.0 : 0.0;
+
+              gsl_test_abs(Bij, expected, tol, "tri_packed_invert[%zu,%zu] N=%zu %s %s",
+                           i, j, n, uplo_str, diag_str);
+            }
+        }
+
+      gsl_matrix_free(T);
+      gsl_matrix_free(B);
+      gsl_vector_free(TP);
+      gsl_vector_free(sol);
+      gsl_vector_free(x);
+    }
+
+  return s;
+}
+
+int
+test_tri_packed(gsl_rng * r)
+{
+  int s = 0;
+
+  s += test_tri_packed2(CblasLower, CblasNonUnit, r, 1.0e-10);
+  s += test_tri_packed2(CblasLower, CblasUnit, r, 1.0e-10);
+
+  s += test_tri_packed2(CblasUpper, CblasNonUnit, r, 1.0e-10);
+  s += test_tri_packed2(CblasUpper, CblasUnit, r, 1.0e-10);
+
+  return s;
+}
+
 int
 test_tri_invert(gsl_rng * r)
 {
@@ -3173,6 +3805,141 @@ test_tri_invert(gsl_rng * r)
   return s;
 }
 
+static int
+test_expm_eps(const gsl_matrix * A, const gsl_matrix * expected, const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t N = A->size1;
+  gsl_matrix * eA = gsl_matrix_alloc(N, N);
+  size_t i, j;
+
+  s += gsl_linalg_expm(A, eA);
+
+  for (i = 0; i < N; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double aij = gsl_matrix_get(eA, i, j);
+          double bij = gsl_matrix_get(expected, i, j);
+
+          gsl_test_rel(aij, bij, eps, "%s: (%zu,%zu)[%zu,%zu]: %22.18g   %22.18g\n",
+                       desc, N, N, i, j, aij, bij);
+        }
+    }
+
+  gsl_matrix_free(eA);
+
+  return s;
+}
+
+int
+test_expm(gsl_rng * r)
+{
+  int s = 0;
+  const double theta[] = { 1.0e-3, 0.1, 1.0, 5.0, 30.0 };
+  gsl_matrix * A = gsl_matrix_alloc(2, 2);
+  gsl_matrix * E = gsl_matrix_alloc(2, 2);
+  size_t k, N;
+
+  for (k = 0; k < sizeof(theta) / sizeof(theta[0]); ++k)
+    {
+      const double t = theta[k];
+
+      /* exp([0 t; -t 0]) is a rotation */
+      gsl_matrix_set(A, 0, 0, 0.0);
+      gsl_matrix_set(A, 0, 1, t);
+      gsl_matrix_set(A, 1, 0, -t);
+      gsl_matrix_set(A, 1, 1, 0.0);
+
+      gsl_matrix_set(E, 0, 0, cos(t));
+      gsl_matrix_set(E, 0, 1, sin(t));
+      gsl_matrix_set(E, 1, 0, -sin(t));
+      gsl_matrix_set(E, 1, 1, cos(t));
+
+      s += test_expm_eps(A, E, 1.0e3 * (1.0 + t) * GSL_DBL_EPSILON, "expm rotation");
+
+      /* exp([a b; 0 c]) = [e^a b (e^a - e^c) / (a - c); 0 e^c] */
+      gsl_matrix_set(A, 0, 0, -t);
+      gsl_matrix_set(A, 0, 1, 3.0 * t);
+      gsl_matrix_set(A, 1, 0, 0.0);
+      gsl_matrix_set(A, 1, 1, 0.5 * t);
+
+      gsl_matrix_set(E, 0, 0, exp(-t));
+      gsl_matrix_set(E, 0, 1, 3.0 * t * exp(0.5 * t) * expm1(-1.5 * t) / (-1.5 * t));
+      gsl_matrix_set(E, 1, 0, 0.0);
+      gsl_matrix_set(E, 1, 1, exp(0.5 * t));
+
+      s += test_expm_eps(A, E, 1.0e3 * (1.0 + t) * GSL_DBL_EPSILON, "expm triangular");
+    }
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(E);
+
+  for (N = 1; N <= 30; ++N)
+    {
+      const double tval[] = { 0.1, 1.0, 10.0 };
+      gsl_matrix * Q = gsl_matrix_alloc(N, N);
+      gsl_matrix * tQ = gsl_matrix_alloc(N, N);
+      gsl_matrix * eQ = gsl_matrix_alloc(N, N);
+      gsl_vector * v = gsl_vector_alloc(N);
+      gsl_vector * w = gsl_vector_alloc(N);
+      gsl_vector * y = gsl_vector_alloc(N);
+      size_t i, j;
+
+      /* Markov chain generator, with nonnegative rates and zero row sums */
+      create_random_matrix(Q, r);
+      for (i = 0; i < N; ++i)
+        {
+          double sum = 0.0;
+
+          for (j = 0; j < N; ++j)
+            {
+              if (j != i)
+                sum += gsl_matrix_get(Q, i, j);
+            }
+
+          gsl_matrix_set(Q, i, i, -sum);
+        }
+
+      create_random_vector(v, r);
+
+      for (k = 0; k < sizeof(tval) / sizeof(tval[0]); ++k)
+        {
+          const double t = tval[k];
+
+          gsl_matrix_memcpy(tQ, Q);
+          gsl_matrix_scale(tQ, t);
+
+          /* compare with the Taylor series method */
+          gsl_linalg_exponential_ss(tQ, eQ, GSL_PREC_DOUBLE);
+          s += test_expm_eps(tQ, eQ, 1.0e-10, "expm markov");
+
+          /* compare exp(tQ) v with expm(tQ) v */
+          gsl_linalg_expm(tQ, eQ);
+          gsl_blas_dgemv(CblasNoTrans, 1.0, eQ, v, 0.0, y);
+          s += gsl_linalg_expm_multiply(Q, t, v, w);
+
+          for (i = 0; i < N; ++i)
+            {
+              double wi = gsl_vector_get(w, i);
+              double yi = gsl_vector_get(y, i);
+
+              gsl_test_rel(wi, yi, 1.0e-10, "expm_multiply markov: N=%zu t=%g [%zu]: %22.18g   %22.18g\n",
+                           N, t, i, wi, yi);
+            }
+        }
+
+      gsl_matrix_free(Q);
+      gsl_matrix_free(tQ);
+      gsl_matrix_free(eQ);
+      gsl_vector_free(v);
+      gsl_vector_free(w);
+      gsl_vector_free(y);
+    }
+
+  return s;
+}
+
 void
 my_error_handler (const char *reason, const char *file, int line, int err)
 {
@@ -3184,6 +3951,10 @@ main(void)
 {
   gsl_rng *r = gsl_rng_alloc(gsl_rng_default);
 
+  /* the newer tests draw from a separate generator, so that they leave
+   * the random matrices of the older tests unchanged */
+  gsl_rng *r2 = gsl_rng_alloc(gsl_rng_default);
+
   gsl_ieee_env_setup ();
   gsl_set_error_handler (&my_error_handler);
 
@@ -3245,11 +4016,18 @@ main(void)
 #endif
 
   gsl_test(test_tri_invert(r),           "Triangular Inverse");
+  gsl_test(test_tri_packed(r2),           "Packed Triangular Solve and Inverse");
+  gsl_test(test_expm(r2),                 "Matrix Exponential");
 
   gsl_test(test_bidiag_decomp(),         "Bidiagonal Decomposition");
   gsl_test(test_LU_decomp(r),            "LU Decomposition");
+  gsl_test(test_LU_decomp_tiled(r2),      "LU Decomposition (tiled)");
+  gsl_test(test_LU_batch(r2),             "LU Decomposition (batched)");
   gsl_test(test_LU_solve(r),             "LU Solve");
   gsl_test(test_LU_invert(r),            "LU Inverse");
+  gsl_test(test_LU_band_decomp(r2),       "Banded LU Decomposition");
+  gsl_test(test_LU_band_solve(r2),        "Banded LU Solve");
+  gsl_test(test_LU_solve_mixed(r2),       "LU Solve (mixed precision)");
   gsl_test(test_LUc_decomp(r),           "Complex LU Decomposition");
   gsl_test(test_LUc_solve(r),            "Complex LU Solve");
   gsl_test(test_LUc_invert(r),           "Complex LU Inverse");
@@ -3262,6 +4040,9 @@ main(void)
   gsl_test(test_QR_QTmat_r(r),           "QR QTmat (recursive)");
   gsl_test(test_QR_solve_r(r),           "QR Solve (recursive)");
   gsl_test(test_QR_lssolve_r(r),         "QR LS Solve (recursive)");
+  gsl_test(test_R_update(r2),             "R Row Append/Delete");
+  gsl_test(test_QRc_decomp_r(r2),         "Complex QR Decomposition (recursive)");
+  gsl_test(test_QRc_solve_r(r2),          "Complex QR Solve (recursive)");
 
   gsl_test(test_LQ_decomp(),             "LQ Decomposition");
   gsl_test(test_LQ_LQsolve(),            "LQ LQ Solve");
@@ -3275,6 +4056,7 @@ main(void)
   gsl_test(test_QR_lssolve(),            "QR LS Solve");
   gsl_test(test_QR_update(),             "QR Rank-1 Update");
   gsl_test(test_QRPT_decomp(),           "QRPT Decomposition");
+  gsl_test(test_QRPT_decomp_r(r2),        "QRPT Decomposition (blocked)");
   gsl_test(test_QRPT_lssolve(),          "QRPT LS Solve");
   gsl_test(test_QRPT_lssolve2(),         "QRPT LS Solve 2");
   gsl_test(test_QRPT_solve(),            "QRPT Solve");
@@ -3287,12 +4069,17 @@ main(void)
 
   gsl_test(test_SV_decomp(),             "Singular Value Decomposition");
   gsl_test(test_SV_decomp_jacobi(),      "Singular Value Decomposition (Jacobi)");
+  gsl_test(test_SV_decomp_dc(r2),         "Singular Value Decomposition (divide and conquer)");
+  gsl_test(test_SV_decomp_jacobi_tiled(r2), "Singular Value Decomposition (block Jacobi)");
+  gsl_test(test_rSVD(r2),                 "Randomized Singular Value Decomposition");
   gsl_test(test_SV_decomp_mod(),         "Singular Value Decomposition (Mod)");
   gsl_test(test_SV_solve(),              "SVD Solve");
 
   gsl_test(test_cholesky_decomp_unit(),  "Cholesky Decomposition [unit triangular]");
   gsl_test(test_cholesky_solve(),        "Cholesky Solve");
   gsl_test(test_cholesky_decomp(r),      "Cholesky Decomposition");
+  gsl_test(test_cholesky_decomp_tiled(r2), "Cholesky Decomposition (tiled)");
+  gsl_test(test_cholesky_batch(r2),       "Cholesky Decomposition (batched)");
   gsl_test(test_cholesky_invert(r),      "Cholesky Inverse");
 
   gsl_test(test_pcholesky_decomp(r),     "Pivoted Cholesky Decomposition");
@@ -3311,17 +4098,25 @@ main(void)
   gsl_test(test_cholesky_band_solve(r),  "Banded Cholesky Solve");
   gsl_test(test_cholesky_band_invert(r), "Banded Cholesky Inverse");
 
+  gsl_test(test_cholesky_packed_decomp(r2), "Packed Cholesky Decomposition");
+  gsl_test(test_cholesky_packed_solve(r2),  "Packed Cholesky Solve");
+  gsl_test(test_cholesky_packed_invert(r2), "Packed Cholesky Inverse");
+
   gsl_test(test_ldlt_decomp(r),          "LDLT Decomposition");
   gsl_test(test_ldlt_solve(r),           "LDLT Solve");
 
   gsl_test(test_ldlt_band_decomp(r),     "Banded LDLT Decomposition");
   gsl_test(test_ldlt_band_solve(r),      "Banded LDLT Solve");
 
+  gsl_test(test_ldlt_packed_decomp(r2),   "Packed LDLT Decomposition");
+  gsl_test(test_ldlt_packed_solve(r2),    "Packed LDLT Solve");
+
   gsl_test(test_HH_solve(),              "Householder solve");
   gsl_test(test_TDS_solve(),             "Tridiagonal symmetric solve");
   gsl_test(test_TDS_cyc_solve(),         "Tridiagonal symmetric cyclic solve");
   gsl_test(test_TDN_solve(),             "Tridiagonal nonsymmetric solve");
   gsl_test(test_TDN_cyc_solve(),         "Tridiagonal nonsymmetric cyclic solve");
+  gsl_test(test_tridiag_batch(r2),        "Tridiagonal solve (batched)");
 
   gsl_matrix_free(m11);
   gsl_matrix_free(m35);
@@ -3363,6 +4158,7 @@ main(void)
   gsl_matrix_free (bigsparse);
 
   gsl_rng_free(r);
+  gsl_rng_free(r2);
 
   exit (gsl_test_summary());
 }
@@ -32,6 +32,8 @@ static int test_cholesky_decomp_eps(const int scale, const gsl_matrix * m,
                                     const double expected_rcond, const double eps,
                                     const char * desc);
 static int test_cholesky_decomp(gsl_rng * r);
+static int test_cholesky_decomp_tiled(gsl_rng * r);
+static int test_cholesky_batch(gsl_rng * r);
 int test_cholesky_invert_eps(const gsl_matrix * m, const double eps, const char *desc);
 int test_cholesky_invert(gsl_rng * r);
 static int test_pcholesky_decomp_eps(const int scale, const gsl_matrix * m,
@@ -183,6 +185,148 @@ test_cholesky_decomp(gsl_rng * r)
   return s;
 }
 
+/* compare the tiled Cholesky decomposition with gsl_linalg_cholesky_decomp1 */
+static int
+test_cholesky_decomp_tiled_eps(const gsl_matrix * m, const size_t nthreads,
+                               const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t N = m->size1;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_matrix * B = gsl_matrix_alloc(N, N);
+  size_t i, j;
+
+  gsl_matrix_memcpy(A, m);
+  gsl_linalg_cholesky_decomp1(A);
+
+  gsl_matrix_memcpy(B, m);
+  s += gsl_linalg_cholesky_decomp_tiled(B, nthreads);
+
+  for (i = 0; i < N; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double aij = gsl_matrix_get(A, i, j);
+          double bij = gsl_matrix_get(B, i, j);
+
+          gsl_test_rel(bij, aij, eps, "%s: (%zu,%zu) nthreads=%zu [%zu,%zu]",
+                       desc, N, N, nthreads, i, j);
+        }
+    }
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(B);
+
+  return s;
+}
+
+static int
+test_cholesky_decomp_tiled(gsl_rng * r)
+{
+  int s = 0;
+  const size_t sizes[] = { 100, 300, 457, 640 };
+  size_t i;
+
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+      const size_t N = sizes[i];
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+
+      create_posdef_matrix(m, r);
+      s += test_cholesky_decomp_tiled_eps(m, 1, 1.0e3 * N * GSL_DBL_EPSILON, "cholesky_decomp_tiled random");
+      s += test_cholesky_decomp_tiled_eps(m, 4, 1.0e3 * N * GSL_DBL_EPSILON, "cholesky_decomp_tiled random");
+
+      gsl_matrix_free(m);
+    }
+
+  return s;
+}
+
+/* compare the batched Cholesky decomposition and solve with
+ * gsl_linalg_cholesky_decomp1 */
+static int
+test_cholesky_batch_eps(const size_t N, const size_t nbatch, const double eps,
+                        const char * desc, gsl_rng * r)
+{
+  int s = 0;
+  gsl_matrix * A = gsl_matrix_alloc(nbatch * N, N);
+  gsl_matrix * LLT = gsl_matrix_alloc(nbatch * N, N);
+  gsl_vector * sol = gsl_vector_alloc(nbatch * N);
+  gsl_vector * rhs = gsl_vector_alloc(nbatch * N);
+  gsl_vector * x = gsl_vector_alloc(nbatch * N);
+  gsl_matrix * B = gsl_matrix_alloc(N, N);
+  size_t b, i, j;
+
+  create_random_vector(sol, r);
+
+  for (b = 0; b < nbatch; ++b)
+    {
+      gsl_matrix_view Ab = gsl_matrix_submatrix(A, b * N, 0, N, N);
+      gsl_vector_view sb = gsl_vector_subvector(sol, b * N, N);
+      gsl_vector_view rb = gsl_vector_subvector(rhs, b * N, N);
+
+      create_posdef_matrix(&Ab.matrix, r);
+      gsl_blas_dgemv(CblasNoTrans, 1.0, &Ab.matrix, &sb.vector, 0.0, &rb.vector);
+    }
+
+  gsl_matrix_memcpy(LLT, A);
+  s += gsl_linalg_cholesky_decomp_batch(LLT);
+  s += gsl_linalg_cholesky_solve_batch(LLT, rhs, x);
+
+  for (b = 0; b < nbatch; ++b)
+    {
+      gsl_matrix_const_view Ab = gsl_matrix_const_submatrix(A, b * N, 0, N, N);
+
+      gsl_matrix_memcpy(B, &Ab.matrix);
+      gsl_linalg_cholesky_decomp1(B);
+
+      for (i = 0; i < N; ++i)
+        {
+          double xi = gsl_vector_get(x, b * N + i);
+          double yi = gsl_vector_get(sol, b * N + i);
+
+          gsl_test_rel(xi, yi, eps, "%s: N=%zu nbatch=%zu solve[%zu,%zu]",
+                       desc, N, nbatch, b, i);
+
+          for (j = 0; j < N; ++j)
+            {
+              double aij = gsl_matrix_get(B, i, j);
+              double bij = gsl_matrix_get(LLT, b * N + i, j);
+
+              gsl_test_rel(bij, aij, eps, "%s: N=%zu nbatch=%zu LLT[%zu](%zu,%zu)",
+                           desc, N, nbatch, b, i, j);
+            }
+        }
+    }
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(LLT);
+  gsl_vector_free(sol);
+  gsl_vector_free(rhs);
+  gsl_vector_free(x);
+  gsl_matrix_free(B);
+
+  return s;
+}
+
+static int
+test_cholesky_batch(gsl_rng * r)
+{
+  int s = 0;
+  const size_t sizes[] = { 1, 4, 7, 16 };
+  const size_t nbatch[] = { 1, 8, 29 };
+  size_t i, j;
+
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+      for (j = 0; j < sizeof(nbatch) / sizeof(nbatch[0]); ++j)
+        s += test_cholesky_batch_eps(sizes[i], nbatch[j], 1.0e3 * sizes[i] * GSL_DBL_EPSILON,
+                                     "cholesky_batch random", r);
+    }
+
+  return s;
+}
+
 int
 test_cholesky_invert_eps(const gsl_matrix * m, const double eps, const char *desc)
 {
@@ -1103,3 +1247,156 @@ test_cholesky_band_invert(gsl_rng * r)
 
   return s;
 }
+
+static int
+test_cholesky_packed_decomp_eps(const gsl_matrix * m, const double eps, const char * desc)
+{
+  int s = 0;
+  size_t i, j, N = m->size1;
+  gsl_matrix * V = gsl_matrix_alloc(N, N);
+  gsl_matrix * L = gsl_matrix_alloc(N, N);
+  gsl_vector * AP = gsl_vector_alloc(N * (N + 1) / 2);
+
+  tri2packed_matrix(CblasLower, m, AP);
+  s += gsl_linalg_cholesky_packed_decomp(AP);
+  packed2tri_matrix(CblasLower, AP, L);
+
+  /* compare with the factor from the full storage decomposition */
+  gsl_matrix_memcpy(V, m);
+  s += gsl_linalg_cholesky_decomp1(V);
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j <= i; j++)
+        {
+          double Lij = gsl_matrix_get(L, i, j);
+          double Vij = gsl_matrix_get(V, i, j);
+
+          gsl_test_rel(Lij, Vij, eps,
+                       "%s: (%3zu,%3zu)[%zu,%zu]: %22.18g   %22.18g\n",
+                       desc, N, N, i, j, Lij, Vij);
+        }
+    }
+
+  gsl_matrix_free(V);
+  gsl_matrix_free(L);
+  gsl_vector_free(AP);
+
+  return s;
+}
+
+static int
+test_cholesky_packed_decomp(gsl_rng * r)
+{
+  int s = 0;
+  const size_t N_max = 50;
+  size_t N;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+
+      create_posdef_matrix(m, r);
+      s += test_cholesky_packed_decomp_eps(m, 1.0e3 * N * GSL_DBL_EPSILON, "cholesky_packed_decomp random");
+
+      if (N <= 4)
+        {
+          create_hilbert_matrix2(m);
+          s += test_cholesky_packed_decomp_eps(m, 1.0e3 * N * GSL_DBL_EPSILON, "cholesky_packed_decomp hilbert");
+        }
+
+      gsl_matrix_free(m);
+    }
+
+  return s;
+}
+
+static int
+test_cholesky_packed_solve(gsl_rng * r)
+{
+  int s = 0;
+  const size_t N_max = 50;
+  size_t N, i;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+      gsl_vector * AP = gsl_vector_alloc(N * (N + 1) / 2);
+      gsl_vector * rhs = gsl_vector_alloc(N);
+      gsl_vector * sol = gsl_vector_alloc(N);
+      gsl_vector * x = gsl_vector_alloc(N);
+      const double eps = 1.0e3 * N * GSL_DBL_EPSILON;
+
+      create_posdef_matrix(m, r);
+      create_random_vector(sol, r);
+      gsl_blas_dsymv(CblasLower, 1.0, m, sol, 0.0, rhs);
+
+      tri2packed_matrix(CblasLower, m, AP);
+      s += gsl_linalg_cholesky_packed_decomp(AP);
+      s += gsl_linalg_cholesky_packed_solve(AP, rhs, x);
+
+      for (i = 0; i < N; i++)
+        {
+          double xi = gsl_vector_get(x, i);
+          double yi = gsl_vector_get(sol, i);
+
+          gsl_test_rel(xi, yi, eps,
+                       "cholesky_packed_solve random: %3zu[%zu]: %22.18g   %22.18g\n",
+                       N, i, xi, yi);
+        }
+
+      gsl_matrix_free(m);
+      gsl_vector_free(AP);
+      gsl_vector_free(rhs);
+      gsl_vector_free(sol);
+      gsl_vector_free(x);
+    }
+
+  return s;
+}
+
+static int
+test_cholesky_packed_invert(gsl_rng * r)
+{
+  int s = 0;
+  const size_t N_max = 50;
+  size_t N, i, j;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+      gsl_matrix * minv = gsl_matrix_alloc(N, N);
+      gsl_matrix * c = gsl_matrix_alloc(N, N);
+      gsl_vector * AP = gsl_vector_alloc(N * (N + 1) / 2);
+      const double eps = 1.0e2 * N * GSL_DBL_EPSILON;
+
+      create_posdef_matrix(m, r);
+
+      tri2packed_matrix(CblasLower, m, AP);
+      s += gsl_linalg_cholesky_packed_decomp(AP);
+      s += gsl_linalg_cholesky_packed_invert(AP);
+      packed2tri_matrix(CblasLower, AP, minv);
+
+      /* c = m^{-1} m should be the identity matrix */
+      gsl_blas_dsymm(CblasLeft, CblasLower, 1.0, minv, m, 0.0, c);
+
+      for (i = 0; i < N; ++i)
+        {
+          for (j = 0; j < N; ++j)
+            {
+              double cij = gsl_matrix_get(c, i, j);
+              double expected = (i == j) ? 1.0 : 0.0;
+
+              gsl_test_abs(cij, expected, eps, "cholesky_packed_invert random (N=%zu)[%zu,%zu]: %22.18g   %22.18g\n",
+                           N, i, j, cij, expected);
+            }
+        }
+
+      gsl_matrix_free(m);
+      gsl_matrix_free(minv);
+      gsl_matrix_free(c);
+      gsl_vector_free(AP);
+    }
+
+  return s;
+}
@@ -282,3 +282,100 @@ symm2band_matrix(const size_t p, const gsl_matrix * m, gsl_matrix * bm)
       return GSL_SUCCESS;
     }
 }
+
+/* copy the triangle Uplo of a dense matrix m to row-wise packed format */
+static int
+tri2packed_matrix(CBLAS_UPLO_t Uplo, const gsl_matrix * m, gsl_vector * v)
+{
+  const size_t N = m->size1;
+  size_t i, j, k = 0;
+
+  for (i = 0; i < N; ++i)
+    {
+      size_t jmin = (Uplo == CblasLower) ? 0 : i;
+      size_t jmax = (Uplo == CblasLower) ? i : N - 1;
+
+      for (j = jmin; j <= jmax; ++j)
+        v->data[k++] = gsl_matrix_get(m, i, j);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* unpack a row-wise packed triangle Uplo into a dense matrix m, zeroing the other triangle */
+static int
+packed2tri_matrix(CBLAS_UPLO_t Uplo, const gsl_vector * v, gsl_matrix * m)
+{
+  const size_t N = m->size1;
+  size_t i, j, k = 0;
+
+  gsl_matrix_set_zero(m);
+
+  for (i = 0; i < N; ++i)
+    {
+      size_t jmin = (Uplo == CblasLower) ? 0 : i;
+      size_t jmax = (Uplo == CblasLower) ? i : N - 1;
+
+      for (j = jmin; j <= jmax; ++j)
+        gsl_matrix_set(m, i, j, v->data[k++]);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* create general banded matrix with lower bandwidth p and upper bandwidth q */
+static int
+create_band_matrix(const size_t p, const size_t q, gsl_matrix * m, gsl_rng * r)
+{
+  const size_t M = m->size1;
+  const size_t N = m->size2;
+  size_t i, j;
+
+  gsl_matrix_set_zero(m);
+
+  for (j = 0; j < N; ++j)
+    {
+      size_t imin = (j > q) ? j - q : 0;
+      size_t imax = GSL_MIN(M - 1, j + p);
+
+      for (i = imin; i <= imax; ++i)
+        gsl_matrix_set(m, i, j, 2.0 * gsl_rng_uniform(r) - 1.0);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* transform dense general banded matrix to the packed format of
+ * gsl_linalg_LU_band_decomp, N-by-(2p+q+1) */
+static int
+gen2band_matrix(const size_t p, const size_t q, const gsl_matrix * m, gsl_matrix * bm)
+{
+  const size_t M = m->size1;
+  const size_t N = m->size2;
+
+  if (bm->size1 != N)
+    {
+      GSL_ERROR("banded matrix requires N rows", GSL_EBADLEN);
+    }
+  else if (bm->size2 != 2 * p + q + 1)
+    {
+      GSL_ERROR("banded matrix requires 2*p + q + 1 columns", GSL_EBADLEN);
+    }
+  else
+    {
+      size_t i, j;
+
+      gsl_matrix_set_zero(bm);
+
+      for (j = 0; j < N; ++j)
+        {
+          size_t imin = (j > q) ? j - q : 0;
+          size_t imax = GSL_MIN(M - 1, j + p);
+
+          for (i = imin; i <= imax; ++i)
+            gsl_matrix_set(bm, j, p + q + i - j, gsl_matrix_get(m, i, j));
+        }
+
+      return GSL_SUCCESS;
+    }
+}
@@ -370,3 +370,103 @@ test_ldlt_band_solve(gsl_rng * r)
 
   return s;
 }
+
+static int
+test_ldlt_packed_decomp_eps(const gsl_matrix * m, const double eps, const char * desc)
+{
+  int s = 0;
+  size_t i, j, N = m->size1;
+  gsl_matrix * V = gsl_matrix_alloc(N, N);
+  gsl_matrix * L = gsl_matrix_alloc(N, N);
+  gsl_vector * AP = gsl_vector_alloc(N * (N + 1) / 2);
+
+  tri2packed_matrix(CblasLower, m, AP);
+  s += gsl_linalg_ldlt_packed_decomp(AP);
+  packed2tri_matrix(CblasLower, AP, L);
+
+  /* compare with the factors from the full storage decomposition */
+  gsl_matrix_memcpy(V, m);
+  s += gsl_linalg_ldlt_decomp(V);
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j <= i; j++)
+        {
+          double Lij = gsl_matrix_get(L, i, j);
+          double Vij = gsl_matrix_get(V, i, j);
+
+          gsl_test_rel(Lij, Vij, eps,
+                       "%s: (%3zu,%3zu)[%zu,%zu]: %22.18g   %22.18g\n",
+                       desc, N, N, i, j, Lij, Vij);
+        }
+    }
+
+  gsl_matrix_free(V);
+  gsl_matrix_free(L);
+  gsl_vector_free(AP);
+
+  return s;
+}
+
+static int
+test_ldlt_packed_decomp(gsl_rng * r)
+{
+  int s = 0;
+  const size_t N_max = 50;
+  size_t N;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+
+      create_posdef_matrix(m, r);
+      s += test_ldlt_packed_decomp_eps(m, 1.0e3 * N * GSL_DBL_EPSILON, "ldlt_packed_decomp random");
+
+      gsl_matrix_free(m);
+    }
+
+  return s;
+}
+
+static int
+test_ldlt_packed_solve(gsl_rng * r)
+{
+  int s = 0;
+  const size_t N_max = 50;
+  size_t N, i;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+      gsl_vector * AP = gsl_vector_alloc(N * (N + 1) / 2);
+      gsl_vector * rhs = gsl_vector_alloc(N);
+      gsl_vector * sol = gsl_vector_alloc(N);
+      gsl_vector * x = gsl_vector_alloc(N);
+
+      create_posdef_matrix(m, r);
+      create_random_vector(sol, r);
+      gsl_blas_dsymv(CblasLower, 1.0, m, sol, 0.0, rhs);
+
+      tri2packed_matrix(CblasLower, m, AP);
+      s += gsl_linalg_ldlt_packed_decomp(AP);
+      s += gsl_linalg_ldlt_packed_solve(AP, rhs, x);
+
+      for (i = 0; i < N; i++)
+        {
+          double xi = gsl_vector_get(x, i);
+          double yi = gsl_vector_get(sol, i);
+
+          gsl_test_rel(xi, yi, 64.0 * N * GSL_DBL_EPSILON,
+                       "ldlt_packed_solve random: %3zu[%zu]: %22.18g   %22.18g\n",
+                       N, i, xi, yi);
+        }
+
+      gsl_matrix_free(m);
+      gsl_vector_free(AP);
+      gsl_vector_free(rhs);
+      gsl_vector_free(sol);
+      gsl_vector_free(x);
+    }
+
+  return s;
+}
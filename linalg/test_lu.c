@@ -149,6 +149,164 @@ test_LU_decomp(gsl_rng * r)
   return s;
 }
 
+/* compare the tiled LU decomposition with gsl_linalg_LU_decomp */
+static int
+test_LU_decomp_tiled_eps(const gsl_matrix * m, const size_t nthreads,
+                         const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t N = m->size1;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_matrix * B = gsl_matrix_alloc(N, N);
+  gsl_permutation * p = gsl_permutation_alloc(N);
+  gsl_permutation * q = gsl_permutation_alloc(N);
+  int signum, signum_tiled;
+  size_t i, j;
+
+  gsl_matrix_memcpy(A, m);
+  gsl_linalg_LU_decomp(A, p, &signum);
+
+  gsl_matrix_memcpy(B, m);
+  s += gsl_linalg_LU_decomp_tiled(B, q, &signum_tiled, nthreads);
+
+  gsl_test(signum != signum_tiled, "%s: (%zu,%zu) nthreads=%zu signum", desc, N, N, nthreads);
+
+  for (i = 0; i < N; ++i)
+    {
+      size_t pi = gsl_permutation_get(p, i);
+      size_t qi = gsl_permutation_get(q, i);
+
+      gsl_test(pi != qi, "%s: (%zu,%zu) nthreads=%zu p[%zu]", desc, N, N, nthreads, i);
+
+      for (j = 0; j < N; ++j)
+        {
+          double aij = gsl_matrix_get(A, i, j);
+          double bij = gsl_matrix_get(B, i, j);
+
+          gsl_test_rel(bij, aij, eps, "%s: (%zu,%zu) nthreads=%zu [%zu,%zu]",
+                       desc, N, N, nthreads, i, j);
+        }
+    }
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(B);
+  gsl_permutation_free(p);
+  gsl_permutation_free(q);
+
+  return s;
+}
+
+static int
+test_LU_decomp_tiled(gsl_rng * r)
+{
+  int s = 0;
+  const size_t sizes[] = { 100, 300, 457, 640 };
+  size_t i;
+
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+      const size_t N = sizes[i];
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+
+      create_random_matrix(m, r);
+      s += test_LU_decomp_tiled_eps(m, 1, 1.0e5 * N * GSL_DBL_EPSILON, "LU_decomp_tiled random");
+      s += test_LU_decomp_tiled_eps(m, 4, 1.0e5 * N * GSL_DBL_EPSILON, "LU_decomp_tiled random");
+
+      gsl_matrix_free(m);
+    }
+
+  return s;
+}
+
+/* compare the batched LU decomposition and solve with gsl_linalg_LU_decomp */
+static int
+test_LU_batch_eps(const size_t N, const size_t nbatch, const double eps,
+                  const char * desc, gsl_rng * r)
+{
+  int s = 0;
+  gsl_matrix * A = gsl_matrix_alloc(nbatch * N, N);
+  gsl_matrix * LU = gsl_matrix_alloc(nbatch * N, N);
+  gsl_vector_uint * ipiv = gsl_vector_uint_alloc(nbatch * N);
+  gsl_vector * sol = gsl_vector_alloc(nbatch * N);
+  gsl_vector * rhs = gsl_vector_alloc(nbatch * N);
+  gsl_vector * x = gsl_vector_alloc(nbatch * N);
+  gsl_matrix * B = gsl_matrix_alloc(N, N);
+  gsl_permutation * p = gsl_permutation_alloc(N);
+  int signum;
+  size_t b, i, j;
+
+  create_random_matrix(A, r);
+  create_random_vector(sol, r);
+
+  for (b = 0; b < nbatch; ++b)
+    {
+      gsl_matrix_view Ab = gsl_matrix_submatrix(A, b * N, 0, N, N);
+      gsl_vector_view sb = gsl_vector_subvector(sol, b * N, N);
+      gsl_vector_view rb = gsl_vector_subvector(rhs, b * N, N);
+
+      gsl_blas_dgemv(CblasNoTrans, 1.0, &Ab.matrix, &sb.vector, 0.0, &rb.vector);
+    }
+
+  gsl_matrix_memcpy(LU, A);
+  s += gsl_linalg_LU_decomp_batch(LU, ipiv);
+  s += gsl_linalg_LU_solve_batch(LU, ipiv, rhs, x);
+
+  for (b = 0; b < nbatch; ++b)
+    {
+      gsl_matrix_const_view Ab = gsl_matrix_const_submatrix(A, b * N, 0, N, N);
+
+      gsl_matrix_memcpy(B, &Ab.matrix);
+      gsl_linalg_LU_decomp(B, p, &signum);
+
+      for (i = 0; i < N; ++i)
+        {
+          double xi = gsl_vector_get(x, b * N + i);
+          double yi = gsl_vector_get(sol, b * N + i);
+
+          gsl_test_rel(xi, yi, eps, "%s: N=%zu nbatch=%zu solve[%zu,%zu]",
+                       desc, N, nbatch, b, i);
+
+          for (j = 0; j < N; ++j)
+            {
+              double aij = gsl_matrix_get(B, i, j);
+              double bij = gsl_matrix_get(LU, b * N + i, j);
+
+              gsl_test_rel(bij, aij, eps, "%s: N=%zu nbatch=%zu LU[%zu](%zu,%zu)",
+                           desc, N, nbatch, b, i, j);
+            }
+        }
+    }
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(LU);
+  gsl_vector_uint_free(ipiv);
+  gsl_vector_free(sol);
+  gsl_vector_free(rhs);
+  gsl_vector_free(x);
+  gsl_matrix_free(B);
+  gsl_permutation_free(p);
+
+  return s;
+}
+
+static int
+test_LU_batch(gsl_rng * r)
+{
+  int s = 0;
+  const size_t sizes[] = { 1, 4, 7, 16 };
+  const size_t nbatch[] = { 1, 8, 29 };
+  size_t i, j;
+
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+      for (j = 0; j < sizeof(nbatch) / sizeof(nbatch[0]); ++j)
+        s += test_LU_batch_eps(sizes[i], nbatch[j], 1.0e5 * sizes[i] * GSL_DBL_EPSILON,
+                               "LU_batch random", r);
+    }
+
+  return s;
+}
+
 static int
 test_LU_solve_eps(const gsl_matrix * m, const gsl_vector * rhs, const gsl_vector * sol, const double eps, const char * desc)
 {
@@ -286,3 +444,284 @@ test_LU_invert(gsl_rng * r)
 
   return s;
 }
+
+static int
+test_LU_band_decomp_eps(const size_t p, const size_t q, const gsl_matrix * m,
+                        const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t M = m->size1;
+  const size_t N = m->size2;
+  const size_t minMN = GSL_MIN(M, N);
+  gsl_matrix * AB = gsl_matrix_alloc(N, 2 * p + q + 1);
+  gsl_vector_uint * piv = gsl_vector_uint_alloc(minMN);
+  gsl_matrix * L = gsl_matrix_alloc(M, minMN);
+  gsl_matrix * U = gsl_matrix_alloc(minMN, N);
+  gsl_matrix * A = gsl_matrix_alloc(M, N);
+  gsl_matrix * B = gsl_matrix_alloc(M, N);
+  size_t i, j;
+
+  gen2band_matrix(p, q, m, AB);
+
+  s += gsl_linalg_LU_band_decomp(M, p, q, AB, piv);
+  s += gsl_linalg_LU_band_unpack(M, p, q, AB, piv, L, U);
+
+  /* B = L U */
+  gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, L, U, 0.0, B);
+
+  /* A = P m */
+  gsl_matrix_memcpy(A, m);
+  for (i = 0; i < minMN; ++i)
+    {
+      size_t pi = gsl_vector_uint_get(piv, i);
+
+      if (pi != i)
+        gsl_matrix_swap_rows(A, i, pi);
+    }
+
+  for (i = 0; i < M; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double aij = gsl_matrix_get(A, i, j);
+          double bij = gsl_matrix_get(B, i, j);
+
+          gsl_test_rel(bij, aij, eps, "%s: (%zu,%zu) p=%zu q=%zu [%zu,%zu]: %22.18g   %22.18g\n",
+                       desc, M, N, p, q, i, j, bij, aij);
+        }
+    }
+
+  gsl_matrix_free(AB);
+  gsl_vector_uint_free(piv);
+  gsl_matrix_free(L);
+  gsl_matrix_free(U);
+  gsl_matrix_free(A);
+  gsl_matrix_free(B);
+
+  return s;
+}
+
+static int
+test_LU_band_decomp(gsl_rng * r)
+{
+  int s = 0;
+  const size_t N_max = 20;
+  size_t M, N, p, q;
+
+  for (M = 1; M <= N_max; ++M)
+    {
+      for (N = 1; N <= N_max; N += 3)
+        {
+          gsl_matrix * m = gsl_matrix_alloc(M, N);
+
+          for (p = 0; p < GSL_MIN(M, 5); ++p)
+            {
+              for (q = 0; q < GSL_MIN(N, 4); ++q)
+                {
+                  create_band_matrix(p, q, m, r);
+                  s += test_LU_band_decomp_eps(p, q, m, 1.0e3 * GSL_MAX(M, N) * GSL_DBL_EPSILON,
+                                               "LU_band_decomp random");
+                }
+            }
+
+          gsl_matrix_free(m);
+        }
+    }
+
+  return s;
+}
+
+/* compare the banded solve with gsl_linalg_LU_solve, which chooses the
+ * same pivots; random banded matrices are often badly conditioned, so
+ * the exact solution is not a useful reference */
+static int
+test_LU_band_solve_eps(const size_t p, const size_t q, const gsl_matrix * m,
+                       const gsl_vector * rhs, const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t N = m->size1;
+  gsl_matrix * AB = gsl_matrix_alloc(N, 2 * p + q + 1);
+  gsl_vector_uint * piv = gsl_vector_uint_alloc(N);
+  gsl_vector * x = gsl_vector_alloc(N);
+  gsl_matrix * LU = gsl_matrix_alloc(N, N);
+  gsl_permutation * perm = gsl_permutation_alloc(N);
+  gsl_vector * y = gsl_vector_alloc(N);
+  int signum;
+  size_t i;
+
+  gen2band_matrix(p, q, m, AB);
+
+  s += gsl_linalg_LU_band_decomp(N, p, q, AB, piv);
+  s += gsl_linalg_LU_band_solve(p, q, AB, piv, rhs, x);
+
+  gsl_matrix_memcpy(LU, m);
+  gsl_linalg_LU_decomp(LU, perm, &signum);
+  gsl_linalg_LU_solve(LU, perm, rhs, y);
+
+  for (i = 0; i < N; ++i)
+    {
+      double xi = gsl_vector_get(x, i);
+      double yi = gsl_vector_get(y, i);
+
+      gsl_test_rel(xi, yi, eps, "%s: N=%zu p=%zu q=%zu [%zu]: %22.18g   %22.18g\n",
+                   desc, N, p, q, i, xi, yi);
+    }
+
+  gsl_matrix_free(AB);
+  gsl_vector_uint_free(piv);
+  gsl_vector_free(x);
+  gsl_matrix_free(LU);
+  gsl_permutation_free(perm);
+  gsl_vector_free(y);
+
+  return s;
+}
+
+static int
+test_LU_band_solve(gsl_rng * r)
+{
+  int s = 0;
+  const size_t N_max = 50;
+  size_t N, p, q;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+      gsl_vector * rhs = gsl_vector_alloc(N);
+
+      for (p = 0; p < GSL_MIN(N, 6); ++p)
+        {
+          for (q = 0; q < GSL_MIN(N, 6); ++q)
+            {
+              create_band_matrix(p, q, m, r);
+              create_random_vector(rhs, r);
+
+              s += test_LU_band_solve_eps(p, q, m, rhs, 1.0e3 * N * GSL_DBL_EPSILON,
+                                          "LU_band_solve random");
+            }
+        }
+
+      gsl_matrix_free(m);
+      gsl_vector_free(rhs);
+    }
+
+  return s;
+}
+
+/* compare the mixed precision solution with gsl_linalg_LU_solve */
+static int
+test_LU_solve_mixed_eps(const gsl_matrix * m, const gsl_vector * rhs,
+                        const int fallback, const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t N = m->size1;
+  gsl_vector * x = gsl_vector_alloc(N);
+  gsl_matrix * LU = gsl_matrix_alloc(N, N);
+  gsl_permutation * perm = gsl_permutation_alloc(N);
+  gsl_vector * y = gsl_vector_alloc(N);
+  int signum, iter;
+  size_t i;
+
+  s += gsl_linalg_LU_solve_mixed(m, rhs, x, &iter);
+
+  gsl_matrix_memcpy(LU, m);
+  gsl_linalg_LU_decomp(LU, perm, &signum);
+  gsl_linalg_LU_solve(LU, perm, rhs, y);
+
+  if (fallback >= 0)
+    {
+      gsl_test(fallback != (iter < 0), "%s: N=%zu iter=%d", desc, N, iter);
+      s += fallback != (iter < 0);
+    }
+
+  for (i = 0; i < N; ++i)
+    {
+      double xi = gsl_vector_get(x, i);
+      double yi = gsl_vector_get(y, i);
+
+      gsl_test_rel(xi, yi, eps, "%s: N=%zu iter=%d [%zu]: %22.18g   %22.18g\n",
+                   desc, N, iter, i, xi, yi);
+    }
+
+  gsl_vector_free(x);
+  gsl_matrix_free(LU);
+  gsl_permutation_free(perm);
+  gsl_vector_free(y);
+
+  return s;
+}
+
+static int
+test_LU_solve_mixed_random(const size_t N, gsl_rng * r)
+{
+  int s = 0;
+  gsl_matrix * m = gsl_matrix_alloc(N, N);
+  gsl_vector * rhs = gsl_vector_alloc(N);
+  size_t i;
+
+  create_random_matrix(m, r);
+  create_random_vector(rhs, r);
+  s += test_LU_solve_mixed_eps(m, rhs, -1, 1.0e4 * N * GSL_DBL_EPSILON,
+                               "LU_solve_mixed random");
+
+  /* diagonally dominant: refinement must converge; for small N even
+   * the correctly rounded solution may miss the stopping criterion,
+   * which only has the slack sqrt(N), and fall back to double */
+  for (i = 0; i < N; ++i)
+    *gsl_matrix_ptr(m, i, i) += (double) N;
+
+  s += test_LU_solve_mixed_eps(m, rhs, N >= 10 ? 0 : -1, 1.0e2 * N * GSL_DBL_EPSILON,
+                               "LU_solve_mixed diag dominant");
+
+  gsl_matrix_free(m);
+  gsl_vector_free(rhs);
+
+  return s;
+}
+
+static int
+test_LU_solve_mixed(gsl_rng * r)
+{
+  int s = 0;
+  const size_t N_max = 50;
+  size_t N;
+
+  for (N = 1; N <= N_max; ++N)
+    s += test_LU_solve_mixed_random(N, r);
+
+  s += test_LU_solve_mixed_random(100, r);
+  s += test_LU_solve_mixed_random(257, r);
+
+  /* Hilbert matrices beyond single precision: fall back to double */
+  for (N = 10; N <= 12; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+      gsl_vector * rhs = gsl_vector_alloc(N);
+
+      create_hilbert_matrix2(m);
+      create_random_vector(rhs, r);
+      s += test_LU_solve_mixed_eps(m, rhs, 1, GSL_DBL_EPSILON,
+                                   "LU_solve_mixed hilbert");
+
+      gsl_matrix_free(m);
+      gsl_vector_free(rhs);
+    }
+
+  /* elements beyond FLT_MAX: fall back to double without demoting A */
+  {
+    const size_t N = 20;
+    gsl_matrix * m = gsl_matrix_alloc(N, N);
+    gsl_vector * rhs = gsl_vector_alloc(N);
+
+    create_random_matrix(m, r);
+    create_random_vector(rhs, r);
+    gsl_matrix_scale(m, 1.0e300);
+    s += test_LU_solve_mixed_eps(m, rhs, 1, 1.0e4 * N * GSL_DBL_EPSILON,
+                                 "LU_solve_mixed overflow");
+
+    gsl_matrix_free(m);
+    gsl_vector_free(rhs);
+  }
+
+  return s;
+}
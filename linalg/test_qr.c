@@ -246,15 +246,20 @@ test_QR_QTmat_r_eps(const gsl_matrix * A, const gsl_matrix * B, const double eps
   /* compute Q^T B with both recursive and non-recursive methods and compare */
   s += gsl_linalg_QR_QTmat_r(QR, T, B1, work);
   s += gsl_linalg_QR_QTmat(QR, &tau.vector, B2);
-  
-  for (i = 0; i < M; i++)
+
+  /* Q is orthogonal, so the errors in column j scale with ||B(:,j)||,
+   * also for the elements which are small through cancellation */
+  for (j = 0; j < K; j++)
     {
-      for (j = 0; j < K; j++)
+      gsl_vector_const_view bj = gsl_matrix_const_column(B, j);
+      double bnorm = gsl_blas_dnrm2(&bj.vector);
+
+      for (i = 0; i < M; i++)
         {
           double aij = gsl_matrix_get(B1, i, j);
           double bij = gsl_matrix_get(B2, i, j);
 
-          gsl_test_rel(aij, bij, eps, "%s (%3lu,%3lu)[%lu,%lu]: %22.18g   %22.18g\n",
+          gsl_test_abs(aij, bij, eps * bnorm, "%s (%3lu,%3lu)[%lu,%lu]: %22.18g   %22.18g\n",
                        desc, M, K, i,j, aij, bij);
         }
     }
@@ -446,3 +451,126 @@ test_QR_lssolve_r(gsl_rng * r)
 
   return s;
 }
+
+/* slide a window of W rows down [A b] with gsl_linalg_R_append_row() and
+ * gsl_linalg_R_delete_row(), and compare the least squares solution of the
+ * last window with QR_lssolve_r */
+static int
+test_R_update_eps(const gsl_matrix * A, const gsl_vector * b, const size_t W,
+                  const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  gsl_matrix * R = gsl_matrix_calloc(N + 1, N + 1);
+  gsl_vector * row = gsl_vector_alloc(N + 1);
+  gsl_vector * work = gsl_vector_alloc(N + 1);
+  gsl_vector * c = gsl_vector_alloc(N);
+  gsl_matrix * QR = gsl_matrix_alloc(W, N);
+  gsl_matrix * T = gsl_matrix_alloc(N, N);
+  gsl_vector * x = gsl_vector_alloc(W);
+  gsl_vector * lswork = gsl_vector_alloc(N);
+  gsl_matrix_const_view Aw = gsl_matrix_const_submatrix(A, M - W, 0, W, N);
+  gsl_vector_const_view bw = gsl_vector_const_subvector(b, M - W, W);
+  gsl_matrix_view R11 = gsl_matrix_submatrix(R, 0, 0, N, N);
+  size_t i, k;
+
+  for (k = 0; k < M; ++k)
+    {
+      if (k >= W)
+        {
+          /* delete the oldest row of the window */
+          gsl_vector_view v = gsl_vector_subvector(row, 0, N);
+          gsl_matrix_get_row(&v.vector, A, k - W);
+          gsl_vector_set(row, N, gsl_vector_get(b, k - W));
+          s += gsl_linalg_R_delete_row(R, row, work);
+        }
+
+      {
+        gsl_vector_view v = gsl_vector_subvector(row, 0, N);
+        gsl_matrix_get_row(&v.vector, A, k);
+        gsl_vector_set(row, N, gsl_vector_get(b, k));
+        s += gsl_linalg_R_append_row(R, row);
+      }
+    }
+
+  for (i = 0; i < N; i++)
+    gsl_vector_set(c, i, gsl_matrix_get(R, i, N));
+
+  s += gsl_linalg_R_svx(&R11.matrix, c);
+
+  gsl_matrix_memcpy(QR, &Aw.matrix);
+  s += gsl_linalg_QR_decomp_r(QR, T);
+  s += gsl_linalg_QR_lssolve_r(QR, T, &bw.vector, x, lswork);
+
+  for (i = 0; i < N; i++)
+    {
+      double ci = gsl_vector_get(c, i);
+      double xi = gsl_vector_get(x, i);
+
+      gsl_test_rel(ci, xi, eps, "%s (%3zu,%3zu,%3zu)[%zu]: %22.18g   %22.18g\n",
+                   desc, M, N, W, i, ci, xi);
+    }
+
+  if (W > N)
+    {
+      gsl_vector_view x2 = gsl_vector_subvector(x, N, W - N);
+      double rnorm = fabs(gsl_matrix_get(R, N, N));
+      double rnorm_expected = gsl_blas_dnrm2(&x2.vector);
+
+      gsl_test_rel(rnorm, rnorm_expected, eps, "%s rnorm (%3lu,%3lu,%3lu): %22.18g   %22.18g\n",
+                   desc, M, N, W, rnorm, rnorm_expected);
+    }
+
+  gsl_matrix_free(R);
+  gsl_vector_free(row);
+  gsl_vector_free(work);
+  gsl_vector_free(c);
+  gsl_matrix_free(QR);
+  gsl_matrix_free(T);
+  gsl_vector_free(x);
+  gsl_vector_free(lswork);
+
+  return s;
+}
+
+static int
+test_R_update(gsl_rng * r)
+{
+  int s = 0;
+  size_t N;
+
+  for (N = 1; N <= 20; ++N)
+    {
+      const size_t M = 4 * N + 10;
+      const size_t W = 2 * N + 3;
+      gsl_matrix * A = gsl_matrix_alloc(M, N);
+      gsl_vector * b = gsl_vector_alloc(M);
+
+      create_random_matrix(A, r);
+      create_random_vector(b, r);
+
+      s += test_R_update_eps(A, b, W, 1.0e5 * M * GSL_DBL_EPSILON, "R_update random");
+
+      gsl_matrix_free(A);
+      gsl_vector_free(b);
+    }
+
+  {
+    /* deleting a row which is not in A must fail and leave R unchanged */
+    double Rdat[] = { 3.0, 1.0, 0.0, 2.0 };
+    double xdat[] = { 4.0, 0.0 };
+    gsl_matrix_view Rv = gsl_matrix_view_array(Rdat, 2, 2);
+    gsl_vector_view xv = gsl_vector_view_array(xdat, 2);
+    gsl_vector * work = gsl_vector_alloc(2);
+    int status = gsl_linalg_R_delete_row(&Rv.matrix, &xv.vector, work);
+
+    gsl_test(status != GSL_EDOM, "R_delete_row not positive definite status");
+    gsl_test(Rdat[0] != 3.0 || Rdat[1] != 1.0 || Rdat[3] != 2.0,
+             "R_delete_row not positive definite R unchanged");
+
+    gsl_vector_free(work);
+  }
+
+  return s;
+}
@@ -0,0 +1,206 @@
+/* linalg/test_qrc.c
+ *
+ * Copyright (C) 2019 Patrick Alken
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_ieee_utils.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_complex_math.h>
+
+static int
+test_QRc_decomp_r_eps(const gsl_matrix_complex * m, const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t M = m->size1;
+  const size_t N = m->size2;
+  size_t i, j;
+
+  gsl_matrix_complex * QR = gsl_matrix_complex_alloc(M, N);
+  gsl_matrix_complex * T = gsl_matrix_complex_alloc(N, N);
+  gsl_matrix_complex * A  = gsl_matrix_complex_alloc(M, N);
+  gsl_matrix_complex * R  = gsl_matrix_complex_alloc(N, N);
+  gsl_matrix_complex * Q  = gsl_matrix_complex_alloc(M, M);
+  gsl_matrix_complex * QHQ  = gsl_matrix_complex_alloc(M, M);
+  gsl_matrix_complex_view Q1 = gsl_matrix_complex_submatrix(Q, 0, 0, M, N);
+
+  gsl_matrix_complex_memcpy(QR, m);
+
+  s += gsl_linalg_complex_QR_decomp_r(QR, T);
+  s += gsl_linalg_complex_QR_unpack_r(QR, T, Q, R);
+
+  /* compute A = Q R */
+  gsl_matrix_complex_memcpy(A, &Q1.matrix);
+  gsl_blas_ztrmm (CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit, GSL_COMPLEX_ONE, R, A);
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          gsl_complex aij = gsl_matrix_complex_get(A, i, j);
+          gsl_complex mij = gsl_matrix_complex_get(m, i, j);
+
+          gsl_test_abs(GSL_REAL(aij), GSL_REAL(mij), eps,
+                       "%s real (%3zu,%3zu)[%zu,%zu]: %22.18g   %22.18g\n",
+                       desc, M, N, i, j, GSL_REAL(aij), GSL_REAL(mij));
+
+          gsl_test_abs(GSL_IMAG(aij), GSL_IMAG(mij), eps,
+                       "%s imag (%3zu,%3zu)[%zu,%zu]: %22.18g   %22.18g\n",
+                       desc, M, N, i, j, GSL_IMAG(aij), GSL_IMAG(mij));
+        }
+    }
+
+  /* test that R has a real diagonal and Q is unitary */
+  for (i = 0; i < N; i++)
+    {
+      gsl_complex rii = gsl_matrix_complex_get(R, i, i);
+
+      gsl_test_abs(GSL_IMAG(rii), 0.0, eps, "%s R (%3zu,%3zu)[%zu,%zu] imag",
+                   desc, M, N, i, i);
+    }
+
+  gsl_matrix_complex_set_identity(QHQ);
+  gsl_blas_zgemm(CblasConjTrans, CblasNoTrans, GSL_COMPLEX_ONE, Q, Q, GSL_COMPLEX_NEGONE, QHQ);
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < M; j++)
+        {
+          gsl_complex zij = gsl_matrix_complex_get(QHQ, i, j);
+
+          gsl_test_abs(gsl_complex_abs(zij), 0.0, eps,
+                       "%s Q^H Q (%3zu,%3zu)[%zu,%zu]", desc, M, N, i, j);
+        }
+    }
+
+  gsl_matrix_complex_free(QR);
+  gsl_matrix_complex_free(T);
+  gsl_matrix_complex_free(A);
+  gsl_matrix_complex_free(Q);
+  gsl_matrix_complex_free(R);
+  gsl_matrix_complex_free(QHQ);
+
+  return s;
+}
+
+static int
+test_QRc_decomp_r(gsl_rng * r)
+{
+  int s = 0;
+  size_t M, N;
+
+  for (M = 1; M <= 40; ++M)
+    {
+      for (N = 1; N <= M; ++N)
+        {
+          gsl_matrix_complex * A = gsl_matrix_complex_alloc(M, N);
+
+          create_random_complex_matrix(A, r);
+          s += test_QRc_decomp_r_eps(A, 1.0e2 * M * GSL_DBL_EPSILON, "complex_QR_decomp_r random");
+
+          gsl_matrix_complex_free(A);
+        }
+    }
+
+  return s;
+}
+
+static int
+test_QRc_solve_r_eps(const gsl_matrix_complex * A, const gsl_vector_complex * rhs,
+                     const gsl_vector_complex * sol, const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  size_t i;
+
+  gsl_matrix_complex * QR = gsl_matrix_complex_alloc(M, N);
+  gsl_matrix_complex * T = gsl_matrix_complex_alloc(N, N);
+  gsl_vector_complex * x = gsl_vector_complex_alloc(M);
+  gsl_vector_complex * work = gsl_vector_complex_alloc(N);
+
+  gsl_matrix_complex_memcpy(QR, A);
+
+  s += gsl_linalg_complex_QR_decomp_r(QR, T);
+
+  if (M == N)
+    s += gsl_linalg_complex_QR_solve_r(QR, T, rhs, x);
+  else
+    s += gsl_linalg_complex_QR_lssolve_r(QR, T, rhs, x, work);
+
+  for (i = 0; i < N; i++)
+    {
+      gsl_complex xi = gsl_vector_complex_get(x, i);
+      gsl_complex yi = gsl_vector_complex_get(sol, i);
+
+      gsl_test_rel(GSL_REAL(xi), GSL_REAL(yi), eps,
+                   "%s real (%3zu,%3zu)[%zu]: %22.18g   %22.18g\n",
+                   desc, M, N, i, GSL_REAL(xi), GSL_REAL(yi));
+
+      gsl_test_rel(GSL_IMAG(xi), GSL_IMAG(yi), eps,
+                   "%s imag (%3zu,%3zu)[%zu]: %22.18g   %22.18g\n",
+                   desc, M, N, i, GSL_IMAG(xi), GSL_IMAG(yi));
+    }
+
+  gsl_matrix_complex_free(QR);
+  gsl_matrix_complex_free(T);
+  gsl_vector_complex_free(x);
+  gsl_vector_complex_free(work);
+
+  return s;
+}
+
+static int
+test_QRc_solve_r(gsl_rng * r)
+{
+  int s = 0;
+  size_t M, N;
+
+  /* square systems are solved with complex_QR_solve_r, and consistent
+   * overdetermined systems with complex_QR_lssolve_r */
+  for (M = 1; M <= 40; ++M)
+    {
+      for (N = GSL_MAX(M / 2, 1); N <= M; N += GSL_MAX(M / 4, 1))
+        {
+          gsl_matrix_complex * A = gsl_matrix_complex_alloc(M, N);
+          gsl_vector_complex * sol = gsl_vector_complex_alloc(N);
+          gsl_vector_complex * rhs = gsl_vector_complex_alloc(M);
+
+          gsl_vector_complex_view d = gsl_matrix_complex_diagonal(A);
+
+          /* shift the diagonal so that A is well conditioned */
+          create_random_complex_matrix(A, r);
+          gsl_vector_complex_add_constant(&d.vector, gsl_complex_rect((double) M, 0.0));
+          create_random_complex_vector(sol, r);
+          gsl_blas_zgemv(CblasNoTrans, GSL_COMPLEX_ONE, A, sol, GSL_COMPLEX_ZERO, rhs);
+
+          s += test_QRc_solve_r_eps(A, rhs, sol, 1.0e4 * M * GSL_DBL_EPSILON,
+                                    (M == N) ? "complex_QR_solve_r random" : "complex_QR_lssolve_r random");
+
+          gsl_matrix_complex_free(A);
+          gsl_vector_complex_free(sol);
+          gsl_vector_complex_free(rhs);
+        }
+    }
+
+  return s;
+}
@@ -0,0 +1,223 @@
+/* linalg/tiled.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Task scheduler for the tiled factorizations. Ready tasks are kept in
+ * a first-in first-out queue, so that tasks of earlier steps of the
+ * factorization, which lie on the critical path, tend to run first.
+ * The worker threads are started for each factorization and joined at
+ * the end; without thread support all tasks run on the calling thread
+ * in the same order.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+
+#include "tiled.h"
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
+struct linalg_tiled_sched
+{
+  linalg_tiled_task *queue;     /* ready tasks, queue[head..tail) */
+  size_t head;
+  size_t tail;
+  size_t ntasks;                /* total number of tasks */
+  size_t ndone;                 /* number of completed tasks */
+  int status;                   /* first error returned by a task */
+  linalg_tiled_run run;
+  linalg_tiled_done done;
+  void *params;
+#ifdef HAVE_PTHREAD
+  pthread_mutex_t lock;
+  pthread_cond_t ready;         /* signalled when a task is pushed or
+                                 * the factorization ends */
+#endif
+};
+
+static void *tiled_worker (void *p);
+
+void
+linalg_tiled_push (linalg_tiled_sched * sched, const int type,
+                   const size_t i, const size_t j, const size_t k)
+{
+  linalg_tiled_task *t = &sched->queue[sched->tail++];
+
+  t->type = type;
+  t->i = i;
+  t->j = j;
+  t->k = k;
+
+#ifdef HAVE_PTHREAD
+  pthread_cond_signal (&sched->ready);
+#endif
+}
+
+/*
+linalg_tiled_execute()
+  Run a task graph
+
+Inputs: nthreads - number of threads, including the calling thread
+        ntasks   - total number of tasks in the graph
+        task0    - first task, which has no dependencies
+        run      - function which runs a task
+        done     - function which records the completion of a task
+                   and pushes its successors
+        params   - parameters passed to run and done
+
+Return: success/error
+*/
+
+int
+linalg_tiled_execute (const size_t nthreads, const size_t ntasks,
+                      const linalg_tiled_task * task0,
+                      linalg_tiled_run run, linalg_tiled_done done,
+                      void * params)
+{
+  linalg_tiled_sched sched;
+
+  sched.queue = malloc (ntasks * sizeof (linalg_tiled_task));
+  if (sched.queue == NULL)
+    {
+      GSL_ERROR ("failed to allocate space for task queue", GSL_ENOMEM);
+    }
+
+  sched.queue[0] = *task0;
+  sched.head = 0;
+  sched.tail = 1;
+  sched.ntasks = ntasks;
+  sched.ndone = 0;
+  sched.status = GSL_SUCCESS;
+  sched.run = run;
+  sched.done = done;
+  sched.params = params;
+
+#ifdef HAVE_PTHREAD
+  {
+    pthread_t *threads = NULL;
+    size_t nstarted = 0;
+    size_t i;
+
+    pthread_mutex_init (&sched.lock, NULL);
+    pthread_cond_init (&sched.ready, NULL);
+
+    if (nthreads > 1)
+      threads = malloc ((nthreads - 1) * sizeof (pthread_t));
+
+    if (threads != NULL)
+      {
+        for (i = 0; i < nthreads - 1; ++i)
+          {
+            if (pthread_create (&threads[i], NULL, tiled_worker, &sched) != 0)
+              break;
+
+            ++nstarted;
+          }
+      }
+
+    /* the calling thread works too, and runs everything if no worker
+     * could be started */
+    tiled_worker (&sched);
+
+    for (i = 0; i < nstarted; ++i)
+      pthread_join (threads[i], NULL);
+
+    free (threads);
+    pthread_cond_destroy (&sched.ready);
+    pthread_mutex_destroy (&sched.lock);
+  }
+#else
+  (void) nthreads;
+  tiled_worker (&sched);
+#endif
+
+  free (sched.queue);
+
+  return sched.status;
+}
+
+static void *
+tiled_worker (void *p)
+{
+  linalg_tiled_sched *sched = (linalg_tiled_sched *) p;
+
+#ifdef HAVE_PTHREAD
+  pthread_mutex_lock (&sched->lock);
+#endif
+
+  for (;;)
+    {
+      linalg_tiled_task task;
+      int status;
+
+      if (sched->ndone == sched->ntasks || sched->status != GSL_SUCCESS)
+        break;
+
+      if (sched->head == sched->tail)
+        {
+#ifdef HAVE_PTHREAD
+          pthread_cond_wait (&sched->ready, &sched->lock);
+          continue;
+#else
+          /* cannot happen in a consistent task graph */
+          sched->status = GSL_ESANITY;
+          break;
+#endif
+        }
+
+      task = sched->queue[sched->head++];
+
+#ifdef HAVE_PTHREAD
+      pthread_mutex_unlock (&sched->lock);
+#endif
+
+      status = (sched->run) (&task, sched->params);
+
+#ifdef HAVE_PTHREAD
+      pthread_mutex_lock (&sched->lock);
+#endif
+
+      if (status != GSL_SUCCESS)
+        {
+          if (sched->status == GSL_SUCCESS)
+            sched->status = status;
+        }
+      else
+        {
+          (sched->done) (&task, sched->params, sched);
+          ++(sched->ndone);
+        }
+
+#ifdef HAVE_PTHREAD
+      /* wake up waiting threads so they can exit */
+      if (sched->ndone == sched->ntasks || sched->status != GSL_SUCCESS)
+        pthread_cond_broadcast (&sched->ready);
+#endif
+    }
+
+#ifdef HAVE_PTHREAD
+  pthread_mutex_unlock (&sched->lock);
+#endif
+
+  return NULL;
+}
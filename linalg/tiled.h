@@ -0,0 +1,68 @@
+/* linalg/tiled.h
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Internal interface to the task scheduler used by the tiled
+ * factorizations.
+ *
+ * A factorization is described as a set of tasks, each acting on a
+ * few tiles of the matrix. The scheduler starts from a list of tasks
+ * which are ready to run, and runs them on a group of threads. When a
+ * task completes, the done() callback of the factorization is called
+ * with the scheduler lock held; it records the completion and pushes
+ * every task whose dependencies are now satisfied with
+ * linalg_tiled_push(). Each task must be pushed exactly once, and the
+ * scheduler returns when ntasks tasks have completed or a task has
+ * returned an error.
+ */
+
+#ifndef __LINALG_TILED_H__
+#define __LINALG_TILED_H__
+
+#include <stddef.h>
+
+/* tile size of the tiled factorizations */
+#define TILE_SIZE 128
+
+typedef struct
+{
+  int type;
+  size_t i, j, k;
+} linalg_tiled_task;
+
+typedef struct linalg_tiled_sched linalg_tiled_sched;
+
+/* run a task; returns GSL_SUCCESS or an error code, which stops the
+ * scheduler */
+typedef int (*linalg_tiled_run) (const linalg_tiled_task * task, void * params);
+
+/* record the completion of a task and push its successors; called with
+ * the scheduler lock held */
+typedef void (*linalg_tiled_done) (const linalg_tiled_task * task, void * params,
+                                   linalg_tiled_sched * sched);
+
+int linalg_tiled_execute (const size_t nthreads, const size_t ntasks,
+                          const linalg_tiled_task * task0,
+                          linalg_tiled_run run, linalg_tiled_done done,
+                          void * params);
+
+void linalg_tiled_push (linalg_tiled_sched * sched, const int type,
+                        const size_t i, const size_t j, const size_t k);
+
+#endif /* __LINALG_TILED_H__ */
@@ -0,0 +1,172 @@
+/* linalg/tri_packed.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <math.h>
+
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_cblas.h>
+
+#include "packed.h"
+
+static int tri_packed_singular (CBLAS_UPLO_t Uplo, const size_t N, const double * ap);
+
+/*
+gsl_linalg_tri_packed_svx()
+  Solve a triangular system op(T) x = b with T in packed format
+
+Inputs: Uplo  - CblasUpper or CblasLower
+        TransA - CblasNoTrans or CblasTrans
+        Diag  - CblasUnit or CblasNonUnit
+        TP    - triangular matrix T in packed format, length N(N+1)/2
+        x     - on input, right hand side b; on output, solution x
+
+Return: success/error
+*/
+
+int
+gsl_linalg_tri_packed_svx (CBLAS_UPLO_t Uplo, CBLAS_TRANSPOSE_t TransA,
+                           CBLAS_DIAG_t Diag, const gsl_vector * TP,
+                           gsl_vector * x)
+{
+  size_t N;
+  int status = packed_order (TP, &N);
+
+  if (status)
+    return status;
+  else if (x->size != N)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      cblas_dtpsv (CblasRowMajor, Uplo, TransA, Diag, (int) N,
+                   TP->data, x->data, (int) x->stride);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_tri_packed_invert()
+  Invert a triangular matrix in packed format, in place
+
+Inputs: Uplo - CblasUpper or CblasLower
+        Diag - CblasUnit or CblasNonUnit
+        TP   - on input, triangular matrix T in packed format,
+               length N(N+1)/2;
+               on output, T^{-1} in packed format
+
+Return: success/error
+
+Notes:
+1) For lower triangular T, row j of T^{-1} satisfies
+T^{-1}(j,0:j-1) = -T^{-1}(j,j) T(j,0:j-1) T^{-1}(0:j-1,0:j-1)
+so rows are computed in increasing order with a packed
+triangular matrix-vector product against the leading block, which
+has already been inverted. For upper triangular T, rows are computed
+in decreasing order against the trailing block (LAPACK DTPTRI)
+*/
+
+int
+gsl_linalg_tri_packed_invert (CBLAS_UPLO_t Uplo, CBLAS_DIAG_t Diag,
+                              gsl_vector * TP)
+{
+  size_t N;
+  int status = packed_order (TP, &N);
+
+  if (status)
+    return status;
+  else if (Diag == CblasNonUnit && tri_packed_singular (Uplo, N, TP->data))
+    {
+      GSL_ERROR ("matrix is singular", GSL_ESING);
+    }
+  else
+    {
+      double *ap = TP->data;
+      size_t j;
+
+      if (Uplo == CblasLower)
+        {
+          for (j = 0; j < N; ++j)
+            {
+              double *tj = ap + j * (j + 1) / 2; /* row j */
+              double ajj = -1.0;
+
+              if (Diag == CblasNonUnit)
+                {
+                  tj[j] = 1.0 / tj[j];
+                  ajj = -tj[j];
+                }
+
+              if (j > 0)
+                {
+                  cblas_dtpmv (CblasRowMajor, CblasLower, CblasTrans, Diag,
+                               (int) j, ap, tj, 1);
+                  cblas_dscal ((int) j, ajj, tj, 1);
+                }
+            }
+        }
+      else
+        {
+          for (j = N; j-- > 0; )
+            {
+              double *tj = ap + j * (2 * N - j + 1) / 2; /* row j, starting at T(j,j) */
+              double ajj = -1.0;
+
+              if (Diag == CblasNonUnit)
+                {
+                  tj[0] = 1.0 / tj[0];
+                  ajj = -tj[0];
+                }
+
+              if (j < N - 1)
+                {
+                  /* trailing block T(j+1:N-1,j+1:N-1) follows row j */
+                  cblas_dtpmv (CblasRowMajor, CblasUpper, CblasTrans, Diag,
+                               (int) (N - j - 1), tj + (N - j), tj + 1, 1);
+                  cblas_dscal ((int) (N - j - 1), ajj, tj + 1, 1);
+                }
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+static int
+tri_packed_singular (CBLAS_UPLO_t Uplo, const size_t N, const double * ap)
+{
+  size_t i;
+
+  for (i = 0; i < N; ++i)
+    {
+      double Tii = (Uplo == CblasLower) ? ap[PACKED_LOWER_DIAG (i)] : ap[i * (2 * N - i + 1) / 2];
+
+      if (Tii == 0.0)
+        return GSL_ESING;
+    }
+
+  return GSL_SUCCESS;
+}
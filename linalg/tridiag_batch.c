@@ -0,0 +1,927 @@
+/* linalg/tridiag_batch.c
+ *
+ * Copyright (C) 2019 The GSL Team
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * Batched solvers for many tridiagonal systems of the same size N.
+ *
+ * The nbatch systems of a batch are stored in interleaved order: the
+ * coefficients and right hand sides are N-by-nbatch matrices (or
+ * (N-1)-by-nbatch for the off-diagonals of a non-cyclic system),
+ * and column b holds system b. Row i then contains element i of every
+ * system, contiguous in memory, and each step of the recurrences of
+ * tridiag.c is carried out for a group of TRIDIAG_GROUP systems at
+ * once, in loops with unit stride and a fixed trip count which are
+ * vectorized by the compiler. The recurrences of the systems of a
+ * group are independent, so the latency of the divisions, which
+ * bounds the speed of a single solve, is hidden. The operations
+ * applied to each system are the same as in tridiag.c. A partial last
+ * group is padded with identity systems.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+
+/* number of systems processed together */
+#define TRIDIAG_GROUP 16
+
+static int tridiag_batch_check (const gsl_matrix * diag, const gsl_matrix * offdiag,
+                                const size_t noff, const gsl_matrix * rhs,
+                                const gsl_matrix * solution);
+static void tridiag_load (const gsl_matrix * A, const size_t i, const size_t b0,
+                          const size_t ng, double * u);
+static void tridiag_store (const double * u, const size_t i, const size_t b0,
+                           const size_t ng, gsl_matrix * A);
+static size_t symm_tridiag_batch (const gsl_matrix * diag, const gsl_matrix * offdiag,
+                                  const gsl_matrix * rhs, gsl_matrix * x,
+                                  const size_t b0, const size_t ng, double * W);
+static size_t tridiag_batch (const gsl_matrix * diag, const gsl_matrix * abovediag,
+                             const gsl_matrix * belowdiag, const gsl_matrix * rhs,
+                             gsl_matrix * x, const size_t b0, const size_t ng, double * W);
+static size_t symm_cyc_tridiag_batch (const gsl_matrix * diag, const gsl_matrix * offdiag,
+                                      const gsl_matrix * rhs, gsl_matrix * x,
+                                      const size_t b0, const size_t ng, double * W);
+static size_t cyc_tridiag_batch (const gsl_matrix * diag, const gsl_matrix * abovediag,
+                                 const gsl_matrix * belowdiag, const gsl_matrix * rhs,
+                                 gsl_matrix * x, const size_t b0, const size_t ng, double * W);
+
+/*
+gsl_linalg_solve_symm_tridiag_batch()
+  Solve many symmetric tridiagonal systems T_b x_b = r_b
+
+Inputs: diag     - N-by-nbatch, column b is the diagonal of T_b
+        offdiag  - (N-1)-by-nbatch, column b is the off-diagonal of T_b
+        rhs      - N-by-nbatch, column b is r_b
+        solution - (output) N-by-nbatch, column b is x_b; may be the
+                   same matrix as rhs
+
+Return: success/error
+
+Notes:
+1) Each system is solved as in gsl_linalg_solve_symm_tridiag, with
+the factorization T = L D L^T
+*/
+
+int
+gsl_linalg_solve_symm_tridiag_batch (const gsl_matrix * diag,
+                                     const gsl_matrix * offdiag,
+                                     const gsl_matrix * rhs,
+                                     gsl_matrix * solution)
+{
+  int status = tridiag_batch_check (diag, offdiag, diag->size1 - 1, rhs, solution);
+
+  if (status)
+    {
+      return status;
+    }
+  else
+    {
+      const size_t N = diag->size1;
+      const size_t nbatch = diag->size2;
+      double *W = malloc (2 * N * TRIDIAG_GROUP * sizeof (double));
+      size_t nzero = 0;
+      size_t b0;
+
+      if (W == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      for (b0 = 0; b0 < nbatch; b0 += TRIDIAG_GROUP)
+        {
+          const size_t ng = GSL_MIN (TRIDIAG_GROUP, nbatch - b0);
+          nzero += symm_tridiag_batch (diag, offdiag, rhs, solution, b0, ng, W);
+        }
+
+      free (W);
+
+      if (nzero > 0)
+        {
+          GSL_ERROR ("matrix must be positive definite", GSL_EZERODIV);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_solve_tridiag_batch()
+  Solve many nonsymmetric tridiagonal systems T_b x_b = r_b
+
+Inputs: diag      - N-by-nbatch, column b is the diagonal of T_b
+        abovediag - (N-1)-by-nbatch, column b is the superdiagonal of T_b
+        belowdiag - (N-1)-by-nbatch, column b is the subdiagonal of T_b
+        rhs       - N-by-nbatch, column b is r_b
+        solution  - (output) N-by-nbatch, column b is x_b; may be the
+                    same matrix as rhs
+
+Return: success/error
+
+Notes:
+1) Each system is solved as in gsl_linalg_solve_tridiag, by Gaussian
+elimination without pivoting
+*/
+
+int
+gsl_linalg_solve_tridiag_batch (const gsl_matrix * diag,
+                                const gsl_matrix * abovediag,
+                                const gsl_matrix * belowdiag,
+                                const gsl_matrix * rhs,
+                                gsl_matrix * solution)
+{
+  int status = tridiag_batch_check (diag, abovediag, diag->size1 - 1, rhs, solution);
+
+  if (status)
+    {
+      return status;
+    }
+  else if (belowdiag->size1 != diag->size1 - 1 || belowdiag->size2 != diag->size2)
+    {
+      GSL_ERROR ("belowdiag must be (N-1)-by-nbatch", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t N = diag->size1;
+      const size_t nbatch = diag->size2;
+      double *W = malloc (2 * N * TRIDIAG_GROUP * sizeof (double));
+      size_t nzero = 0;
+      size_t b0;
+
+      if (W == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      for (b0 = 0; b0 < nbatch; b0 += TRIDIAG_GROUP)
+        {
+          const size_t ng = GSL_MIN (TRIDIAG_GROUP, nbatch - b0);
+          nzero += tridiag_batch (diag, abovediag, belowdiag, rhs, solution, b0, ng, W);
+        }
+
+      free (W);
+
+      if (nzero > 0)
+        {
+          GSL_ERROR ("matrix is singular", GSL_EZERODIV);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_solve_symm_cyc_tridiag_batch()
+  Solve many symmetric cyclic tridiagonal systems T_b x_b = r_b
+
+Inputs: diag     - N-by-nbatch, column b is the diagonal of T_b
+        offdiag  - N-by-nbatch, column b is the off-diagonal of T_b,
+                   with the corner element T_b(0,N-1) in row N-1
+        rhs      - N-by-nbatch, column b is r_b
+        solution - (output) N-by-nbatch, column b is x_b; may be the
+                   same matrix as rhs
+
+Return: success/error
+
+Notes:
+1) Each system is solved as in gsl_linalg_solve_symm_cyc_tridiag;
+N must be at least 3
+*/
+
+int
+gsl_linalg_solve_symm_cyc_tridiag_batch (const gsl_matrix * diag,
+                                         const gsl_matrix * offdiag,
+                                         const gsl_matrix * rhs,
+                                         gsl_matrix * solution)
+{
+  int status = tridiag_batch_check (diag, offdiag, diag->size1, rhs, solution);
+
+  if (status)
+    {
+      return status;
+    }
+  else if (diag->size1 < 3)
+    {
+      GSL_ERROR ("size of cyclic system must be 3 or more", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t N = diag->size1;
+      const size_t nbatch = diag->size2;
+      double *W = malloc (3 * N * TRIDIAG_GROUP * sizeof (double));
+      size_t nzero = 0;
+      size_t b0;
+
+      if (W == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      for (b0 = 0; b0 < nbatch; b0 += TRIDIAG_GROUP)
+        {
+          const size_t ng = GSL_MIN (TRIDIAG_GROUP, nbatch - b0);
+          nzero += symm_cyc_tridiag_batch (diag, offdiag, rhs, solution, b0, ng, W);
+        }
+
+      free (W);
+
+      if (nzero > 0)
+        {
+          GSL_ERROR ("matrix must be positive definite", GSL_EZERODIV);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_solve_cyc_tridiag_batch()
+  Solve many nonsymmetric cyclic tridiagonal systems T_b x_b = r_b
+
+Inputs: diag      - N-by-nbatch, column b is the diagonal of T_b
+        abovediag - N-by-nbatch, column b is the superdiagonal of T_b,
+                    with the corner element T_b(N-1,0) in row N-1
+        belowdiag - N-by-nbatch, column b is the subdiagonal of T_b,
+                    with the corner element T_b(0,N-1) in row N-1
+        rhs       - N-by-nbatch, column b is r_b
+        solution  - (output) N-by-nbatch, column b is x_b; may be the
+                    same matrix as rhs
+
+Return: success/error
+
+Notes:
+1) Each system is solved as in gsl_linalg_solve_cyc_tridiag, with the
+Sherman-Morrison formula; N must be at least 3
+*/
+
+int
+gsl_linalg_solve_cyc_tridiag_batch (const gsl_matrix * diag,
+                                    const gsl_matrix * abovediag,
+                                    const gsl_matrix * belowdiag,
+                                    const gsl_matrix * rhs,
+                                    gsl_matrix * solution)
+{
+  int status = tridiag_batch_check (diag, abovediag, diag->size1, rhs, solution);
+
+  if (status)
+    {
+      return status;
+    }
+  else if (belowdiag->size1 != diag->size1 || belowdiag->size2 != diag->size2)
+    {
+      GSL_ERROR ("belowdiag must be N-by-nbatch", GSL_EBADLEN);
+    }
+  else if (diag->size1 < 3)
+    {
+      GSL_ERROR ("size of cyclic system must be 3 or more", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t N = diag->size1;
+      const size_t nbatch = diag->size2;
+      double *W = malloc (3 * N * TRIDIAG_GROUP * sizeof (double));
+      size_t nzero = 0;
+      size_t b0;
+
+      if (W == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      for (b0 = 0; b0 < nbatch; b0 += TRIDIAG_GROUP)
+        {
+          const size_t ng = GSL_MIN (TRIDIAG_GROUP, nbatch - b0);
+          nzero += cyc_tridiag_batch (diag, abovediag, belowdiag, rhs, solution, b0, ng, W);
+        }
+
+      free (W);
+
+      if (nzero > 0)
+        {
+          GSL_ERROR ("matrix is singular", GSL_EZERODIV);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+static int
+tridiag_batch_check (const gsl_matrix * diag, const gsl_matrix * offdiag,
+                     const size_t noff, const gsl_matrix * rhs,
+                     const gsl_matrix * solution)
+{
+  if (rhs->size1 != diag->size1 || rhs->size2 != diag->size2)
+    {
+      GSL_ERROR ("rhs must match the size of diag", GSL_EBADLEN);
+    }
+  else if (solution->size1 != diag->size1 || solution->size2 != diag->size2)
+    {
+      GSL_ERROR ("solution must match the size of diag", GSL_EBADLEN);
+    }
+  else if (offdiag->size1 != noff || offdiag->size2 != diag->size2)
+    {
+      if (noff == diag->size1)
+        {
+          GSL_ERROR ("off-diagonal must be N-by-nbatch", GSL_EBADLEN);
+        }
+      else
+        {
+          GSL_ERROR ("off-diagonal must be (N-1)-by-nbatch", GSL_EBADLEN);
+        }
+    }
+  else
+    {
+      return GSL_SUCCESS;
+    }
+}
+
+/* u[l] = A(i,b0+l), l < ng */
+static void
+tridiag_load (const gsl_matrix * A, const size_t i, const size_t b0,
+              const size_t ng, double * u)
+{
+  const double * Ai = A->data + i * A->tda + b0;
+  size_t l;
+
+  if (ng == TRIDIAG_GROUP)
+    {
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        u[l] = Ai[l];
+    }
+  else
+    {
+      for (l = 0; l < ng; ++l)
+        u[l] = Ai[l];
+    }
+}
+
+/* A(i,b0+l) = u[l], l < ng */
+static void
+tridiag_store (const double * u, const size_t i, const size_t b0,
+               const size_t ng, gsl_matrix * A)
+{
+  double * Ai = A->data + i * A->tda + b0;
+  size_t l;
+
+  if (ng == TRIDIAG_GROUP)
+    {
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        Ai[l] = u[l];
+    }
+  else
+    {
+      for (l = 0; l < ng; ++l)
+        Ai[l] = u[l];
+    }
+}
+
+/*
+symm_tridiag_batch()
+  Solve the symmetric systems b0,...,b0+ng-1 of a batch
+
+Inputs: diag    - diagonals
+        offdiag - off-diagonals
+        rhs     - right hand sides
+        x       - (output) solutions
+        b0      - first system of the group
+        ng      - number of systems in the group
+        W       - workspace, length 2*N*TRIDIAG_GROUP
+
+Return: number of zero pivots
+*/
+
+static size_t
+symm_tridiag_batch (const gsl_matrix * diag, const gsl_matrix * offdiag,
+                    const gsl_matrix * rhs, gsl_matrix * x,
+                    const size_t b0, const size_t ng, double * W)
+{
+  const size_t N = diag->size1;
+  double *gamma = W;                        /* lower diagonal of L */
+  double *c = W + N * TRIDIAG_GROUP;        /* D^{-1} L^{-1} r */
+  double d[TRIDIAG_GROUP], o[TRIDIAG_GROUP], r[TRIDIAG_GROUP];
+  double alpha[TRIDIAG_GROUP], z[TRIDIAG_GROUP];
+  size_t nzero = 0;
+  size_t i, l;
+
+  /* pad the group with identity systems */
+  for (l = 0; l < TRIDIAG_GROUP; ++l)
+    {
+      d[l] = 1.0;
+      o[l] = 0.0;
+      r[l] = 0.0;
+    }
+
+  for (i = 0; i < N; ++i)
+    {
+      double *ci = c + i * TRIDIAG_GROUP;
+
+      tridiag_load (diag, i, b0, ng, d);
+      tridiag_load (rhs, i, b0, ng, r);
+
+      if (i == 0)
+        {
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            {
+              alpha[l] = d[l];
+              z[l] = r[l];
+            }
+        }
+      else
+        {
+          const double *gi = gamma + (i - 1) * TRIDIAG_GROUP;
+
+          /* o holds offdiag(i-1) */
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            {
+              alpha[l] = d[l] - o[l] * gi[l];
+              z[l] = r[l] - gi[l] * z[l];
+            }
+        }
+
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        {
+          nzero += (alpha[l] == 0.0);
+          ci[l] = z[l] / alpha[l];
+        }
+
+      if (i + 1 < N)
+        {
+          double *gi = gamma + i * TRIDIAG_GROUP;
+
+          tridiag_load (offdiag, i, b0, ng, o);
+
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            gi[l] = o[l] / alpha[l];
+        }
+    }
+
+  /* back substitution */
+  for (l = 0; l < TRIDIAG_GROUP; ++l)
+    z[l] = c[(N - 1) * TRIDIAG_GROUP + l];
+
+  tridiag_store (z, N - 1, b0, ng, x);
+
+  for (i = N - 1; i-- > 0; )
+    {
+      const double *gi = gamma + i * TRIDIAG_GROUP;
+      const double *ci = c + i * TRIDIAG_GROUP;
+
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        z[l] = ci[l] - gi[l] * z[l];
+
+      tridiag_store (z, i, b0, ng, x);
+    }
+
+  return nzero;
+}
+
+/*
+tridiag_batch()
+  Solve the nonsymmetric systems b0,...,b0+ng-1 of a batch
+
+Inputs: diag      - diagonals
+        abovediag - superdiagonals
+        belowdiag - subdiagonals
+        rhs       - right hand sides
+        x         - (output) solutions
+        b0        - first system of the group
+        ng        - number of systems in the group
+        W         - workspace, length 2*N*TRIDIAG_GROUP
+
+Return: number of zero pivots
+*/
+
+static size_t
+tridiag_batch (const gsl_matrix * diag, const gsl_matrix * abovediag,
+               const gsl_matrix * belowdiag, const gsl_matrix * rhs,
+               gsl_matrix * x, const size_t b0, const size_t ng, double * W)
+{
+  const size_t N = diag->size1;
+  double *alpha = W;                        /* diagonal after elimination */
+  double *z = W + N * TRIDIAG_GROUP;        /* rhs after elimination */
+  double d[TRIDIAG_GROUP], a[TRIDIAG_GROUP], b[TRIDIAG_GROUP], r[TRIDIAG_GROUP];
+  double y[TRIDIAG_GROUP];
+  size_t nzero = 0;
+  size_t i, l;
+
+  for (l = 0; l < TRIDIAG_GROUP; ++l)
+    {
+      d[l] = 1.0;
+      a[l] = 0.0;
+      b[l] = 0.0;
+      r[l] = 0.0;
+    }
+
+  tridiag_load (diag, 0, b0, ng, d);
+  tridiag_load (rhs, 0, b0, ng, r);
+
+  for (l = 0; l < TRIDIAG_GROUP; ++l)
+    {
+      nzero += (d[l] == 0.0);
+      alpha[l] = d[l];
+      z[l] = r[l];
+    }
+
+  /* eliminate the subdiagonal */
+  for (i = 1; i < N; ++i)
+    {
+      const double *alpha0 = alpha + (i - 1) * TRIDIAG_GROUP;
+      const double *z0 = z + (i - 1) * TRIDIAG_GROUP;
+      double *alpha1 = alpha + i * TRIDIAG_GROUP;
+      double *z1 = z + i * TRIDIAG_GROUP;
+
+      tridiag_load (diag, i, b0, ng, d);
+      tridiag_load (abovediag, i - 1, b0, ng, a);
+      tridiag_load (belowdiag, i - 1, b0, ng, b);
+      tridiag_load (rhs, i, b0, ng, r);
+
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        {
+          const double t = b[l] / alpha0[l];
+          alpha1[l] = d[l] - t * a[l];
+          z1[l] = r[l] - t * z0[l];
+        }
+
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        nzero += (alpha1[l] == 0.0);
+    }
+
+  /* back substitution */
+  for (l = 0; l < TRIDIAG_GROUP; ++l)
+    y[l] = z[(N - 1) * TRIDIAG_GROUP + l] / alpha[(N - 1) * TRIDIAG_GROUP + l];
+
+  tridiag_store (y, N - 1, b0, ng, x);
+
+  for (i = N - 1; i-- > 0; )
+    {
+      const double *alphai = alpha + i * TRIDIAG_GROUP;
+      const double *zi = z + i * TRIDIAG_GROUP;
+
+      tridiag_load (abovediag, i, b0, ng, a);
+
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        y[l] = (zi[l] - a[l] * y[l]) / alphai[l];
+
+      tridiag_store (y, i, b0, ng, x);
+    }
+
+  return nzero;
+}
+
+/*
+symm_cyc_tridiag_batch()
+  Solve the symmetric cyclic systems b0,...,b0+ng-1 of a batch, with
+the method of solve_cyc_tridiag in tridiag.c
+
+Inputs: diag    - diagonals
+        offdiag - off-diagonals
+        rhs     - right hand sides
+        x       - (output) solutions
+        b0      - first system of the group
+        ng      - number of systems in the group
+        W       - workspace, length 3*N*TRIDIAG_GROUP
+
+Return: number of zero pivots
+*/
+
+static size_t
+symm_cyc_tridiag_batch (const gsl_matrix * diag, const gsl_matrix * offdiag,
+                        const gsl_matrix * rhs, gsl_matrix * x,
+                        const size_t b0, const size_t ng, double * W)
+{
+  const size_t N = diag->size1;
+  double *gamma = W;
+  double *delta = W + N * TRIDIAG_GROUP;
+  double *c = W + 2 * N * TRIDIAG_GROUP;
+  double d[TRIDIAG_GROUP], o0[TRIDIAG_GROUP], o1[TRIDIAG_GROUP], r[TRIDIAG_GROUP];
+  double alpha[TRIDIAG_GROUP], z[TRIDIAG_GROUP], y[TRIDIAG_GROUP];
+  double sum[TRIDIAG_GROUP], sumz[TRIDIAG_GROUP];
+  size_t nzero = 0;
+  size_t i, l;
+
+  for (l = 0; l < TRIDIAG_GROUP; ++l)
+    {
+      d[l] = 1.0;
+      o0[l] = 0.0;
+      o1[l] = 0.0;
+      r[l] = 0.0;
+      y[l] = 0.0;
+      sum[l] = 0.0;
+      sumz[l] = 0.0;
+    }
+
+  /* factor and update for rows 0,...,N-2; o0 holds offdiag(i-1) and
+   * o1 holds offdiag(i) */
+  for (i = 0; i < N - 1; ++i)
+    {
+      double *gi = gamma + i * TRIDIAG_GROUP;
+      double *deltai = delta + i * TRIDIAG_GROUP;
+      double *ci = c + i * TRIDIAG_GROUP;
+
+      tridiag_load (diag, i, b0, ng, d);
+      tridiag_load (rhs, i, b0, ng, r);
+
+      if (i == 0)
+        {
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            {
+              alpha[l] = d[l];
+              z[l] = r[l];
+            }
+        }
+      else
+        {
+          const double *g0 = gi - TRIDIAG_GROUP;
+
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            {
+              o0[l] = o1[l];
+              alpha[l] = d[l] - o0[l] * g0[l];
+              z[l] = r[l] - z[l] * g0[l];
+            }
+        }
+
+      tridiag_load (offdiag, i, b0, ng, o1);
+
+      if (i == 0)
+        {
+          /* delta_0 = offdiag(N-1) / alpha_0 */
+          tridiag_load (offdiag, N - 1, b0, ng, y);
+
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            {
+              gi[l] = o1[l] / alpha[l];
+              deltai[l] = y[l] / alpha[l];
+            }
+        }
+      else if (i < N - 2)
+        {
+          const double *delta0 = deltai - TRIDIAG_GROUP;
+
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            {
+              gi[l] = o1[l] / alpha[l];
+              deltai[l] = -delta0[l] * o0[l] / alpha[l];
+            }
+        }
+      else
+        {
+          const double *delta0 = deltai - TRIDIAG_GROUP;
+
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            gi[l] = (o1[l] - o0[l] * delta0[l]) / alpha[l];
+        }
+
+      if (i < N - 2)
+        {
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            {
+              sum[l] += alpha[l] * deltai[l] * deltai[l];
+              sumz[l] += deltai[l] * z[l];
+            }
+        }
+
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        {
+          nzero += (alpha[l] == 0.0);
+          ci[l] = z[l] / alpha[l];
+        }
+    }
+
+  /* last row, with alpha and z holding row N-2 */
+  {
+    const double *g0 = gamma + (N - 2) * TRIDIAG_GROUP;
+
+    tridiag_load (diag, N - 1, b0, ng, d);
+    tridiag_load (rhs, N - 1, b0, ng, r);
+
+    for (l = 0; l < TRIDIAG_GROUP; ++l)
+      {
+        const double alpha1 = d[l] - sum[l] - alpha[l] * g0[l] * g0[l];
+        const double z1 = r[l] - sumz[l] - g0[l] * z[l];
+
+        nzero += (alpha1 == 0.0);
+        y[l] = z1 / alpha1;
+        z[l] = y[l];      /* x_{N-1} */
+      }
+
+    tridiag_store (y, N - 1, b0, ng, x);
+
+    for (l = 0; l < TRIDIAG_GROUP; ++l)
+      y[l] = c[(N - 2) * TRIDIAG_GROUP + l] - g0[l] * y[l];
+
+    tridiag_store (y, N - 2, b0, ng, x);
+  }
+
+  /* back substitution; z holds x_{N-1} */
+  for (i = N - 2; i-- > 0; )
+    {
+      const double *gi = gamma + i * TRIDIAG_GROUP;
+      const double *deltai = delta + i * TRIDIAG_GROUP;
+      const double *ci = c + i * TRIDIAG_GROUP;
+
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        y[l] = ci[l] - gi[l] * y[l] - deltai[l] * z[l];
+
+      tridiag_store (y, i, b0, ng, x);
+    }
+
+  return nzero;
+}
+
+/*
+cyc_tridiag_batch()
+  Solve the nonsymmetric cyclic systems b0,...,b0+ng-1 of a batch, with
+the method of solve_cyc_tridiag_nonsym in tridiag.c
+
+Inputs: diag      - diagonals
+        abovediag - superdiagonals
+        belowdiag - subdiagonals
+        rhs       - right hand sides
+        x         - (output) solutions
+        b0        - first system of the group
+        ng        - number of systems in the group
+        W         - workspace, length 3*N*TRIDIAG_GROUP
+
+Return: number of zero pivots
+*/
+
+static size_t
+cyc_tridiag_batch (const gsl_matrix * diag, const gsl_matrix * abovediag,
+                   const gsl_matrix * belowdiag, const gsl_matrix * rhs,
+                   gsl_matrix * x, const size_t b0, const size_t ng, double * W)
+{
+  const size_t N = diag->size1;
+  double *alpha = W;
+  double *zb = W + N * TRIDIAG_GROUP;       /* rhs after elimination, then x */
+  double *zu = W + 2 * N * TRIDIAG_GROUP;   /* rhs of A q = u after elimination, then w */
+  double d[TRIDIAG_GROUP], a[TRIDIAG_GROUP], b[TRIDIAG_GROUP], r[TRIDIAG_GROUP];
+  double beta[TRIDIAG_GROUP], y[TRIDIAG_GROUP], w[TRIDIAG_GROUP];
+  size_t nzero = 0;
+  size_t i, l;
+
+  for (l = 0; l < TRIDIAG_GROUP; ++l)
+    {
+      d[l] = 1.0;
+      a[l] = 0.0;
+      b[l] = 0.0;
+      r[l] = 0.0;
+      y[l] = 1.0;
+    }
+
+  tridiag_load (diag, 0, b0, ng, d);
+  tridiag_load (diag, 1, b0, ng, y);
+  tridiag_load (abovediag, 0, b0, ng, a);
+  tridiag_load (belowdiag, 0, b0, ng, b);
+  tridiag_load (rhs, 0, b0, ng, r);
+
+  for (l = 0; l < TRIDIAG_GROUP; ++l)
+    {
+      const double q = 1 - a[l] * b[l] / (d[l] * y[l]);
+      double bl = (d[l] != 0) ? -d[l] : 1;
+
+      if (fabs (q / bl) > 0.5 && fabs (q / bl) < 2)
+        bl *= (fabs (q / bl) < 1) ? 0.5 : 2;
+
+      beta[l] = bl;
+      zb[l] = r[l];
+      zu[l] = bl;
+      alpha[l] = d[l] - bl;
+      nzero += (alpha[l] == 0.0);
+    }
+
+  for (i = 1; i < N; ++i)
+    {
+      const double *alpha0 = alpha + (i - 1) * TRIDIAG_GROUP;
+      const double *zb0 = zb + (i - 1) * TRIDIAG_GROUP;
+      const double *zu0 = zu + (i - 1) * TRIDIAG_GROUP;
+      double *alpha1 = alpha + i * TRIDIAG_GROUP;
+      double *zb1 = zb + i * TRIDIAG_GROUP;
+      double *zu1 = zu + i * TRIDIAG_GROUP;
+
+      tridiag_load (diag, i, b0, ng, d);
+      tridiag_load (abovediag, i - 1, b0, ng, a);
+      tridiag_load (belowdiag, i - 1, b0, ng, b);
+      tridiag_load (rhs, i, b0, ng, r);
+
+      if (i < N - 1)
+        {
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            {
+              const double t = b[l] / alpha0[l];
+              alpha1[l] = d[l] - t * a[l];
+              zb1[l] = r[l] - t * zb0[l];
+              zu1[l] = -t * zu0[l];
+            }
+        }
+      else
+        {
+          /* corner elements abovediag(N-1), belowdiag(N-1) */
+          double ac[TRIDIAG_GROUP], bc[TRIDIAG_GROUP];
+
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            {
+              ac[l] = 0.0;
+              bc[l] = 0.0;
+            }
+
+          tridiag_load (abovediag, N - 1, b0, ng, ac);
+          tridiag_load (belowdiag, N - 1, b0, ng, bc);
+
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            {
+              const double t = b[l] / alpha0[l];
+              alpha1[l] = d[l] - ac[l] * bc[l] / beta[l] - t * a[l];
+              zb1[l] = r[l] - t * zb0[l];
+              zu1[l] = ac[l] - t * zu0[l];
+            }
+
+          /* save belowdiag(N-1) / beta for the Sherman-Morrison update */
+          for (l = 0; l < TRIDIAG_GROUP; ++l)
+            beta[l] = bc[l] / beta[l];
+        }
+
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        nzero += (alpha1[l] == 0.0);
+    }
+
+  /* back substitution for w and x, stored in zu and zb */
+  {
+    double *alphai = alpha + (N - 1) * TRIDIAG_GROUP;
+    double *zbi = zb + (N - 1) * TRIDIAG_GROUP;
+    double *zui = zu + (N - 1) * TRIDIAG_GROUP;
+
+    for (l = 0; l < TRIDIAG_GROUP; ++l)
+      {
+        w[l] = zui[l] / alphai[l];
+        y[l] = zbi[l] / alphai[l];
+        zui[l] = w[l];
+        zbi[l] = y[l];
+      }
+  }
+
+  for (i = N - 1; i-- > 0; )
+    {
+      const double *alphai = alpha + i * TRIDIAG_GROUP;
+      double *zbi = zb + i * TRIDIAG_GROUP;
+      double *zui = zu + i * TRIDIAG_GROUP;
+
+      tridiag_load (abovediag, i, b0, ng, a);
+
+      for (l = 0; l < TRIDIAG_GROUP; ++l)
+        {
+          w[l] = (zui[l] - a[l] * w[l]) / alphai[l];
+          y[l] = (zbi[l] - a[l] * y[l]) / alphai[l];
+          zui[l] = w[l];
+          zbi[l] = y[l];
+        }
+    }
+
+  /* Sherman-Morrison, with beta holding belowdiag(N-1) / beta */
+  {
+    const double *wN = zu + (N - 1) * TRIDIAG_GROUP;
+    const double *xN = zb + (N - 1) * TRIDIAG_GROUP;
+    double f[TRIDIAG_GROUP];
+
+    for (l = 0; l < TRIDIAG_GROUP; ++l)
+      {
+        const double vw = zu[l] + beta[l] * wN[l];
+        const double vx = zb[l] + beta[l] * xN[l];
+
+        nzero += (vw + 1 == 0);
+        f[l] = vx / (1 + vw);
+      }
+
+    for (i = 0; i < N; ++i)
+      {
+        const double *zbi = zb + i * TRIDIAG_GROUP;
+        const double *zui = zu + i * TRIDIAG_GROUP;
+
+        for (l = 0; l < TRIDIAG_GROUP; ++l)
+          y[l] = zbi[l] - f[l] * zui[l];
+
+        tridiag_store (y, i, b0, ng, x);
+      }
+  }
+
+  return nzero;
+}
@@ -48,7 +48,7 @@ typedef struct
   }
 gsl_rng_type;
 
-typedef struct
+typedef struct gsl_rng_struct
   {
     const gsl_rng_type * type;
     void *state;
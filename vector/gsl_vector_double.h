@@ -182,8 +182,7 @@ gsl_vector_get (const gsl_vector * v, const size_t i)
       GSL_ERROR_VAL ("index out of range", GSL_EINVAL, 0);
     }
 #endif
-  //return v->data[i * v->stride];
-  return *(v->data + i);
+  return v->data[i * v->stride];
 }
 
 INLINE_FUN
@@ -196,8 +195,7 @@ gsl_vector_set (gsl_vector * v, const size_t i, double x)
       GSL_ERROR_VOID ("index out of range", GSL_EINVAL);
     }
 #endif
-  //v->data[i * v->stride] = x;
-  *(v->data + i)  = x;
+  v->data[i * v->stride] = x;
 }
 
 INLINE_FUN
@@ -210,8 +208,7 @@ gsl_vector_ptr (gsl_vector * v, const size_t i)
       GSL_ERROR_NULL ("index out of range", GSL_EINVAL);
     }
 #endif
-  //return (double *) (v->data + i * v->stride);
-  return (double *)(v->data + i);
+  return (double *) (v->data + i * v->stride);
 }
 
 INLINE_FUN
@@ -224,8 +221,7 @@ gsl_vector_const_ptr (const gsl_vector * v, const size_t i)
       GSL_ERROR_NULL ("index out of range", GSL_EINVAL);
     }
 #endif
-  //return (const double *) (v->data + i * v->stride);
-  return (const double *)(v->data + i);
+  return (const double *) (v->data + i * v->stride);
 }
 #endif /* HAVE_INLINE */
 
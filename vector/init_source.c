@@ -178,13 +178,18 @@ FUNCTION (gsl_vector, set_zero) (TYPE (gsl_vector) * v)
   const size_t stride = v->stride;
   const BASE zero = ZERO ;
 
-  //size_t i;
+  size_t i;
 
-  //for (i = 0; i < n; i++)
-  //  {
-  //    *(BASE *) (data + MULTIPLICITY * i * stride) = zero;
-  //  }
-  memset(data, 0, sizeof(BASE)*n);
+  if (stride == 1)
+    {
+      memset (data, 0, sizeof (BASE) * n);
+      return;
+    }
+
+  for (i = 0; i < n; i++)
+    {
+      *(BASE *) (data + MULTIPLICITY * i * stride) = zero;
+    }
 }
 
 int